@@ -126,7 +126,15 @@ typedef CachedValue<vector_fp>& CachedArray;
  *
  * Each method in the class that implements caching behavior needs a unique id
  * for its cached value. This id should be obtained by using the getId()
- * function to initialize a static variable within the function.
+ * function to initialize a constant at namespace scope in the file which
+ * implements the method. This way, all ids are assigned during static
+ * initialization, before any threads can be started, and the cache can be
+ * used without any locking. (Initializing a static variable within the method
+ * instead is not thread safe with some compilers, since two threads calling
+ * the method for the first time may both try to initialize it.)
+ *
+ * Each ValueCache belongs to a single object, so objects that are not shared
+ * between threads can use their caches concurrently; see \ref threadSafety.
  *
  * For cases where the property is a scalar or vector, the cached value can be
  * stored in the CachedValue object. If the data type of the cached value is
@@ -135,11 +143,14 @@ typedef CachedValue<vector_fp>& CachedArray;
  *
  * An example use of class ValueCache:
  * @code
+ * namespace {
+ * const int cacheId_property = ValueCache::getId();
+ * }
+ *
  * class Example {
  *     ValueCache m_cache;
  *     doublereal get_property(doublereal T, doublereal P) {
- *         const static int cacheId = m_cache.getId();
- *         CachedScalar cached = m_cache.getScalar(cacheId);
+ *         CachedScalar cached = m_cache.getScalar(cacheId_property);
  *         if (T != cached.state1 || P != cached.state2) {
  *             cached.value = some_expensive_function(T,P);
  *             cached.state1 = T;
@@ -154,8 +165,9 @@ class ValueCache
 {
 public:
     //! Get a unique id for a cached value. Must be called exactly once for each
-    //! method that implements caching behavior.
-    int getId();
+    //! method that implements caching behavior, during static initialization.
+    //! With THREAD_SAFE_CANTERA, ids may also be requested concurrently.
+    static int getId();
 
     //! Get a reference to a CachedValue object representing a scalar
     //! (doublereal) with the given id.
@@ -182,8 +194,15 @@ protected:
     //! Cached array values
     std::map<int, CachedValue<vector_fp> > m_arrayCache;
 
-    //! The last assigned id. Automatically incremented by the getId() method.
-    static int m_last_id;
+#if defined(THREAD_SAFE_CANTERA) && defined(_MSC_VER)
+    typedef long id_counter_t;
+#else
+    typedef int id_counter_t;
+#endif
+
+    //! The last assigned id. Automatically incremented by the getId() method,
+    //! atomically if THREAD_SAFE_CANTERA is defined.
+    static volatile id_counter_t m_last_id;
 };
 
 }
@@ -1,6 +1,41 @@
 /*!
  * @file ct_thread.h
- * Header file containing utilities used to ensure thread safety.
+ * Header file containing utilities used to ensure thread safety
+ * (see \ref threadSafety).
+ */
+
+/*!
+ * @defgroup threadSafety Thread safety
+ *
+ * Cantera can be used from multithreaded applications if it is compiled with
+ * the `build_thread_safe` option, which defines the preprocessor symbol
+ * THREAD_SAFE_CANTERA. The rules are:
+ *
+ *  - An individual object (e.g. a ThermoPhase, Kinetics, Transport, Reactor
+ *    or ReactorNet, together with the objects it refers to) may only be used
+ *    by one thread at a time. Typically, each thread creates its own objects.
+ *    Sharing a single object between threads requires locking by the
+ *    application.
+ *
+ *  - Independent objects may be used concurrently from different threads
+ *    without any synchronization. Properties that are cached to avoid
+ *    recomputation, e.g. the reference state properties cached by
+ *    IdealGasPhase or the rate constants cached by GasKinetics, are stored
+ *    in the object that uses them, so the evaluation of the cached
+ *    properties does not require any locks. Classes using ValueCache obtain
+ *    the ids for their cached values during static initialization for the
+ *    same reason.
+ *
+ *  - State which is shared by all objects is protected by mutexes. This
+ *    includes the Application object (input file search path, cached XML
+ *    trees, and per-thread error and log messages) and the factory
+ *    singletons (e.g. ThermoFactory, KineticsFactory, TransportFactory and
+ *    ReactorFactory). These locks are only acquired while objects are being
+ *    created, not while they are being used.
+ *
+ * Without THREAD_SAFE_CANTERA, the mutex types defined in this file are
+ * dummies, and only the first two rules apply, with the exception that
+ * objects may not be created concurrently.
  */
 
 #ifndef CT_THREAD_H
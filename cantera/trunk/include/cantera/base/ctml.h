@@ -782,6 +782,9 @@ void ct2ctml(const char* file, const int debug = 0);
 
 //! Get a string with the ctml representation of a cti file.
 /*!
+ *  The file is converted with ct2ctml_native() if possible, and otherwise
+ *  with the Python converter.
+ *
  *  @param   file    Path to the input file in CTI format
  *  @return  String containing the xml representation of the input file
  *
@@ -791,6 +794,9 @@ std::string ct2ctml_string(const std::string& file);
 
 //! Get a string with the ctml representation of a cti input string.
 /*!
+ *  The input is converted with ct2ctml_native() if possible, and otherwise
+ *  with the Python converter.
+ *
  *  @param   cti    String containing the cti representation
  *  @return  String containing the xml representation of the input
  *
@@ -798,6 +804,86 @@ std::string ct2ctml_string(const std::string& file);
  */
 std::string ct_string2ctml_string(const std::string& cti);
 
+//! Convert cti input to an XML tree without calling Python.
+/*!
+ * The built-in converter handles the entries that are used for ideal gas
+ * mechanisms: `units`, `standard_pressure`, `validate`, `element`,
+ * `ideal_gas`, `species` (with `NASA`, `NASA9`, `Shomate` or `const_cp`
+ * thermo and `gas_transport` parameters) and the `reaction`,
+ * `three_body_reaction`, `falloff_reaction`,
+ * `chemically_activated_reaction`, `pdep_arrhenius` and
+ * `chebyshev_reaction` entries, in files which contain only these entries,
+ * assignments and simple arithmetic. The tree is the same as the one read
+ * from the output of the Python converter.
+ *
+ * If the input contains anything else, or is invalid, nothing is added to
+ * `root` and false is returned, in which case the input should be converted
+ * with the Python converter, which also reports any errors.
+ *
+ *  @param  cti   Contents of the cti file
+ *  @param  root  Node to which the `ctml` node is added as a child
+ *  @return       True if the input was converted
+ *
+ *  @ingroup inputfiles
+ */
+bool ct2ctml_native(const std::string& cti, Cantera::XML_Node& root);
+
+//! Convert a cti file or string to ctml using the Python converter.
+/*!
+ *  @param  text    Path to the input file, or the cti input itself
+ *  @param  isfile  True if `text` is the path to a file
+ *  @return String containing the xml representation of the input
+ *
+ *  @ingroup inputfiles
+ */
+std::string call_ctml_writer(const std::string& text, bool isfile);
+
+//! Write an XML tree to a file in the binary CTML format.
+/*!
+ * The binary CTML format is a cache of the parsed XML tree. It stores the
+ * same tree as a CTML file, but as tables of nodes, attributes and
+ * (deduplicated) strings that can be read without any text parsing. Input
+ * files with the extension `.ctmlb` are read in this format by
+ * get_XML_File(), so they can be used in place of the CTI or CTML file from
+ * which they were generated, without running the Python preprocessor. Since
+ * the tree for a phase includes its species, reactions and transport data, a
+ * mechanism that has already been loaded can be converted with, e.g.
+ *
+ *     ctml::writeBinaryCTML(gas.xml().root(), "gri30.ctmlb");
+ *
+ * Only the reading of the tree is avoided. The values of the nodes are
+ * stored as the same text as in the CTML file, and the phase, kinetics and
+ * transport objects are built from the tree as usual, which includes
+ * converting the numbers and fitting the transport properties. For GRI-Mech
+ * 3.0, reading the tree takes about 2 ms instead of 7 ms, out of about 60 ms
+ * to set up the phase, kinetics and transport objects.
+ *
+ * References to data in other files (e.g. a `datasrc` attribute naming
+ * another file) are stored as they are, and must still be resolvable when
+ * the binary file is used. The file is written in the byte order of the
+ * machine that writes it, and is rejected on machines with a different
+ * byte order.
+ *
+ *  @param root  Root of the tree to be written
+ *  @param file  Name of the output file
+ *
+ *  @ingroup inputfiles
+ */
+void writeBinaryCTML(const Cantera::XML_Node& root, const std::string& file);
+
+//! Read a file in the binary CTML format.
+/*!
+ * The file is memory-mapped where supported, and the tree is built directly
+ * from its tables. See writeBinaryCTML().
+ *
+ *  @param file  Name of the input file
+ *  @param root  Node which is set to the root of the tree read from the
+ *               file. Any existing children and attributes are kept.
+ *
+ *  @ingroup inputfiles
+ */
+void readBinaryCTML(const std::string& file, Cantera::XML_Node& root);
+
 //! Convert a Chemkin-format mechanism into a CTI file.
 /*!
  * @param in_file         input file containing species and reactions
@@ -27,20 +27,30 @@ class XML_Reader
 public:
     //! Sole Constructor for the XML_Reader class
     /*!
+     *  The remaining contents of the stream are read into a buffer, from
+     *  which the XML file is then scanned.
+     *
      *   @param input   Reference to the istream object containing
      *                  the XML file
      */
     XML_Reader(std::istream& input);
 
-    //! Read a single character from the input stream and returns it
+    //! Read a single character from the input buffer and returns it
     /*!
      *  All low level reads occur through this function.
      *  The function also keeps track of the line numbers.
+     *  At the end of the input, *ch* is left unchanged and eof()
+     *  becomes true.
      *
      * @param ch   Character to be returned.
      */
     void getchr(char& ch);
 
+    //! True if a read has been attempted past the end of the input
+    bool eof() const {
+        return m_eof;
+    }
+
     //!  Searches a string for the first occurrence of a valid
     //!  quoted string.
     /*!
@@ -87,6 +97,15 @@ protected:
     //! Input stream containing the XML file
     std::istream& m_s;
 
+    //! Contents of the input stream
+    std::string m_buffer;
+
+    //! Position of the next character to be read from #m_buffer
+    size_t m_pos;
+
+    //! True if a read has been attempted past the end of #m_buffer
+    bool m_eof;
+
 public:
     //! Line count
     int m_line;
@@ -657,12 +676,29 @@ public:
     void copy(XML_Node* const node_dest) const;
 
     //! Set the lock for this node and all of its children
+    /*!
+     * If this node is the root of its tree, an index of all the nodes in the
+     * tree by the values of their "id" and "name" attributes is also built.
+     * findID(), findByAttr(), findNameID() and findXMLPhase() then look up
+     * nodes in the index instead of searching the tree, with the same
+     * results. The index is discarded when the tree is modified or unlocked.
+     *
+     * The index is only read by these searches, so a locked tree may be
+     * searched from several threads at once as long as none of them
+     * modifies it.
+     */
     void lock();
 
     //! Unset the lock for this node and all of its children
     void unlock();
 
 private:
+    //! Index of the nodes in a locked tree
+    class Index;
+
+    //! Discard the index of the tree containing this node, if there is one
+    void dropIndex();
+
     //! Write an XML subtree to an output stream.
     /*!
      * This is the main recursive routine. It doesn't put a final endl
@@ -746,6 +782,9 @@ protected:
      *  Currently, unimplemented functionality
      */
     int m_linenum;
+
+    //! Index of the nodes in the tree, built by lock() for a root node
+    Index* m_index;
 };
 
 //! Search an XML_Node tree for a named phase XML_Node
@@ -0,0 +1,156 @@
+/**
+ *  @file BatchEvaluator.h
+ *  Evaluation of production rates and enthalpies for blocks of independent
+ *  states (see \ref kineticsmgr and class
+ *  \link Cantera::BatchEvaluator BatchEvaluator\endlink).
+ */
+
+#ifndef CT_BATCHEVALUATOR_H
+#define CT_BATCHEVALUATOR_H
+
+#include "Kinetics.h"
+
+namespace Cantera
+{
+
+class GasKinetics;
+class GeneralSpeciesThermo;
+
+//! Evaluates species production rates and enthalpies for a block of
+//! independent states of a homogeneous phase.
+/*!
+ * Applications such as parameter sweeps or operator-split CFD chemistry
+ * need the production rates for many unrelated states. The states are passed
+ * to eval() as a block in structure-of-arrays form, i.e. the mass fraction of
+ * species *k* in state *n* is `Y[k*nStates + n]`.
+ *
+ * For a GasKinetics manager of an IdealGasPhase, the states are evaluated
+ * together, in sub-blocks of at most blockSize() states. Each step of the
+ * calculation (the species thermo polynomials, the Arrhenius rate constants,
+ * the third-body concentrations, the equilibrium constants, the products of
+ * the concentrations and the species production rates) is done for all of
+ * the states in a sub-block by loops over the states with unit stride, which
+ * the compiler can vectorize. Only the falloff functions and the P-log and
+ * Chebyshev rates are evaluated one state at a time. The operations are the
+ * same as those done by the kinetics manager and the phase for a single
+ * state, so the results are the same as those of setting each state and
+ * calling Kinetics::getNetProductionRates(), except that rate tables created
+ * by GasKinetics::setRateTabulation() are not used.
+ *
+ * For other kinetics managers and phases, the states are set one at a time,
+ * in order of increasing temperature and pressure so that consecutive states
+ * with the same temperature reuse the temperature-dependent properties
+ * cached by the kinetics manager and phase. In this case, the state of the
+ * phase is restored after each call to eval().
+ *
+ * @ingroup kineticsmgr
+ */
+class BatchEvaluator
+{
+public:
+    //! Constructor.
+    /*!
+     * @param kin  Kinetics manager for a single, homogeneous phase
+     */
+    explicit BatchEvaluator(Kinetics& kin);
+
+    //! Evaluate a block of states.
+    /*!
+     * @param[in] nStates  Number of states
+     * @param[in] T        Temperatures [K]. Length *nStates*.
+     * @param[in] P        Pressures [Pa]. Length *nStates*.
+     * @param[in] Y        Mass fractions, where `Y[k*nStates + n]` is the
+     *     mass fraction of species *k* in state *n*.
+     * @param[out] wdot    Species net production rates [kmol/m^3/s], where
+     *     `wdot[k*nStates + n]` is the rate for species *k* in state *n*.
+     * @param[out] hbar    Species partial molar enthalpies [J/kmol], in the
+     *     same layout as *wdot*. Not computed if NULL.
+     * @param[out] h       Mixture specific enthalpy [J/kg] of each state.
+     *     Length *nStates*. Not computed if NULL.
+     */
+    void eval(size_t nStates, const double* T, const double* P,
+              const double* Y, double* wdot, double* hbar=0, double* h=0);
+
+    //! `true` if the states are evaluated together, `false` if they are
+    //! evaluated one at a time.
+    bool vectorized() const {
+        return m_gas != 0;
+    }
+
+    //! Maximum number of states evaluated together.
+    size_t blockSize() const {
+        return m_blockSize;
+    }
+
+    //! Set the maximum number of states evaluated together. Larger blocks
+    //! give longer vector loops, but need larger work arrays.
+    void setBlockSize(size_t n);
+
+protected:
+    //! Evaluate states *n0* to *n0* + *nb* - 1 together. The arguments are
+    //! the same as those of eval().
+    void evalBlock(size_t nStates, size_t n0, size_t nb, const double* T,
+                   const double* P, const double* Y, double* wdot,
+                   double* hbar, double* h);
+
+    //! Evaluate the states one at a time. The arguments are the same as
+    //! those of eval().
+    void evalStates(size_t nStates, const double* T, const double* P,
+                    const double* Y, double* wdot, double* hbar, double* h);
+
+    Kinetics* m_kin;
+    thermo_t* m_thermo;
+
+    //! The kinetics manager, if the states can be evaluated together
+    GasKinetics* m_gas;
+
+    //! The species thermo manager of the phase, if it can evaluate blocks of
+    //! states
+    const GeneralSpeciesThermo* m_spthermo;
+
+    size_t m_blockSize; //!< Maximum number of states evaluated together
+
+    //! Order in which the states are evaluated by evalStates()
+    std::vector<size_t> m_order;
+
+    //! Work arrays for a single state
+    vector_fp m_y1;
+    vector_fp m_work;
+    vector_fp m_state;
+
+    //! @name Work arrays for a block of states
+    //! Arrays for species and reactions are in the same layout as the
+    //! arguments of eval(), with the block size in place of *nStates*.
+    //!@{
+    vector_fp m_T; //!< Temperature
+    vector_fp m_logT; //!< Logarithm of the temperature
+    vector_fp m_recipT; //!< Inverse of the temperature
+    vector_fp m_P; //!< Pressure, as computed by the phase
+    vector_fp m_logP; //!< Log of the pressure, for P-log and Chebyshev rates
+    vector_fp m_logC0; //!< Log of the standard concentration
+    vector_fp m_rho; //!< Density
+    vector_fp m_mmw; //!< Mean molecular weight
+    vector_fp m_ctot; //!< Molar density
+    vector_fp m_y; //!< Normalized mass fractions
+    vector_fp m_conc; //!< Species concentrations
+    vector_fp m_cp_R; //!< Dimensionless species heat capacities
+    vector_fp m_h_RT; //!< Dimensionless species enthalpies
+    vector_fp m_s_R; //!< Dimensionless species entropies
+    vector_fp m_mu0; //!< Species standard chemical potentials
+    vector_fp m_ropf; //!< Forward rate constants, then rates of progress
+    vector_fp m_ropr; //!< Reverse rate constants, then rates of progress
+    vector_fp m_rkcn; //!< Reciprocals of the equilibrium constants
+    vector_fp m_concm_3b; //!< Enhanced third-body concentrations
+    vector_fp m_concm_falloff; //!< Third-body conc. for falloff reactions
+    vector_fp m_rfn_low; //!< Low-pressure rate constants
+    vector_fp m_rfn_high; //!< High-pressure rate constants
+    vector_fp m_pr; //!< Reduced pressures of the falloff reactions
+    vector_fp m_pr1; //!< Reduced pressures for one state
+    vector_fp m_falloff_work; //!< Falloff function work array for one state
+    vector_fp m_wdot; //!< Net production rates
+    //!@}
+};
+
+}
+
+#endif
@@ -48,6 +48,42 @@ public:
     virtual void getEquilibriumConstants(doublereal* kc);
     virtual void getFwdRateConstants(doublereal* kfwd);
 
+    //! @}
+    //! @name Derivatives of Species Production Rates
+    //! @{
+
+    //! Derivatives of the species net production rates with respect to the
+    //! species concentrations, at constant temperature.
+    /*!
+     * The derivatives of the mass-action terms and of the enhanced
+     * third-body concentrations of three-body and falloff reactions are
+     * evaluated analytically. For falloff reactions, the derivative of the
+     * blending function with respect to the reduced pressure is evaluated
+     * by a one-sided difference. The total concentration is taken to be the
+     * sum of the species concentrations, and the pressure used by P-log and
+     * Chebyshev reactions is held fixed.
+     *
+     * @param dwdot_dC  Output array of length m_kk * m_kk, in column-major
+     *     order, so that `dwdot_dC[k + m_kk*j]` is the derivative of the net
+     *     production rate of species *k* with respect to the concentration
+     *     of species *j*. Units: 1/s.
+     */
+    virtual void getNetProductionRates_ddC(doublereal* dwdot_dC);
+
+    //! Derivatives of the species net production rates with respect to
+    //! temperature, at constant species concentrations.
+    /*!
+     * The temperature derivatives of the rate coefficients and the
+     * equilibrium constants are evaluated analytically, except for the
+     * explicit temperature dependence of the falloff blending functions,
+     * which is evaluated by a one-sided difference. The pressure used by
+     * P-log and Chebyshev reactions is held fixed.
+     *
+     * @param dwdot_dT  Output vector of derivatives. Length: m_kk.
+     *     Units: kmol/m^3/s/K.
+     */
+    virtual void getNetProductionRates_ddT(doublereal* dwdot_dT);
+
     //! @}
     //! @name Reaction Mechanism Setup Routines
     //! @{
@@ -70,6 +106,57 @@ public:
     //! reactions.
     virtual void update_rates_C();
 
+    //! @name Tabulation of Temperature-Dependent Rate Data
+    //! @{
+
+    //! Interpolate the temperature-dependent parts of the reaction rates in a
+    //! table, for temperatures between *Tmin* and *Tmax*.
+    /*!
+     * The tabulated values are the forward rate constants of the elementary
+     * and three-body reactions, the low- and high-pressure rate constants
+     * and the temperature-dependent parameters of the falloff functions of
+     * the falloff reactions, and the equilibrium constants of the reversible
+     * reactions. They are tabulated at temperatures evenly spaced in 1/T,
+     * where the Arrhenius expressions vary most uniformly, and interpolated
+     * with cubic polynomials. The range is split into segments at the
+     * temperatures where the species thermo polynomials change, since the
+     * equilibrium constants are not smooth there. In each segment, starting
+     * from 9 temperatures, the spacing is halved until the interpolation
+     * error at the midpoints between the tabulated temperatures is less than
+     * *rtol* for every value, relative to the magnitude of the value, or for
+     * the falloff parameters, relative to the larger of the magnitude and 1.
+     *
+     * Outside of the tabulated range, and for P-log and Chebyshev
+     * reactions, the rates are evaluated directly. The equilibrium constants
+     * are assumed to depend only on temperature, so the phase must be an
+     * ideal gas. The table is discarded when a reaction is added.
+     *
+     * @param Tmin     Lowest tabulated temperature [K]
+     * @param Tmax     Highest tabulated temperature [K]
+     * @param rtol     Relative tolerance for the interpolation error
+     * @param maxSize  Maximum number of tabulated temperatures in each
+     *     segment. An exception is thrown if *rtol* cannot be met with this
+     *     many temperatures.
+     */
+    void setRateTabulation(doublereal Tmin, doublereal Tmax,
+                           doublereal rtol=1e-6, size_t maxSize=16385);
+
+    //! Evaluate all reaction rates directly, discarding the table created by
+    //! setRateTabulation().
+    void disableRateTabulation();
+
+    //! Number of tabulated temperatures, or 0 if tabulation is disabled.
+    size_t rateTableSize() const {
+        return m_tableSize;
+    }
+
+    //! Largest relative interpolation error found at the midpoints between
+    //! the tabulated temperatures when the table was created.
+    doublereal rateTableError() const {
+        return m_tableError;
+    }
+    //! @}
+
 protected:
     size_t m_nfall;
 
@@ -115,7 +202,80 @@ protected:
     //! Update the equilibrium constants in molar units.
     void updateKc();
 
+    //! Tabulate the rate data at temperatures evenly spaced in 1/T between
+    //! *xmin* and *xmax*, appending the rows to m_table. Returns the
+    //! interpolation error estimate.
+    doublereal tabulateSegment(doublereal xmin, doublereal xmax,
+                               doublereal rtol, size_t maxSize);
+
+    //! Evaluate the values tabulated by setRateTabulation() at temperature
+    //! *T*. The temperature of the phase is set to *T*.
+    void evalRateTableRow(doublereal T, doublereal* row);
+
+    //! Interpolate the temperature-dependent rate data in the table created
+    //! by setRateTabulation(). *T* must be within the tabulated range.
+    void interpolateRates(doublereal T);
+
+    //! Update the work arrays used by getNetProductionRates_ddC() and
+    //! getNetProductionRates_ddT(): the forward and reverse rate constants,
+    //! the concentration products of each reaction, and the derivatives of
+    //! the forward rate constants with respect to the enhanced third-body
+    //! concentrations.
+    void updateROPDerivatives();
+
+    //! Update the falloff blending function values #m_falloff_g and their
+    //! derivatives with respect to the reduced pressure and temperature.
+    void updateFalloffDerivatives();
+
+    //! @name Work arrays for production rate derivatives
+    //!@{
+
+    //! Species with a nonzero net stoichiometric coefficient in each reaction
+    std::vector<std::vector<size_t> > m_netSpecies;
+
+    //! Net stoichiometric coefficients of the species in #m_netSpecies
+    std::vector<vector_fp> m_netStoich;
+
+    vector_fp m_kf_eff; //!< Forward rate constants, including all factors
+    vector_fp m_kr_eff; //!< Reverse rate constants, including all factors
+    vector_fp m_cprod_f; //!< Reactant concentration products
+    vector_fp m_cprod_r; //!< Product concentration products, times 1/Kc
+    vector_fp m_dkf_dM; //!< Derivative of m_kf_eff w.r.t. the 3rd-body conc.
+    vector_fp m_dlnk_dT; //!< Temperature derivative of log(rate coefficient)
+    vector_fp m_dMdC; //!< Third-body concentration derivatives (1 reaction)
+
+    vector_fp m_falloff_pr; //!< Reduced pressure of each falloff reaction
+    vector_fp m_falloff_g; //!< Falloff blending function values
+    vector_fp m_falloff_dgdPr; //!< Derivatives of m_falloff_g w.r.t. Pr
+    vector_fp m_falloff_dgdT; //!< Derivatives of m_falloff_g w.r.t. T
+    vector_fp m_falloff_dlnk0_dT; //!< d(ln k0)/dT for each falloff reaction
+    vector_fp m_falloff_dlnkinf_dT; //!< d(ln kinf)/dT for each falloff reaction
+    vector_fp m_falloff_work_T; //!< falloff_work at a perturbed temperature
+    //!@}
+
+    //! @name Tabulation of temperature-dependent rate data
+    //!@{
+    size_t m_tableSize; //!< Number of tabulated temperatures
+    size_t m_tableWidth; //!< Number of values tabulated at each temperature
+    doublereal m_tableError; //!< Interpolation error estimate
+    //! Values of 1/T at the boundaries of the table segments, in increasing
+    //! order
+    vector_fp m_tableX;
+    vector_fp m_tableH; //!< Spacing in 1/T of the rows of each segment
+    //! Index of the first row of each segment. The last entry is the total
+    //! number of rows.
+    std::vector<size_t> m_tableStart;
+    //! Tabulated values. Row *m_tableStart[s] + j* holds the values at
+    //! 1/T = m_tableX[s] + j*m_tableH[s], in the order m_rfn, m_rkcn,
+    //! m_rfn_low, m_rfn_high, falloff_work.
+    vector_fp m_table;
+    //!@}
+
     bool m_finalized;
+
+    //! BatchEvaluator evaluates the rates of blocks of states using the
+    //! rate coefficient managers and stoichiometry of this object.
+    friend class BatchEvaluator;
 };
 }
 
@@ -596,6 +596,50 @@ public:
      */
     virtual void getNetProductionRates(doublereal* wdot);
 
+    //! Derivatives of the species net production rates with respect to the
+    //! species activity concentrations, at constant temperature.
+    /*!
+     * The derivatives are evaluated analytically from the stoichiometry of
+     * the reactions, rather than by perturbing the state of the phase.
+     *
+     * @param dwdot_dC  Output array of length m_kk * m_kk, in column-major
+     *     order, so that `dwdot_dC[k + m_kk*j]` is the derivative of the net
+     *     production rate of species *k* with respect to the activity
+     *     concentration of species *j*. Units: 1/s.
+     */
+    virtual void getNetProductionRates_ddC(doublereal* dwdot_dC) {
+        throw NotImplementedError("Kinetics::getNetProductionRates_ddC");
+    }
+
+    //! Derivatives of the species net production rates with respect to
+    //! temperature, at constant species activity concentrations.
+    /*!
+     * @param dwdot_dT  Output vector of derivatives. Length: m_kk.
+     *     Units: kmol/m^3/s/K.
+     */
+    virtual void getNetProductionRates_ddT(doublereal* dwdot_dT) {
+        throw NotImplementedError("Kinetics::getNetProductionRates_ddT");
+    }
+
+    //! Sparsity pattern of the derivatives of the species net production
+    //! rates with respect to the species concentrations.
+    /*!
+     * The production rate of species *k* is taken to depend on the
+     * concentration of species *j* if both species participate in a common
+     * reaction, or if species *k* participates in a three-body, falloff or
+     * chemically activated reaction, whose rate depends on the concentrations
+     * of all species. The diagonal elements are always included. The pattern
+     * is given in compressed sparse column (CSC) form, with the rows sorted
+     * within each column, and corresponds to the matrix returned by
+     * getNetProductionRates_ddC().
+     *
+     * @param[out] colStart  Offset in *rowIndex* of the first element of
+     *     each column. Length m_kk + 1.
+     * @param[out] rowIndex  Row indices of the nonzero elements
+     */
+    virtual void getProductionRateSparsity(std::vector<size_t>& colStart,
+                                           std::vector<size_t>& rowIndex) const;
+
     //! @}
     //! @name Reaction Mechanism Informational Query Routines
     //! @{
@@ -87,6 +87,43 @@ public:
         }
     }
 
+    /**
+     * Write the temperature derivatives of the logarithms of the rate
+     * coefficients, d(ln k)/dT, into array values. Each calculator writes one
+     * entry in values, at the location specified by the reaction number when
+     * it was installed.
+     */
+    void update_dlnkdT(doublereal T, doublereal logT, doublereal* values) {
+        doublereal recipT = 1.0/T;
+        for (size_t i = 0; i != m_rates.size(); i++) {
+            values[m_rxn[i]] = m_rates[i].dlnkdT(logT, recipT);
+        }
+    }
+
+    /**
+     * Write the rate coefficients for each of *n* independent states into
+     * array values, where `values[m_rxn[i]*n + j]` is the rate coefficient of
+     * reaction `m_rxn[i]` in state *j*. If *c* is not NULL, update_C() is
+     * called with `c + j` before the rates are evaluated for state *j*.
+     *
+     * @param n       Number of states
+     * @param logT    Logarithm of the temperature of each state
+     * @param recipT  Inverse of the temperature of each state
+     * @param values  Output array of rate coefficients
+     * @param c       Data passed to update_C() for each state, or NULL
+     */
+    void updateBatch(size_t n, const doublereal* logT, const doublereal* recipT,
+                     doublereal* values, const doublereal* c=0) {
+        for (size_t j = 0; j < n; j++) {
+            if (c) {
+                update_C(c + j);
+            }
+            for (size_t i = 0; i != m_rates.size(); i++) {
+                values[m_rxn[i]*n + j] = m_rates[i].updateRC(logT[j], recipT[j]);
+            }
+        }
+    }
+
     size_t nReactions() const {
         return m_rates.size();
     }
@@ -96,6 +133,119 @@ protected:
     std::vector<size_t>           m_rxn;
 };
 
+//! Evaluate the Arrhenius rate constants \f$ k_i = A_i T^{b_i} \exp(-E_i/T)
+//! \f$ for *n* reactions.
+/*!
+ * The loops over the reactions are vectorized by the compiler, including
+ * the calls to exp() where a vector math library is available. With GCC on
+ * x86-64 Linux, versions for AVX-512, AVX2 and the baseline instruction set
+ * are compiled, and the one matching the processor is selected at run time.
+ *
+ * @param n     Number of reactions
+ * @param A     Pre-exponential factors. Length *n*.
+ * @param b     Temperature exponents. Length *n*.
+ * @param E     Activation temperatures [K]. Length *n*.
+ * @param T     Temperature [K]
+ * @param logT  Natural logarithm of the temperature
+ * @param k     Output array of rate constants. Length *n*.
+ */
+void evalArrhenius(size_t n, const doublereal* A, const doublereal* b,
+                   const doublereal* E, doublereal T, doublereal logT,
+                   doublereal* k);
+
+//! Evaluate the Arrhenius rate constants of *n* reactions for each of
+//! *nStates* independent states.
+/*!
+ * The loops over the states are vectorized in the same way as the loops
+ * over the reactions in evalArrhenius(), and give the same results.
+ *
+ * @param n        Number of reactions
+ * @param rxn      Index of the output row of each reaction. Length *n*.
+ * @param A        Pre-exponential factors. Length *n*.
+ * @param b        Temperature exponents. Length *n*.
+ * @param E        Activation temperatures [K]. Length *n*.
+ * @param nStates  Number of states
+ * @param logT     Natural logarithm of the temperature of each state
+ * @param recipT   Inverse of the temperature of each state
+ * @param k        Output array, where `k[rxn[i]*nStates + j]` is the rate
+ *                 constant of reaction *i* in state *j*
+ */
+void evalArrheniusBatch(size_t n, const size_t* rxn, const doublereal* A,
+                        const doublereal* b, const doublereal* E,
+                        size_t nStates, const doublereal* logT,
+                        const doublereal* recipT, doublereal* k);
+
+/**
+ * Rate coefficient manager for reactions with Arrhenius rate constants.
+ *
+ * The Arrhenius parameters are stored in separate arrays rather than as an
+ * array of Arrhenius objects, so that the rate constants can be evaluated by
+ * evalArrhenius() and then copied to their positions in the output array.
+ */
+template<>
+class Rate1<Arrhenius>
+{
+public:
+    Rate1() {}
+    virtual ~Rate1() {}
+
+    size_t install(size_t rxnNumber, const ReactionData& rdata) {
+        if (rdata.rateCoeffType != Arrhenius::type())
+            throw CanteraError("Rate1::install",
+                               "incorrect rate coefficient type: "+int2str(rdata.rateCoeffType) + ". Was Expecting type: "+ int2str(Arrhenius::type()));
+        install(rxnNumber, Arrhenius(rdata));
+        return m_rxn.size() - 1;
+    }
+
+    void install(size_t rxnNumber, const Arrhenius& rate) {
+        m_rxn.push_back(rxnNumber);
+        m_A.push_back(rate.preExponentialFactor());
+        m_b.push_back(rate.temperatureExponent());
+        m_E.push_back(rate.activationEnergy_R());
+        m_work.push_back(0.0);
+    }
+
+    void update_C(const doublereal* c) {}
+
+    void update(doublereal T, doublereal logT, doublereal* values) {
+        size_t n = m_rxn.size();
+        if (n == 0) {
+            return;
+        }
+        evalArrhenius(n, &m_A[0], &m_b[0], &m_E[0], T, logT, &m_work[0]);
+        for (size_t i = 0; i < n; i++) {
+            values[m_rxn[i]] = m_work[i];
+        }
+    }
+
+    void update_dlnkdT(doublereal T, doublereal logT, doublereal* values) {
+        doublereal recipT = 1.0/T;
+        for (size_t i = 0; i < m_rxn.size(); i++) {
+            values[m_rxn[i]] = (m_b[i] + m_E[i]*recipT) * recipT;
+        }
+    }
+
+    void updateBatch(size_t n, const doublereal* logT, const doublereal* recipT,
+                     doublereal* values, const doublereal* c=0) {
+        if (m_rxn.empty()) {
+            return;
+        }
+        evalArrheniusBatch(m_rxn.size(), &m_rxn[0], &m_A[0], &m_b[0],
+                           &m_E[0], n, logT, recipT, values);
+    }
+
+    size_t nReactions() const {
+        return m_rxn.size();
+    }
+
+protected:
+    std::vector<size_t> m_rxn; //!< Reaction numbers
+    vector_fp m_A; //!< Pre-exponential factors
+    vector_fp m_b; //!< Temperature exponents
+    vector_fp m_E; //!< Activation temperatures [K]
+    vector_fp m_work; //!< Rate constants, in the order of m_rxn
+};
+
 }
 
 #endif
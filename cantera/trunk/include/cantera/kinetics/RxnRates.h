@@ -82,6 +82,12 @@ public:
         return m_A * std::exp(m_b*logT - m_E*recipT);
     }
 
+    //! Temperature derivative of the logarithm of the rate constant,
+    //! \f$ d \ln k_f / dT = (b + E/T) / T \f$ [1/K].
+    doublereal dlnkdT(doublereal logT, doublereal recipT) const {
+        return (m_b + m_E*recipT) * recipT;
+    }
+
     //! @deprecated. To be removed after Cantera 2.2
     void writeUpdateRHS(std::ostream& s) const {
         s << " exp(" << m_logA;
@@ -396,6 +402,39 @@ public:
         return std::exp(log_k1 + (log_k2-log_k1) * (logP_-logP1_) * rDeltaP_);
     }
 
+    //! Temperature derivative of the logarithm of the rate constant at the
+    //! current pressure [1/K].
+    doublereal dlnkdT(doublereal logT, doublereal recipT) const {
+        double dlnk1, dlnk2;
+        if (m1_ == 1) {
+            dlnk1 = (n1_[0] + Ea1_[0] * recipT) * recipT;
+        } else {
+            double k = 1e-300; // non-zero to avoid division by zero
+            double dkdT = 0.0;
+            for (size_t m = 0; m < m1_; m++) {
+                double km = A1_[m] * std::exp(n1_[m] * logT - Ea1_[m] * recipT);
+                k += km;
+                dkdT += km * (n1_[m] + Ea1_[m] * recipT) * recipT;
+            }
+            dlnk1 = dkdT / k;
+        }
+
+        if (m2_ == 1) {
+            dlnk2 = (n2_[0] + Ea2_[0] * recipT) * recipT;
+        } else {
+            double k = 1e-300; // non-zero to avoid division by zero
+            double dkdT = 0.0;
+            for (size_t m = 0; m < m2_; m++) {
+                double km = A2_[m] * std::exp(n2_[m] * logT - Ea2_[m] * recipT);
+                k += km;
+                dkdT += km * (n2_[m] + Ea2_[m] * recipT) * recipT;
+            }
+            dlnk2 = dkdT / k;
+        }
+
+        return dlnk1 + (dlnk2-dlnk1) * (logP_-logP1_) * rDeltaP_;
+    }
+
     //! @deprecated. To be removed after Cantera 2.2
     doublereal activationEnergy_R() const {
         throw CanteraError("Plog::activationEnergy_R", "Not implemented");
@@ -513,6 +552,30 @@ public:
         return std::pow(10, logk);
     }
 
+    //! Temperature derivative of the logarithm of the rate constant at the
+    //! current pressure [1/K].
+    doublereal dlnkdT(doublereal logT, doublereal recipT) const {
+        double Tr = (2 * recipT + TrNum_) * TrDen_;
+        double dTr_dT = -2 * recipT * recipT * TrDen_;
+        // Chebyshev polynomials and their derivatives with respect to Tr
+        double Cnm1 = 1;
+        double Cn = Tr;
+        double dCnm1 = 0;
+        double dCn = 1;
+        double Cnp1, dCnp1;
+        double dlogk = dotProd_[1];
+        for (size_t i = 2; i < nT_; i++) {
+            Cnp1 = 2 * Tr * Cn - Cnm1;
+            dCnp1 = 2 * Cn + 2 * Tr * dCn - dCnm1;
+            dlogk += dCnp1 * dotProd_[i];
+            Cnm1 = Cn;
+            Cn = Cnp1;
+            dCnm1 = dCn;
+            dCn = dCnp1;
+        }
+        return std::log(10.0) * dlogk * dTr_dT;
+    }
+
     //! @deprecated. To be removed after Cantera 2.2
     doublereal activationEnergy_R() const {
         return 0.0;
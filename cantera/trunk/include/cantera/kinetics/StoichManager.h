@@ -97,11 +97,19 @@ namespace Cantera
  *  - decrementSpecies(in, out)  : out[k0], out[k1], and out[k2]
  *    are all decremented by in[irxn]
  *
+ *  - multiplyDerivatives(in, R, jac) : jac(irxn, k0, R[irxn]*in[k1]*in[k2]),
+ *    jac(irxn, k1, R[irxn]*in[k0]*in[k2]) and jac(irxn, k2,
+ *    R[irxn]*in[k0]*in[k1]) are called
+ *
  * The function multiply() is usually used when evaluating the forward and
  * reverse rates of progress of reactions. The rate constants are usually
  * loaded into out[]. Then multiply() is called to add in the dependence of
  * the species concentrations to yield a forward and reverse rop.
  *
+ * The function multiplyDerivatives() evaluates the partial derivatives of the
+ * products formed by multiply() with respect to each species, and is used
+ * to assemble analytic Jacobians of the rates of progress.
+ *
  * The function incrementSpecies() and its cousin decrementSpecies() is used
  * to translate from rates of progress to species production rates. The vector
  * in[] is preloaded with the rates of progress of all reactions. Then
@@ -173,6 +181,12 @@ public:
         R[m_rxn] *= S[m_ic0];
     }
 
+    template<class J>
+    void multiplyDerivatives(const doublereal* S, const doublereal* R,
+                             J& jac) const {
+        jac(m_rxn, m_ic0, R[m_rxn]);
+    }
+
     void incrementReaction(const doublereal* S, doublereal* R) const {
         R[m_rxn] += S[m_ic0];
     }
@@ -181,6 +195,50 @@ public:
         R[m_rxn] -= S[m_ic0];
     }
 
+    void multiplyBatch(size_t n, const doublereal* S, doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] *= s0[j];
+        }
+    }
+
+    void incrementSpeciesBatch(size_t n, const doublereal* R,
+                               doublereal* S) const {
+        const doublereal* r = R + m_rxn*n;
+        doublereal* s0 = S + m_ic0*n;
+        for (size_t j = 0; j < n; j++) {
+            s0[j] += r[j];
+        }
+    }
+
+    void decrementSpeciesBatch(size_t n, const doublereal* R,
+                               doublereal* S) const {
+        const doublereal* r = R + m_rxn*n;
+        doublereal* s0 = S + m_ic0*n;
+        for (size_t j = 0; j < n; j++) {
+            s0[j] -= r[j];
+        }
+    }
+
+    void incrementReactionBatch(size_t n, const doublereal* S,
+                                doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] += s0[j];
+        }
+    }
+
+    void decrementReactionBatch(size_t n, const doublereal* S,
+                                doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] -= s0[j];
+        }
+    }
+
     size_t rxnNumber() const {
         return m_rxn;
     }
@@ -255,6 +313,13 @@ public:
         R[m_rxn] *= S[m_ic0] * S[m_ic1];
     }
 
+    template<class J>
+    void multiplyDerivatives(const doublereal* S, const doublereal* R,
+                             J& jac) const {
+        jac(m_rxn, m_ic0, R[m_rxn] * S[m_ic1]);
+        jac(m_rxn, m_ic1, R[m_rxn] * S[m_ic0]);
+    }
+
     void incrementReaction(const doublereal* S, doublereal* R) const {
         R[m_rxn] += S[m_ic0] + S[m_ic1];
     }
@@ -263,6 +328,61 @@ public:
         R[m_rxn] -= (S[m_ic0] + S[m_ic1]);
     }
 
+    void multiplyBatch(size_t n, const doublereal* S, doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        const doublereal* s1 = S + m_ic1*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] *= s0[j] * s1[j];
+        }
+    }
+
+    void incrementSpeciesBatch(size_t n, const doublereal* R,
+                               doublereal* S) const {
+        const doublereal* r = R + m_rxn*n;
+        doublereal* s0 = S + m_ic0*n;
+        doublereal* s1 = S + m_ic1*n;
+        for (size_t j = 0; j < n; j++) {
+            s0[j] += r[j];
+        }
+        for (size_t j = 0; j < n; j++) {
+            s1[j] += r[j];
+        }
+    }
+
+    void decrementSpeciesBatch(size_t n, const doublereal* R,
+                               doublereal* S) const {
+        const doublereal* r = R + m_rxn*n;
+        doublereal* s0 = S + m_ic0*n;
+        doublereal* s1 = S + m_ic1*n;
+        for (size_t j = 0; j < n; j++) {
+            s0[j] -= r[j];
+        }
+        for (size_t j = 0; j < n; j++) {
+            s1[j] -= r[j];
+        }
+    }
+
+    void incrementReactionBatch(size_t n, const doublereal* S,
+                                doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        const doublereal* s1 = S + m_ic1*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] += s0[j] + s1[j];
+        }
+    }
+
+    void decrementReactionBatch(size_t n, const doublereal* S,
+                                doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        const doublereal* s1 = S + m_ic1*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] -= (s0[j] + s1[j]);
+        }
+    }
+
     size_t rxnNumber() const {
         return m_rxn;
     }
@@ -345,6 +465,14 @@ public:
         R[m_rxn] *= S[m_ic0] * S[m_ic1] * S[m_ic2];
     }
 
+    template<class J>
+    void multiplyDerivatives(const doublereal* S, const doublereal* R,
+                             J& jac) const {
+        jac(m_rxn, m_ic0, R[m_rxn] * S[m_ic1] * S[m_ic2]);
+        jac(m_rxn, m_ic1, R[m_rxn] * S[m_ic0] * S[m_ic2]);
+        jac(m_rxn, m_ic2, R[m_rxn] * S[m_ic0] * S[m_ic1]);
+    }
+
     void incrementReaction(const doublereal* S, doublereal* R) const {
         R[m_rxn] += S[m_ic0] + S[m_ic1] + S[m_ic2];
     }
@@ -353,6 +481,72 @@ public:
         R[m_rxn] -= (S[m_ic0] + S[m_ic1] + S[m_ic2]);
     }
 
+    void multiplyBatch(size_t n, const doublereal* S, doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        const doublereal* s1 = S + m_ic1*n;
+        const doublereal* s2 = S + m_ic2*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] *= s0[j] * s1[j] * s2[j];
+        }
+    }
+
+    void incrementSpeciesBatch(size_t n, const doublereal* R,
+                               doublereal* S) const {
+        const doublereal* r = R + m_rxn*n;
+        doublereal* s0 = S + m_ic0*n;
+        doublereal* s1 = S + m_ic1*n;
+        doublereal* s2 = S + m_ic2*n;
+        for (size_t j = 0; j < n; j++) {
+            s0[j] += r[j];
+        }
+        for (size_t j = 0; j < n; j++) {
+            s1[j] += r[j];
+        }
+        for (size_t j = 0; j < n; j++) {
+            s2[j] += r[j];
+        }
+    }
+
+    void decrementSpeciesBatch(size_t n, const doublereal* R,
+                               doublereal* S) const {
+        const doublereal* r = R + m_rxn*n;
+        doublereal* s0 = S + m_ic0*n;
+        doublereal* s1 = S + m_ic1*n;
+        doublereal* s2 = S + m_ic2*n;
+        for (size_t j = 0; j < n; j++) {
+            s0[j] -= r[j];
+        }
+        for (size_t j = 0; j < n; j++) {
+            s1[j] -= r[j];
+        }
+        for (size_t j = 0; j < n; j++) {
+            s2[j] -= r[j];
+        }
+    }
+
+    void incrementReactionBatch(size_t n, const doublereal* S,
+                                doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        const doublereal* s1 = S + m_ic1*n;
+        const doublereal* s2 = S + m_ic2*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] += s0[j] + s1[j] + s2[j];
+        }
+    }
+
+    void decrementReactionBatch(size_t n, const doublereal* S,
+                                doublereal* R) const {
+        doublereal* r = R + m_rxn*n;
+        const doublereal* s0 = S + m_ic0*n;
+        const doublereal* s1 = S + m_ic1*n;
+        const doublereal* s2 = S + m_ic2*n;
+        for (size_t j = 0; j < n; j++) {
+            r[j] -= (s0[j] + s1[j] + s2[j]);
+        }
+    }
+
     size_t rxnNumber() const {
         return m_rxn;
     }
@@ -456,6 +650,28 @@ public:
         }
     }
 
+    template<class J>
+    void multiplyDerivatives(const doublereal* input, const doublereal* R,
+                             J& jac) const {
+        for (size_t n = 0; n < m_n; n++) {
+            if (m_order[n] == 0.0) {
+                continue;
+            }
+            // derivative of the n-th factor
+            doublereal d = R[m_rxn];
+            if (m_order[n] != 1.0) {
+                d *= m_order[n] * ppow(input[m_ic[n]], m_order[n] - 1.0);
+            }
+            // times the product of all other factors
+            for (size_t m = 0; m < m_n && d != 0.0; m++) {
+                if (m != n && m_order[m] != 0.0) {
+                    d *= ppow(input[m_ic[m]], m_order[m]);
+                }
+            }
+            jac(m_rxn, m_ic[n], d);
+        }
+    }
+
     void incrementSpecies(const doublereal* input,
                           doublereal* output) const {
         doublereal x = input[m_rxn];
@@ -484,6 +700,64 @@ public:
             -= m_stoich[n]*input[m_ic[n]];
     }
 
+    void multiplyBatch(size_t nb, const doublereal* input,
+                       doublereal* output) const {
+        doublereal* r = output + m_rxn*nb;
+        for (size_t n = 0; n < m_n; n++) {
+            doublereal oo = m_order[n];
+            const doublereal* s = input + m_ic[n]*nb;
+            if (oo != 0.0) {
+                for (size_t j = 0; j < nb; j++) {
+                    r[j] *= ppow(s[j], oo);
+                }
+            }
+        }
+    }
+
+    void incrementSpeciesBatch(size_t nb, const doublereal* input,
+                               doublereal* output) const {
+        const doublereal* r = input + m_rxn*nb;
+        for (size_t n = 0; n < m_n; n++) {
+            doublereal* s = output + m_ic[n]*nb;
+            for (size_t j = 0; j < nb; j++) {
+                s[j] += m_stoich[n]*r[j];
+            }
+        }
+    }
+
+    void decrementSpeciesBatch(size_t nb, const doublereal* input,
+                               doublereal* output) const {
+        const doublereal* r = input + m_rxn*nb;
+        for (size_t n = 0; n < m_n; n++) {
+            doublereal* s = output + m_ic[n]*nb;
+            for (size_t j = 0; j < nb; j++) {
+                s[j] -= m_stoich[n]*r[j];
+            }
+        }
+    }
+
+    void incrementReactionBatch(size_t nb, const doublereal* input,
+                                doublereal* output) const {
+        doublereal* r = output + m_rxn*nb;
+        for (size_t n = 0; n < m_n; n++) {
+            const doublereal* s = input + m_ic[n]*nb;
+            for (size_t j = 0; j < nb; j++) {
+                r[j] += m_stoich[n]*s[j];
+            }
+        }
+    }
+
+    void decrementReactionBatch(size_t nb, const doublereal* input,
+                                doublereal* output) const {
+        doublereal* r = output + m_rxn*nb;
+        for (size_t n = 0; n < m_n; n++) {
+            const doublereal* s = input + m_ic[n]*nb;
+            for (size_t j = 0; j < nb; j++) {
+                r[j] -= m_stoich[n]*s[j];
+            }
+        }
+    }
+
     //! @deprecated To be removed after Cantera 2.2
     void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) {
         out[m_rxn] = "";
@@ -580,6 +854,16 @@ inline static void _multiply(InputIter begin, InputIter end,
     }
 }
 
+template<class InputIter, class Vec1, class Vec2, class J>
+inline static void _multiplyDerivatives(InputIter begin, InputIter end,
+                                        const Vec1& input, const Vec2& R,
+                                        J& jac)
+{
+    for (; begin != end; ++begin) {
+        begin->multiplyDerivatives(input, R, jac);
+    }
+}
+
 template<class InputIter, class Vec1, class Vec2>
 inline static void _incrementSpecies(InputIter begin,
                                      InputIter end, const Vec1& input, Vec2& output)
@@ -616,6 +900,51 @@ inline static void _decrementReactions(InputIter begin,
     }
 }
 
+template<class InputIter, class Vec1, class Vec2>
+inline static void _multiplyBatch(InputIter begin, InputIter end, size_t n,
+                                  const Vec1& input, Vec2& output)
+{
+    for (; begin != end; ++begin) {
+        begin->multiplyBatch(n, input, output);
+    }
+}
+
+template<class InputIter, class Vec1, class Vec2>
+inline static void _incrementSpeciesBatch(InputIter begin, InputIter end,
+        size_t n, const Vec1& input, Vec2& output)
+{
+    for (; begin != end; ++begin) {
+        begin->incrementSpeciesBatch(n, input, output);
+    }
+}
+
+template<class InputIter, class Vec1, class Vec2>
+inline static void _decrementSpeciesBatch(InputIter begin, InputIter end,
+        size_t n, const Vec1& input, Vec2& output)
+{
+    for (; begin != end; ++begin) {
+        begin->decrementSpeciesBatch(n, input, output);
+    }
+}
+
+template<class InputIter, class Vec1, class Vec2>
+inline static void _incrementReactionsBatch(InputIter begin, InputIter end,
+        size_t n, const Vec1& input, Vec2& output)
+{
+    for (; begin != end; ++begin) {
+        begin->incrementReactionBatch(n, input, output);
+    }
+}
+
+template<class InputIter, class Vec1, class Vec2>
+inline static void _decrementReactionsBatch(InputIter begin, InputIter end,
+        size_t n, const Vec1& input, Vec2& output)
+{
+    for (; begin != end; ++begin) {
+        begin->decrementReactionBatch(n, input, output);
+    }
+}
+
 //! @deprecated To be removed after Cantera 2.2
 template<class InputIter>
 inline static void _writeIncrementSpecies(InputIter begin, InputIter end,
@@ -802,6 +1131,9 @@ public:
             default:
                 m_cn_list.push_back(C_AnyN(rxn, k, order, stoich));
             }
+            if (kRep.size() <= 3) {
+                addSpeciesTerms(rxn, kRep);
+            }
         }
     }
 
@@ -812,17 +1144,67 @@ public:
         _multiply(m_cn_list.begin(), m_cn_list.end(), input, output);
     }
 
+    //! Evaluate the derivatives of the products computed by multiply().
+    /*!
+     * For each reaction *i* handled by this manager, let \f$ P_i = R_i \prod_k
+     * S_k^{o_{k,i}} \f$ be the value that multiply() would leave in
+     * `R[i]`. For each species *k* appearing in \f$ P_i \f$, this method
+     * calls `jac(i, k, d)` with \f$ d \f$ the contribution of that factor
+     * to \f$ \partial P_i / \partial S_k \f$. Species that appear more than
+     * once in a reaction (for example, '2 OH') generate one call per
+     * occurrence, so `jac` must accumulate the values it is given.
+     *
+     * @param input  Vector of species values \f$ S_k \f$. Length: number of
+     *     species.
+     * @param R      Vector of multipliers \f$ R_i \f$. Length: number of
+     *     reactions.
+     * @param jac    Functor with signature `void(size_t i, size_t k, double d)`
+     */
+    template<class J>
+    void multiplyDerivatives(const doublereal* input, const doublereal* R,
+                             J& jac) const {
+        _multiplyDerivatives(m_c1_list.begin(), m_c1_list.end(), input, R, jac);
+        _multiplyDerivatives(m_c2_list.begin(), m_c2_list.end(), input, R, jac);
+        _multiplyDerivatives(m_c3_list.begin(), m_c3_list.end(), input, R, jac);
+        _multiplyDerivatives(m_cn_list.begin(), m_cn_list.end(), input, R, jac);
+    }
+
+    //! Compute \f$ S = S + N R \f$.
+    /*!
+     * The contributions of the reactions in the C1, C2 and C3 lists are
+     * summed separately for each species (see #m_speciesRxns), which avoids
+     * updating the same element of *output* repeatedly from memory. The
+     * terms are added in the same order as by the per-reaction loops, so the
+     * results are identical.
+     */
     void incrementSpecies(const doublereal* input, doublereal* output) const {
-        _incrementSpecies(m_c1_list.begin(), m_c1_list.end(), input, output);
-        _incrementSpecies(m_c2_list.begin(), m_c2_list.end(), input, output);
-        _incrementSpecies(m_c3_list.begin(), m_c3_list.end(), input, output);
+        for (size_t k = 0; k < m_speciesRxns.size(); k++) {
+            const std::vector<size_t>& rxns = m_speciesRxns[k];
+            if (rxns.empty()) {
+                continue;
+            }
+            doublereal sum = output[k];
+            for (size_t n = 0; n < rxns.size(); n++) {
+                sum += input[rxns[n]];
+            }
+            output[k] = sum;
+        }
         _incrementSpecies(m_cn_list.begin(), m_cn_list.end(), input, output);
     }
 
+    //! Compute \f$ S = S - N R \f$. See incrementSpecies().
     void decrementSpecies(const doublereal* input, doublereal* output) const {
-        _decrementSpecies(m_c1_list.begin(), m_c1_list.end(), input, output);
-        _decrementSpecies(m_c2_list.begin(), m_c2_list.end(), input, output);
-        _decrementSpecies(m_c3_list.begin(), m_c3_list.end(), input, output);
+        for (size_t k = 0; k < m_speciesRxns.size(); k++) {
+            const std::vector<size_t>& rxns = m_speciesRxns[k];
+            if (rxns.empty()) {
+                continue;
+            }
+            doublereal sum = output[k];
+            for (size_t n = 0; n < rxns.size(); n++) {
+                sum -= input[rxns[n]];
+            }
+            output[k] = sum;
+        }
         _decrementSpecies(m_cn_list.begin(), m_cn_list.end(), input, output);
     }
 
@@ -840,6 +1222,55 @@ public:
         _decrementReactions(m_cn_list.begin(), m_cn_list.end(), input, output);
     }
 
+    //! @name Operations on blocks of states
+    //! These methods are equivalent to the methods above, applied to each
+    //! of *n* independent states. The arrays are in structure-of-arrays
+    //! form, where the value for species (or reaction) *k* in state *j* is
+    //! element `k*n + j`, so that the inner loops over the states have unit
+    //! stride and can be vectorized.
+    //! @{
+
+    void multiplyBatch(size_t n, const doublereal* input,
+                       doublereal* output) const {
+        _multiplyBatch(m_c1_list.begin(), m_c1_list.end(), n, input, output);
+        _multiplyBatch(m_c2_list.begin(), m_c2_list.end(), n, input, output);
+        _multiplyBatch(m_c3_list.begin(), m_c3_list.end(), n, input, output);
+        _multiplyBatch(m_cn_list.begin(), m_cn_list.end(), n, input, output);
+    }
+
+    void incrementSpeciesBatch(size_t n, const doublereal* input,
+                               doublereal* output) const {
+        _incrementSpeciesBatch(m_c1_list.begin(), m_c1_list.end(), n, input, output);
+        _incrementSpeciesBatch(m_c2_list.begin(), m_c2_list.end(), n, input, output);
+        _incrementSpeciesBatch(m_c3_list.begin(), m_c3_list.end(), n, input, output);
+        _incrementSpeciesBatch(m_cn_list.begin(), m_cn_list.end(), n, input, output);
+    }
+
+    void decrementSpeciesBatch(size_t n, const doublereal* input,
+                               doublereal* output) const {
+        _decrementSpeciesBatch(m_c1_list.begin(), m_c1_list.end(), n, input, output);
+        _decrementSpeciesBatch(m_c2_list.begin(), m_c2_list.end(), n, input, output);
+        _decrementSpeciesBatch(m_c3_list.begin(), m_c3_list.end(), n, input, output);
+        _decrementSpeciesBatch(m_cn_list.begin(), m_cn_list.end(), n, input, output);
+    }
+
+    void incrementReactionsBatch(size_t n, const doublereal* input,
+                                 doublereal* output) const {
+        _incrementReactionsBatch(m_c1_list.begin(), m_c1_list.end(), n, input, output);
+        _incrementReactionsBatch(m_c2_list.begin(), m_c2_list.end(), n, input, output);
+        _incrementReactionsBatch(m_c3_list.begin(), m_c3_list.end(), n, input, output);
+        _incrementReactionsBatch(m_cn_list.begin(), m_cn_list.end(), n, input, output);
+    }
+
+    void decrementReactionsBatch(size_t n, const doublereal* input,
+                                 doublereal* output) const {
+        _decrementReactionsBatch(m_c1_list.begin(), m_c1_list.end(), n, input, output);
+        _decrementReactionsBatch(m_c2_list.begin(), m_c2_list.end(), n, input, output);
+        _decrementReactionsBatch(m_c3_list.begin(), m_c3_list.end(), n, input, output);
+        _decrementReactionsBatch(m_cn_list.begin(), m_cn_list.end(), n, input, output);
+    }
+    //! @}
+
     //! @deprecated To be removed after Cantera 2.2
     void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
         _writeIncrementSpecies(m_c1_list.begin(), m_c1_list.end(), r, out);
@@ -881,10 +1312,48 @@ public:
     }
 
 private:
+    //! Add the terms for reaction *rxn*, with the (repeated) species *k*,
+    //! to #m_speciesRxns. The reaction has just been added to the C1, C2 or
+    //! C3 list corresponding to the length of *k*.
+    void addSpeciesTerms(size_t rxn, const std::vector<size_t>& k) {
+        for (size_t n = 0; n < k.size(); n++) {
+            size_t kn = k[n];
+            if (kn >= m_speciesRxns.size()) {
+                m_speciesRxns.resize(kn + 1);
+                m_nc1.resize(kn + 1, 0);
+                m_nc12.resize(kn + 1, 0);
+            }
+            std::vector<size_t>& rxns = m_speciesRxns[kn];
+            if (k.size() == 1) {
+                rxns.insert(rxns.begin() + m_nc1[kn], rxn);
+                m_nc1[kn]++;
+                m_nc12[kn]++;
+            } else if (k.size() == 2) {
+                rxns.insert(rxns.begin() + m_nc12[kn], rxn);
+                m_nc12[kn]++;
+            } else {
+                rxns.push_back(rxn);
+            }
+        }
+    }
+
     std::vector<C1>     m_c1_list;
     std::vector<C2>     m_c2_list;
     std::vector<C3>     m_c3_list;
     std::vector<C_AnyN> m_cn_list;
+
+    //! For each species *k*, the reactions in #m_c1_list, #m_c2_list and
+    //! #m_c3_list where *k* appears, once for each molecule of *k*. The
+    //! reactions are stored in the order in which the per-reaction loops
+    //! over the three lists would add them to species *k*.
+    std::vector<std::vector<size_t> > m_speciesRxns;
+
+    //! Number of entries of `m_speciesRxns[k]` from #m_c1_list
+    std::vector<size_t> m_nc1;
+
+    //! Number of entries of `m_speciesRxns[k]` from #m_c1_list and
+    //! #m_c2_list
+    std::vector<size_t> m_nc12;
 };
 
 }
@@ -46,6 +46,69 @@ public:
                      output, m_reaction_index.begin());
     }
 
+    //! Equivalent to update() for each of *n* independent states.
+    /*!
+     * @param n     Number of states
+     * @param conc  Species concentrations, where `conc[k*n+j]` is the
+     *     concentration of species *k* in state *j*
+     * @param ctot  Total concentration of each state. Length *n*.
+     * @param work  Output array, where `work[i*n+j]` is the enhanced
+     *     third-body concentration of the `i`-th installed reaction in state
+     *     *j*
+     */
+    void updateBatch(size_t n, const double* conc, const double* ctot,
+                     double* work) {
+        for (size_t i = 0; i < m_species.size(); i++) {
+            double* sum = work + i*n;
+            std::fill(sum, sum + n, 0.0);
+            for (size_t j = 0; j < m_species[i].size(); j++) {
+                double eff = m_eff[i][j];
+                const double* c = conc + m_species[i][j]*n;
+                for (size_t m = 0; m < n; m++) {
+                    sum[m] += eff * c[m];
+                }
+            }
+            double dflt = m_default[i];
+            for (size_t m = 0; m < n; m++) {
+                sum[m] = dflt * ctot[m] + sum[m];
+            }
+        }
+    }
+
+    //! Equivalent to multiply() for each of *n* independent states, with
+    //! the same layout of *output* and *work* as used by updateBatch().
+    void multiplyBatch(size_t n, double* output, const double* work) {
+        for (size_t i = 0; i < m_reaction_index.size(); i++) {
+            double* r = output + m_reaction_index[i]*n;
+            const double* w = work + i*n;
+            for (size_t m = 0; m < n; m++) {
+                r[m] *= w[m];
+            }
+        }
+    }
+
+    //! Derivatives of the enhanced third-body concentration of the `i`-th
+    //! installed reaction with respect to the concentrations of all species.
+    /*!
+     * Assumes that the total concentration passed to update() is the sum of
+     * the species concentrations.
+     *
+     * @param i     Index of the reaction within this calculator
+     * @param nsp   Number of species
+     * @param dMdC  Output array of length `nsp`
+     */
+    void getDerivatives(size_t i, size_t nsp, double* dMdC) const {
+        std::fill(dMdC, dMdC + nsp, m_default[i]);
+        for (size_t j = 0; j < m_species[i].size(); j++) {
+            dMdC[m_species[i][j]] += m_eff[i][j];
+        }
+    }
+
+    //! Index of the `i`-th installed reaction in the full reaction array
+    size_t reactionIndex(size_t i) const {
+        return m_reaction_index[i];
+    }
+
     size_t workSize() {
         return m_reaction_index.size();
     }
@@ -519,6 +519,9 @@ private:
     //! Newton's method.
     SquareMatrix m_Jac;
 
+    //! Damping factor used for the previous Newton step
+    doublereal m_damp_old;
+
 public:
     int m_ioflag;
 };
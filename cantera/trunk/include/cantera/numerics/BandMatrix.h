@@ -192,6 +192,19 @@ public:
      */
     int solve(doublereal* b, size_t nrhs=1, size_t ldb=0);
 
+    //! Solve the matrix problem A^T x = b, using the LU decomposition of A
+    /*!
+     *  The matrix is factored first if necessary.
+     *
+     *  @param b  INPUT rhs of the problem
+     *  @param x  OUTPUT solution to the problem. May be the same array as b.
+     *
+     * @return Return a success flag
+     *          0 indicates a success
+     *         ~0  Some error occurred, see the LAPACK documentation
+     */
+    int solveTranspose(const doublereal* const b, doublereal* const x);
+
     //! Returns an iterator for the start of the band storage data
     /*!
      *  Iterator points to the beginning of the data, and it is changeable.
@@ -0,0 +1,119 @@
+/**
+ *  @file BlockJacobi.h
+ *   Declarations for the class BlockJacobi, a block-diagonal preconditioner
+ *   for the Newton iteration matrix of ODE systems made up of weakly coupled
+ *   subsystems (see \ref odeGroup and
+ *   \link Cantera::BlockJacobi BlockJacobi\endlink).
+ */
+
+#ifndef CT_BLOCKJACOBI_H
+#define CT_BLOCKJACOBI_H
+
+#include "Preconditioner.h"
+#include "DenseMatrix.h"
+
+namespace Cantera
+{
+
+//! Block-Jacobi preconditioner for the Newton iteration matrix of an ODE
+//! system.
+/*!
+ * The state vector is partitioned into blocks, e.g. the state variables of
+ * each reactor in a reactor network, and the Newton iteration matrix \f$ P =
+ * I - \gamma J \f$ is approximated by its diagonal blocks, neglecting the
+ * coupling between blocks. Each block is stored and factored as a dense
+ * matrix, so for a system of *M* blocks of size *n* the cost of forming and
+ * factoring the preconditioner is \f$ O(M n^3) \f$ rather than the \f$ O(M^3
+ * n^3) \f$ required to factor the full Jacobian.
+ *
+ * The Jacobian blocks are evaluated by FuncEval::evalJacobianBlocks if it is
+ * implemented, and otherwise by finite differences, where the *j*-th column
+ * of every block is perturbed at the same time. This requires only as many
+ * function evaluations as there are columns in the largest block, but
+ * changes in one block due to the perturbation of another block are
+ * attributed to the block's own columns. This is acceptable for a
+ * preconditioner as long as the coupling between blocks is weak compared
+ * to the coupling within each block.
+ *
+ * @ingroup odeGroup
+ */
+class BlockJacobi : public Preconditioner
+{
+public:
+    BlockJacobi();
+
+    //! Set the partitioning of the state vector into blocks.
+    /*!
+     * @param blockStart  Index of the first component of each block, followed
+     *     by the total number of components. Blocks must be non-empty.
+     */
+    void setBlocks(const std::vector<size_t>& blockStart);
+
+    //! Evaluate the diagonal blocks of the Jacobian
+    /*!
+     * @returns the number of function evaluations, which is zero if the
+     *     blocks were evaluated by FuncEval::evalJacobianBlocks.
+     */
+    virtual size_t evalJacobian(FuncEval& func, double t, double* y,
+                                const double* ydot, const double* ewt,
+                                double* p=0);
+
+    //! Form and factor each block of the Newton iteration matrix \f$ I -
+    //! \gamma J \f$
+    /*!
+     * @returns 0 on success, or *j* + 1 if the matrix is singular and the
+     *     *j*-th pivot is zero.
+     */
+    virtual int factor(double gamma);
+
+    virtual void solve(const double* b, double* x);
+
+    //! Number of rows and columns
+    size_t size() const {
+        return m_start.back();
+    }
+
+    //! Number of blocks
+    size_t nBlocks() const {
+        return m_jac.size();
+    }
+
+    //! Number of calls to evalJacobian() since the blocks were set
+    int nJacEvals() const {
+        return m_nJacEvals;
+    }
+
+    //! True if the last call to evalJacobian() obtained the blocks from
+    //! FuncEval::evalJacobianBlocks rather than by finite differences
+    bool analyticJacobian() const {
+        return m_analytic;
+    }
+
+    //! Value of element (*i*, *j*) of the last Jacobian evaluated. Returns
+    //! zero for elements outside of the diagonal blocks.
+    double jacobian(size_t i, size_t j) const;
+
+protected:
+    //! Index of the first component of each block
+    std::vector<size_t> m_start;
+
+    //! Block containing each component
+    std::vector<size_t> m_block;
+
+    //! Diagonal blocks of the Jacobian
+    std::vector<Array2D> m_jac;
+
+    //! LU factors of the diagonal blocks of \f$ I - \gamma J \f$
+    std::vector<DenseMatrix> m_lu;
+
+    //! Work arrays
+    vector_fp m_ydot;
+    vector_fp m_ysave;
+
+    int m_nJacEvals;
+    bool m_analytic;
+};
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ *  @file BlockTridiagMatrix.h
+ *   Declarations for the class BlockTridiagMatrix, a matrix with nonzero
+ *   blocks only on the block diagonal and its two neighbors
+ *   (see \ref numerics and
+ *   \link Cantera::BlockTridiagMatrix BlockTridiagMatrix\endlink).
+ */
+
+#ifndef CT_BLOCKTRIDIAGMATRIX_H
+#define CT_BLOCKTRIDIAGMATRIX_H
+
+#include "cantera/base/ct_defs.h"
+
+namespace Cantera
+{
+
+//! A square matrix with a block-tridiagonal structure.
+/*!
+ * The rows and columns are divided into consecutive groups, which need not
+ * all have the same size. Only the blocks coupling a group to itself and to
+ * its two neighboring groups can be nonzero. This is the structure of the
+ * Jacobian of a system of equations discretized on a one-dimensional grid
+ * with a three-point stencil, where each group contains the variables at one
+ * grid point.
+ *
+ * The nonzero blocks of each block row are stored as one contiguous dense
+ * matrix in column-major order. The LU factorization uses partial pivoting
+ * within the rows of the current and next block row. This gives the same
+ * pivot choices as a band LU factorization of the same matrix, but requires
+ * roughly half of the storage and arithmetic, since the structurally zero
+ * parts of the band are never stored or operated on.
+ *
+ * @ingroup numerics
+ */
+class BlockTridiagMatrix
+{
+public:
+    BlockTridiagMatrix();
+
+    //! Create a matrix with the given block sizes and all elements zero.
+    /*!
+     * @param sizes  Number of rows (and columns) in each group
+     */
+    explicit BlockTridiagMatrix(const std::vector<size_t>& sizes);
+
+    //! Change the block sizes. All elements are set to zero.
+    void resize(const std::vector<size_t>& sizes);
+
+    //! Number of rows (and columns)
+    size_t nRows() const {
+        return m_n;
+    }
+
+    //! Number of groups (block rows)
+    size_t nBlocks() const {
+        return m_sizes.size();
+    }
+
+    //! Set all elements to zero
+    void zero();
+
+    //! Return a changeable reference to element (i,j).
+    /*!
+     * If (i,j) is outside the nonzero blocks, a reference to a zero value is
+     * returned, which should not be modified. Invalidates the
+     * factorization.
+     */
+    doublereal& value(size_t i, size_t j);
+
+    //! Return the value of element (i,j), which is zero outside the nonzero
+    //! blocks.
+    doublereal value(size_t i, size_t j) const;
+
+    //! Multiply A*b and write the result to *prod*.
+    void mult(const doublereal* b, doublereal* prod) const;
+
+    //! Compute the LU factorization. The factors are stored separately, so
+    //! the matrix elements are not modified.
+    /*!
+     * @returns 0 on success, or *k* + 1 if the pivot for column *k* is zero
+     */
+    int factor();
+
+    //! Returns `true` if the LU factorization is up to date
+    bool factored() const {
+        return m_factored;
+    }
+
+    //! Solve A*x = b, computing the factorization first if necessary.
+    /*!
+     * *b* and *x* may be the same array.
+     * @returns 0 on success, or the value returned by factor() on failure
+     */
+    int solve(const doublereal* b, doublereal* x);
+
+    //! Solve A^T*x = b, computing the factorization first if necessary.
+    /*!
+     * *b* and *x* may be the same array.
+     * @returns 0 on success, or the value returned by factor() on failure
+     */
+    int solveTranspose(const doublereal* b, doublereal* x);
+
+    //! Number of values stored for the matrix and its factorization
+    size_t storageSize() const {
+        return m_data.size() + m_lu.size();
+    }
+
+protected:
+    //! Location in #m_data of element (i,j), or npos if (i,j) is outside
+    //! the nonzero blocks
+    size_t index(size_t i, size_t j) const;
+
+    //! Number of rows in each group
+    std::vector<size_t> m_sizes;
+
+    //! Index of the first row of each group, with the total number of rows
+    //! appended
+    std::vector<size_t> m_start;
+
+    //! Group containing each row
+    std::vector<size_t> m_group;
+
+    //! Location in #m_data of each block row. Block row *b* is an
+    //! `m_sizes[b]` by `(m_start[b+2] - m_start[b-1])` column-major matrix.
+    std::vector<size_t> m_offset;
+
+    //! Location in #m_lu of the factors for each block row
+    std::vector<size_t> m_luOffset;
+
+    size_t m_n;
+    vector_fp m_data;
+
+    //! LU factors. For group *b*, the first `m_sizes[b]` columns of the
+    //! eliminated rows of groups *b* and *b+1* (the multipliers and the
+    //! diagonal part of U), followed by the remaining columns of U in rows
+    //! of group *b*.
+    vector_fp m_lu;
+
+    //! Pivot rows as returned by LAPACK's DGETRF, numbered from 1 at the
+    //! first row of each group
+    vector_int m_ipiv;
+
+    //! Rows of group *b*+1 modified by the elimination of group *b*
+    vector_fp m_work;
+
+    bool m_factored;
+    doublereal m_zero;
+};
+
+}
+
+#endif
@@ -8,6 +8,7 @@
 #define CT_FUNCEVAL_H
 
 #include "cantera/base/ct_defs.h"
+#include "cantera/base/Array.h"
 
 namespace Cantera
 {
@@ -48,6 +49,88 @@ public:
     virtual size_t nparams() {
         return 0;
     }
+
+    //! Evaluate the Jacobian of the right-hand-side function.
+    /*!
+     * Called by the bundled CVODE integrator when the problem type is
+     * DENSE + JAC (this problem type is not available with CVODES). Derived
+     * classes which can evaluate the Jacobian directly (e.g. analytically)
+     * should override this method. If it returns `false`, the integrator
+     * forms the Jacobian by finite differences instead.
+     *
+     * @param[in] t time.
+     * @param[in] y solution vector, length neq()
+     * @param[in] ydot right-hand-side function evaluated at *t* and *y*
+     * @param[in] p sensitivity parameter vector, length nparams()
+     * @param[out] J Jacobian matrix, neq() by neq(), where `J(i,j)` is the
+     *     derivative of `ydot[i]` with respect to `y[j]`.
+     * @return `true` if the Jacobian was evaluated.
+     */
+    virtual bool getJacobian(double t, double* y, double* ydot, double* p,
+                             Array2D& J) {
+        return false;
+    }
+
+    //! Get the sparsity pattern of the Jacobian of the right-hand-side
+    //! function.
+    /*!
+     * Used by integrators which form a sparse approximation to the Jacobian,
+     * e.g. to construct a preconditioner. The pattern is given in compressed
+     * sparse column (CSC) form. The default implementation returns a dense
+     * pattern.
+     *
+     * @param[out] colStart  Offset in *rowIndex* of the first element of
+     *     each column. Length neq() + 1.
+     * @param[out] rowIndex  Row indices of the nonzero elements
+     */
+    virtual void getJacobianSparsity(std::vector<size_t>& colStart,
+                                     std::vector<size_t>& rowIndex) {
+        size_t n = neq();
+        colStart.resize(n + 1);
+        rowIndex.resize(n * n);
+        for (size_t j = 0; j < n; j++) {
+            colStart[j] = n * j;
+            for (size_t i = 0; i < n; i++) {
+                rowIndex[n*j + i] = i;
+            }
+        }
+        colStart[n] = n * n;
+    }
+
+    //! Get the partitioning of the state vector into blocks for the
+    //! block-Jacobi preconditioner (see BlockJacobi).
+    /*!
+     * Block *n* consists of the components `blockStart[n]` to
+     * `blockStart[n+1] - 1`. The default implementation returns a single
+     * block containing the whole state vector.
+     */
+    virtual void getJacobianBlocks(std::vector<size_t>& blockStart) {
+        blockStart.resize(2);
+        blockStart[0] = 0;
+        blockStart[1] = neq();
+    }
+
+    //! Evaluate the diagonal blocks of the Jacobian of the right-hand-side
+    //! function.
+    /*!
+     * Called by the block-Jacobi preconditioner. Derived classes which can
+     * evaluate the Jacobian blocks directly should override this method. If
+     * it returns `false`, the blocks are formed by finite differences
+     * instead.
+     *
+     * @param[in] t time.
+     * @param[in] y solution vector, length neq()
+     * @param[in] ydot right-hand-side function evaluated at *t* and *y*
+     * @param[in] p sensitivity parameter vector, length nparams()
+     * @param[out] J Jacobian blocks, with the sizes given by
+     *     getJacobianBlocks(). `J[n](i,j)` is the derivative of
+     *     `ydot[blockStart[n]+i]` with respect to `y[blockStart[n]+j]`.
+     * @return `true` if the blocks were evaluated.
+     */
+    virtual bool evalJacobianBlocks(double t, double* y, const double* ydot,
+                                    double* p, std::vector<Array2D>& J) {
+        return false;
+    }
 };
 
 }
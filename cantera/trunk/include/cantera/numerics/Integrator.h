@@ -23,6 +23,15 @@ const int NOJAC = 4;
 const int JAC   = 8;
 const int GMRES =16;
 const int BAND  =32;
+//! Used with GMRES: precondition using an incomplete LU factorization of a
+//! sparse finite difference approximation to the Jacobian. See
+//! FuncEval::getJacobianSparsity and SparseILU. Only supported by the bundled
+//! CVODE integrator.
+const int ILU   =64;
+//! Used with GMRES: precondition using the diagonal blocks of the Jacobian
+//! given by FuncEval::getJacobianBlocks. See BlockJacobi. Only supported by
+//! the bundled CVODE integrator.
+const int BLOCKJACOBI =128;
 
 /**
  * Specifies the method used to integrate the system of equations.
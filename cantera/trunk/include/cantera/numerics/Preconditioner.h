@@ -0,0 +1,64 @@
+/**
+ *  @file Preconditioner.h
+ *   Declarations for the class Preconditioner, the base class for
+ *   approximations to the Newton iteration matrix used to precondition
+ *   iterative linear solvers (see \ref odeGroup and
+ *   \link Cantera::Preconditioner Preconditioner\endlink).
+ */
+
+#ifndef CT_PRECONDITIONER_H
+#define CT_PRECONDITIONER_H
+
+#include "FuncEval.h"
+
+namespace Cantera
+{
+
+//! Base class for preconditioners of the Newton iteration matrix of an ODE
+//! system.
+/*!
+ * For a system \f$ \dot{y} = f(t,y) \f$, the implicit integrators solve
+ * linear systems involving the Newton iteration matrix \f$ P = I - \gamma J
+ * \f$, where \f$ J = \partial f / \partial y \f$. When these systems are
+ * solved with an iterative method such as GMRES, the integrator calls
+ * evalJacobian() whenever it needs a new approximation to *J*, factor()
+ * whenever \f$ \gamma \f$ changes, and solve() in each linear iteration.
+ *
+ * @ingroup odeGroup
+ */
+class Preconditioner
+{
+public:
+    virtual ~Preconditioner() {}
+
+    //! Evaluate the approximation to the Jacobian used by the
+    //! preconditioner.
+    /*!
+     * @param func  Right-hand-side function evaluator
+     * @param t     Time
+     * @param y     State vector. May be modified during the evaluation, but
+     *     is restored on return.
+     * @param ydot  Value of the right-hand-side function at (*t*, *y*)
+     * @param ewt   Error weights used to scale finite difference
+     *     perturbations, i.e. \f$ 1/(rtol |y_j| + atol_j) \f$
+     * @param p     Sensitivity parameter vector passed to FuncEval::eval
+     * @returns the number of evaluations of the right-hand-side function
+     */
+    virtual size_t evalJacobian(FuncEval& func, double t, double* y,
+                                const double* ydot, const double* ewt,
+                                double* p=0) = 0;
+
+    //! Form and factor the Newton iteration matrix \f$ I - \gamma J \f$
+    /*!
+     * @returns 0 on success, or a positive value if the matrix is singular.
+     */
+    virtual int factor(double gamma) = 0;
+
+    //! Solve \f$ P x = b \f$ using the factorization computed by the last
+    //! call to factor(). *b* and *x* may be the same array.
+    virtual void solve(const double* b, double* x) = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ *  @file SparseILU.h
+ *   Declarations for the class SparseILU, an incomplete LU preconditioner for
+ *   the Newton iteration matrix of sparse ODE systems
+ *   (see \ref odeGroup and \link Cantera::SparseILU SparseILU\endlink).
+ */
+
+#ifndef CT_SPARSEILU_H
+#define CT_SPARSEILU_H
+
+#include "Preconditioner.h"
+
+namespace Cantera
+{
+
+//! Incomplete LU factorization of the Newton iteration matrix of a sparse ODE
+//! system.
+/*!
+ * For a system \f$ \dot{y} = f(t,y) \f$, the implicit integrators solve
+ * linear systems involving the Newton iteration matrix \f$ P = I - \gamma J
+ * \f$, where \f$ J = \partial f / \partial y \f$. For large kinetic
+ * mechanisms, *J* is sparse, and forming and factoring it as a dense matrix
+ * requires \f$ O(N^3) \f$ work. This class instead stores *J* with a fixed
+ * sparsity pattern in compressed sparse column (CSC) format, evaluates it by
+ * finite differences where structurally independent columns are perturbed
+ * simultaneously, and computes an ILU(0) factorization of *P*, i.e. an LU
+ * factorization where all fill-in outside the sparsity pattern is discarded.
+ * The factorization is intended to be used as a preconditioner for an
+ * iterative linear solver such as GMRES.
+ *
+ * @ingroup odeGroup
+ */
+class SparseILU : public Preconditioner
+{
+public:
+    SparseILU();
+
+    //! Set the sparsity pattern of the Jacobian.
+    /*!
+     * The diagonal elements are always added to the pattern, and the row
+     * indices need not be sorted within each column.
+     *
+     * @param n         Number of rows and columns
+     * @param colStart  Offset of the first element of each column in
+     *     *rowIndex*. Length *n* + 1.
+     * @param rowIndex  Row indices of the nonzero elements
+     */
+    void setPattern(size_t n, const std::vector<size_t>& colStart,
+                    const std::vector<size_t>& rowIndex);
+
+    //! Evaluate the Jacobian by finite differences.
+    /*!
+     * Columns which do not have any nonzero rows in common are perturbed
+     * together, so the number of function evaluations required is
+     * nColumnGroups() rather than the number of columns.
+     *
+     * @param func  Right-hand-side function evaluator
+     * @param t     Time
+     * @param y     State vector. Modified during the evaluation, but
+     *     restored on return.
+     * @param ydot  Value of the right-hand-side function at (*t*, *y*)
+     * @param ewt   Error weights used to scale the perturbation of each
+     *     component, i.e. \f$ 1/(rtol |y_j| + atol_j) \f$
+     * @param p     Sensitivity parameter vector passed to FuncEval::eval
+     * @returns the number of function evaluations, nColumnGroups()
+     */
+    virtual size_t evalJacobian(FuncEval& func, double t, double* y,
+                                const double* ydot, const double* ewt,
+                                double* p=0);
+
+    //! Form and factor the Newton iteration matrix \f$ I - \gamma J \f$
+    /*!
+     * @returns 0 on success, or *j* + 1 if the *j*-th pivot is zero.
+     */
+    virtual int factor(double gamma);
+
+    //! Solve \f$ LU x = b \f$ using the incomplete factorization computed
+    //! by the last call to factor(). *b* and *x* may be the same array.
+    virtual void solve(const double* b, double* x);
+
+    //! Number of rows and columns
+    size_t size() const {
+        return m_n;
+    }
+
+    //! Number of structurally nonzero elements
+    size_t nNonzeros() const {
+        return m_rowIndex.size();
+    }
+
+    //! Number of groups of structurally independent columns, i.e. the number
+    //! of function evaluations needed by evalJacobian()
+    size_t nColumnGroups() const {
+        return m_groupStart.size() - 1;
+    }
+
+    //! Number of calls to evalJacobian() since the pattern was set
+    int nJacEvals() const {
+        return m_nJacEvals;
+    }
+
+    //! Value of element (*i*, *j*) of the last Jacobian evaluated. Returns
+    //! zero for elements outside the sparsity pattern.
+    double jacobian(size_t i, size_t j) const;
+
+protected:
+    //! Partition the columns into groups with no common nonzero rows
+    void groupColumns();
+
+    size_t m_n;
+
+    //! Offset of the first element of each column in #m_rowIndex
+    std::vector<size_t> m_colStart;
+
+    //! Row indices of the nonzero elements, sorted within each column
+    std::vector<size_t> m_rowIndex;
+
+    //! Offset of the diagonal element of each column in #m_rowIndex
+    std::vector<size_t> m_diag;
+
+    //! Jacobian values, in the same order as #m_rowIndex
+    vector_fp m_jac;
+
+    //! Incomplete LU factors of \f$ I - \gamma J \f$. The unit diagonal of
+    //! *L* is not stored.
+    vector_fp m_lu;
+
+    //! Columns sorted by group. The columns of group *g* are
+    //! `m_groups[m_groupStart[g]]` to `m_groups[m_groupStart[g+1]-1]`
+    std::vector<size_t> m_groups;
+    std::vector<size_t> m_groupStart;
+
+    //! Work arrays
+    vector_fp m_ydot;
+    vector_fp m_ysave;
+    std::vector<size_t> m_pos;
+
+    int m_nJacEvals;
+};
+
+}
+
+#endif
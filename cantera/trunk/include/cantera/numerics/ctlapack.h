@@ -16,6 +16,8 @@
 #ifndef LAPACK_FTN_TRAILING_UNDERSCORE
 
 #define _DGEMV_   dgemv
+#define _DGEMM_   dgemm
+#define _DTRSM_   dtrsm
 #define _DGETRF_  dgetrf
 #define _DGETRS_  dgetrs
 #define _DGETRI_  dgetri
@@ -37,6 +39,8 @@
 #else
 
 #define _DGEMV_   dgemv_
+#define _DGEMM_   dgemm_
+#define _DTRSM_   dtrsm_
 #define _DGETRF_  dgetrf_
 #define _DGETRS_  dgetrs_
 #define _DGETRI_  dgetri_
@@ -87,6 +91,32 @@ extern "C" {
                 const integer* incY);
 #endif
 
+#ifdef LAPACK_FTN_STRING_LEN_AT_END
+    int _DGEMM_(const char* transa, const char* transb,
+                const integer* m, const integer* n, const integer* k,
+                const doublereal* alpha, const doublereal* a,
+                const integer* lda, const doublereal* b, const integer* ldb,
+                const doublereal* beta, doublereal* c, const integer* ldc,
+                ftnlen tasize, ftnlen tbsize);
+    int _DTRSM_(const char* side, const char* uplo, const char* transa,
+                const char* diag, const integer* m, const integer* n,
+                const doublereal* alpha, const doublereal* a,
+                const integer* lda, doublereal* b, const integer* ldb,
+                ftnlen sisize, ftnlen upsize, ftnlen tasize, ftnlen disize);
+#else
+    int _DGEMM_(const char* transa, ftnlen tasize, const char* transb,
+                ftnlen tbsize, const integer* m, const integer* n,
+                const integer* k, const doublereal* alpha,
+                const doublereal* a, const integer* lda, const doublereal* b,
+                const integer* ldb, const doublereal* beta, doublereal* c,
+                const integer* ldc);
+    int _DTRSM_(const char* side, ftnlen sisize, const char* uplo,
+                ftnlen upsize, const char* transa, ftnlen tasize,
+                const char* diag, ftnlen disize, const integer* m,
+                const integer* n, const doublereal* alpha,
+                const doublereal* a, const integer* lda, doublereal* b,
+                const integer* ldb);
+#endif
     int _DGETRF_(const integer* m, const integer* n,
                  doublereal* a, integer* lda, integer* ipiv,
                  integer* info);
@@ -246,6 +276,59 @@ inline void ct_dgemv(ctlapack::storage_t storage,
 #endif
 }
 
+inline void ct_dgemm(ctlapack::transpose_t transa,
+                     ctlapack::transpose_t transb, size_t m, size_t n,
+                     size_t k, doublereal alpha, const doublereal* a,
+                     size_t lda, const doublereal* b, size_t ldb,
+                     doublereal beta, doublereal* c, size_t ldc)
+{
+    integer f_m = (int) m, f_n = (int) n, f_k = (int) k;
+    integer f_lda = (int) lda, f_ldb = (int) ldb, f_ldc = (int) ldc;
+    char ta = no_yes[transa];
+    char tb = no_yes[transb];
+#ifdef NO_FTN_STRING_LEN_AT_END
+    _DGEMM_(&ta, &tb, &f_m, &f_n, &f_k, &alpha, a, &f_lda, b, &f_ldb,
+            &beta, c, &f_ldc);
+#else
+    ftnlen tasize = 1, tbsize = 1;
+#ifdef LAPACK_FTN_STRING_LEN_AT_END
+    _DGEMM_(&ta, &tb, &f_m, &f_n, &f_k, &alpha, a, &f_lda, b, &f_ldb,
+            &beta, c, &f_ldc, tasize, tbsize);
+#else
+    _DGEMM_(&ta, tasize, &tb, tbsize, &f_m, &f_n, &f_k, &alpha, a, &f_lda,
+            b, &f_ldb, &beta, c, &f_ldc);
+#endif
+#endif
+}
+
+//! Solve op(A)*X = alpha*B (side = Left) or X*op(A) = alpha*B (side =
+//! Right) for a triangular matrix A. *diag* is "U" if A has a unit diagonal
+//! and "N" otherwise.
+inline void ct_dtrsm(ctlapack::side_t side, ctlapack::upperlower_t uplo,
+                     ctlapack::transpose_t transa, const char* diag,
+                     size_t m, size_t n, doublereal alpha,
+                     const doublereal* a, size_t lda, doublereal* b,
+                     size_t ldb)
+{
+    integer f_m = (int) m, f_n = (int) n;
+    integer f_lda = (int) lda, f_ldb = (int) ldb;
+    char si = left_right[side];
+    char ul = upper_lower[uplo];
+    char ta = no_yes[transa];
+#ifdef NO_FTN_STRING_LEN_AT_END
+    _DTRSM_(&si, &ul, &ta, diag, &f_m, &f_n, &alpha, a, &f_lda, b, &f_ldb);
+#else
+    ftnlen sisize = 1, upsize = 1, tasize = 1, disize = 1;
+#ifdef LAPACK_FTN_STRING_LEN_AT_END
+    _DTRSM_(&si, &ul, &ta, diag, &f_m, &f_n, &alpha, a, &f_lda, b, &f_ldb,
+            sisize, upsize, tasize, disize);
+#else
+    _DTRSM_(&si, sisize, &ul, upsize, &ta, tasize, diag, disize, &f_m, &f_n,
+            &alpha, a, &f_lda, b, &f_ldb);
+#endif
+#endif
+}
+
 inline void ct_dgbsv(int n, int kl, int ku, int nrhs,
                      doublereal* a, int lda, integer* ipiv, doublereal* b, int ldb,
                      int& info)
@@ -31,6 +31,17 @@ namespace Cantera
  */
 doublereal linearInterp(doublereal x, const vector_fp& xpts,
                         const vector_fp& fpts);
+
+//! Weights of the cubic interpolation through four equally spaced points.
+/*!
+ * The interpolated value at *t* is `w[0]*f(-1) + w[1]*f(0) + w[2]*f(1) +
+ * w[3]*f(2)`, where the points are at -1, 0, 1 and 2.
+ *
+ * @param[in]  t  position, in units of the point spacing, relative to the
+ *                second point
+ * @param[out] w  the four weights
+ */
+void cubicWeights(doublereal t, doublereal* w);
 }
 
 #endif
@@ -440,6 +440,9 @@ private:
      */
     vector_fp m_botBounds;
 
+    //! Damping factor used for the previous Newton step
+    doublereal m_damp_old;
+
 public:
     int m_ioflag;
 };
@@ -56,7 +56,9 @@ public:
         m_left(0),
         m_right(0),
         m_id(""), m_desc(""),
-        m_refiner(0), m_bw(-1) {
+        m_refiner(0), m_bw(-1),
+        m_jac_eval(false),
+        m_force_full_update(false) {
         resize(nv, points);
     }
 
@@ -336,6 +338,35 @@ public:
     virtual void eval(size_t j, doublereal* x, doublereal* r,
                       integer* mask, doublereal rdt=0.0);
 
+    //! Set whether the Jacobian is being evaluated by perturbing several
+    //! grid points simultaneously.
+    /*!
+     *  While this is set, evaluating the residual at all points (`j ==
+     *  npos`) should give the same residual at each point as an evaluation
+     *  for a single Jacobian column would, e.g. properties that are held
+     *  constant while evaluating a Jacobian column should not be updated.
+     *  Used by MultiJac.
+     */
+    void setJacobianEval(bool jac) {
+        m_jac_eval = jac;
+    }
+
+    //! Set whether all properties, including those that are normally held
+    //! constant while evaluating the Jacobian (e.g. transport properties),
+    //! are updated at every evaluation of the residual.
+    /*!
+     *  The Jacobian evaluated while this is set includes the derivatives of
+     *  these properties, which is needed for accurate sensitivities. Used by
+     *  Sim1D::solveAdjoint().
+     */
+    void forceFullUpdate(bool update) {
+        m_force_full_update = update;
+    }
+
+    //! Set the number of threads used to evaluate the residual of this
+    //! domain. The base class implementation does nothing.
+    virtual void setNThreads(size_t n) {}
+
     virtual doublereal residual(doublereal* x, size_t n, size_t j) {
         throw CanteraError("Domain1D::residual","residual function must be overloaded in derived class "+id());
     }
@@ -601,6 +632,14 @@ protected:
     vector_int m_td;
     std::vector<std::string> m_name;
     int m_bw;
+
+    //! True while the Jacobian is being evaluated by perturbing several grid
+    //! points simultaneously. See setJacobianEval().
+    bool m_jac_eval;
+
+    //! True if all properties are updated at every evaluation of the
+    //! residual. See forceFullUpdate().
+    bool m_force_full_update;
 };
 }
 
@@ -10,6 +10,7 @@
 #define CT_MULTIJAC_H
 
 #include "cantera/numerics/BandMatrix.h"
+#include "cantera/numerics/BlockTridiagMatrix.h"
 #include "OneDim.h"
 
 namespace Cantera
@@ -35,6 +36,122 @@ public:
      */
     void eval(doublereal* x0, doublereal* resid0, double rdt);
 
+    //! Copy the blocks of the Jacobian *old* of the same system on a
+    //! different grid that are not affected by the change of grid.
+    /*!
+     * Since the residual at each grid point depends only on the solution at
+     * that point and its two neighbors, the block row for a point is
+     * unchanged if the point and its neighbors are all present in the old
+     * grid, and are neighbors there as well. These block rows are copied.
+     * The columns for the variables at the other points and their neighbors
+     * are left to be evaluated by evalPending(). The age of the Jacobian is
+     * set to the age of *old*. If more than three quarters of the points
+     * would have to be evaluated, nothing is copied, and the Jacobian must
+     * be evaluated with eval().
+     *
+     * @param old  Steady-state Jacobian on the old grid
+     * @param oldPoints  For each global grid point, the index of the same
+     *     point in the old grid, or npos if the point is new.
+     */
+    void remap(const MultiJac& old, const std::vector<size_t>& oldPoints);
+
+    //! Number of grid points whose columns must be evaluated by
+    //! evalPending() to complete a Jacobian set up by remap()
+    size_t nPendingPoints() const {
+        return m_pending.size();
+    }
+
+    /**
+     * Evaluate the steady-state Jacobian columns left by remap() at x0. The
+     * unperturbed residual function is resid0, which must be supplied on
+     * input. Each column is evaluated from the residual at the neighboring
+     * points only, so the cost is proportional to the number of pending
+     * points rather than to the size of the grid.
+     */
+    void evalPending(doublereal* x0, doublereal* resid0);
+
+    //! Set whether the Jacobian is evaluated by perturbing the same variable
+    //! at every third grid point simultaneously (the default).
+    /*!
+     * Since the residual at each grid point depends only on the solution at
+     * that point and its two neighbors, perturbing points *j*, *j* + 3, *j*
+     * + 6, ... at the same time gives the same Jacobian as perturbing them
+     * separately, but requires only 3 evaluations of the residual at all
+     * points per variable, rather than one evaluation per column. If
+     * disabled, each column is evaluated separately.
+     */
+    void setColoring(bool colored) {
+        m_colored = colored;
+    }
+
+    //! Returns `true` if the Jacobian is evaluated by perturbing several grid
+    //! points simultaneously. See setColoring().
+    bool coloring() const {
+        return m_colored;
+    }
+
+    //! Set whether the Jacobian is stored and factored as a block-tridiagonal
+    //! matrix.
+    /*!
+     * By default, the Jacobian is stored in the LAPACK band format of the
+     * BandMatrix base class, with upper and lower bandwidths of about twice
+     * the largest number of variables at any grid point, and is factored with
+     * `dgbtrf`. Since the residual at each grid point depends only on the
+     * solution at that point and its two neighbors, the Jacobian can instead
+     * be stored as a BlockTridiagMatrix with one block row per grid point,
+     * which requires roughly half the memory and half the arithmetic to
+     * factor.
+     *
+     * In block-tridiagonal mode, the band storage of the base class is not
+     * used. Elements must be accessed through value() and the linear system
+     * solved through solve() of this class, rather than through a reference
+     * to the base class. Changing the storage invalidates the Jacobian.
+     */
+    void setBlockTridiagonal(bool block);
+
+    //! Returns `true` if the Jacobian is stored as a block-tridiagonal
+    //! matrix. See setBlockTridiagonal().
+    bool blockTridiagonal() const {
+        return m_block;
+    }
+
+    //! Relative perturbation used to compute the Jacobian by finite
+    //! differences. Component *i* is perturbed by
+    //! `absolutePerturbation() + relativePerturbation()*|x[i]|`.
+    doublereal relativePerturbation() const {
+        return m_rtol;
+    }
+
+    //! Absolute perturbation used to compute the Jacobian by finite
+    //! differences. See relativePerturbation().
+    doublereal absolutePerturbation() const {
+        return m_atol;
+    }
+
+    //! Return a changeable reference to element (i,j) of the Jacobian
+    doublereal& value(size_t i, size_t j) {
+        return m_block ? m_blocks.value(i,j) : BandMatrix::value(i,j);
+    }
+
+    //! Return the value of element (i,j) of the Jacobian
+    doublereal value(size_t i, size_t j) const {
+        return m_block ? m_blocks.value(i,j) : BandMatrix::value(i,j);
+    }
+
+    //! Solve J*x = b, factoring the Jacobian first if necessary.
+    /*!
+     * @returns 0 on success, or a nonzero value if the Jacobian is singular
+     */
+    int solve(const doublereal* const b, doublereal* const x);
+
+    //! Solve J^T*x = b, factoring the Jacobian first if necessary.
+    /*!
+     * Used to solve adjoint problems with the steady-state Jacobian. *b*
+     * and *x* may be the same array.
+     * @returns 0 on success, or a nonzero value if the Jacobian is singular
+     */
+    int solveTranspose(const doublereal* const b, doublereal* const x);
+
     //! Elapsed CPU time spent computing the Jacobian.
     doublereal elapsedTime() const {
         return m_elapsed;
@@ -45,6 +162,15 @@ public:
         return m_nevals;
     }
 
+    virtual bool factored() const {
+        return m_block ? m_blocks.factored() : BandMatrix::factored();
+    }
+
+    //! Number of times the Jacobian has been factored
+    int nFactors() const {
+        return m_nfactors;
+    }
+
     //! Number of times 'incrementAge' has been called since the last
     //! evaluation
     int age() const {
@@ -70,6 +196,17 @@ public:
     void incrementDiagonal(int j, doublereal d);
 
 protected:
+    //! Evaluate the Jacobian one column at a time
+    void evalColumns(doublereal* x0, doublereal* resid0, doublereal rdt);
+
+    //! Evaluate the columns for the variables at grid point *j*
+    void evalPoint(size_t j, doublereal* x0, doublereal* resid0,
+                   doublereal rdt);
+
+    //! Evaluate the Jacobian by perturbing every third grid point
+    //! simultaneously
+    void evalColored(doublereal* x0, doublereal* resid0);
+
     //!  Residual evaluator for this jacobian
     /*!
      *  This is a pointer to the residual evaluator. This object isn't owned
@@ -83,9 +220,34 @@ protected:
     vector_fp m_ssdiag;
     vector_int m_mask;
     int m_nevals;
+    int m_nfactors;
     int m_age;
     size_t m_size;
     size_t m_points;
+
+    //! Location and number of variables of each grid point of the grid the
+    //! Jacobian was created for. Used by remap().
+    std::vector<size_t> m_loc;
+    std::vector<size_t> m_nv;
+
+    //! Grid points whose columns have not been evaluated since remap()
+    std::vector<size_t> m_pending;
+
+    //! True if the Jacobian is evaluated by perturbing several grid points
+    //! simultaneously
+    bool m_colored;
+
+    //! Unperturbed values and reciprocal perturbations of the variables
+    //! perturbed simultaneously by evalColored(), indexed by grid point
+    vector_fp m_xsave;
+    vector_fp m_rdx;
+
+    //! True if the Jacobian is stored in #m_blocks rather than in the band
+    //! storage of the base class
+    bool m_block;
+
+    //! Block-tridiagonal storage of the Jacobian
+    BlockTridiagMatrix m_blocks;
 };
 }
 
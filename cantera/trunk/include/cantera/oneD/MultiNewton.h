@@ -71,15 +71,106 @@ public:
         m_maxAge = maxJacAge;
     }
 
+    //! Keep using a Jacobian older than the maximum age as long as the
+    //! Newton iteration converges quickly.
+    /*!
+     * By default, the Jacobian is re-evaluated whenever its age exceeds the
+     * value set with setOptions(). If *rate* is positive, a Jacobian that has
+     * reached the maximum age is kept as long as the ratio of the norms of
+     * successive undamped Newton steps stays below *rate*, since a Jacobian
+     * that still produces a rapidly converging iteration does not need to be
+     * updated. Set *rate* to zero to restore the default behavior.
+     */
+    void setJacReuseRate(doublereal rate) {
+        m_reuseRate = rate;
+    }
+
+    //! Compute Newton steps with a Jacobian-free Newton-Krylov method.
+    /*!
+     * If enabled, the Newton step is computed by solving the linear system
+     * with GMRES, where products of the Jacobian with a vector are
+     * approximated by finite differences of the residual, and the last
+     * factored Jacobian is used as a (left) preconditioner. Since the
+     * linear system is solved with the current Jacobian rather than the
+     * stored one, an old Jacobian can be used for many more iterations than
+     * with the direct solver. If GMRES does not converge, the Jacobian is
+     * re-evaluated. Combine with setJacReuseRate() to allow the Jacobian to
+     * exceed the maximum age.
+     *
+     * @param krylov   Enable or disable the Newton-Krylov mode
+     * @param maxIters Maximum number of GMRES iterations for each Newton
+     *                 step, which is also the dimension of the Krylov
+     *                 subspace
+     * @param tol      GMRES convergence tolerance, relative to the weighted
+     *                 norm of the step computed with the stored Jacobian
+     */
+    void setKrylov(bool krylov, size_t maxIters=20, doublereal tol=0.05);
+
+    //! Returns `true` if the Newton-Krylov mode is enabled
+    bool krylov() const {
+        return m_krylov;
+    }
+
+    //! Total number of GMRES iterations in the Newton-Krylov mode since the
+    //! last call to clearStats()
+    int nKrylovIters() const {
+        return m_nKrylovIters;
+    }
+
+    //! Reset the number of GMRES iterations
+    void clearStats() {
+        m_nKrylovIters = 0;
+    }
+
     /// Change the problem size.
     void resize(size_t points);
 
 protected:
+    //! Improve the Newton step computed with the stored Jacobian using
+    //! GMRES. See setKrylov().
+    /*!
+     * @param x     Current solution
+     * @param f     Residual at `x`
+     * @param step  On entry, the step computed with the stored Jacobian. On
+     *              return, the improved step.
+     */
+    void krylovStep(const doublereal* x, const doublereal* f,
+                    doublereal* step, OneDim& r, MultiJac& jac,
+                    int loglevel);
+
     //! Work arrays of size #m_n used in solve().
     vector_fp m_x, m_stp, m_stp1;
 
     int m_maxAge;
 
+    //! Ratio of step norms below which an old Jacobian is kept. See
+    //! setJacReuseRate().
+    doublereal m_reuseRate;
+
+    //! Ratio of the norm of the last undamped step to that of the
+    //! preceding one
+    doublereal m_rate;
+
+    //! True if the Newton-Krylov mode is enabled
+    bool m_krylov;
+
+    //! Maximum number of GMRES iterations per Newton step
+    size_t m_krylovDim;
+
+    //! Relative GMRES convergence tolerance
+    doublereal m_krylovTol;
+
+    //! True if GMRES converged in the last call to krylovStep()
+    bool m_krylovConverged;
+
+    //! Number of GMRES iterations since the last call to clearStats()
+    int m_nKrylovIters;
+
+    //! Work arrays used by krylovStep(): residual, error weights, perturbed
+    //! solution and residual, Krylov basis, Hessenberg matrix, Givens
+    //! rotations and right-hand side of the least-squares problem
+    vector_fp m_f, m_ewt, m_xp, m_fp, m_basis, m_hess, m_cs, m_sn, m_g;
+
     //! number of variables
     size_t m_n;
 
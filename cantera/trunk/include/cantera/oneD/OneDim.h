@@ -180,6 +180,20 @@ public:
     //! Call after one or more grids has been refined.
     void resize();
 
+    //! Call after one or more grids has been refined, keeping the parts of
+    //! the steady-state Jacobian that are not affected by the refinement.
+    /*!
+     * @param oldPoints  For each global grid point, the index of the same
+     *     point in the old grid, or npos if the point is new.
+     *
+     * If the current Jacobian has been evaluated and is not older than the
+     * maximum steady-state Jacobian age, the blocks of the residuals at
+     * points whose neighbors have not changed are copied to the new
+     * Jacobian, and only the columns for the other points are evaluated
+     * before the next call to solve(). See MultiJac::remap().
+     */
+    void resize(const std::vector<size_t>& oldPoints);
+
     //void setTransientMask();
     vector_int& transientMask() {
         return m_mask;
@@ -236,6 +250,8 @@ public:
      *    - number of grid points
      *    - number of Jacobian evaluations
      *    - CPU time spent evaluating Jacobians
+     *    - number of Jacobian factorizations
+     *    - number of GMRES iterations (see MultiNewton::setKrylov)
      *    - number of non-Jacobian function evaluations
      *    - CPU time spent evaluating functions
      */
@@ -244,6 +260,15 @@ public:
     //! Clear saved statistics
     void clearStats();
 
+    //! Set the number of threads used to evaluate the residual of each
+    //! domain. See StFlow::setNThreads(). Applies to the domains that have
+    //! already been added.
+    void setNThreads(size_t n) {
+        for (size_t i = 0; i < m_nd; i++) {
+            m_dom[i]->setNThreads(n);
+        }
+    }
+
     //! Set a function that will be called every time #eval is called.
     //! Can be used to provide keyboard interrupt support in the high-level
     //! language interfaces.
@@ -292,6 +317,8 @@ private:
     std::vector<size_t> m_gridpts;
     vector_int m_jacEvals;
     vector_fp m_jacElapsed;
+    vector_int m_jacFactors;
+    vector_int m_krylovIters;
     vector_int m_funcEvals;
     vector_fp m_funcElapsed;
 };
@@ -10,6 +10,28 @@
 namespace Cantera
 {
 
+class Kinetics;
+
+//! A scalar parameter of a one-dimensional problem, which is varied by the
+//! continuation methods of class Sim1D.
+/*!
+ * Derived classes set the parameter in the domains of the problem, for
+ * example the mass flux of one or more inlets (see Inlet1D::setMdot), the
+ * pressure, or a rate multiplier.
+ * @ingroup onedim
+ */
+class ContinuationParameter
+{
+public:
+    virtual ~ContinuationParameter() {}
+
+    //! The current value of the parameter
+    virtual doublereal value() const = 0;
+
+    //! Set the value of the parameter
+    virtual void setValue(doublereal p) = 0;
+};
+
 /**
  * One-dimensional simulations. Class Sim1D extends class OneDim by storing
  * the solution vector, and by adding a hybrid Newton/time-stepping solver.
@@ -25,7 +47,7 @@ public:
      *  but is not meant to be used in most applications.  Use the next
      *  constructor
      */
-    Sim1D() {}
+    Sim1D() : m_param(0) {}
 
     /**
      * Standard constructor.
@@ -155,6 +177,161 @@ public:
 
     void evalSSJacobian();
 
+    //! Solve the adjoint equation \f$ J^T \lambda = b \f$.
+    /*!
+     * Here, \f$ J = \partial f/\partial x \f$ is the steady-state Jacobian
+     * of the system of equations \f$ f(x, p) = 0 \f$, evaluated at the
+     * current solution. The Jacobian is evaluated with all properties
+     * updated for each perturbation (see Domain1D::forceFullUpdate()). The
+     * sensitivities of a scalar function \f$ g(x, p) \f$ of the solution to
+     * any number of parameters \f$ p \f$ can then be computed as
+     * \f[
+     *     \frac{dg}{dp} = \frac{\partial g}{\partial p}
+     *         - \lambda^T \frac{\partial f}{\partial p}
+     * \f]
+     * where \f$ b = (\partial g/\partial x)^T \f$. The Jacobian is
+     * re-evaluated by the next call to solve().
+     *
+     * @param b       Right-hand side (length size())
+     * @param lambda  Output solution (length size()). May be the same array
+     *                as *b*.
+     */
+    void solveAdjoint(const doublereal* b, doublereal* lambda);
+
+    //! Compute the sensitivities of a function of the solution to the rate
+    //! multipliers of all reactions.
+    /*!
+     * On return, `sens[i]` is \f$ dg/d\ln m_i \f$, where \f$ m_i \f$ is
+     * the multiplier of reaction *i* in *kin* (see Kinetics::setMultiplier)
+     * and \f$ g \f$ is a function of the solution with gradient *dgdx*.
+     * For example, the sensitivities of the flame speed of a FreeFlame are
+     * obtained with `dgdx` equal to one for the velocity at its first grid
+     * point and zero elsewhere.
+     *
+     * The sensitivities are computed with a single adjoint solve (see
+     * solveAdjoint()), followed by one evaluation of the residual for each
+     * reaction to find \f$ \partial f/\partial \ln m_i \f$. Since the
+     * reaction rates do not affect the transport properties, these are held
+     * constant while the residual is evaluated with the perturbed
+     * multipliers.
+     *
+     * @param kin   Kinetics manager used by the flow domains
+     * @param dgdx  Derivatives of the function with respect to the solution
+     *              components (length size())
+     * @param sens  Output sensitivities (length `kin.nReactions()`)
+     * @param dp    Relative perturbation of each multiplier
+     */
+    void getReactionSensitivities(Kinetics& kin, const doublereal* dgdx,
+                                  doublereal* sens, doublereal dp=1.0e-5);
+
+    /**
+     * @name Continuation
+     *
+     * These methods trace the steady-state solution as a function of a
+     * parameter, on a fixed grid. Each step consists of a predictor along
+     * the tangent to the solution branch, followed by damped corrector
+     * iterations with a Jacobian that is kept as long as the iterations
+     * converge, so that most steps do not require a new Jacobian and no time
+     * stepping is needed. With pseudo-arclength continuation, the corrector
+     * solves the system augmented by the condition that the step be
+     * orthogonal to the tangent, which remains regular at turning points, so
+     * that S-shaped curves, e.g. of the temperature of a counterflow flame
+     * versus the strain rate, are traced through the extinction and ignition
+     * points.
+     */
+    //@{
+
+    //! Start a continuation from the current solution.
+    /*!
+     * The current solution must be a converged steady-state solution for
+     * the current value of *param*. The grid must not be changed until the
+     * continuation is finished.
+     *
+     * @param param  The parameter to vary. Not owned by Sim1D, and must
+     *               remain valid while continuationStep() is called.
+     * @param dp     Initial change in the parameter. Its sign gives the
+     *               initial direction of the continuation.
+     * @param arclength  If `true`, use pseudo-arclength continuation.
+     *               Otherwise, the parameter is incremented at each step
+     *               (natural-parameter continuation), which fails at
+     *               turning points.
+     */
+    void initContinuation(ContinuationParameter& param, doublereal dp,
+                          bool arclength=true);
+
+    //! Take one continuation step.
+    /*!
+     * On return, the solution and the value of the parameter have been
+     * updated. The step size is increased after steps that converge
+     * quickly and reduced after steps that converge slowly or fail, within
+     * 0.001 and 10 times the initial step. The arclength is measured in
+     * the root-mean-square norm of the changes in the solution components,
+     * each scaled by the largest magnitude of that component in its domain,
+     * combined with the change in the parameter scaled by the larger of its
+     * initial value and the initial step.
+     *
+     * @param loglevel  Controls amount of diagnostic output.
+     * @returns 1 if the continuation has passed a turning point, i.e. the
+     *     parameter changed direction during this step, and 0 otherwise.
+     *     Throws an exception if no step could be taken.
+     */
+    int continuationStep(int loglevel=0);
+
+    //! The derivative of the parameter with respect to the arclength
+    //! (pseudo-arclength continuation), or the sign of the parameter step
+    //! (natural-parameter continuation). Changes sign at turning points.
+    doublereal continuationDirection() const {
+        return m_dpds;
+    }
+    //@}
+
+    /**
+     * @name Solution cache
+     *
+     * These methods keep converged solutions, together with their grids, for
+     * use as initial guesses in sweeps over parameters such as the
+     * equivalence ratio, the pressure or the inlet temperature. After each
+     * converged solution, call cacheSolution() with the values of the
+     * parameters. Before solving for new values of the parameters, call
+     * restoreCachedSolution() to start from the nearest cached solution.
+     */
+    //@{
+
+    //! Add the current solution and its grid to the cache, as the solution
+    //! for the parameter values *params*.
+    void cacheSolution(const vector_fp& params);
+
+    //! Set the current solution to the cached solution nearest to the
+    //! parameter values *params*, interpolated onto the current grid.
+    /*!
+     * The distance between two sets of parameter values is the
+     * root-mean-square of the relative differences of the parameters.
+     *
+     * The profiles in a FreeFlame domain where the location of the flame is
+     * fixed (see setFixedTemperature()) are shifted so that the temperature
+     * at the fixed point is equal to the fixed temperature. If the current
+     * FreeFlame domain has no fixed point, the fixed temperature of the
+     * cached solution is used.
+     *
+     * @param params    Values of the parameters, which must have the same
+     *                  size as those given to cacheSolution().
+     * @param loglevel  Controls amount of diagnostic output.
+     * @returns the index of the cached solution that was used, in the order
+     *     in which the solutions were added to the cache.
+     */
+    size_t restoreCachedSolution(const vector_fp& params, int loglevel=0);
+
+    //! Number of solutions in the cache
+    size_t nCachedSolutions() const {
+        return m_cache.size();
+    }
+
+    //! Remove all solutions from the cache
+    void clearSolutionCache() {
+        m_cache.clear();
+    }
+    //@}
+
 protected:
     //! the solution vector
     vector_fp m_x;
@@ -169,14 +346,92 @@ protected:
     //! solution
     vector_int m_steps;
 
+    //! Parameter varied by continuationStep(), or NULL
+    ContinuationParameter* m_param;
+
+    //! True for pseudo-arclength continuation
+    bool m_arclength;
+
+    //! Tangent to the solution branch: derivatives of the solution and the
+    //! parameter with respect to the arclength, or of the solution with
+    //! respect to the parameter (natural-parameter continuation)
+    vector_fp m_dxds;
+    doublereal m_dpds;
+
+    //! Current and initial continuation step size
+    doublereal m_ds, m_ds0;
+
+    //! Scale of the parameter used in the arclength
+    doublereal m_pscale;
+
+    //! Work arrays used by continuationStep(): scales of the solution
+    //! components used in the arclength, solution at the start of the step,
+    //! residual or corrector step, trial solution, and derivatives of the
+    //! residual and the solution with respect to the parameter
+    vector_fp m_ewt, m_xc, m_fc, m_x1, m_dfdp, m_dxdp;
+
+    //! A converged solution stored by cacheSolution()
+    struct CachedSolution {
+        //! Values of the parameters
+        vector_fp params;
+
+        //! Grid of each domain
+        std::vector<vector_fp> grids;
+
+        //! Solution vector
+        vector_fp x;
+
+        //! Fixed temperature and its location for FreeFlame domains, or
+        //! #Undef for other domains
+        vector_fp tfixed, zfixed;
+    };
+
+    //! Solutions stored by cacheSolution()
+    std::vector<CachedSolution> m_cache;
+
 private:
     /// Calls method _finalize in each domain.
     void finalize();
 
+    //! Evaluate the steady-state Jacobian at the current solution, with all
+    //! properties updated for each perturbation (see
+    //! Domain1D::forceFullUpdate()).
+    void evalFullJacobian();
+
     /*! Wrapper around the Newton solver.
      * @return 0 if successful, -1 on failure
      */
     int newtonSolve(int loglevel);
+
+    //! Evaluate the derivative of the steady-state residual at the solution
+    //! *x* with respect to the continuation parameter *p*, and solve for
+    //! the derivative of the solution, #m_dxdp.
+    void solveParameterDerivative(doublereal* x, doublereal p);
+
+    //! Update the tangent from #m_dxdp, keeping the direction of the
+    //! previous tangent
+    void updateTangent(const doublereal* x);
+
+    //! Set #m_x and *p* to the solution and the parameter predicted by a
+    //! step of size #m_ds along the tangent from #m_xc and *p0*. The
+    //! predicted solution is limited to the bounds of each component.
+    void predict(doublereal p0, doublereal& p);
+
+    //! Compute the corrector step *step* and *dp* from the solution *x* and
+    //! the parameter *p*, for a step of size *ds* from #m_xc and *p0*. *cb*
+    //! is the coefficient of the parameter change in the arclength condition.
+    //! Returns false if the Jacobian is singular.
+    bool correctorStep(doublereal* x, doublereal p, doublereal p0,
+                       doublereal ds, doublereal cb, doublereal* step,
+                       doublereal& dp);
+
+    //! Apply the corrector iteration to the solution #m_x and the parameter
+    //! *p*, which on entry are the values predicted by a step of size *ds*
+    //! from the solution #m_xc and the parameter *p0*.
+    /*!
+     * @returns the number of iterations if successful, or -1 on failure
+     */
+    int correct(doublereal& p, doublereal p0, doublereal ds, int loglevel);
 };
 
 }
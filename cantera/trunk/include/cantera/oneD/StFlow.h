@@ -50,6 +50,8 @@ public:
     //! @param points Initial number of grid points
     StFlow(IdealGasPhase* ph = 0, size_t nsp = 1, size_t points = 1);
 
+    virtual ~StFlow();
+
     //! @name Problem Specification
     //! @{
 
@@ -71,11 +73,13 @@ public:
      */
     void setThermo(IdealGasPhase& th) {
         m_thermo = &th;
+        clearThreadData();
     }
 
     //! Set the kinetics manager. The kinetics manager must
     void setKinetics(Kinetics& kin) {
         m_kin = &kin;
+        clearThreadData();
     }
 
     //! set the transport manager
@@ -85,6 +89,50 @@ public:
         return m_do_soret;
     }
 
+    //! Set the number of threads used to evaluate the residual.
+    /*!
+     * When the residual is evaluated at all grid points, which includes each
+     * residual evaluation used to compute the Jacobian with MultiJac's
+     * coloring enabled, the grid points are divided into contiguous blocks
+     * and the thermodynamic and transport properties, reaction rates and
+     * residual equations at the points in each block are evaluated by a
+     * separate thread. Each additional thread uses its own copies of the
+     * IdealGasPhase, Kinetics and Transport objects, which are created from
+     * the XML input data of the phase when they are first needed. Since the
+     * values at each point do not depend on which thread computes them, the
+     * results are identical for any number of threads.
+     *
+     * Reaction rate multipliers are copied to the additional kinetics
+     * managers before each evaluation. Any other change to the phase,
+     * kinetics or transport objects is only seen by the copies after
+     * setNThreads(), setThermo(), setKinetics() or setTransport() is called
+     * again.
+     *
+     * Threads are only used if Cantera is compiled with thread safety enabled
+     * (see \ref threadSafety). The additional threads are started when the
+     * residual is first evaluated, and wait for the next evaluation until
+     * this object is destroyed or the threads are replaced after one of the
+     * functions above is called. Note that the evaluation times reported by
+     * OneDim::writeStats() are CPU times, summed over all threads.
+     *
+     * @param n  Number of threads. If zero, one thread is used for each
+     *           processor.
+     */
+    virtual void setNThreads(size_t n);
+
+    //! Number of threads used to evaluate the residual. See setNThreads().
+    size_t nThreads() const {
+        return m_nthreads;
+    }
+
+    //! Number of different threads which took part in the last evaluation of
+    //! the residual at all grid points. This is less than nThreads() if there
+    //! are fewer grid points than threads, and is always 1 if Cantera is
+    //! compiled without thread safety.
+    size_t nThreadsUsed() const {
+        return m_nthreads_used;
+    }
+
     //! Set the pressure. Since the flow equations are for the limit of
     //! small Mach number, the pressure is very nearly constant
     //! throughout the flow.
@@ -290,11 +338,18 @@ public:
     void setJac(MultiJac* jac);
 
     //! Set the gas object state to be consistent with the solution at point j.
-    void setGas(const doublereal* x, size_t j);
+    void setGas(const doublereal* x, size_t j) {
+        setGas(*m_thermo, x, j);
+    }
+
+    //! Set the state of *gas* to be consistent with the solution at point j.
+    void setGas(IdealGasPhase& gas, const doublereal* x, size_t j);
 
     //! Set the gas state to be consistent with the solution at the midpoint
     //! between j and j + 1.
-    void setGasAtMidpoint(const doublereal* x, size_t j);
+    void setGasAtMidpoint(const doublereal* x, size_t j) {
+        setGasAtMidpoint(m_threadData[0], x, j);
+    }
 
     doublereal density(size_t j) const {
         return m_rho[j];
@@ -343,10 +398,32 @@ protected:
         return m_wdot(k,j);
     }
 
+    //! Objects used by one thread to evaluate the residual. See
+    //! setNThreads().
+    struct ThreadData {
+        ThreadData() : thermo(0), kin(0), trans(0), jmin(0), jmax(0) {}
+        IdealGasPhase* thermo;
+        Kinetics* kin;
+        Transport* trans;
+
+        //! Mass fractions at the midpoint. See setGasAtMidpoint().
+        vector_fp ybar;
+
+        //! First and last grid points of the block evaluated by this thread
+        size_t jmin, jmax;
+
+        //! Message of an exception thrown while evaluating this block
+        std::string error;
+    };
+
     //! Write the net production rates at point `j` into array `m_wdot`
     void getWdot(doublereal* x, size_t j) {
-        setGas(x,j);
-        m_kin->getNetProductionRates(&m_wdot(0,j));
+        getWdot(m_threadData[0], x, j);
+    }
+
+    void getWdot(ThreadData& td, doublereal* x, size_t j) {
+        setGas(*td.thermo, x, j);
+        td.kin->getNetProductionRates(&m_wdot(0,j));
     }
 
     /**
@@ -354,11 +431,16 @@ protected:
      * (inclusive), based on solution x.
      */
     void updateThermo(const doublereal* x, size_t j0, size_t j1) {
+        updateThermo(m_threadData[0], x, j0, j1);
+    }
+
+    void updateThermo(ThreadData& td, const doublereal* x, size_t j0,
+                      size_t j1) {
         for (size_t j = j0; j <= j1; j++) {
-            setGas(x,j);
-            m_rho[j] = m_thermo->density();
-            m_wtm[j] = m_thermo->meanMolecularWeight();
-            m_cp[j]  = m_thermo->cp_mass();
+            setGas(*td.thermo, x, j);
+            m_rho[j] = td.thermo->density();
+            m_wtm[j] = td.thermo->meanMolecularWeight();
+            m_cp[j]  = td.thermo->cp_mass();
         }
     }
 
@@ -532,10 +614,62 @@ protected:
 
     //! Update the transport properties at grid points in the range from `j0`
     //! to `j1`, based on solution `x`.
-    void updateTransport(doublereal* x, size_t j0, size_t j1);
+    void updateTransport(doublereal* x, size_t j0, size_t j1) {
+        updateTransport(m_threadData[0], x, j0, j1);
+    }
+
+    void updateTransport(ThreadData& td, doublereal* x, size_t j0, size_t j1);
+
+    //! Set the state of the phase of *td* to be consistent with the solution
+    //! at the midpoint between j and j + 1.
+    void setGasAtMidpoint(ThreadData& td, const doublereal* x, size_t j);
+
+    //! Compute the radiative heat loss at points `j0` to `j1 - 1`.
+    void updateRadiation(const doublereal* x, size_t j0, size_t j1);
+
+    //! Evaluate the residual equations at points `j0` to `j1` (inclusive).
+    //! The properties at points `j0 - 1` to `j1 + 1` must be up to date.
+    void evalResidual(ThreadData& td, doublereal* x, doublereal* rsd,
+                      integer* diag, doublereal rdt, size_t j0, size_t j1);
+
+    //! @name Multithreaded evaluation
+    //! @{
+
+    //! Update the properties for the block of grid points of thread *t*.
+    //! `jlast` is the last point at which properties are needed.
+    void evalPropertiesBlock(size_t t, doublereal* x, size_t jlast,
+                             bool transport);
 
-private:
-    vector_fp m_ybar;
+    //! Evaluate the residual equations for the block of grid points of
+    //! thread *t*
+    void evalResidualBlock(size_t t, doublereal* x, doublereal* rsd,
+                           integer* diag, doublereal rdt);
+
+    //! Make sure that the copies of the phase, kinetics and transport
+    //! objects needed by *n* threads exist and use the current rate
+    //! multipliers.
+    void prepareThreads(size_t n);
+
+    //! Stop the additional threads and delete the copies made for them
+    void clearThreadData();
+
+    //! Number of threads used to evaluate the residual
+    size_t m_nthreads;
+
+    //! Number of threads used by the last evaluation of all grid points
+    size_t m_nthreads_used;
+
+    //! Threads which evaluate the blocks of grid points. Defined only if
+    //! Cantera is compiled with thread safety.
+    class WorkerPool;
+
+    //! The threads used by eval(), started when they are first needed
+    WorkerPool* m_pool;
+
+    //! Objects used by each thread. The first entry refers to #m_thermo,
+    //! #m_kin and #m_trans; the others are owned by this object.
+    std::vector<ThreadData> m_threadData;
+    //! @}
 };
 
 /**
@@ -4,7 +4,8 @@
  *  manager for a phase (see \ref mgrsrefcalc and
  * \link Cantera::GeneralSpeciesThermo GeneralSpeciesThermo\endlink).
  *
- *  Because it is general, it is slow.
+ *  Species with two-region NASA, two-region Shomate, or multi-region NASA9
+ *  parameterizations are evaluated from packed coefficient arrays.
  */
 #ifndef CT_GENERALSPECIESTHERMO_H
 #define CT_GENERALSPECIESTHERMO_H
@@ -19,9 +20,18 @@ namespace Cantera
 /*!
  * This is a general manager that can handle a wide variety
  * of species thermodynamic polynomials for individual species.
- * It is slow, however, because it recomputes the functions of
- * temperature needed for each species. What it does is to create
- * a vector of SpeciesThermoInterpType objects.
+ * What it does is to create a vector of SpeciesThermoInterpType objects.
+ *
+ * If all of the species with a given parameterization type use one of the
+ * two-region NASA (NasaPoly2), two-region Shomate (ShomatePoly2), or
+ * multi-region NASA9 (Nasa9PolyMultiTempRegion) parameterizations, their
+ * coefficients are also copied into packed arrays when the species are
+ * installed. Species which have the same temperature region boundaries are
+ * placed in the same group, so that update() chooses the temperature region
+ * once for each group and then evaluates all of the species in the group in
+ * a single loop, without calling any virtual functions. Other
+ * parameterizations are evaluated through their SpeciesThermoInterpType
+ * objects.
  *
  * @ingroup mgrsrefcalc
  */
@@ -109,6 +119,25 @@ public:
     virtual void update(doublereal T, doublereal* cp_R,
                         doublereal* h_RT, doublereal* s_R) const;
 
+    //! Equivalent to update() for each of *n* independent temperatures.
+    /*!
+     * Species evaluated from packed coefficients are evaluated in loops over
+     * the temperatures, which can be vectorized. The results are the same as
+     * those of update().
+     *
+     * @param n     Number of temperatures
+     * @param T     Temperatures [K]. Length *n*.
+     * @param cp_R  Output array of dimensionless heat capacities, where
+     *              `cp_R[k*n + j]` is the value for species *k* at
+     *              temperature `T[j]`.
+     * @param h_RT  Output array of dimensionless enthalpies, in the same
+     *              layout as *cp_R*.
+     * @param s_R   Output array of dimensionless entropies, in the same
+     *              layout as *cp_R*.
+     */
+    void updateBatch(size_t n, const doublereal* T, doublereal* cp_R,
+                     doublereal* h_RT, doublereal* s_R) const;
+
     virtual doublereal minTemp(size_t k=npos) const;
     virtual doublereal maxTemp(size_t k=npos) const;
     virtual doublereal refPressure(size_t k=npos) const;
@@ -136,6 +165,23 @@ private:
 
     void clear(); //<! Delete owned SpeciesThermoInterpType objects.
 
+    //! Get the coefficients of a species in the form used by #m_groups.
+    /*!
+     * @param stit_ptr  Parameterization for the species
+     * @param bounds    Output - temperatures at the boundaries between the
+     *                  temperature regions
+     * @param coeffs    Output - coefficients for each temperature region
+     * @return `true` if the parameterization can be evaluated from packed
+     *     coefficients, `false` otherwise.
+     */
+    static bool getPackedCoeffs(const SpeciesThermoInterpType* stit_ptr,
+                                vector_fp& bounds, vector_fp& coeffs);
+
+    //! Add species *k* to the group for its parameterization type and
+    //! temperature region boundaries, creating the group if necessary.
+    void addToGroup(size_t k, int type, const vector_fp& bounds,
+                    const vector_fp& coeffs);
+
 protected:
     typedef std::map<int, std::vector<SpeciesThermoInterpType*> > STIT_map;
     typedef std::map<int, std::vector<double> > tpoly_map;
@@ -161,6 +207,34 @@ protected:
     //! reference pressure (Pa)
     doublereal m_p0;
 
+    //! Coefficients for a group of species that have the same
+    //! parameterization type and temperature region boundaries.
+    struct PolyGroup {
+        //! Parameterization type
+        int type;
+
+        //! Temperatures at the boundaries between the temperature regions
+        vector_fp bounds;
+
+        //! Indices of the species in the group
+        std::vector<size_t> species;
+
+        //! `coeffs[n*i+j][m]` is coefficient *j* in temperature region *i*
+        //! for the *m*-th species in the group, where *n* is the number of
+        //! coefficients per region.
+        std::vector<vector_fp> coeffs;
+    };
+
+    //! Groups of species evaluated from packed coefficients
+    std::vector<PolyGroup> m_groups;
+
+    //! Location (group, position in group) of each species in #m_groups
+    std::map<size_t, std::pair<size_t, size_t> > m_groupLoc;
+
+    //! `true` for each parameterization type where all species are
+    //! evaluated from #m_groups.
+    std::map<int, bool> m_packed;
+
     //! Make the class VPSSMgr a friend because we need to access
     //! the function provideSTIT()
     friend class VPSSMgr;
@@ -3047,38 +3047,42 @@ private:
     void s_updateIMS_lnMolalityActCoeff() const;
 
 private:
-    //! Calculate the Pitzer portion of the activity coefficients.
+    //! Calculate the Pitzer portion of the activity coefficients and their
+    //! temperature and pressure derivatives.
     /**
      *  This is the main routine in the whole module. It calculates the
      *  molality based activity coefficients for the solutes, and
-     *  the activity of water.
-     */
-    void s_updatePitzer_lnMolalityActCoeff() const;
-
-    //!  Calculates the temperature derivative of the
-    //!  natural logarithm of the molality activity coefficients.
-    /*!
-     * Public function makes sure that all dependent data is
-     * up to date, before calling a private function
-     */
-    void s_updatePitzer_dlnMolalityActCoeff_dT() const;
-
-    /**
-     * This function calculates the temperature second derivative of the
-     * natural logarithm of the molality activity coefficients.
+     *  the activity of water, along with their first and second
+     *  temperature derivatives and their pressure derivative. The
+     *  requested quantities are evaluated in a single pass over the
+     *  species, sharing the terms which depend only on the molalities.
+     *
+     *  The derivatives are evaluated at constant molality. It is assumed
+     *  that the cropped molalities and the Pitzer coefficients are current,
+     *  as set up by s_update_lnMolalityActCoeff().
      *
-     * It is assumed that the Pitzer activity coefficient and first derivative
-     * routine are called immediately preceding the call to this routine.
+     *  @param quantities  Bitwise combination of the quantities to
+     *      evaluate: 1 for the activity coefficients, stored in
+     *      m_lnActCoeffMolal_Unscaled; 2 for their temperature derivatives,
+     *      m_dlnActCoeffMolaldT_Unscaled; 4 for their second temperature
+     *      derivatives, m_d2lnActCoeffMolaldT2_Unscaled; and 8 for their
+     *      pressure derivatives, m_dlnActCoeffMolaldP_Unscaled.
      */
-    void s_updatePitzer_d2lnMolalityActCoeff_dT2() const;
+    void s_updatePitzer_lnMolalityActCoeff(int quantities) const;
 
-    //!  Calculates the Pressure derivative of the
-    //!  natural logarithm of the molality activity coefficients.
+    //! Make sure that one of the unscaled derivatives of the activity
+    //! coefficients is current.
     /*!
-     * It is assumed that the Pitzer activity coefficient and first derivative
-     * routine are called immediately preceding the calling of this routine.
+     *  A derivative which has been requested once is evaluated together
+     *  with the activity coefficients by s_update_lnMolalityActCoeff() from
+     *  then on, so that the activity coefficients and all of the derivatives
+     *  needed by the property routines are obtained in a single pass for
+     *  each new state.
+     *
+     *  @param quantity  Derivative to update, using the flags of
+     *      s_updatePitzer_lnMolalityActCoeff()
      */
-    void s_updatePitzer_dlnMolalityActCoeff_dP() const;
+    void s_updatePitzer_derivatives(int quantity) const;
 
     //! Calculates the Pitzer coefficients' dependence on the temperature.
     /*!
@@ -3107,6 +3111,13 @@ private:
     void calc_lambdas(double is) const;
     mutable doublereal m_last_is;
 
+    //! Derivatives of the activity coefficients which have been requested,
+    //! using the flags of s_updatePitzer_lnMolalityActCoeff()
+    mutable int m_pitzerDerivs;
+
+    //! Quantities evaluated for the current state
+    mutable int m_pitzerCurrent;
+
     /**
      *  Calculate etheta and etheta_prime
      *
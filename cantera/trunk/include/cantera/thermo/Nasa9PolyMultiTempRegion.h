@@ -161,6 +161,9 @@ public:
      */
     virtual void modifyParameters(doublereal* coeffs);
 
+    //! Needs access to #m_regionPts to pack the coefficients of each region
+    friend class GeneralSpeciesThermo;
+
 protected:
     //! Number of temperature regions
     size_t m_numTempRegions;
@@ -226,6 +226,9 @@ public:
 
     void validate(const std::string& name);
 
+    //! Needs access to #mnp_low and #mnp_high to pack their coefficients
+    friend class GeneralSpeciesThermo;
+
 protected:
     //! Midrange temperature
     doublereal m_midT;
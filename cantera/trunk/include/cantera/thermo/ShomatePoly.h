@@ -509,6 +509,9 @@ public:
         msp_high.modifyOneHf298(k, hnew);
     }
 
+    //! Needs access to #msp_low and #msp_high to pack their coefficients
+    friend class GeneralSpeciesThermo;
+
 protected:
     //! Midrange temperature (kelvin)
     doublereal m_midT;
@@ -13,6 +13,7 @@
 #define WATERPROPSIAPWS_H
 
 #include "WaterPropsIAPWSphi.h"
+#include "cantera/base/ct_defs.h"
 
 namespace Cantera
 {
@@ -275,6 +276,72 @@ public:
      */
     doublereal density_const(doublereal pressure, int phase = -1, doublereal rhoguess = -1.0) const;
 
+    //! @name Tabulation of the Liquid Density
+    //! @{
+
+    //! Interpolate the density of liquid water in a table, for temperatures
+    //! between *Tmin* and *Tmax* and pressures between the saturation
+    //! pressure and *Pmax*.
+    /*!
+     * Finding the density at a given temperature and pressure requires the
+     * iterative solution of the equation of state, which takes many
+     * evaluations of the Helmholtz function. With a table, calls to
+     * density() for the liquid phase instead interpolate the density from
+     * values tabulated on a grid that is evenly spaced in the temperature
+     * and in the pressure above the saturation pressure estimated by
+     * psat_est(). Since the liquid density is tabulated up to the
+     * saturation line, the interpolation remains accurate close to it.
+     * Bicubic interpolation is used, and starting from 9 temperatures and 9
+     * pressures, the spacing in each direction is halved until the
+     * interpolation error at the midpoints between the tabulated values in
+     * that direction is less than *rtol*, relative to the density.
+     *
+     * Each interpolated density is then corrected with one Newton iteration
+     * using the full equation of state, which is evaluated anyway to set
+     * the state. If the correction is larger than *rtol* relative to the
+     * density, the full iteration is used instead. The remaining error of
+     * an accepted density is therefore of the order of *rtol* squared, and
+     * for the default tolerance is comparable to the convergence tolerance
+     * of the full iteration.
+     *
+     * The full iteration is also used for temperatures or pressures outside
+     * of the table, for pressures below the estimated saturation pressure,
+     * where the stable phase may be steam, and when a phase other than
+     * WATER_LIQUID or a density guess below the critical density is given.
+     * *Tmax* must be below the critical temperature. Close to it, the
+     * liquid density varies rapidly with the pressure near the saturation
+     * line, and the table becomes large: with the default tolerance and
+     * pressure range, it has 65 x 65 values for Tmax = 573.15 K, and 257 x
+     * 257 values for Tmax = 623.15 K.
+     *
+     * @param Tmin     Lowest tabulated temperature [K]
+     * @param Tmax     Highest tabulated temperature [K]
+     * @param Pmax     Highest tabulated pressure [Pa]
+     * @param rtol     Relative tolerance for the interpolation error
+     * @param maxSize  Maximum number of tabulated temperatures and of
+     *     tabulated pressures. An exception is thrown if *rtol* cannot be met
+     *     with this many values.
+     */
+    void setDensityTabulation(doublereal Tmin=273.16, doublereal Tmax=573.15,
+                              doublereal Pmax=1.0E8, doublereal rtol=1.0E-6,
+                              size_t maxSize=1025);
+
+    //! Always solve the equation of state for the density, discarding the
+    //! table created by setDensityTabulation().
+    void disableDensityTabulation();
+
+    //! Number of tabulated densities, or 0 if tabulation is disabled.
+    size_t densityTableSize() const {
+        return m_tableDelta.size();
+    }
+
+    //! Largest relative interpolation error found at the midpoints between
+    //! the tabulated values when the table was created.
+    doublereal densityTableError() const {
+        return m_tableError;
+    }
+    //! @}
+
     //! Returns the density (kg m-3)
     /*!
      * The density is an independent variable in the underlying equation of state
@@ -462,6 +529,33 @@ private:
 
     //! Current state of the system
     mutable int iState;
+
+    //! Interpolate the reduced density of the liquid from the table created
+    //! by setDensityTabulation(). Returns -1 if (*temperature*, *pressure*)
+    //! is outside of the table.
+    doublereal interpolateDelta(doublereal temperature,
+                                doublereal pressure) const;
+
+    //! @name Tabulation of the liquid density
+    //!@{
+    bool m_useTable; //!< True if density() uses the table
+    doublereal m_tableTmin; //!< Lowest tabulated temperature
+    doublereal m_tableHT; //!< Spacing of the tabulated temperatures
+    //! Spacing of the tabulated pressures above the saturation pressure
+    doublereal m_tableHP;
+    size_t m_tableNT; //!< Number of tabulated temperatures
+    size_t m_tableNP; //!< Number of tabulated pressures
+    doublereal m_tableRtol; //!< Tolerance for the Newton correction
+    doublereal m_tableError; //!< Interpolation error estimate
+
+    //! Estimated saturation pressures at the tabulated temperatures
+    vector_fp m_tablePsat;
+
+    //! Reduced densities. Element `j*m_tableNP + i` is the value at the
+    //! temperature `m_tableTmin + j*m_tableHT` and the pressure
+    //! `m_tablePsat[j] + i*m_tableHP`.
+    vector_fp m_tableDelta;
+    //!@}
 };
 
 }
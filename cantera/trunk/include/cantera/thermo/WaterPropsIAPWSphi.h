@@ -123,6 +123,23 @@ public:
      */
     doublereal dfind(doublereal p_red, doublereal tau, doublereal deltaGuess);
 
+    //! Take a single, undamped Newton step towards the reduced density at
+    //! which the reduced pressure equals *p_red*.
+    /*!
+     * This is used to correct a close estimate of the density, for which
+     * the damping and the convergence checks done by dfind() are not
+     * needed.
+     *
+     * @param p_red   Value of the dimensionless pressure
+     * @param tau     Dimensionless temperature = T_c/T
+     * @param delta   Estimate of the dimensionless density
+     *
+     * @return
+     *   Returns the updated dimensionless density, or -1 if the pressure
+     *   does not increase with the density at *delta*.
+     */
+    doublereal dfindStep(doublereal p_red, doublereal tau, doublereal delta);
+
     //! Calculate the dimensionless gibbs free energy
     doublereal gibbs_RT() const;
 
@@ -152,7 +152,29 @@ protected:
     doublereal m_lambda;
 
     // L matrix quantities
+
+    //! The block L00,00 of the L matrix, or its inverse if #m_l0000_inv_ok
     DenseMatrix  m_Lmatrix;
+
+    //! The block L00,10 of the L matrix. L10,00 is its transpose.
+    DenseMatrix m_L0010;
+
+    //! The block L10,10 of the L matrix, which is overwritten by the matrix
+    //! of the reduced system solved in solveLMatrixEquation()
+    DenseMatrix m_L1010;
+
+    //! The product of the inverse of L00,00 and L00,10
+    DenseMatrix m_L0010_solved;
+
+    //! The block L10,01 of the L matrix. L01,10 is its transpose.
+    DenseMatrix m_L1001;
+
+    //! L10,01 with each column divided by the corresponding element of L01,01
+    DenseMatrix m_L1001_scaled;
+
+    //! The diagonal of the block L01,01 of the L matrix
+    vector_fp m_L0101;
+
     SquareMatrix m_aa;
     //DenseMatrix m_Lmatrix;
     vector_fp m_a;
@@ -168,7 +190,9 @@ protected:
 
     //! Boolean indicating viscosity is up to date
     bool m_abc_ok;
-    bool m_l0000_ok;
+
+    //! True if #m_Lmatrix holds the inverse of L00,00 at the current state
+    bool m_l0000_inv_ok;
     bool m_lmatrix_soln_ok;
 
     //! Evaluate the L0000 matrices
@@ -184,15 +208,14 @@ protected:
      */
     void eval_L0010(const doublereal* const x);
 
-    //! Evaluate the L1000 matrices
-    void eval_L1000();
-
-    void eval_L0100();
-    void eval_L0001();
     void eval_L1010(const doublereal* x);
     void eval_L1001(const doublereal* x);
-    void eval_L0110();
     void eval_L0101(const doublereal* x);
+
+    //! Evaluate L00,00 at the current state and replace #m_Lmatrix with its
+    //! inverse, unless this has already been done
+    void invert_L0000();
+
     bool hasInternalModes(size_t j);
 
     doublereal pressure_ig() {
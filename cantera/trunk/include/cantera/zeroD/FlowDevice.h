@@ -8,6 +8,7 @@
 #define CT_FLOWDEVICE_H
 
 #include "cantera/base/ct_defs.h"
+#include "cantera/base/ctexceptions.h"
 #include "cantera/base/global.h"
 #include "cantera/base/stringUtils.h"
 
@@ -34,6 +35,13 @@ public:
 
     virtual ~FlowDevice() {}
 
+    //! Create a new flow device of the same type and with the same
+    //! parameters as this one, which is not installed between any reactors.
+    //! The function set by setFunction() is shared with this flow device.
+    virtual FlowDevice* duplMyselfAsFlowDevice() const {
+        throw NotImplementedError("FlowDevice::duplMyselfAsFlowDevice");
+    }
+
     //! Return an integer indicating the type of flow device
     int type() {
         return m_type;
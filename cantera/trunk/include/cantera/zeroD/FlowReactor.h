@@ -31,6 +31,8 @@ public:
     virtual void evalEqs(doublereal t, doublereal* y,
                          doublereal* ydot, doublereal* params);
     virtual void updateState(doublereal* y);
+    virtual bool getMultiplierDerivativeProducts(doublereal t,
+            const doublereal* lambda, doublereal* prod);
 
     void setMassFlowRate(doublereal mdot) {
         m_rho0 = m_thermo->density();
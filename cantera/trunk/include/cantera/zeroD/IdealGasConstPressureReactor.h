@@ -40,6 +40,18 @@ public:
 
     virtual void updateState(doublereal* y);
 
+    //! Evaluate the Jacobian of the governing equations.
+    /*!
+     * As for IdealGasReactor::getJacobian, the derivatives of the species
+     * production rates are evaluated analytically, and the heat transfer
+     * rate and mass flow rates are treated as independent of the state of
+     * the reactor. Returns `false` for reactors with surface chemistry.
+     */
+    virtual bool getJacobian(doublereal t, doublereal* params, Array2D& J);
+
+    virtual bool getMultiplierDerivativeProducts(doublereal t,
+            const doublereal* lambda, doublereal* prod);
+
     //! Return the index in the solution vector for this reactor of the
     //! component named *nm*. Possible values for *nm* are "m", "T", the name
     //! of a homogeneous phase species, or the name of a surface species.
@@ -47,6 +59,7 @@ public:
 
 protected:
     vector_fp m_hk; //!< Species molar enthalpies
+    vector_fp m_cpk; //!< Species molar heat capacities at constant pressure
 };
 }
 
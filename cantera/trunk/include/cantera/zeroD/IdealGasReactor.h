@@ -38,10 +38,25 @@ public:
 
     virtual void updateState(doublereal* y);
 
+    //! Evaluate the Jacobian of the governing equations.
+    /*!
+     * The derivatives of the species production rates are evaluated
+     * analytically by Kinetics::getNetProductionRates_ddC and
+     * Kinetics::getNetProductionRates_ddT. The rates of volume change and
+     * heat transfer from walls and the mass flow rates of inlets and outlets
+     * are treated as independent of the state of the reactor. Returns
+     * `false` for reactors with surface chemistry, which is not included.
+     */
+    virtual bool getJacobian(doublereal t, doublereal* params, Array2D& J);
+
+    virtual bool getMultiplierDerivativeProducts(doublereal t,
+            const doublereal* lambda, doublereal* prod);
+
     virtual size_t componentIndex(const std::string& nm) const;
 
 protected:
     vector_fp m_uk; //!< Species molar internal energies
+    vector_fp m_cvk; //!< Species molar heat capacities at constant volume
 };
 
 }
@@ -9,6 +9,7 @@
 
 #include "ReactorBase.h"
 #include "cantera/kinetics/Kinetics.h"
+#include "cantera/base/Array.h"
 
 namespace Cantera
 {
@@ -75,6 +76,18 @@ public:
         m_chem = true;
     }
 
+    //! Returns `true` if changes in the reactor composition due to chemical
+    //! reactions are enabled.
+    bool chemistryEnabled() const {
+        return m_chem;
+    }
+
+    //! Return a pointer to the kinetics manager for the reactor contents, or
+    //! NULL if no kinetics manager has been set.
+    Kinetics* kineticsMgr() {
+        return m_kin;
+    }
+
     //! Set the energy equation on or off.
     void setEnergy(int eflag = 1) {
         if (eflag > 0) {
@@ -146,6 +159,90 @@ public:
     //! name of a homogeneous phase species, or the name of a surface species.
     virtual size_t componentIndex(const std::string& nm) const;
 
+    //! Get the sparsity pattern of the Jacobian of the governing equations
+    //! for this reactor, in compressed sparse column (CSC) form.
+    /*!
+     * The equations for the homogeneous phase species are coupled as given
+     * by Kinetics::getProductionRateSparsity, while all other equations and
+     * state variables (e.g. mass, volume, energy and surface species) are
+     * treated as being coupled to every component. Couplings which arise
+     * only through the dependence of the temperature on the composition are
+     * neglected, so the pattern is suitable for forming an approximate
+     * Jacobian, e.g. to precondition an iterative linear solver.
+     *
+     * @param[out] colStart  Offset in *rowIndex* of the first element of
+     *     each column. Length neq() + 1.
+     * @param[out] rowIndex  Row indices of the nonzero elements
+     */
+    virtual void getJacobianSparsity(std::vector<size_t>& colStart,
+                                     std::vector<size_t>& rowIndex);
+
+    //! Evaluate the Jacobian of the governing equations for this reactor with
+    //! respect to its own state variables.
+    /*!
+     * Called by ReactorNet::getJacobian after the state of the reactor has
+     * been set with updateState(). The base class does not provide a
+     * Jacobian, and returns `false`.
+     *
+     * @param[in] t time.
+     * @param[in] params sensitivity parameter vector, as for evalEqs()
+     * @param[out] J Jacobian matrix, neq() by neq(), where `J(i,j)` is the
+     *     derivative of the rate of change of state variable *i* with
+     *     respect to state variable *j*.
+     * @return `true` if the Jacobian was evaluated.
+     */
+    virtual bool getJacobian(doublereal t, doublereal* params, Array2D& J) {
+        return false;
+    }
+
+    //! Number of reactions in the homogeneous phase. The rate multiplier of
+    //! each reaction is a parameter for the adjoint sensitivity analysis
+    //! done by ReactorNet::advanceAdjoint.
+    size_t nReactions() const {
+        return m_kin ? m_kin->nReactions() : 0;
+    }
+
+    //! Evaluate the products of the vector *lambda* with the derivatives of
+    //! the governing equations with respect to the rate multiplier of each
+    //! reaction in the homogeneous phase.
+    /*!
+     * Called by ReactorNet::advanceAdjoint after the state of the reactor has
+     * been set with updateState(). The multipliers affect the governing
+     * equations only through the species production rates, which appear in
+     * the species equations of all the reactor types derived from this
+     * class. Derived classes which use other formulations should override
+     * this method, e.g. to return `false`, in which case the derivatives
+     * are computed by getMultiplierDerivatives() instead.
+     *
+     * @param[in] t time.
+     * @param[in] lambda vector of length neq()
+     * @param[out] prod `prod[i]` is the product of *lambda* with the
+     *     derivative of the rate of change of the state vector with respect
+     *     to the logarithm of the multiplier of reaction *i*. Length
+     *     nReactions().
+     * @return `true` if the products were evaluated.
+     */
+    virtual bool getMultiplierDerivativeProducts(doublereal t,
+            const doublereal* lambda, doublereal* prod);
+
+    //! Evaluate the derivatives of the governing equations with respect to
+    //! the rate multiplier of each reaction in the homogeneous phase, by
+    //! finite differences.
+    /*!
+     * Called by ReactorNet::advanceAdjoint after the state of the reactor has
+     * been set with updateState(), if getMultiplierDerivativeProducts()
+     * returns `false`.
+     *
+     * @param[in] t time.
+     * @param[in] y solution vector, as for evalEqs()
+     * @param[in] params sensitivity parameter vector, as for evalEqs()
+     * @param[out] dfdp neq() by nReactions(), where `dfdp(j,i)` is the
+     *     derivative of the rate of change of state variable *j* with
+     *     respect to the logarithm of the multiplier of reaction *i*.
+     */
+    void getMultiplierDerivatives(doublereal t, doublereal* y,
+                                  doublereal* params, Array2D& dfdp);
+
 protected:
     //! Set reaction rate multipliers based on the sensitivity variables in
     //! *params*.
@@ -177,6 +274,13 @@ protected:
     //! Get initial conditions for SurfPhase objects attached to this reactor
     virtual void getSurfaceInitialConditions(double* y);
 
+    //! Evaluate `prod[i] = sum_k w[k] * d(wdot_k)/d(ln m_i)`, where `m_i` is
+    //! the rate multiplier of reaction *i*, given the derivatives *w* of a
+    //! product of a vector with the governing equations with respect to
+    //! the species production rates. Used to implement
+    //! getMultiplierDerivativeProducts().
+    void multiplierProducts(const doublereal* w, doublereal* prod);
+
     //! Pointer to the homogeneous Kinetics object that handles the reactions
     Kinetics*   m_kin;
 
@@ -189,6 +293,15 @@ protected:
     vector_fp m_sdot;
 
     vector_fp m_wdot; //!< Species net molar production rates
+
+    //! Derivatives of #m_wdot with respect to the species concentrations, in
+    //! column-major order. Used by derived classes which evaluate the
+    //! Jacobian.
+    vector_fp m_dwdot_dC;
+
+    //! Derivatives of #m_wdot with respect to temperature
+    vector_fp m_dwdot_dT;
+
     vector_fp m_uk; //!< Species molar internal energies
     bool m_chem;
     bool m_energy;
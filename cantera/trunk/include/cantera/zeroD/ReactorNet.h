@@ -14,6 +14,8 @@
 namespace Cantera
 {
 
+class ReactorNetAdjoint;
+
 //! A class representing a network of connected reactors.
 /*!
  *  This class is used to integrate the time-dependent governing equations for
@@ -45,6 +47,11 @@ public:
         m_init = false;
     }
 
+    //! The maximum time step, or a negative value if it has not been set
+    double maxTimeStep() const {
+        return m_maxstep;
+    }
+
     //! Set the maximum number of error test failures permitted by the CVODES
     //! integrator in a single time step.
     void setMaxErrTestFails(int nmax) {
@@ -52,6 +59,45 @@ public:
         m_init = false;
     }
 
+    //! The maximum number of error test failures in a single time step, or
+    //! zero to use the integrator's default
+    int maxErrTestFails() const {
+        return m_maxErrTestFails;
+    }
+
+    //! Set the method used to solve the linear systems arising in the
+    //! Newton iterations of the integrator.
+    /*!
+     * @param type  One of:
+     *   - "DENSE" (default): direct solution using a dense, finite
+     *     difference Jacobian.
+     *   - "DENSE_ANALYTIC": direct solution using a dense Jacobian
+     *     assembled from the Jacobians of the individual reactors (see
+     *     getJacobian). If any reactor does not provide its Jacobian, a
+     *     finite difference Jacobian is used instead. Only available if
+     *     Cantera is built without Sundials.
+     *   - "GMRES": Krylov iterative solution without preconditioning.
+     *   - "ILU_GMRES": Krylov iterative solution, preconditioned by an
+     *     incomplete LU factorization of a sparse approximation to the
+     *     Jacobian. The sparsity pattern is based on the reaction
+     *     stoichiometry (see getJacobianSparsity), which makes this method
+     *     much faster than "DENSE" for mechanisms with many species. Only
+     *     available if Cantera is built without Sundials.
+     *   - "BLOCK_JACOBI_GMRES": Krylov iterative solution, preconditioned by
+     *     the diagonal blocks of the Jacobian corresponding to each reactor
+     *     (see BlockJacobi). The cost of the preconditioner grows linearly
+     *     with the number of reactors, which makes this method much faster
+     *     than "DENSE" for networks of many reactors. Only available if
+     *     Cantera is built without Sundials.
+     */
+    void setLinearSolverType(const std::string& type);
+
+    //! The method used to solve the linear systems. See
+    //! setLinearSolverType().
+    const std::string& linearSolverType() const {
+        return m_linearSolverType;
+    }
+
     //! Set the relative and absolute tolerances for the integrator.
     void setTolerances(doublereal rtol, doublereal atol) {
         if (rtol >= 0.0) {
@@ -130,6 +176,11 @@ public:
         return *m_reactors[n];
     }
 
+    //! Number of reactors in this network
+    size_t nReactors() const {
+        return m_reactors.size();
+    }
+
     //! Returns `true` if verbose logging output is enabled.
     bool verbose() const {
         return m_verbose;
@@ -178,6 +229,76 @@ public:
         return sensitivity(k, p);
     }
 
+    //! Set the number of integrator steps between the checkpoints stored
+    //! during the forward integration by advanceAdjoint().
+    /*!
+     * The solution between two checkpoints is recomputed and stored at
+     * every time step when it is needed for the backward integration of the
+     * adjoint equations. The memory required is proportional to the number
+     * of checkpoints plus twice *nsteps*, and the extra work for the
+     * recomputation is about one forward integration. The default is 100.
+     */
+    void setAdjointCheckpointInterval(size_t nsteps) {
+        m_adjointInterval = std::max<size_t>(nsteps, 1);
+    }
+
+    //! The number of parameters for the adjoint sensitivity analysis done by
+    //! advanceAdjoint(). These are the rate multipliers of every reaction in
+    //! each reactor, for each reactor in the order in which the reactors
+    //! were added to the network (see Reactor::nReactions).
+    size_t nAdjointParams();
+
+    //! Advance the state of all reactors to *time*, and compute the
+    //! sensitivities of a scalar function *g* of the final state with
+    //! respect to all the reaction rate multipliers, using the adjoint
+    //! method.
+    /*!
+     *  The sensitivities are found by integrating the adjoint equations
+     *  \f[ \frac{d\lambda}{dt} = -J^T \lambda, \qquad
+     *      \lambda(t_f) = \frac{\partial g}{\partial y}(t_f) \f]
+     *  backward in time, where \f$ J \f$ is the Jacobian of the governing
+     *  equations \f$ \dot{y} = f(y, p) \f$, together with the quadratures
+     *  \f[ \frac{dg}{d \ln p_i} = \int_{t_0}^{t_f} \lambda^T
+     *      \frac{\partial f}{\partial \ln p_i} dt \f]
+     *  for all the parameters at once. The cost is therefore independent of
+     *  the number of parameters, unlike the forward sensitivity analysis
+     *  done for the parameters added with Reactor::addSensitivityReaction.
+     *
+     *  The state of the network is stored at checkpoints during the forward
+     *  integration (see setAdjointCheckpointInterval), and the adjoint
+     *  equations are integrated with the tolerances set by
+     *  setSensitivityTolerances. If the network consists of a single
+     *  reactor without walls or flow devices, the Jacobian is given by
+     *  Reactor::getJacobian where it is available. Otherwise, the Jacobian
+     *  is computed by finite differences.
+     *
+     *  @param time   Time to advance to (s).
+     *  @param dgdy   Derivatives of *g* with respect to the components of
+     *      the global state vector at *time*. Length neq().
+     *  @param[out] sens  Derivatives of *g* with respect to the logarithm
+     *      of each rate multiplier. Length nAdjointParams().
+     */
+    void advanceAdjoint(doublereal time, const doublereal* dgdy,
+                        doublereal* sens);
+
+    //! Advance the state of all reactors to *time*, and compute the
+    //! normalized sensitivities of the component named *component* of the
+    //! final state with respect to all the reaction rate multipliers.
+    /*!
+     *  The sensitivities are defined as for sensitivity(size_t, size_t),
+     *  and are computed as described for advanceAdjoint(doublereal,
+     *  const doublereal*, doublereal*).
+     *
+     *  @param time   Time to advance to (s).
+     *  @param component  Name of the component, as for
+     *      globalComponentIndex()
+     *  @param[out] sens  Sensitivities with respect to each rate multiplier.
+     *      Length nAdjointParams().
+     *  @param reactor  Index of the reactor
+     */
+    void advanceAdjoint(doublereal time, const std::string& component,
+                        doublereal* sens, size_t reactor=0);
+
     //! Evaluate the Jacobian matrix for the reactor network.
     /*!
      *  @param[in] t Time at which to evaluate the Jacobian
@@ -201,6 +322,36 @@ public:
         return m_ntotpar;
     }
 
+    //! Evaluate the Jacobian of the reactor network from the Jacobians of
+    //! the individual reactors.
+    /*!
+     * The diagonal block for each reactor is given by Reactor::getJacobian.
+     * Couplings between reactors through walls and flow devices are not
+     * included, so for networks of more than one reactor the result is an
+     * approximation which is suitable for use by the integrator. Returns
+     * `false` if any reactor does not provide its Jacobian.
+     */
+    virtual bool getJacobian(doublereal t, doublereal* y, doublereal* ydot,
+                             doublereal* p, Array2D& J);
+
+    //! Get the sparsity pattern of the Jacobian for the reactor network.
+    /*!
+     * The pattern is block diagonal, with each block given by
+     * Reactor::getJacobianSparsity. Couplings between reactors through
+     * walls and flow devices are not included.
+     */
+    virtual void getJacobianSparsity(std::vector<size_t>& colStart,
+                                     std::vector<size_t>& rowIndex);
+
+    //! Get the partitioning of the state vector into blocks, one for each
+    //! reactor.
+    virtual void getJacobianBlocks(std::vector<size_t>& blockStart);
+
+    //! Evaluate the Jacobian of each reactor, using Reactor::getJacobian.
+    //! Returns `false` if any reactor does not provide its Jacobian.
+    virtual bool evalJacobianBlocks(double t, double* y, const double* ydot,
+                                    double* p, std::vector<Array2D>& J);
+
     //! Return the index corresponding to the component named *component* in the
     //! reactor with index *reactor* in the global state vector for the
     //! reactor network.
@@ -251,6 +402,9 @@ protected:
     doublereal m_atols, m_atolsens;
     doublereal m_maxstep;
     int m_maxErrTestFails;
+
+    //! Linear solver type. See setLinearSolverType().
+    std::string m_linearSolverType;
     bool m_verbose;
     size_t m_ntotpar;
     std::vector<size_t> m_nparams;
@@ -269,6 +423,14 @@ protected:
 
     vector_fp m_ydot;
 
+    //! Work space for the Jacobian of a single reactor
+    Array2D m_jacWork;
+
+    //! Number of integrator steps between the checkpoints stored by
+    //! advanceAdjoint()
+    size_t m_adjointInterval;
+    friend class ReactorNetAdjoint;
+
     std::vector<bool> m_iown;
 };
 }
@@ -0,0 +1,236 @@
+/**
+ *  @file ReactorNetEnsemble.h
+ *  Integration of many copies of a reactor network with different initial
+ *  conditions (see class
+ *  \link Cantera::ReactorNetEnsemble ReactorNetEnsemble\endlink).
+ */
+
+#ifndef CT_REACTORNET_ENSEMBLE_H
+#define CT_REACTORNET_ENSEMBLE_H
+
+#include "ReactorNet.h"
+#include "cantera/base/ct_thread.h"
+
+namespace Cantera
+{
+
+class Wall;
+class FlowDevice;
+
+//! Integrates copies of a reactor network for a set of initial conditions.
+/*!
+ * Parameter sweeps, such as the computation of ignition delays for all of
+ * the conditions in a database of shock tube experiments, require
+ * integrating the same reactor network many times with different initial
+ * states. This class creates a private copy of a "template" network for each
+ * case, consisting of new ThermoPhase and Kinetics objects constructed from
+ * the XML input data of the phases in the template network, new reactors and
+ * reservoirs of the same types, and copies of all walls and flow devices.
+ * The tolerances, linear solver type, maximum time step and maximum number
+ * of error test failures of the template network, and the reaction rate
+ * multipliers of its kinetics managers, are applied to each copy. The cases
+ * are then integrated independently.
+ *
+ * If Cantera is compiled with thread safety enabled (see \ref threadSafety),
+ * the cases are distributed dynamically over a pool of threads: each thread
+ * holds its own copies of the phases and kinetics managers, and takes the
+ * next unstarted case whenever it finishes one. Otherwise, the cases are
+ * integrated sequentially by the calling thread.
+ *
+ * For each case, the ensemble records the ignition delay, defined as the
+ * time of the maximum rate of temperature rise of one of the reactors, and
+ * optionally the solution vector after each time step.
+ *
+ * The template network must not be modified or integrated while run() is
+ * executing. Sensitivity parameters, FlowReactor objects, and walls with
+ * surface reactions are not supported.
+ *
+ * Example:
+ * @code
+ * IdealGasMix gas("gri30.xml", "gri30");
+ * IdealGasReactor r;
+ * r.insert(gas);
+ * ReactorNet net;
+ * net.addReactor(r);
+ * ReactorNetEnsemble ensemble(net);
+ * for (int i = 0; i < 100; i++) {
+ *     ensemble.addCase(1000.0 + 5*i, 20*OneAtm, "CH4:1, O2:2, N2:7.52");
+ * }
+ * ensemble.run(0.1, 4);
+ * double tau = ensemble.ignitionDelay(10);
+ * @endcode
+ *
+ * @ingroup reactor0
+ */
+class ReactorNetEnsemble
+{
+public:
+    //! Constructor.
+    /*!
+     * The structure of *net*, including the reactors connected to it through
+     * walls and flow devices, and the current states of all of its reactors
+     * are recorded by the constructor. The template network should be
+     * completely set up before the ensemble is created.
+     *
+     * @param net  Template reactor network
+     */
+    explicit ReactorNetEnsemble(ReactorNet& net);
+
+    virtual ~ReactorNetEnsemble();
+
+    //! Add a case.
+    /*!
+     * The initial state of the contents of reactor *reactor* in the copy of
+     * the network used for this case is set to (*T*, *P*, *X*). All other
+     * reactors start at the same state as in the template network.
+     *
+     * @param T        Initial temperature [K]
+     * @param P        Initial pressure [Pa]
+     * @param X        Initial mole fractions, e.g. "CH4:1.0, O2:2.0"
+     * @param reactor  Index of the reactor in the template network
+     * @returns the index of the new case
+     */
+    size_t addCase(double T, double P, const std::string& X,
+                   size_t reactor=0);
+
+    //! Number of cases
+    size_t nCases() const {
+        return m_cases.size();
+    }
+
+    //! Set the index (in the template network) of the reactor used to
+    //! determine the ignition delay. The default is reactor 0.
+    void setIgnitionReactor(size_t reactor);
+
+    //! Enable or disable storing the solution after each time step. Disabled
+    //! by default.
+    void setSaveHistory(bool save=true) {
+        m_saveHistory = save;
+    }
+
+    //! Integrate all cases from time zero to *tEnd*.
+    /*!
+     * @param tEnd      End time [s]
+     * @param nThreads  Number of threads. If zero, one thread is started for
+     *     each processor. Ignored if Cantera is not compiled with thread
+     *     safety enabled.
+     */
+    void run(double tEnd, size_t nThreads=1);
+
+    //! Ignition delay [s] for case *icase*, i.e. the time of the maximum rate
+    //! of temperature rise of the ignition reactor. NaN if the integration
+    //! of this case failed.
+    double ignitionDelay(size_t icase) const;
+
+    //! Temperature [K] of the ignition reactor at the end of case *icase*
+    double finalTemperature(size_t icase) const;
+
+    //! Number of equations in the reactor network
+    size_t neq() const {
+        return m_neq;
+    }
+
+    //! Times at which the solution of case *icase* was stored. Empty unless
+    //! setSaveHistory() has been called.
+    const vector_fp& times(size_t icase) const;
+
+    //! Solution vectors for case *icase*. The *k*-th component of the
+    //! solution at time `times(icase)[n]` is element `n*neq() + k`. Use
+    //! ReactorNet::globalComponentIndex() of the template network to find
+    //! the index of a particular component.
+    const vector_fp& solution(size_t icase) const;
+
+    //! Error message for case *icase*, or an empty string if the
+    //! integration was successful.
+    const std::string& error(size_t icase) const;
+
+protected:
+    class Worker;
+    friend class Worker;
+
+    //! Check that *icase* is a valid case index
+    void checkCaseIndex(size_t icase) const;
+
+    //! Add the reactor *r* and everything connected to it to the template
+    //! description, if it has not already been added.
+    void addTemplateReactor(ReactorBase* r);
+
+    //! Add the phase *ph* to the template description if it has not already
+    //! been added, and return its index.
+    size_t addTemplatePhase(thermo_t* ph);
+
+    //! Take the next unstarted case. Returns npos if there are no cases left.
+    size_t nextCase();
+
+    //! Initial conditions for one case
+    struct Case {
+        double T;
+        double P;
+        std::string X;
+        size_t reactor;
+    };
+
+    std::vector<Case> m_cases;
+
+    //! @name Template network
+    //! @{
+
+    ReactorNet* m_net;
+
+    //! Phases, including all phases of the kinetics managers
+    std::vector<thermo_t*> m_phases;
+
+    //! Kinetics managers
+    std::vector<Kinetics*> m_kinetics;
+
+    //! Indices in #m_phases of the phases of each kinetics manager
+    std::vector<std::vector<size_t> > m_kinPhases;
+
+    //! Reactors and reservoirs. The reactors in the template network come
+    //! first, in the same order.
+    std::vector<ReactorBase*> m_reactors;
+
+    //! Index in #m_phases of the contents of each reactor
+    std::vector<size_t> m_reactorPhase;
+
+    //! Index in #m_kinetics of the kinetics manager of each reactor, or npos
+    std::vector<size_t> m_reactorKin;
+
+    //! Initial state of the contents of each reactor
+    std::vector<vector_fp> m_reactorState;
+
+    //! Walls and the indices in #m_reactors of the reactors on each side
+    std::vector<Wall*> m_walls;
+    std::vector<std::pair<size_t, size_t> > m_wallReactors;
+
+    //! Flow devices and the indices in #m_reactors of the upstream and
+    //! downstream reactors
+    std::vector<FlowDevice*> m_devices;
+    std::vector<std::pair<size_t, size_t> > m_deviceReactors;
+
+    //! @}
+
+    size_t m_ignitionReactor;
+    bool m_saveHistory;
+    double m_tEnd;
+    size_t m_neq;
+
+    //! Index of the next case to be started by run()
+    size_t m_next;
+
+    //! Lock for #m_next
+    mutex_t m_next_mutex;
+
+    //! @name Results for each case
+    //! @{
+    vector_fp m_tau;
+    vector_fp m_Tfinal;
+    std::vector<vector_fp> m_times;
+    std::vector<vector_fp> m_solution;
+    std::vector<std::string> m_error;
+    //! @}
+};
+
+}
+
+#endif
@@ -31,6 +31,12 @@ public:
 
     virtual ~Wall() {}
 
+    //! Create a new wall with the same parameters as this one, which is not
+    //! installed between any reactors. The functions of time specifying the
+    //! velocity and heat flux are shared with this wall. Walls with surface
+    //! reactions can not be duplicated.
+    virtual Wall* duplMyselfAsWall() const;
+
     //! Rate of volume change (m^3/s) for the adjacent reactors.
     /*! The volume rate of change is given by
      * \f[ \dot V = K A (P_{left} - P_{right}) + F(t) \f]
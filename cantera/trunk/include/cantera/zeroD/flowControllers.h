@@ -26,6 +26,14 @@ public:
         m_type = MFC_Type;
     }
 
+    virtual FlowDevice* duplMyselfAsFlowDevice() const {
+        MassFlowController* f = new MassFlowController();
+        f->m_mdot = m_mdot;
+        f->m_func = m_func;
+        f->m_coeffs = m_coeffs;
+        return f;
+    }
+
     virtual bool ready() {
         return FlowDevice::ready() && m_mdot >= 0.0;
     }
@@ -53,6 +61,17 @@ public:
         m_type = PressureController_Type;
     }
 
+    //! The master flow controller of the copy is the same as that of this
+    //! flow controller, and should be replaced using setMaster().
+    virtual FlowDevice* duplMyselfAsFlowDevice() const {
+        PressureController* f = new PressureController();
+        f->m_mdot = m_mdot;
+        f->m_func = m_func;
+        f->m_coeffs = m_coeffs;
+        f->m_master = m_master;
+        return f;
+    }
+
     virtual bool ready() {
         return FlowDevice::ready() && m_master != 0;
     }
@@ -61,6 +80,10 @@ public:
         m_master = master;
     }
 
+    FlowDevice* master() const {
+        return m_master;
+    }
+
     virtual void updateMassFlowRate(doublereal time) {
         doublereal master_mdot = m_master->massFlowRate(time);
         m_mdot = master_mdot + m_coeffs[0]*(in().pressure() -
@@ -85,6 +108,14 @@ public:
         m_type = Valve_Type;
     }
 
+    virtual FlowDevice* duplMyselfAsFlowDevice() const {
+        Valve* f = new Valve();
+        f->m_mdot = m_mdot;
+        f->m_func = m_func;
+        f->m_coeffs = m_coeffs;
+        return f;
+    }
+
     virtual bool ready() {
         return FlowDevice::ready() && m_coeffs.size() >= 1;
     }
@@ -341,6 +341,7 @@ cdef extern from "cantera/zeroD/ReactorNet.h":
         double atol()
         void setMaxTimeStep(double)
         void setMaxErrTestFails(int)
+        void setLinearSolverType(string) except +
         cbool verbose()
         void setVerbose(cbool)
         size_t neq()
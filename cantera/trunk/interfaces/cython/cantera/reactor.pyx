@@ -801,6 +801,23 @@ cdef class ReactorNet:
         def __set__(self, n):
             self.net.setMaxErrTestFails(n)
 
+    property linear_solver_type:
+        """
+        The method used to solve the linear systems in the Newton iterations
+        of the integrator. One of ``'DENSE'`` (default), ``'GMRES'``,
+        ``'ILU_GMRES'``, which uses GMRES preconditioned with an incomplete LU
+        factorization of a sparse Jacobian based on the reaction
+        stoichiometry, and is much faster for mechanisms with many species,
+        ``'BLOCK_JACOBI_GMRES'``, which uses GMRES preconditioned with the
+        Jacobian of each reactor, and is much faster for networks with many
+        reactors, or ``'DENSE_ANALYTIC'``, which uses a dense direct solver
+        with an analytic Jacobian for networks of ideal gas reactors without
+        surface chemistry. The preconditioned and analytic options are only
+        available if Cantera is built without Sundials.
+        """
+        def __set__(self, solver_type):
+            self.net.setLinearSolverType(stringify(solver_type))
+
     property rtol:
         """
         The relative error tolerance used while integrating the reactor
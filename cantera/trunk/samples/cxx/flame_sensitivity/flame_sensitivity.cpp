@@ -0,0 +1,186 @@
+/////////////////////////////////////////////////////////////
+//
+//  Sensitivities of the laminar flame speed of a hydrogen/oxygen/argon
+//  flame to the rate constants of all reactions, computed with the adjoint
+//  method of Sim1D::getReactionSensitivities(). For the most sensitive reactions,
+//  the results are compared with central differences obtained by solving
+//  the flame again with perturbed rate constants, and the time taken by
+//  both methods is printed.
+//
+//  usage: flame_sensitivity [phi] [ncompare]
+//
+/////////////////////////////////////////////////////////////
+
+#include "cantera/oneD/Sim1D.h"
+#include "cantera/oneD/Inlet1D.h"
+#include "cantera/oneD/StFlow.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/transport.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+using namespace Cantera;
+
+//! Wall clock time in seconds
+double wallTime()
+{
+#ifdef _WIN32
+    return 0.001 * GetTickCount();
+#else
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + 1e-6 * t.tv_usec;
+#endif
+}
+
+//! Sort reaction indices by decreasing magnitude of the sensitivity
+struct BySensitivity {
+    BySensitivity(const vector_fp& s) : sens(s) {}
+    bool operator()(size_t i, size_t j) const {
+        return std::abs(sens[i]) > std::abs(sens[j]);
+    }
+    const vector_fp& sens;
+};
+
+int main(int argc, char** argv)
+{
+    double phi = (argc > 1) ? atof(argv[1]) : 0.55;
+    size_t ncompare = (argc > 2) ? atoi(argv[2]) : 5;
+
+    try {
+        IdealGasMix gas("h2o2.xml", "ohmech");
+        double T0 = 300.0;
+        vector_fp x(gas.nSpecies(), 0.0);
+        x[gas.speciesIndex("H2")] = 2.0 * phi;
+        x[gas.speciesIndex("O2")] = 1.0;
+        x[gas.speciesIndex("AR")] = 5.0;
+        gas.setState_TPX(T0, OneAtm, &x[0]);
+        double rho_in = gas.density();
+        vector_fp yin(gas.nSpecies()), yout(gas.nSpecies());
+        gas.getMassFractions(&yin[0]);
+        gas.equilibrate("HP");
+        gas.getMassFractions(&yout[0]);
+        double rho_out = gas.density();
+        double Tad = gas.temperature();
+
+        FreeFlame flow(&gas);
+        vector_fp z(6);
+        for (size_t i = 0; i < 5; i++) {
+            z[i] = 0.0075 * i;
+        }
+        z[5] = 0.0315;
+        flow.setupGrid(6, &z[0]);
+        Transport* tr = newTransportMgr("Mix", &gas);
+        flow.setTransport(*tr);
+        flow.setKinetics(gas);
+        flow.setPressure(OneAtm);
+
+        Inlet1D inlet;
+        double mdot = 0.3 * rho_in;
+        inlet.setMdot(mdot);
+        inlet.setTemperature(T0);
+        Outlet1D outlet;
+
+        std::vector<Domain1D*> domains;
+        domains.push_back(&inlet);
+        domains.push_back(&flow);
+        domains.push_back(&outlet);
+        Sim1D flame(domains);
+        // the inlet composition can only be set once the flow is attached
+        inlet.setMoleFractions(&x[0]);
+
+        vector_fp locs(3), value(3);
+        locs[0] = 0.0;
+        locs[1] = 0.7;
+        locs[2] = 1.0;
+        value[0] = mdot / rho_in;
+        value[1] = value[2] = mdot / rho_out;
+        flame.setInitialGuess("u", locs, value);
+        value[0] = T0;
+        value[1] = value[2] = Tad;
+        flame.setInitialGuess("T", locs, value);
+        for (size_t k = 0; k < gas.nSpecies(); k++) {
+            value[0] = yin[k];
+            value[1] = value[2] = yout[k];
+            flame.setInitialGuess(gas.speciesName(k), locs, value);
+        }
+
+        flame.setRefineCriteria(1, 10.0, 0.2, 0.2);
+        flow.fixTemperature();
+        flame.setFixedTemperature(900.0);
+        flame.solve(0, true);
+        flow.solveEnergyEqn();
+        flame.solve(0, true);
+
+        size_t iu = flow.loc() + flow.componentIndex("u");
+        double Su = flame.solution()[iu];
+        printf("phi = %g: flame speed %.5f m/s, %d grid points\n", phi, Su,
+               int(flow.nPoints()));
+
+        // Adjoint sensitivities d(ln Su)/d(ln k_i) for all reactions
+        size_t nr = gas.nReactions();
+        vector_fp dgdx(flame.size(), 0.0), sens(nr);
+        dgdx[iu] = 1.0 / Su;
+        double t0 = wallTime();
+        flame.getReactionSensitivities(gas, &dgdx[0], &sens[0]);
+        double tAdjoint = wallTime() - t0;
+
+        std::vector<size_t> order(nr);
+        for (size_t i = 0; i < nr; i++) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), BySensitivity(sens));
+
+        // Central differences for the most sensitive reactions
+        ncompare = std::min(ncompare, nr);
+        vector_fp x0(flame.solution(), flame.solution() + flame.size());
+        vector_fp brute(ncompare);
+        double dp = 1e-3;
+        t0 = wallTime();
+        for (size_t m = 0; m < ncompare; m++) {
+            size_t i = order[m];
+            gas.setMultiplier(i, 1.0 + dp);
+            flame.solve(0, false);
+            double Su1 = flame.solution()[iu];
+            flame.setSolution(&x0[0]);
+            gas.setMultiplier(i, 1.0 - dp);
+            flame.solve(0, false);
+            double Su2 = flame.solution()[iu];
+            flame.setSolution(&x0[0]);
+            gas.setMultiplier(i, 1.0);
+            brute[m] = (Su1 - Su2) / (2 * dp * Su);
+        }
+        double tBrute = wallTime() - t0;
+
+        printf("\n%-40s %10s %10s\n", "reaction", "adjoint", "re-solve");
+        for (size_t m = 0; m < nr; m++) {
+            size_t i = order[m];
+            if (m < ncompare) {
+                printf("%-40s %10.5f %10.5f\n",
+                       gas.reactionString(i).c_str(), sens[i], brute[m]);
+            } else {
+                printf("%-40s %10.5f\n", gas.reactionString(i).c_str(),
+                       sens[i]);
+            }
+        }
+        printf("\nadjoint, all %d reactions: %8.3f s\n", int(nr), tAdjoint);
+        if (ncompare) {
+            printf("re-solve, per reaction:    %8.3f s\n",
+                   tBrute / ncompare);
+        }
+        delete tr;
+    } catch (CanteraError& err) {
+        printf("%s\n", err.what());
+        return 1;
+    }
+    appdelete();
+    return 0;
+}
@@ -0,0 +1,117 @@
+/////////////////////////////////////////////////////////////
+//
+//  Time the evaluation of the Pitzer activity coefficients in HMWSoln and
+//  of the properties which depend on their temperature and pressure
+//  derivatives:
+//
+//   - the activity coefficients alone
+//   - the partial molar enthalpies (first temperature derivative)
+//   - the partial molar heat capacities (first and second temperature
+//     derivatives)
+//   - the partial molar enthalpies, heat capacities and volumes (all
+//     derivatives)
+//
+//  The molality is changed slightly before each evaluation, so that the
+//  activity coefficients cannot be reused while the standard state
+//  properties, which depend only on temperature and pressure, are not
+//  recomputed. The input files for the HMWSoln test
+//  problems in test_problems/cathermo can be used, e.g.
+//  HMW_graph_CpvT/HMW_NaCl_sp1977_alt.xml or HMW_test_3/HMW_NaCl_tc.xml.
+//
+//  usage: hmw_benchmark [input file] [phase id] [molality] [repetitions]
+//
+/////////////////////////////////////////////////////////////
+
+#include "cantera/thermo/HMWSoln.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+using namespace Cantera;
+
+//! Wall clock time in seconds
+double wallTime()
+{
+#ifdef _WIN32
+    return 0.001 * GetTickCount();
+#else
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + 1e-6 * t.tv_usec;
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    std::string infile = (argc > 1) ? argv[1] : "HMW_NaCl_sp1977_alt.xml";
+    std::string id = (argc > 2) ? argv[2] : "NaCl_electrolyte";
+    double m = (argc > 3) ? atof(argv[3]) : 3.0;
+    int nrep = (argc > 4) ? atoi(argv[4]) : 2000;
+
+    try {
+        HMWSoln brine(infile, id);
+        size_t nsp = brine.nSpecies();
+        vector_fp moll(nsp, 0.0), ac(nsp), h(nsp), cp(nsp), v(nsp);
+        size_t iNa = brine.speciesIndex("Na+");
+        size_t iCl = brine.speciesIndex("Cl-");
+        brine.setState_TP(298.15, OneAtm);
+
+        double t0 = wallTime();
+        for (int n = 0; n < nrep; n++) {
+            moll[iNa] = moll[iCl] = m * (1.0 + 1e-5 * n);
+            brine.setMolalities(&moll[0]);
+            brine.getMolalityActivityCoefficients(&ac[0]);
+        }
+        double tAct = wallTime() - t0;
+
+        t0 = wallTime();
+        for (int n = 0; n < nrep; n++) {
+            moll[iNa] = moll[iCl] = m * (1.0 + 1e-5 * n);
+            brine.setMolalities(&moll[0]);
+            brine.getPartialMolarEnthalpies(&h[0]);
+        }
+        double tEnthalpy = wallTime() - t0;
+
+        t0 = wallTime();
+        for (int n = 0; n < nrep; n++) {
+            moll[iNa] = moll[iCl] = m * (1.0 + 1e-5 * n);
+            brine.setMolalities(&moll[0]);
+            brine.getPartialMolarCp(&cp[0]);
+        }
+        double tCp = wallTime() - t0;
+
+        t0 = wallTime();
+        for (int n = 0; n < nrep; n++) {
+            moll[iNa] = moll[iCl] = m * (1.0 + 1e-5 * n);
+            brine.setMolalities(&moll[0]);
+            brine.getPartialMolarEnthalpies(&h[0]);
+            brine.getPartialMolarCp(&cp[0]);
+            brine.getPartialMolarVolumes(&v[0]);
+        }
+        double tAll = wallTime() - t0;
+
+        printf("%s: %d species, molality %g, %d repetitions\n",
+               infile.c_str(), int(nsp), m, nrep);
+        double scale = 1e6 / nrep;
+        printf("%-40s %10.2f us/state\n", "getMolalityActivityCoefficients",
+               scale * tAct);
+        printf("%-40s %10.2f us/state\n", "getPartialMolarEnthalpies",
+               scale * tEnthalpy);
+        printf("%-40s %10.2f us/state\n", "getPartialMolarCp", scale * tCp);
+        printf("%-40s %10.2f us/state\n", "enthalpies + Cp + volumes",
+               scale * tAll);
+        // print a result so that the loops cannot be optimized away
+        printf("checksum: %g\n", ac[1] + h[0] + cp[nsp-1] + v[0]);
+    } catch (CanteraError& err) {
+        printf("%s\n", err.what());
+        return 1;
+    }
+    appdelete();
+    return 0;
+}
@@ -0,0 +1,151 @@
+/////////////////////////////////////////////////////////////
+//
+//  Time the innermost kernels of a gas-phase mechanism evaluation:
+//
+//   - the Arrhenius rate constants (Rate1<Arrhenius>::update)
+//   - the products of the reactant concentrations (StoichManagerN::multiply)
+//   - the species production rates from the rates of progress
+//     (StoichManagerN::incrementSpecies)
+//   - the species reference-state thermo properties (SpeciesThermo::update)
+//
+//  The Arrhenius rates and the reactant and product stoichiometry are built
+//  from the reactions in the mechanism, so each kernel is timed separately
+//  from the rest of the kinetics manager.
+//
+//  usage: kernel_benchmark [mechanism] [phase id] [repetitions]
+//
+/////////////////////////////////////////////////////////////
+
+#include "cantera/IdealGasMix.h"
+#include "cantera/kinetics/Reaction.h"
+#include "cantera/kinetics/StoichManager.h"
+#include "cantera/thermo/SpeciesThermo.h"
+#include "cantera/base/ctml.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+using namespace Cantera;
+
+//! Wall clock time in seconds
+double wallTime()
+{
+#ifdef _WIN32
+    return 0.001 * GetTickCount();
+#else
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + 1e-6 * t.tv_usec;
+#endif
+}
+
+//! Add the species on one side of a reaction to *stoich*.
+void addSide(IdealGasMix& gas, size_t i, const Composition& comp,
+             StoichManagerN& stoich)
+{
+    std::vector<size_t> k;
+    vector_fp order, coeffs;
+    for (Composition::const_iterator iter = comp.begin();
+         iter != comp.end(); ++iter) {
+        k.push_back(gas.speciesIndex(iter->first));
+        order.push_back(iter->second);
+        coeffs.push_back(iter->second);
+    }
+    stoich.add(i, k, order, coeffs);
+}
+
+int main(int argc, char** argv)
+{
+    std::string mech = (argc > 1) ? argv[1] : "gri30.xml";
+    std::string id = (argc > 2) ? argv[2] : "gri30_mix";
+    int nrep = (argc > 3) ? atoi(argv[3]) : 20000;
+
+    try {
+        IdealGasMix gas(mech, id);
+        size_t nsp = gas.nSpecies();
+
+        Rate1<Arrhenius> rates;
+        StoichManagerN reactants, products;
+        XML_Node* data = get_XML_File(mech)->findByName("reactionData");
+        if (!data) {
+            throw CanteraError("kernel_benchmark", "no reactions in " + mech);
+        }
+        std::vector<XML_Node*> rxns = data->getChildren("reaction");
+        size_t nr = rxns.size();
+        for (size_t i = 0; i < nr; i++) {
+            shared_ptr<Reaction> R = newReaction(*rxns[i]);
+            if (R->reaction_type == ELEMENTARY_RXN ||
+                R->reaction_type == THREE_BODY_RXN) {
+                rates.install(i, dynamic_cast<ElementaryReaction&>(*R).rate);
+            }
+            addSide(gas, i, R->reactants, reactants);
+            addSide(gas, i, R->products, products);
+        }
+
+        vector_fp kf(nr), conc(nsp), ropf(nr), wdot(nsp);
+        vector_fp cp(nsp), h(nsp), s(nsp);
+        for (size_t k = 0; k < nsp; k++) {
+            conc[k] = 1e-3 * (k + 1);
+        }
+        SpeciesThermo& spthermo = gas.speciesThermo();
+        double T0 = 1000.0;
+
+        // Arrhenius rate constants, at a different temperature each time
+        double t0 = wallTime();
+        for (int n = 0; n < nrep; n++) {
+            double T = T0 + 0.01 * n;
+            rates.update(T, log(T), &kf[0]);
+        }
+        double tRates = wallTime() - t0;
+
+        // reactant concentration products
+        t0 = wallTime();
+        for (int n = 0; n < nrep; n++) {
+            ropf = kf;
+            reactants.multiply(&conc[0], &ropf[0]);
+        }
+        double tMultiply = wallTime() - t0;
+
+        // production rates
+        t0 = wallTime();
+        for (int n = 0; n < nrep; n++) {
+            products.incrementSpecies(&ropf[0], &wdot[0]);
+            reactants.decrementSpecies(&ropf[0], &wdot[0]);
+        }
+        double tIncrement = wallTime() - t0;
+
+        // reference-state thermo, at a different temperature each time
+        t0 = wallTime();
+        for (int n = 0; n < nrep; n++) {
+            spthermo.update(T0 + 0.01 * n, &cp[0], &h[0], &s[0]);
+        }
+        double tThermo = wallTime() - t0;
+
+        printf("%s: %d species, %d reactions (%d Arrhenius), "
+               "%d repetitions\n", mech.c_str(), int(nsp), int(nr),
+               int(rates.nReactions()), nrep);
+        double scale = 1e9 / nrep;
+        printf("%-44s %8.2f ns/reaction\n", "Rate1<Arrhenius>::update",
+               scale * tRates / rates.nReactions());
+        printf("%-44s %8.2f ns/reaction\n", "StoichManagerN::multiply",
+               scale * tMultiply / nr);
+        printf("%-44s %8.2f ns/reaction\n",
+               "StoichManagerN::increment/decrementSpecies",
+               scale * tIncrement / nr);
+        printf("%-44s %8.2f ns/species\n", "SpeciesThermo::update",
+               scale * tThermo / nsp);
+        // print a result so that the loops cannot be optimized away
+        printf("checksum: %g\n", kf[0] + ropf[nr-1] + wdot[0] + h[nsp-1]);
+    } catch (CanteraError& err) {
+        printf("%s\n", err.what());
+        return 1;
+    }
+    appdelete();
+    return 0;
+}
@@ -0,0 +1,170 @@
+/////////////////////////////////////////////////////////////
+//
+//  Time the steps of loading a mechanism:
+//
+//   - for a CTI file, converting it using the built-in converter and the
+//     Python ctml_writer module
+//   - parsing the XML file, or the XML produced by the conversion
+//   - looking up each species and reaction in the XML tree, with and without
+//     the index that is built when the tree is locked
+//
+//  usage: load_benchmark [file.cti|file.xml] [repetitions]
+//
+/////////////////////////////////////////////////////////////
+
+#include "cantera/base/ctml.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+using namespace Cantera;
+
+//! Wall clock time in seconds. CPU time would not include the time spent in
+//! the Python subprocess.
+double wallTime()
+{
+#ifdef _WIN32
+    return 0.001 * GetTickCount();
+#else
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + 1e-6 * t.tv_usec;
+#endif
+}
+
+//! Time the conversion of a CTI file. Returns false if the file is not
+//! supported by the built-in converter.
+bool timeConversion(const std::string& file, const std::string& path,
+                    const std::string& text, int nrep)
+{
+    double tNative = 0.0;
+    for (int i = 0; i < nrep; i++) {
+        XML_Node root;
+        double t0 = wallTime();
+        if (!ctml::ct2ctml_native(text, root)) {
+            printf("%s is not supported by the built-in converter\n",
+                   file.c_str());
+            return false;
+        }
+        tNative += wallTime() - t0;
+    }
+
+    double tPython = 0.0;
+    for (int i = 0; i < nrep; i++) {
+        XML_Node root;
+        double t0 = wallTime();
+        std::stringstream xml(ctml::call_ctml_writer(path, true));
+        root.build(xml);
+        tPython += wallTime() - t0;
+    }
+
+    printf("%s: average over %d conversions\n", file.c_str(), nrep);
+    printf("  built-in converter: %10.4f ms\n", 1000 * tNative / nrep);
+    printf("  ctml_writer.py:     %10.4f ms\n", 1000 * tPython / nrep);
+    printf("  speedup:            %10.1f\n", tPython / tNative);
+    return true;
+}
+
+//! Look up every species by name and every reaction by id. Returns the
+//! elapsed time.
+double timeLookups(XML_Node& root, const std::vector<std::string>& species,
+                   const std::vector<std::string>& reactions)
+{
+    double t0 = wallTime();
+    for (size_t k = 0; k < species.size(); k++) {
+        if (!root.findByAttr("name", species[k])) {
+            throw CanteraError("timeLookups", "missing species " + species[k]);
+        }
+    }
+    for (size_t i = 0; i < reactions.size(); i++) {
+        if (!root.findID(reactions[i])) {
+            throw CanteraError("timeLookups", "missing reaction " + reactions[i]);
+        }
+    }
+    return wallTime() - t0;
+}
+
+//! Time parsing of the XML text, and lookups in the resulting tree
+void timeXML(const std::string& xml, int nrep)
+{
+    double tBuild = 0.0;
+    for (int i = 0; i < nrep; i++) {
+        std::stringstream s(xml);
+        XML_Node root;
+        double t0 = wallTime();
+        root.build(s);
+        tBuild += wallTime() - t0;
+    }
+
+    std::stringstream s(xml);
+    XML_Node root;
+    root.build(s);
+    std::vector<std::string> species, reactions;
+    std::vector<XML_Node*> nodes = root.child("ctml").getChildren("speciesData");
+    for (size_t n = 0; n < nodes.size(); n++) {
+        std::vector<XML_Node*> sp = nodes[n]->getChildren("species");
+        for (size_t k = 0; k < sp.size(); k++) {
+            species.push_back(sp[k]->attrib("name"));
+        }
+    }
+    nodes = root.child("ctml").getChildren("reactionData");
+    for (size_t n = 0; n < nodes.size(); n++) {
+        std::vector<XML_Node*> rxns = nodes[n]->getChildren("reaction");
+        for (size_t i = 0; i < rxns.size(); i++) {
+            reactions.push_back(rxns[i]->id());
+        }
+    }
+
+    double tSearch = timeLookups(root, species, reactions);
+    double t0 = wallTime();
+    root.lock();
+    double tIndex = wallTime() - t0;
+    double tIndexed = timeLookups(root, species, reactions);
+    root.unlock();
+
+    printf("XML tree: %d bytes, %d species, %d reactions\n",
+           int(xml.size()), int(species.size()), int(reactions.size()));
+    printf("  parsing:            %10.4f ms\n", 1000 * tBuild / nrep);
+    printf("  lookups, unlocked:  %10.4f ms\n", 1000 * tSearch);
+    printf("  building index:     %10.4f ms\n", 1000 * tIndex);
+    printf("  lookups, locked:    %10.4f ms\n", 1000 * tIndexed);
+}
+
+int main(int argc, char** argv)
+{
+    std::string file = (argc > 1) ? argv[1] : "gri30.cti";
+    int nrep = (argc > 2) ? atoi(argv[2]) : 5;
+
+    try {
+        std::string path = findInputFile(file);
+        std::ifstream f(path.c_str());
+        std::stringstream text;
+        text << f.rdbuf();
+
+        std::string xml = text.str();
+        if (path.rfind(".cti") == path.size() - 4) {
+            if (!timeConversion(file, path, text.str(), nrep)) {
+                return 1;
+            }
+            XML_Node root;
+            ctml::ct2ctml_native(text.str(), root);
+            std::stringstream s;
+            root.write(s);
+            xml = s.str();
+        }
+        timeXML(xml, nrep);
+    } catch (CanteraError& err) {
+        printf("%s\n", err.what());
+        return 1;
+    }
+    appdelete();
+    return 0;
+}
@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////
+//
+//  Accuracy and speed of tabulated reaction rate data
+//
+//  The net production rates of a mixture are evaluated at a sequence of
+//  random temperatures, so that the temperature-dependent parts of the
+//  reaction rates must be updated at every evaluation, with the rates
+//  evaluated directly and interpolated in tables created with several
+//  tolerances.
+//
+//  usage: rate_tabulation [mechanism] [phase id] [evaluations]
+//
+/////////////////////////////////////////////////////////////
+
+#include "cantera/IdealGasMix.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+using namespace Cantera;
+
+//! Wall clock time in seconds
+double wallTime()
+{
+#ifdef _WIN32
+    return 0.001 * GetTickCount();
+#else
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + 1e-6 * t.tv_usec;
+#endif
+}
+
+//! Evaluate the net production rates at each temperature, storing the
+//! results in *wdot*. Returns the elapsed time.
+double evaluate(IdealGasMix& gas, const vector_fp& T, vector_fp& wdot)
+{
+    size_t nsp = gas.nSpecies();
+    wdot.resize(T.size() * nsp);
+    double t0 = wallTime();
+    for (size_t n = 0; n < T.size(); n++) {
+        gas.setState_TP(T[n], OneAtm);
+        gas.getNetProductionRates(&wdot[n * nsp]);
+    }
+    return wallTime() - t0;
+}
+
+int main(int argc, char** argv)
+{
+    std::string mech = (argc > 1) ? argv[1] : "gri30.xml";
+    std::string id = (argc > 2) ? argv[2] : "gri30_mix";
+    size_t neval = (argc > 3) ? atoi(argv[3]) : 20000;
+    double Tmin = 300.0, Tmax = 3000.0;
+
+    try {
+        IdealGasMix gas(mech, id);
+        gas.setState_TPX(1000.0, OneAtm,
+                         "CH4:1, O2:2, N2:7.52, H2:0.1, OH:0.01, H:0.01, "
+                         "O:0.01, CO:0.1, H2O:0.1");
+        size_t nsp = gas.nSpecies();
+
+        // random temperatures in [Tmin, Tmax]
+        srand(1);
+        vector_fp T(neval);
+        for (size_t n = 0; n < neval; n++) {
+            T[n] = Tmin + (Tmax - Tmin) * rand() / double(RAND_MAX);
+        }
+
+        vector_fp wdot0, wdot;
+        double tDirect = evaluate(gas, T, wdot0);
+        printf("%s: %d species, %d reactions, %d evaluations\n",
+               mech.c_str(), int(nsp), int(gas.nReactions()), int(neval));
+        printf("%8s %8s %10s %12s %12s %8s\n", "rtol", "points", "setup(ms)",
+               "time/eval(us)", "max error", "speedup");
+        printf("%8s %8s %10s %12.3f %12s %8s\n", "direct", "-", "-",
+               1e6 * tDirect / neval, "-", "-");
+
+        double rtols[] = {1e-4, 1e-5, 1e-6, 1e-7};
+        for (size_t m = 0; m < 4; m++) {
+            double t0 = wallTime();
+            gas.setRateTabulation(Tmin, Tmax, rtols[m]);
+            double tSetup = wallTime() - t0;
+            double tTable = evaluate(gas, T, wdot);
+
+            // error in the production rates, relative to the largest
+            // production rate at each temperature
+            double maxErr = 0.0;
+            for (size_t n = 0; n < neval; n++) {
+                double scale = 0.0;
+                for (size_t k = 0; k < nsp; k++) {
+                    scale = std::max(scale, std::abs(wdot0[n*nsp+k]));
+                }
+                for (size_t k = 0; k < nsp; k++) {
+                    maxErr = std::max(maxErr,
+                        std::abs(wdot[n*nsp+k] - wdot0[n*nsp+k]) / scale);
+                }
+            }
+            printf("%8.0e %8d %10.2f %12.3f %12.3e %8.2f\n", rtols[m],
+                   int(gas.rateTableSize()), 1000 * tSetup,
+                   1e6 * tTable / neval, maxErr, tDirect / tTable);
+        }
+        gas.disableRateTabulation();
+    } catch (CanteraError& err) {
+        printf("%s\n", err.what());
+        return 1;
+    }
+    appdelete();
+    return 0;
+}
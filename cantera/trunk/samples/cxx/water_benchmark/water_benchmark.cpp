@@ -0,0 +1,153 @@
+/////////////////////////////////////////////////////////////
+//
+//  Compare the throughput of the IAPWS-95 water model when the liquid
+//  density is found by solving the equation of state, and when it is
+//  interpolated from the table created by
+//  WaterPropsIAPWS::setDensityTabulation():
+//
+//   - the liquid density alone, at random temperatures and pressures
+//   - a brine described by HMWSoln, where the solvent standard state and
+//     the Debye-Huckel constant are evaluated with the IAPWS-95 model.
+//     At each state, the activity coefficients and the partial molar
+//     enthalpies and volumes are computed.
+//
+//  The temperatures are between 273.16 K and Tmax, and the pressures are
+//  up to 50 MPa above the larger of 1 bar and the saturation pressure. The
+//  largest relative difference between the results of the two methods is
+//  also printed.
+//
+//  usage: water_benchmark [repetitions] [Tmax] [rtol]
+//
+//  The brine is read from HMW_NaCl_sp1977_alt.xml, which can be found in
+//  test_problems/cathermo/HMW_graph_CpvT.
+//
+/////////////////////////////////////////////////////////////
+
+#include "cantera/thermo/HMWSoln.h"
+#include "cantera/thermo/PDSS_Water.h"
+#include "cantera/thermo/WaterPropsIAPWS.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+using namespace Cantera;
+
+//! Wall clock time in seconds
+double wallTime()
+{
+#ifdef _WIN32
+    return 0.001 * GetTickCount();
+#else
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + 1e-6 * t.tv_usec;
+#endif
+}
+
+//! Compute the density at each state, returning the time per state in
+//! microseconds
+double timeDensity(WaterPropsIAPWS& water, const vector_fp& T,
+                   const vector_fp& P, vector_fp& rho)
+{
+    double t0 = wallTime();
+    for (size_t n = 0; n < T.size(); n++) {
+        rho[n] = water.density(T[n], P[n], WATER_LIQUID);
+    }
+    return 1e6 * (wallTime() - t0) / T.size();
+}
+
+//! Compute the activity coefficients and the partial molar enthalpies and
+//! volumes of the brine at each state, returning the time per state in
+//! microseconds. The enthalpies are stored in *h*.
+double timeBrine(HMWSoln& brine, const vector_fp& T, const vector_fp& P,
+                 vector_fp& h)
+{
+    size_t nsp = brine.nSpecies();
+    vector_fp ac(nsp), v(nsp);
+    double t0 = wallTime();
+    for (size_t n = 0; n < T.size(); n++) {
+        brine.setState_TP(T[n], P[n]);
+        brine.getActivityCoefficients(&ac[0]);
+        brine.getPartialMolarEnthalpies(&h[n*nsp]);
+        brine.getPartialMolarVolumes(&v[0]);
+    }
+    return 1e6 * (wallTime() - t0) / T.size();
+}
+
+double maxRelativeDifference(const vector_fp& x, const vector_fp& y)
+{
+    double diff = 0.0;
+    for (size_t n = 0; n < x.size(); n++) {
+        double scale = std::max(std::abs(x[n]), 1e-300);
+        diff = std::max(diff, std::abs(x[n] - y[n]) / scale);
+    }
+    return diff;
+}
+
+int main(int argc, char** argv)
+{
+    int nrep = (argc > 1) ? atoi(argv[1]) : 20000;
+    double Tmax = (argc > 2) ? atof(argv[2]) : 573.15;
+    double rtol = (argc > 3) ? atof(argv[3]) : 1e-6;
+
+    try {
+        WaterPropsIAPWS exact, tabulated;
+        double t0 = wallTime();
+        tabulated.setDensityTabulation(273.16, Tmax, 1.0E8, rtol);
+        double tSetup = wallTime() - t0;
+        printf("Density table for 273.16 - %g K: %d values, error estimate "
+               "%.2e, created in %.2f s\n", Tmax,
+               int(tabulated.densityTableSize()),
+               tabulated.densityTableError(), tSetup);
+
+        vector_fp T(nrep), P(nrep);
+        srand(1);
+        for (int n = 0; n < nrep; n++) {
+            T[n] = 273.16 + (Tmax - 273.16) * rand() / RAND_MAX;
+            P[n] = std::max(exact.psat_est(T[n]), 1.0E5) +
+                   5.0E7 * rand() / RAND_MAX;
+        }
+
+        vector_fp rho1(nrep), rho2(nrep);
+        double tExact = timeDensity(exact, T, P, rho1);
+        double tTable = timeDensity(tabulated, T, P, rho2);
+        printf("\n%d liquid densities:\n", nrep);
+        printf("%-30s %10.2f us/state\n", "equation of state", tExact);
+        printf("%-30s %10.2f us/state\n", "table", tTable);
+        printf("max. relative difference: %.2e\n",
+               maxRelativeDifference(rho1, rho2));
+
+        int nBrine = std::max(nrep / 20, 1);
+        T.resize(nBrine);
+        P.resize(nBrine);
+        HMWSoln brine1("HMW_NaCl_sp1977_alt.xml", "NaCl_electrolyte");
+        HMWSoln brine2("HMW_NaCl_sp1977_alt.xml", "NaCl_electrolyte");
+        size_t nsp = brine1.nSpecies();
+        vector_fp moll(nsp, 0.0), h1(nBrine * nsp), h2(nBrine * nsp);
+        moll[brine1.speciesIndex("Na+")] = 3.0;
+        moll[brine1.speciesIndex("Cl-")] = 3.0;
+        brine1.setMolalities(&moll[0]);
+        brine2.setMolalities(&moll[0]);
+        PDSS_Water* solvent = dynamic_cast<PDSS_Water*>(brine2.providePDSS(0));
+        solvent->getWater()->setDensityTabulation(273.16, Tmax, 1.0E8, rtol);
+
+        tExact = timeBrine(brine1, T, P, h1);
+        tTable = timeBrine(brine2, T, P, h2);
+        printf("\n%d states of 3 molal NaCl brine:\n", nBrine);
+        printf("%-30s %10.2f us/state\n", "equation of state", tExact);
+        printf("%-30s %10.2f us/state\n", "table", tTable);
+        printf("max. relative difference in h: %.2e\n",
+               maxRelativeDifference(h1, h2));
+    } catch (CanteraError& err) {
+        printf("%s\n", err.what());
+        return 1;
+    }
+    appdelete();
+    return 0;
+}
@@ -3,22 +3,32 @@
  */
 
 #include "cantera/base/ValueCache.h"
-#include "cantera/base/ct_thread.h"
 
-namespace
-{
-Cantera::mutex_t id_mutex;
-}
+#if defined(THREAD_SAFE_CANTERA) && defined(_MSC_VER)
+#include <intrin.h>
+#pragma intrinsic(_InterlockedIncrement)
+#endif
 
 namespace Cantera
 {
 
-int ValueCache::m_last_id = 0;
+volatile ValueCache::id_counter_t ValueCache::m_last_id = 0;
 
 int ValueCache::getId()
 {
-    ScopedLock lock(id_mutex);
+    // A mutex can't be used here, since it may not have been constructed yet
+    // when this function is called during the static initialization of
+    // another file. Instead, the counter (which is initialized to zero before
+    // any code runs) is incremented atomically, so that ids are also unique if
+    // they are requested concurrently, e.g. while shared libraries using
+    // Cantera are loaded by different threads.
+#if !defined(THREAD_SAFE_CANTERA)
     return ++m_last_id;
+#elif defined(_MSC_VER)
+    return _InterlockedIncrement(&m_last_id);
+#else
+    return __sync_add_and_fetch(&m_last_id, 1);
+#endif
 }
 
 void ValueCache::clear()
@@ -257,10 +257,25 @@ XML_Node* Application::get_XML_File(const std::string& file, int debug)
         ext = "";
     }
     XML_Node* x = new XML_Node("doc");
-    if (ext != ".xml" && ext != ".ctml") {
-        // Assume that we are trying to open a cti file. Do the conversion to XML.
-        std::stringstream phase_xml(ctml::ct2ctml_string(path));
-        x->build(phase_xml);
+    if (ext == ".ctmlb") {
+        // Binary CTML file, which holds an already parsed tree
+        try {
+            ctml::readBinaryCTML(path, *x);
+        } catch (...) {
+            delete x;
+            throw;
+        }
+    } else if (ext != ".xml" && ext != ".ctml") {
+        // Assume that we are trying to open a cti file. Build the tree
+        // directly if the built-in converter handles the file, and otherwise
+        // do the conversion to XML with the Python converter.
+        std::ifstream s(path.c_str());
+        std::stringstream cti;
+        cti << s.rdbuf();
+        if (!s || !ctml::ct2ctml_native(cti.str(), *x)) {
+            std::stringstream phase_xml(ctml::call_ctml_writer(path, true));
+            x->build(phase_xml);
+        }
     } else {
         std::ifstream s(path.c_str());
         if (s) {
@@ -284,16 +299,26 @@ XML_Node* Application::get_XML_from_string(const std::string& text)
         // Return existing cached XML tree
         return entry.first;
     }
-    std::stringstream s;
     size_t start = text.find_first_not_of(" \t\r\n");
-    if (text.substr(start,5) == "<?xml") {
-        s << text;
-    } else {
-        s << ctml::ct_string2ctml_string(text);
+    bool isxml = (text.substr(start,5) == "<?xml");
+    XML_Node* x = new XML_Node();
+    if (isxml || !ctml::ct2ctml_native(text, *x)) {
+        try {
+            std::stringstream s;
+            if (isxml) {
+                s << text;
+            } else {
+                s << ctml::call_ctml_writer(text, false);
+            }
+            x->build(s);
+        } catch (...) {
+            delete x;
+            throw;
+        }
     }
-    entry.first = new XML_Node();
-    entry.first->build(s);
-    return entry.first;
+    x->lock();
+    entry.first = x;
+    return x;
 }
 
 void Application::close_XML_File(const std::string& file)
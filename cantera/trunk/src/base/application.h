@@ -293,7 +293,9 @@ public:
      *  This routine will find the file and read the XML file into an
      *  XML tree structure. Then, a pointer will be returned. If the
      *  file has already been processed, then just the pointer will
-     *  be returned.
+     *  be returned. Files with the extension `.ctmlb` are read in the
+     *  binary CTML format, which stores an already parsed tree (see
+     *  ctml::writeBinaryCTML()).
      *
      * @param file String containing the relative or absolute file name
      * @param debug Debug flag
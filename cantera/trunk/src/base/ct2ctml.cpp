@@ -1,7 +1,8 @@
 /**
  * @file ct2ctml.cpp
- * Driver for the system call to the python executable that converts
- * cti files to ctml files (see \ref inputfiles).
+ * Conversion of cti files to ctml files, using the built-in converter
+ * (see ct2ctml_native.cpp) or a system call to the python executable (see
+ * \ref inputfiles).
  */
 // Copyright 2001-2005  California Institute of Technology
 
@@ -77,7 +78,7 @@ void ct2ctml(const char* file, const int debug)
     out << xml;
 }
 
-static std::string call_ctml_writer(const std::string& text, bool isfile)
+std::string call_ctml_writer(const std::string& text, bool isfile)
 {
     std::string file, arg;
     if (isfile) {
@@ -176,13 +177,36 @@ static std::string call_ctml_writer(const std::string& text, bool isfile)
     return python_output;
 }
 
+//! Write the tree created by ct2ctml_native() in the format of the output
+//! of the Python converter
+static std::string write_native_ctml(const XML_Node& root)
+{
+    std::stringstream s;
+    s << "<?xml version=\"1.0\"?>" << endl;
+    root.child(0).write(s);
+    return s.str();
+}
+
 std::string ct2ctml_string(const std::string& file)
 {
+    std::ifstream f(file.c_str());
+    if (f) {
+        std::stringstream cti;
+        cti << f.rdbuf();
+        XML_Node root;
+        if (ct2ctml_native(cti.str(), root)) {
+            return write_native_ctml(root);
+        }
+    }
     return call_ctml_writer(file, true);
 }
 
 std::string ct_string2ctml_string(const std::string& cti)
 {
+    XML_Node root;
+    if (ct2ctml_native(cti, root)) {
+        return write_native_ctml(root);
+    }
     return call_ctml_writer(cti, false);
 }
 
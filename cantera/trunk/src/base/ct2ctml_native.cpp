@@ -0,0 +1,1879 @@
+/**
+ * @file ct2ctml_native.cpp
+ * Conversion of cti input to CTML without calling the Python
+ * interpreter (see \ref inputfiles).
+ */
+
+#include "cantera/base/ctml.h"
+#include "cantera/base/stringUtils.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <sstream>
+
+using namespace Cantera;
+using namespace std;
+
+namespace ctml
+{
+
+namespace
+{
+
+//! Thrown when the input contains anything that the built-in converter does
+//! not handle, or that the Python converter would reject. In either case,
+//! the conversion is left to the Python converter, which reports any errors.
+struct Unsupported {};
+
+void unsupported()
+{
+    throw Unsupported();
+}
+
+//! A value in a cti file: a number, a string, a tuple or list, or a call of
+//! one of the functions that define the entries of the file. Calls are
+//! evaluated when the XML tree is built, as in ctml_writer.py.
+struct Value {
+    enum Kind {None, Number, String, Sequence, Call};
+
+    Value() : kind(None), num(0.0), isInt(false) {}
+
+    Kind kind;
+    double num;
+    //! Like Python numbers, numbers are either integers or floats, which
+    //! differ in how they are written to the XML file.
+    bool isInt;
+    //! The string, or the name of the called function
+    std::string str;
+    //! Items of a sequence, or positional arguments of a call
+    std::vector<Value> items;
+    //! Names of the keyword arguments of a call
+    std::vector<std::string> kwNames;
+    //! Values of the keyword arguments of a call
+    std::vector<Value> kwValues;
+};
+
+Value numberValue(double x, bool isInt)
+{
+    Value v;
+    v.kind = Value::Number;
+    v.num = x;
+    v.isInt = isInt;
+    return v;
+}
+
+Value stringValue(const std::string& s)
+{
+    Value v;
+    v.kind = Value::String;
+    v.str = s;
+    return v;
+}
+
+//! Python's `repr` of a float
+std::string reprFloat(double x)
+{
+    if (x != x) {
+        return "nan";
+    } else if (x > DBL_MAX) {
+        return "inf";
+    } else if (x < -DBL_MAX) {
+        return "-inf";
+    }
+    // shortest representation that reads back as the same number
+    char buf[40];
+    for (int prec = 0; prec < 17; prec++) {
+        sprintf(buf, "%.*e", prec, x);
+        if (strtod(buf, 0) == x) {
+            break;
+        }
+    }
+    std::string s(buf);
+    size_t iexp = s.find('e');
+    int exp10 = atoi(s.c_str() + iexp + 1);
+    std::string sign = (s[0] == '-') ? "-" : "";
+    std::string digits;
+    for (size_t i = sign.size(); i < iexp; i++) {
+        if (s[i] != '.') {
+            digits += s[i];
+        }
+    }
+    while (digits.size() > 1 && digits[digits.size()-1] == '0') {
+        digits.erase(digits.size()-1);
+    }
+
+    std::string out;
+    if (exp10 >= -4 && exp10 < 16) {
+        size_t nint = exp10 + 1;
+        if (exp10 < 0) {
+            out = "0." + std::string(-exp10 - 1, '0') + digits;
+        } else if (digits.size() <= nint) {
+            out = digits + std::string(nint - digits.size(), '0') + ".0";
+        } else {
+            out = digits.substr(0, nint) + "." + digits.substr(nint);
+        }
+    } else {
+        out = digits.substr(0, 1);
+        if (digits.size() > 1) {
+            out += "." + digits.substr(1);
+        }
+        sprintf(buf, "e%c%02d", (exp10 < 0) ? '-' : '+', std::abs(exp10));
+        out += buf;
+    }
+    return sign + out;
+}
+
+//! Python's `repr` (or `str`) of a number
+std::string repr(const Value& v)
+{
+    if (v.kind != Value::Number) {
+        unsupported();
+    }
+    return v.isInt ? fp2str(v.num, "%.0f") : reprFloat(v.num);
+}
+
+//! The value of a node as it is read from the XML file written by
+//! ctml_writer.py, which strips the leading whitespace of each line of a
+//! multi-line value, and indents it.
+std::string xmlValue(const std::string& s)
+{
+    if (s.find('\n') == std::string::npos) {
+        return stripws(s);
+    }
+    std::string out;
+    size_t i = 0;
+    while (i < s.size()) {
+        size_t start = s.find_first_not_of(" \t\r\n\f\v", i);
+        if (start == std::string::npos) {
+            break;
+        }
+        size_t eol = s.find('\n', start);
+        if (eol == std::string::npos) {
+            eol = s.size();
+        }
+        out += "\n " + s.substr(start, eol - start);
+        i = eol;
+    }
+    return stripws(out);
+}
+
+//! Add a child with a value that is written as a string
+XML_Node& addChild(XML_Node& node, const std::string& name,
+                   const std::string& value)
+{
+    return node.addChild(name, xmlValue(value));
+}
+
+//! Add a comment as it is read from the XML file written by ctml_writer.py
+void addComment(XML_Node& node, const std::string& comment)
+{
+    size_t start = comment.find_first_not_of(" \t\r\n\f\v");
+    std::string c = (start == std::string::npos) ? "" : comment.substr(start);
+    if (c.empty() || c[c.size()-1] != ' ') {
+        c += " ";
+    }
+    node.addComment(" " + c);
+}
+
+//! Split a string at whitespace, like Python's `str.split()`
+std::vector<std::string> split(const std::string& s)
+{
+    std::vector<std::string> toks;
+    std::istringstream ss(s);
+    std::string tok;
+    while (ss >> tok) {
+        toks.push_back(tok);
+    }
+    return toks;
+}
+
+//! Split a string at each occurrence of `sep`, like Python's `str.split(sep)`
+std::vector<std::string> split(const std::string& s, char sep)
+{
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (true) {
+        size_t end = s.find(sep, start);
+        if (end == std::string::npos) {
+            parts.push_back(s.substr(start));
+            return parts;
+        }
+        parts.push_back(s.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+std::string replaceAll(const std::string& s, const std::string& from,
+                       const std::string& to)
+{
+    std::string out;
+    size_t start = 0;
+    while (true) {
+        size_t k = s.find(from, start);
+        if (k == std::string::npos) {
+            return out + s.substr(start);
+        }
+        out += s.substr(start, k - start) + to;
+        start = k + from.size();
+    }
+}
+
+//! Convert a string to a number, like Python's `float()`
+bool pyFloat(const std::string& s, double& x)
+{
+    if (s.empty() || s.find_first_of("xXpP_") != std::string::npos) {
+        return false;
+    }
+    char* end;
+    x = strtod(s.c_str(), &end);
+    return *end == '\0';
+}
+
+//! Convert a string to a number, like Python's `int()`
+bool pyInt(const std::string& s, double& x)
+{
+    size_t i = (s.size() && (s[0] == '+' || s[0] == '-')) ? 1 : 0;
+    if (i == s.size()) {
+        return false;
+    }
+    for (size_t j = i; j < s.size(); j++) {
+        if (!isdigit(s[j])) {
+            return false;
+        }
+    }
+    x = atof(s.c_str());
+    return true;
+}
+
+//! A species composition or set of stoichiometric coefficients, in the
+//! order of insertion (like the Python dictionaries in ctml_writer.py)
+typedef std::vector<std::pair<std::string, Value> > Composition;
+
+size_t find(const Composition& c, const std::string& name)
+{
+    for (size_t i = 0; i < c.size(); i++) {
+        if (c[i].first == name) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+void erase(Composition& c, const std::string& name)
+{
+    size_t i = find(c, name);
+    if (i == npos) {
+        unsupported();
+    }
+    c.erase(c.begin() + i);
+}
+
+std::string compositionString(const Composition& c)
+{
+    std::string s;
+    for (size_t i = 0; i < c.size(); i++) {
+        s += (i ? " " : "") + c[i].first + ":" + repr(c[i].second);
+    }
+    return s;
+}
+
+//! Stoichiometric coefficients of one side of a reaction equation. See
+//! `getReactionSpecies` in ctml_writer.py.
+Composition reactionSpecies(const std::string& side)
+{
+    std::string s = replaceAll(side, " (+", " (+ ");
+    std::vector<std::string> toks = split(replaceAll(s, " + ", " "));
+    Composition d;
+    Value n = numberValue(1.0, false);
+    for (size_t i = 0; i < toks.size(); i++) {
+        double x;
+        if (pyFloat(toks[i], x)) {
+            if (x < 0.0) {
+                unsupported();
+            }
+            n = numberValue(x, false);
+        } else {
+            size_t k = find(d, toks[i]);
+            if (k == npos) {
+                d.push_back(std::make_pair(toks[i], n));
+            } else {
+                Value& v = d[k].second;
+                v = numberValue(v.num + n.num, v.isInt && n.isInt);
+            }
+            n = numberValue(1.0, true);
+        }
+    }
+    return d;
+}
+
+//! Arguments of a call, matched to the parameters of the called function
+class Args
+{
+public:
+    template<size_t N>
+    Args(const Value& call, const char* const (&names)[N],
+         size_t maxPositional = N) :
+        m_names(names, names + N),
+        m_values(N, (const Value*) 0)
+    {
+        if (call.items.size() > std::min(N, maxPositional)) {
+            unsupported();
+        }
+        for (size_t i = 0; i < call.items.size(); i++) {
+            m_values[i] = &call.items[i];
+        }
+        for (size_t i = 0; i < call.kwNames.size(); i++) {
+            size_t k = index(call.kwNames[i]);
+            if (k == npos || m_values[k]) {
+                unsupported();
+            }
+            m_values[k] = &call.kwValues[i];
+        }
+    }
+
+    //! The value of an argument, or 0 if it was not given
+    const Value* operator[](const std::string& name) const {
+        return m_values[index(name)];
+    }
+
+private:
+    size_t index(const std::string& name) const {
+        for (size_t k = 0; k < m_names.size(); k++) {
+            if (name == m_names[k]) {
+                return k;
+            }
+        }
+        return npos;
+    }
+
+    std::vector<std::string> m_names;
+    std::vector<const Value*> m_values;
+};
+
+//! Python's truth value of an optional argument
+bool truthy(const Value* v)
+{
+    if (!v) {
+        return false;
+    }
+    switch (v->kind) {
+    case Value::None:
+        return false;
+    case Value::Number:
+        return v->num != 0.0;
+    case Value::String:
+        return !v->str.empty();
+    case Value::Sequence:
+        return !v->items.empty();
+    default:
+        return true;
+    }
+}
+
+std::string getString(const Value* v, const std::string& dflt)
+{
+    if (!v) {
+        return dflt;
+    } else if (v->kind != Value::String) {
+        unsupported();
+    }
+    return v->str;
+}
+
+double getNumber(const Value* v, double dflt)
+{
+    if (!v) {
+        return dflt;
+    } else if (v->kind != Value::Number) {
+        unsupported();
+    }
+    return v->num;
+}
+
+//! An argument which is either a string or a sequence of strings
+std::vector<std::string> getStrings(const Value* v, const std::string& dflt)
+{
+    std::vector<std::string> s;
+    if (!v) {
+        s.push_back(dflt);
+    } else if (v->kind == Value::String) {
+        s.push_back(v->str);
+    } else if (v->kind == Value::Sequence) {
+        for (size_t i = 0; i < v->items.size(); i++) {
+            s.push_back(getString(&v->items[i], ""));
+        }
+    } else {
+        unsupported();
+    }
+    return s;
+}
+
+//! The entries of an argument which is either a single entry or a
+//! sequence of entries
+std::vector<const Value*> getEntries(const Value& v)
+{
+    std::vector<const Value*> entries;
+    if (v.kind == Value::Call) {
+        entries.push_back(&v);
+    } else if (v.kind == Value::Sequence) {
+        for (size_t i = 0; i < v.items.size(); i++) {
+            if (v.items[i].kind != Value::Call) {
+                unsupported();
+            }
+            entries.push_back(&v.items[i]);
+        }
+    } else {
+        unsupported();
+    }
+    return entries;
+}
+
+//! Add a child with a floating-point value, given either as a number, which
+//! has the default units (if any), or as a sequence of a number and its
+//! units. See `addFloat` in ctml_writer.py.
+void addFloat(XML_Node& node, const std::string& name, const Value& val,
+              const std::string& fmt = "", const std::string& defunits = "")
+{
+    const Value* x = &val;
+    std::string units = defunits;
+    bool isnum = (val.kind == Value::Number);
+    if (!isnum) {
+        if (val.kind != Value::Sequence || val.items.size() < 2 ||
+                val.items[1].kind != Value::String) {
+            unsupported();
+        }
+        x = &val.items[0];
+        units = val.items[1].str;
+    }
+    if (x->kind != Value::Number) {
+        unsupported();
+    }
+    std::string s;
+    if (!fmt.empty()) {
+        s = fp2str(x->num, fmt);
+    } else {
+        s = isnum ? reprFloat(x->num) : repr(*x);
+    }
+    XML_Node& c = addChild(node, name, s);
+    if (!isnum || !units.empty()) {
+        c.addAttribute("units", units);
+    }
+}
+
+struct Token {
+    enum Kind {Name, Number, String, Op, Newline, End};
+    Token() : kind(End), num(0.0), isInt(false) {}
+    Kind kind;
+    std::string text;
+    double num;
+    bool isInt;
+};
+
+bool isOp(const Token& t, const char* op)
+{
+    return t.kind == Token::Op && t.text == op;
+}
+
+//! Read a string literal starting at s[i], which is the opening quote
+std::string readString(const std::string& s, size_t& i, bool raw)
+{
+    char q = s[i];
+    bool triple = (s.compare(i, 3, std::string(3, q)) == 0);
+    i += triple ? 3 : 1;
+    std::string out;
+    while (true) {
+        if (i >= s.size()) {
+            unsupported();
+        }
+        char c = s[i];
+        if (c == q && (!triple || s.compare(i, 3, std::string(3, q)) == 0)) {
+            i += triple ? 3 : 1;
+            return out;
+        } else if (c == '\n' && !triple) {
+            unsupported();
+        } else if (c == '\\' && i + 1 < s.size()) {
+            char e = s[i+1];
+            i += 2;
+            if (raw) {
+                out += c;
+                out += e;
+            } else if (e == 'n') {
+                out += '\n';
+            } else if (e == 't') {
+                out += '\t';
+            } else if (e == 'r') {
+                out += '\r';
+            } else if (e == '\\' || e == '\'' || e == '"') {
+                out += e;
+            } else if (e == '\n') {
+                // line continuation
+            } else if (strchr("01234567xNuUabfv\r", e)) {
+                unsupported();
+            } else {
+                out += c;
+                out += e;
+            }
+        } else {
+            out += c;
+            i++;
+        }
+    }
+}
+
+//! Split the text of a cti file into tokens. Newline tokens are added at
+//! the end of each logical line.
+void tokenize(const std::string& s, std::vector<Token>& tokens)
+{
+    size_t i = 0, n = s.size();
+    int depth = 0;
+    bool lineStart = true;
+    while (i < n) {
+        char c = s[i];
+        if (c == '\n' || c == '\r') {
+            if (depth == 0) {
+                if (!tokens.empty() && tokens.back().kind != Token::Newline) {
+                    tokens.push_back(Token());
+                    tokens.back().kind = Token::Newline;
+                }
+                lineStart = true;
+            }
+            i++;
+            continue;
+        } else if (c == ' ' || c == '\t' || c == '\f') {
+            i++;
+            continue;
+        } else if (c == '#') {
+            while (i < n && s[i] != '\n' && s[i] != '\r') {
+                i++;
+            }
+            continue;
+        } else if (c == '\\') {
+            // explicit line joining
+            size_t j = i + 1;
+            if (j < n && s[j] == '\r') {
+                j++;
+            }
+            if (j >= n || s[j] != '\n') {
+                unsupported();
+            }
+            i = j + 1;
+            continue;
+        }
+        if (lineStart && depth == 0 && i > 0 &&
+                (s[i-1] == ' ' || s[i-1] == '\t' || s[i-1] == '\f')) {
+            // indented statement
+            unsupported();
+        }
+        lineStart = false;
+
+        Token t;
+        if (isalpha(c) || c == '_') {
+            size_t j = i;
+            while (j < n && (isalnum(s[j]) || s[j] == '_')) {
+                j++;
+            }
+            std::string word = s.substr(i, j - i);
+            std::string prefix = lowercase(word);
+            if (j < n && (s[j] == '\'' || s[j] == '"') &&
+                    (prefix == "r" || prefix == "u" || prefix == "b" ||
+                     prefix == "br" || prefix == "rb")) {
+                i = j;
+                t.kind = Token::String;
+                t.text = readString(s, i, prefix.find('r') != npos);
+            } else {
+                t.kind = Token::Name;
+                t.text = word;
+                i = j;
+            }
+        } else if (isdigit(c) || (c == '.' && i + 1 < n && isdigit(s[i+1]))) {
+            size_t j = i;
+            t.isInt = true;
+            while (j < n && isdigit(s[j])) {
+                j++;
+            }
+            if (j < n && s[j] == '.') {
+                t.isInt = false;
+                j++;
+                while (j < n && isdigit(s[j])) {
+                    j++;
+                }
+            }
+            if (j < n && (s[j] == 'e' || s[j] == 'E')) {
+                t.isInt = false;
+                j++;
+                if (j < n && (s[j] == '+' || s[j] == '-')) {
+                    j++;
+                }
+                if (j >= n || !isdigit(s[j])) {
+                    unsupported();
+                }
+                while (j < n && isdigit(s[j])) {
+                    j++;
+                }
+            }
+            if (j < n && (isalnum(s[j]) || s[j] == '_' || s[j] == '.')) {
+                // hexadecimal, complex, etc.
+                unsupported();
+            }
+            t.kind = Token::Number;
+            t.text = s.substr(i, j - i);
+            if (t.isInt && t.text.size() > 1 && t.text[0] == '0' &&
+                    t.text.find_first_not_of('0') != npos) {
+                unsupported();
+            }
+            t.num = strtod(t.text.c_str(), 0);
+            i = j;
+        } else if (c == '\'' || c == '"') {
+            t.kind = Token::String;
+            t.text = readString(s, i, false);
+        } else if (c == ';') {
+            if (depth != 0) {
+                unsupported();
+            }
+            t.kind = Token::Newline;
+            i++;
+        } else if (s.compare(i, 2, "**") == 0) {
+            t.kind = Token::Op;
+            t.text = "**";
+            i += 2;
+        } else if (strchr("()[],=+-*/", c) && c != '\0') {
+            if (c == '=' && i + 1 < n && s[i+1] == '=') {
+                unsupported();
+            }
+            if (c == '(' || c == '[') {
+                depth++;
+            } else if (c == ')' || c == ']') {
+                if (--depth < 0) {
+                    unsupported();
+                }
+            }
+            t.kind = Token::Op;
+            t.text = std::string(1, c);
+            i++;
+        } else {
+            unsupported();
+        }
+        tokens.push_back(t);
+    }
+    if (depth != 0) {
+        unsupported();
+    }
+    tokens.push_back(Token());
+    tokens.back().kind = Token::Newline;
+    tokens.push_back(Token());
+}
+
+//! A phase defined by an `ideal_gas` entry
+struct Phase {
+    std::string name;
+    std::string elements;
+    std::string note;
+    std::string kinetics;
+    std::string transport;
+    //! Data source and names of each set of species
+    std::vector<std::pair<std::string, std::string> > species;
+    //! Data source and reaction numbers of each set of reactions
+    std::vector<std::pair<std::string, std::string> > reactions;
+    std::set<std::string> speciesNames;
+    std::vector<std::string> options;
+    Value initialState;
+
+    bool hasOption(const std::string& opt) const {
+        return std::find(options.begin(), options.end(), opt) != options.end();
+    }
+};
+
+//! Reads the entries of a cti file, and builds the corresponding XML tree,
+//! in the same way as ctml_writer.py.
+class CtiConverter
+{
+public:
+    CtiConverter() :
+        m_ulen("m"), m_umol("kmol"), m_umass("kg"), m_utime("s"),
+        m_ue("J/kmol"), m_uenergy("J"), m_upres("Pa"),
+        m_pref(numberValue(1.0e5, false)),
+        m_valsp("yes"), m_valrxn("yes"),
+        m_pos(0)
+    {
+        m_vars["OneAtm"] = numberValue(1.01325e5, false);
+        m_vars["OneBar"] = numberValue(1.0e5, false);
+        m_vars["eV"] = numberValue(9.64853364595687e7, false);
+        m_vars["ElectronMass"] = numberValue(9.10938291e-31, false);
+        m_vars["None"] = Value();
+    }
+
+    void parse(const std::string& text) {
+        // Line endings are normalized as for a file read by Python in
+        // universal newlines mode
+        std::string normalized = replaceAll(text, "\r\n", "\n");
+        tokenize(replaceAll(normalized, "\r", "\n"), m_tokens);
+        while (peek().kind != Token::End) {
+            if (peek().kind == Token::Newline) {
+                m_pos++;
+            } else {
+                statement();
+            }
+        }
+    }
+
+    void build(XML_Node& ctml) {
+        XML_Node& v = ctml.addChild("validate");
+        v.addAttribute("species", m_valsp);
+        v.addAttribute("reactions", m_valrxn);
+
+        if (!m_elements.empty()) {
+            XML_Node& ed = ctml.addChild("elementData");
+            for (size_t i = 0; i < m_elements.size(); i++) {
+                static const char* const names[] =
+                    {"symbol", "atomic_mass", "atomic_number"};
+                Args a(m_elements[i], names);
+                XML_Node& e = ed.addChild("element");
+                e.addAttribute("name", getString(a["symbol"], ""));
+                e.addAttribute("atomicWt", a["atomic_mass"] ?
+                               repr(*a["atomic_mass"]) : "0.01");
+                e.addAttribute("atomicNumber", a["atomic_number"] ?
+                               repr(*a["atomic_number"]) : "0");
+            }
+        }
+
+        for (size_t i = 0; i < m_phases.size(); i++) {
+            buildPhase(m_phases[i], ctml);
+        }
+
+        addComment(ctml, "     species definitions     ");
+        XML_Node& sd = ctml.addChild("speciesData");
+        sd.addAttribute("id", "species_data");
+        for (size_t i = 0; i < m_species.size(); i++) {
+            buildSpecies(m_species[i], sd);
+        }
+
+        XML_Node& rd = ctml.addChild("reactionData");
+        rd.addAttribute("id", "reaction_data");
+        for (size_t i = 0; i < m_reactions.size(); i++) {
+            buildReaction(m_reactions[i], i + 1, rd);
+        }
+    }
+
+private:
+    const Token& peek(size_t k = 0) const {
+        return m_tokens[std::min(m_pos + k, m_tokens.size() - 1)];
+    }
+
+    void expect(const char* op) {
+        if (!isOp(peek(), op)) {
+            unsupported();
+        }
+        m_pos++;
+    }
+
+    void statement() {
+        if (peek().kind == Token::Name && isOp(peek(1), "=")) {
+            std::string name = peek().text;
+            m_pos += 2;
+            if (name == "None") {
+                unsupported();
+            }
+            m_vars[name] = expression();
+            handle(m_vars[name]);
+        } else {
+            handle(expression());
+        }
+        if (peek().kind != Token::Newline) {
+            unsupported();
+        }
+        m_pos++;
+    }
+
+    //! Handle the value of a statement. Entries that are created within
+    //! other expressions are not supported, since they would be added to
+    //! the file in the order they are evaluated.
+    void handle(const Value& v) {
+        if (v.kind == Value::Call) {
+            for (size_t i = 0; i < v.items.size(); i++) {
+                checkNested(v.items[i]);
+            }
+            for (size_t i = 0; i < v.kwValues.size(); i++) {
+                checkNested(v.kwValues[i]);
+            }
+            addEntry(v);
+        } else {
+            checkNested(v);
+        }
+    }
+
+    void checkNested(const Value& v) {
+        if (v.kind == Value::Call && !isHelper(v.str)) {
+            unsupported();
+        }
+        for (size_t i = 0; i < v.items.size(); i++) {
+            checkNested(v.items[i]);
+        }
+        for (size_t i = 0; i < v.kwValues.size(); i++) {
+            checkNested(v.kwValues[i]);
+        }
+    }
+
+    //! Functions that create parts of other entries
+    static bool isHelper(const std::string& f) {
+        static const char* const helpers[] =
+            {"NASA", "NASA9", "Shomate", "const_cp", "gas_transport",
+             "Arrhenius", "Troe", "SRI", "Lindemann", "state"};
+        for (size_t i = 0; i < sizeof(helpers) / sizeof(helpers[0]); i++) {
+            if (f == helpers[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Value expression() {
+        Value v = term();
+        while (isOp(peek(), "+") || isOp(peek(), "-")) {
+            std::string op = peek().text;
+            m_pos++;
+            v = binary(v, term(), op);
+        }
+        return v;
+    }
+
+    Value term() {
+        Value v = factor();
+        while (isOp(peek(), "*") || isOp(peek(), "/")) {
+            std::string op = peek().text;
+            m_pos++;
+            v = binary(v, factor(), op);
+        }
+        return v;
+    }
+
+    Value factor() {
+        if (isOp(peek(), "-") || isOp(peek(), "+")) {
+            bool negate = isOp(peek(), "-");
+            m_pos++;
+            Value v = factor();
+            if (v.kind != Value::Number) {
+                unsupported();
+            }
+            if (negate) {
+                v.num = -v.num;
+            }
+            return v;
+        }
+        Value v = atom();
+        if (isOp(peek(), "(") || isOp(peek(), "[")) {
+            // calls of computed values, indexing, etc.
+            unsupported();
+        }
+        if (isOp(peek(), "**")) {
+            m_pos++;
+            v = binary(v, factor(), "**");
+        }
+        return v;
+    }
+
+    Value atom() {
+        const Token& t = peek();
+        Value v;
+        if (t.kind == Token::Number) {
+            m_pos++;
+            return numberValue(t.num, t.isInt);
+        } else if (t.kind == Token::String) {
+            v.kind = Value::String;
+            while (peek().kind == Token::String) {
+                v.str += peek().text;
+                m_pos++;
+            }
+            return v;
+        } else if (t.kind == Token::Name) {
+            m_pos++;
+            if (isOp(peek(), "(")) {
+                v.kind = Value::Call;
+                v.str = t.text;
+                arguments(v);
+                return v;
+            }
+            std::map<std::string, Value>::const_iterator iter =
+                m_vars.find(t.text);
+            if (iter == m_vars.end()) {
+                unsupported();
+            }
+            return iter->second;
+        } else if (isOp(t, "(") || isOp(t, "[")) {
+            bool list = isOp(t, "[");
+            const char* close = list ? "]" : ")";
+            m_pos++;
+            v.kind = Value::Sequence;
+            bool comma = false;
+            while (!isOp(peek(), close)) {
+                v.items.push_back(expression());
+                if (isOp(peek(), ",")) {
+                    comma = true;
+                    m_pos++;
+                } else if (!isOp(peek(), close)) {
+                    unsupported();
+                }
+            }
+            m_pos++;
+            if (!list && !comma && v.items.size() == 1) {
+                // parenthesized expression
+                Value x = v.items[0];
+                return x;
+            }
+            return v;
+        }
+        unsupported();
+        return v;
+    }
+
+    void arguments(Value& call) {
+        expect("(");
+        while (!isOp(peek(), ")")) {
+            if (peek().kind == Token::Name && isOp(peek(1), "=")) {
+                call.kwNames.push_back(peek().text);
+                m_pos += 2;
+                call.kwValues.push_back(expression());
+            } else if (call.kwNames.empty()) {
+                call.items.push_back(expression());
+            } else {
+                // positional argument following a keyword argument
+                unsupported();
+            }
+            if (isOp(peek(), ",")) {
+                m_pos++;
+            } else if (!isOp(peek(), ")")) {
+                unsupported();
+            }
+        }
+        m_pos++;
+    }
+
+    static Value binary(const Value& a, const Value& b, const std::string& op) {
+        if (a.kind == Value::Number && b.kind == Value::Number) {
+            bool ints = a.isInt && b.isInt;
+            if (op == "+") {
+                return numberValue(a.num + b.num, ints);
+            } else if (op == "-") {
+                return numberValue(a.num - b.num, ints);
+            } else if (op == "*") {
+                return numberValue(a.num * b.num, ints);
+            } else if (op == "/" && b.num != 0.0) {
+                return numberValue(a.num / b.num, false);
+            } else if (op == "**" && !(a.num == 0.0 && b.num < 0.0) &&
+                       !(a.num < 0.0 && b.num != floor(b.num))) {
+                return numberValue(pow(a.num, b.num), ints && b.num >= 0);
+            }
+        } else if (op == "+" && a.kind == Value::String &&
+                   b.kind == Value::String) {
+            return stringValue(a.str + b.str);
+        } else if (op == "+" && a.kind == Value::Sequence &&
+                   b.kind == Value::Sequence) {
+            Value v = a;
+            v.items.insert(v.items.end(), b.items.begin(), b.items.end());
+            return v;
+        }
+        unsupported();
+        return a;
+    }
+
+    //! Handle a top-level entry. Entries that set options are processed
+    //! immediately, and the others are saved to be built later.
+    void addEntry(const Value& e) {
+        const std::string& f = e.str;
+        if (isHelper(f)) {
+            // not an entry by itself
+            return;
+        } else if (f == "units") {
+            static const char* const names[] =
+                {"length", "quantity", "mass", "time", "act_energy", "energy",
+                 "pressure"};
+            Args a(e, names);
+            setUnits(m_ulen, a["length"]);
+            setUnits(m_umol, a["quantity"]);
+            setUnits(m_umass, a["mass"]);
+            setUnits(m_utime, a["time"]);
+            setUnits(m_ue, a["act_energy"]);
+            setUnits(m_uenergy, a["energy"]);
+            setUnits(m_upres, a["pressure"]);
+        } else if (f == "standard_pressure") {
+            static const char* const names[] = {"p0"};
+            Args a(e, names);
+            if (!a["p0"] || a["p0"]->kind != Value::Number) {
+                unsupported();
+            }
+            m_pref = *a["p0"];
+        } else if (f == "validate") {
+            static const char* const names[] = {"species", "reactions"};
+            Args a(e, names);
+            m_valsp = getString(a["species"], "yes");
+            m_valrxn = getString(a["reactions"], "yes");
+        } else if (f == "dataset") {
+            // only sets the name of the output file
+            static const char* const names[] = {"nm"};
+            Args a(e, names);
+            getString(a["nm"], "");
+        } else if (f == "element") {
+            m_elements.push_back(e);
+        } else if (f == "species") {
+            static const char* const names[] =
+                {"name", "atoms", "note", "thermo", "transport", "charge",
+                 "size"};
+            Args a(e, names);
+            std::string name = getString(a["name"], "missing name!");
+            if (m_speciesNames.count(name)) {
+                unsupported();
+            }
+            m_speciesNames.insert(name);
+            m_species.push_back(e);
+        } else if (f == "ideal_gas") {
+            addPhase(e);
+        } else if (f == "reaction" || f == "three_body_reaction" ||
+                   f == "falloff_reaction" ||
+                   f == "chemically_activated_reaction" ||
+                   f == "pdep_arrhenius" || f == "chebyshev_reaction") {
+            m_reactions.push_back(e);
+        } else {
+            unsupported();
+        }
+    }
+
+    void setUnits(std::string& units, const Value* v) {
+        if (truthy(v)) {
+            units = getString(v, "");
+        }
+    }
+
+    void addPhase(const Value& e) {
+        static const char* const names[] =
+            {"name", "elements", "species", "note", "reactions", "kinetics",
+             "transport", "initial_state", "options"};
+        Args a(e, names);
+        Phase p;
+        p.name = getString(a["name"], "");
+        p.elements = getString(a["elements"], "");
+        p.note = getString(a["note"], "");
+        p.kinetics = getString(a["kinetics"], "GasKinetics");
+        p.transport = getString(a["transport"], "None");
+        if (a["options"]) {
+            p.options = getStrings(a["options"], "");
+        }
+        if (p.hasOption("debug")) {
+            unsupported();
+        }
+        if (a["initial_state"]) {
+            p.initialState = *a["initial_state"];
+        }
+
+        std::vector<std::string> species = getStrings(a["species"], "");
+        for (size_t i = 0; i < species.size(); i++) {
+            const std::string& sp = species[i];
+            size_t icolon = sp.find(':');
+            if (icolon != std::string::npos && icolon > 0) {
+                p.species.push_back(make_pair(
+                    stripws(sp.substr(0, icolon)) + ".xml",
+                    sp.substr(icolon + 1)));
+            } else {
+                p.species.push_back(make_pair(std::string(), sp));
+            }
+            std::vector<std::string> toks = split(p.species.back().second);
+            for (size_t j = 0; j < toks.size(); j++) {
+                std::string s = toks[j];
+                if (s == ",") {
+                    continue;
+                }
+                if (s[0] == ',') {
+                    s = s.substr(1);
+                }
+                if (!s.empty() && s[s.size()-1] == ',') {
+                    s = s.substr(0, s.size() - 1);
+                }
+                if (s != "all" && p.speciesNames.count(s)) {
+                    unsupported();
+                }
+                p.speciesNames.insert(s);
+            }
+        }
+        if (p.speciesNames.empty()) {
+            unsupported();
+        }
+
+        const Value* rxns = a["reactions"];
+        if (rxns && !(rxns->kind == Value::String && rxns->str == "none")) {
+            std::vector<std::string> rxnStrings = getStrings(rxns, "");
+            for (size_t i = 0; i < rxnStrings.size(); i++) {
+                const std::string& r = rxnStrings[i];
+                size_t icolon = r.find(':');
+                if (icolon != std::string::npos && icolon > 0) {
+                    p.reactions.push_back(make_pair(
+                        stripws(r.substr(0, icolon)) + ".xml",
+                        r.substr(icolon + 1)));
+                } else {
+                    p.reactions.push_back(make_pair(std::string(), r));
+                }
+            }
+        }
+        m_phases.push_back(p);
+    }
+
+    void buildPhase(const Phase& p, XML_Node& ctml) {
+        addComment(ctml, "    phase " + p.name + "     ");
+        XML_Node& ph = ctml.addChild("phase");
+        ph.addAttribute("id", p.name);
+        ph.addAttribute("dim", "3");
+        addChild(ph, "elementArray", p.elements).addAttribute("datasrc",
+                "elements.xml");
+        for (size_t i = 0; i < p.species.size(); i++) {
+            XML_Node& sa = addChild(ph, "speciesArray", p.species[i].second);
+            sa.addAttribute("datasrc", p.species[i].first + "#species_data");
+            if (p.hasOption("skip_undeclared_elements")) {
+                sa.addChild("skip").addAttribute("element", "undeclared");
+            }
+        }
+        for (size_t i = 0; i < p.reactions.size(); i++) {
+            XML_Node& ra = ph.addChild("reactionArray");
+            ra.addAttribute("datasrc", p.reactions[i].first + "#reaction_data");
+            XML_Node* skip = 0;
+            if (p.hasOption("skip_undeclared_species")) {
+                skip = &ra.addChild("skip");
+                skip->addAttribute("species", "undeclared");
+            }
+            if (p.hasOption("skip_undeclared_third_bodies")) {
+                if (!skip) {
+                    skip = &ra.addChild("skip");
+                }
+                skip->addAttribute("third_bodies", "undeclared");
+            }
+            std::vector<std::string> rtoks = split(p.reactions[i].second);
+            if (rtoks.empty()) {
+                unsupported();
+            }
+            if (rtoks[0] != "all") {
+                XML_Node& inc = ra.addChild("include");
+                inc.addAttribute("min", rtoks[0]);
+                if (rtoks.size() > 2 && (rtoks[1] == "to" || rtoks[1] == "-")) {
+                    inc.addAttribute("max", rtoks[2]);
+                } else {
+                    inc.addAttribute("max", rtoks[0]);
+                }
+            }
+        }
+        if (truthy(&p.initialState)) {
+            buildState(p.initialState, ph);
+        }
+        if (!p.note.empty()) {
+            addChild(ph, "note", p.note);
+        }
+        XML_Node& thermo = ph.addChild("thermo");
+        if (p.hasOption("allow_discontinuous_thermo")) {
+            thermo.addAttribute("allow_discontinuities", "true");
+        }
+        thermo.addAttribute("model", "IdealGas");
+        ph.addChild("kinetics").addAttribute("model", p.kinetics);
+        ph.addChild("transport").addAttribute("model", p.transport);
+    }
+
+    void buildState(const Value& e, XML_Node& ph) {
+        if (e.kind != Value::Call || e.str != "state") {
+            unsupported();
+        }
+        static const char* const names[] =
+            {"temperature", "pressure", "mole_fractions", "mass_fractions",
+             "density", "coverages", "solute_molalities"};
+        Args a(e, names);
+        XML_Node& st = ph.addChild("state");
+        if (truthy(a["temperature"])) {
+            addFloat(st, "temperature", *a["temperature"], "", "K");
+        }
+        if (truthy(a["pressure"])) {
+            addFloat(st, "pressure", *a["pressure"], "", m_upres);
+        }
+        if (truthy(a["density"])) {
+            addFloat(st, "density", *a["density"], "",
+                     m_umass + "/" + m_ulen + "3");
+        }
+        const char* const strings[][2] = {
+            {"mole_fractions", "moleFractions"},
+            {"mass_fractions", "massFractions"},
+            {"coverages", "coverages"},
+            {"solute_molalities", "soluteMolalities"}
+        };
+        for (size_t i = 0; i < 4; i++) {
+            if (truthy(a[strings[i][0]])) {
+                addChild(st, strings[i][1], getString(a[strings[i][0]], ""));
+            }
+        }
+    }
+
+    void buildSpecies(const Value& e, XML_Node& sd) {
+        static const char* const names[] =
+            {"name", "atoms", "note", "thermo", "transport", "charge",
+             "size"};
+        Args a(e, names);
+        std::string name = getString(a["name"], "missing name!");
+
+        // atomic composition (see getAtomicComp in ctml_writer.py)
+        Composition atoms;
+        std::vector<std::string> toks =
+            split(replaceAll(getString(a["atoms"], ""), ",", " "));
+        for (size_t i = 0; i < toks.size(); i++) {
+            std::vector<std::string> b = split(toks[i], ':');
+            double x;
+            if (b.size() < 2) {
+                unsupported();
+            }
+            Value n;
+            if (pyInt(b[1], x)) {
+                n = numberValue(x, true);
+            } else if (pyFloat(b[1], x)) {
+                n = numberValue(x, false);
+            } else {
+                unsupported();
+            }
+            size_t k = find(atoms, b[0]);
+            if (k == npos) {
+                atoms.push_back(std::make_pair(b[0], n));
+            } else {
+                atoms[k].second = n;
+            }
+        }
+
+        Value charge = a["charge"] ? *a["charge"] : numberValue(-999, true);
+        if (charge.kind != Value::Number) {
+            unsupported();
+        }
+        size_t iE = find(atoms, "E");
+        if (iE != npos) {
+            Value chrg = atoms[iE].second;
+            chrg.num = -chrg.num;
+            if (charge.num != -999 && charge.num != chrg.num) {
+                unsupported();
+            }
+            charge = chrg;
+        }
+
+        addComment(sd, "    species " + name + "    ");
+        XML_Node& s = sd.addChild("species");
+        s.addAttribute("name", name);
+        std::string comp;
+        for (size_t i = 0; i < atoms.size(); i++) {
+            comp += atoms[i].first + ":" + repr(atoms[i].second) + " ";
+        }
+        addChild(s, "atomArray", comp);
+        if (truthy(a["note"])) {
+            addChild(s, "note", getString(a["note"], ""));
+        }
+        if (charge.num != -999) {
+            addChild(s, "charge", repr(charge));
+        }
+        if (getNumber(a["size"], 1.0) != 1.0) {
+            addChild(s, "size", repr(*a["size"]));
+        }
+
+        XML_Node& t = s.addChild("thermo");
+        if (truthy(a["thermo"])) {
+            std::vector<const Value*> thermo = getEntries(*a["thermo"]);
+            for (size_t i = 0; i < thermo.size(); i++) {
+                buildThermo(*thermo[i], t);
+            }
+        } else {
+            buildThermo(Value(), t);
+        }
+
+        if (truthy(a["transport"])) {
+            XML_Node& tr = s.addChild("transport");
+            std::vector<const Value*> trans = getEntries(*a["transport"]);
+            for (size_t i = 0; i < trans.size(); i++) {
+                buildTransport(*trans[i], tr);
+            }
+        }
+    }
+
+    //! Build a species thermo entry. A default-constructed Value is used for
+    //! the default `const_cp()` entry.
+    void buildThermo(const Value& e, XML_Node& t) {
+        if (e.kind == Value::None || e.str == "const_cp") {
+            static const char* const names[] =
+                {"t0", "cp0", "h0", "s0", "tmax", "tmin"};
+            Value dflt;
+            dflt.kind = Value::Call;
+            Args a((e.kind == Value::None) ? dflt : e, names);
+            Value zero = numberValue(0.0, false);
+            XML_Node& c = t.addChild("const_cp");
+            if (getNumber(a["tmin"], 100.0) >= 0.0) {
+                c.addAttribute("Tmin", a["tmin"] ? repr(*a["tmin"]) : "100.0");
+            }
+            if (getNumber(a["tmax"], 5000.0) >= 0.0) {
+                c.addAttribute("Tmax", a["tmax"] ? repr(*a["tmax"]) : "5000.0");
+            }
+            std::string energy = m_uenergy + "/" + m_umol;
+            Value t0 = numberValue(298.15, false);
+            addFloat(c, "t0", a["t0"] ? *a["t0"] : t0, "", "K");
+            addFloat(c, "h0", a["h0"] ? *a["h0"] : zero, "", energy);
+            addFloat(c, "s0", a["s0"] ? *a["s0"] : zero, "", energy + "/K");
+            addFloat(c, "cp0", a["cp0"] ? *a["cp0"] : zero, "", energy + "/K");
+            return;
+        }
+
+        size_t ncoeffs;
+        if (e.str == "NASA" || e.str == "Shomate") {
+            ncoeffs = 7;
+        } else if (e.str == "NASA9") {
+            ncoeffs = 9;
+        } else {
+            unsupported();
+        }
+        static const char* const names[] = {"Trange", "coeffs", "p0"};
+        Args a(e, names);
+        const Value* trange = a["Trange"];
+        const Value* coeffs = a["coeffs"];
+        if (!trange || trange->kind != Value::Sequence ||
+                trange->items.size() < 2 || !coeffs ||
+                coeffs->kind != Value::Sequence ||
+                coeffs->items.size() != ncoeffs) {
+            unsupported();
+        }
+        XML_Node& n = t.addChild(e.str);
+        n.addAttribute("Tmin", repr(trange->items[0]));
+        n.addAttribute("Tmax", repr(trange->items[1]));
+        if (getNumber(a["p0"], -1.0) <= 0.0) {
+            n.addAttribute("P0", repr(m_pref));
+        } else {
+            n.addAttribute("P0", repr(*a["p0"]));
+        }
+        std::string s;
+        for (size_t i = 0; i < ncoeffs; i++) {
+            s += fp2str(getNumber(&coeffs->items[i], 0.0), "%17.9E");
+            if (i + 1 < ncoeffs) {
+                s += (i == 7) ? "," : ", ";
+            }
+            if (i == 3 || i == 7) {
+                s += "\n";
+            }
+        }
+        XML_Node& u = addChild(n, "floatArray", s);
+        u.addAttribute("size", int2str(ncoeffs));
+        u.addAttribute("name", "coeffs");
+    }
+
+    void buildTransport(const Value& e, XML_Node& t) {
+        if (e.str != "gas_transport") {
+            unsupported();
+        }
+        static const char* const names[] =
+            {"geom", "diam", "well_depth", "dipole", "polar", "rot_relax",
+             "acentric_factor"};
+        Args a(e, names);
+        t.addAttribute("model", "gas_transport");
+        addChild(t, "string", getString(a["geom"], "nonlin"))
+            .addAttribute("title", "geometry");
+        const char* const params[][3] = {
+            {"well_depth", "LJ_welldepth", "K"},
+            {"diam", "LJ_diameter", "A"},
+            {"dipole", "dipoleMoment", "Debye"},
+            {"polar", "polarizability", "A3"},
+            {"rot_relax", "rotRelax", ""}
+        };
+        for (size_t i = 0; i < 5; i++) {
+            double x = getNumber(a[params[i][0]], 0.0);
+            XML_Node& c = addChild(t, params[i][1], fp2str(x, "%8.3f"));
+            if (params[i][2][0]) {
+                c.addAttribute("units", params[i][2]);
+            }
+        }
+        const Value* w = a["acentric_factor"];
+        if (w && w->kind != Value::None) {
+            addChild(t, "acentric_factor", fp2str(getNumber(w, 0.0), "%8.3f"));
+        }
+    }
+
+    //! Conversion factor for the pre-exponential factor of a rate constant
+    //! with the given dimensions (see `reaction.unit_factor` in
+    //! ctml_writer.py)
+    double unitFactor(double ldim, double mdim) const {
+        double len, mol, time;
+        if (m_ulen == "cm") {
+            len = 0.01;
+        } else if (m_ulen == "m") {
+            len = 1.0;
+        } else if (m_ulen == "mm") {
+            len = 0.001;
+        } else {
+            unsupported();
+        }
+        if (m_umol == "kmol") {
+            mol = 1.0;
+        } else if (m_umol == "mol") {
+            mol = 0.001;
+        } else if (m_umol == "molec") {
+            mol = 1.0 / 6.02214129e26;
+        } else {
+            unsupported();
+        }
+        if (m_utime == "s") {
+            time = 1.0;
+        } else if (m_utime == "min") {
+            time = 60.0;
+        } else if (m_utime == "hr") {
+            time = 3600.0;
+        } else {
+            unsupported();
+        }
+        return std::pow(len, -ldim) * std::pow(mol, -mdim) / time;
+    }
+
+    void buildArrhenius(XML_Node& kfnode, const Value* kf, double factor,
+                        const std::string& name) {
+        const Value* A;
+        const Value* b;
+        const Value* E;
+        const Value* type = 0;
+        if (kf && kf->kind == Value::Call) {
+            if (kf->str != "Arrhenius") {
+                unsupported();
+            }
+            static const char* const names[] =
+                {"A", "b", "E", "coverage", "rate_type", "n"};
+            Args a(*kf, names);
+            if (a["n"] || truthy(a["coverage"])) {
+                unsupported();
+            }
+            A = a["A"];
+            b = a["b"];
+            E = a["E"];
+            type = a["rate_type"];
+        } else if (kf && kf->kind == Value::Sequence && kf->items.size() >= 3) {
+            A = &kf->items[0];
+            b = &kf->items[1];
+            E = &kf->items[2];
+        } else {
+            unsupported();
+        }
+        Value zero = numberValue(0.0, false);
+        XML_Node& a = kfnode.addChild("Arrhenius");
+        if (!name.empty()) {
+            a.addAttribute("name", name);
+        }
+        if (truthy(type)) {
+            if (getString(type, "") == "stick") {
+                unsupported();
+            }
+            a.addAttribute("type", type->str);
+        }
+        if (!A) {
+            A = &zero;
+        }
+        if (A->kind == Value::Number) {
+            addFloat(a, "A", numberValue(A->num * factor, false), "%14.6E");
+        } else {
+            if (A->kind == Value::Sequence && A->items.size() == 2 &&
+                    A->items[1].kind == Value::String &&
+                    A->items[1].str == "/site") {
+                unsupported();
+            }
+            addFloat(a, "A", *A, "%14.6E");
+        }
+        addChild(a, "b", repr(b ? *b : zero));
+        addFloat(a, "E", E ? *E : zero, "%f", m_ue);
+    }
+
+    void buildFalloff(XML_Node& kfnode, const Value* f) {
+        std::string type = "Lindemann";
+        std::vector<double> params;
+        if (f && f->kind != Value::None) {
+            if (f->kind != Value::Call) {
+                unsupported();
+            }
+            type = f->str;
+            if (type == "Troe") {
+                static const char* const names[] = {"A", "T3", "T1", "T2"};
+                Args a(*f, names);
+                params.push_back(getNumber(a["A"], 0.0));
+                params.push_back(getNumber(a["T3"], 0.0));
+                params.push_back(getNumber(a["T1"], 0.0));
+                if (getNumber(a["T2"], -999.9) != -999.9) {
+                    params.push_back(a["T2"]->num);
+                }
+            } else if (type == "SRI") {
+                static const char* const names[] = {"A", "B", "C", "D", "E"};
+                Args a(*f, names);
+                params.push_back(getNumber(a["A"], 0.0));
+                params.push_back(getNumber(a["B"], 0.0));
+                params.push_back(getNumber(a["C"], 0.0));
+                if (getNumber(a["D"], -999.9) != -999.9 &&
+                        getNumber(a["E"], -999.9) != -999.9) {
+                    params.push_back(a["D"]->num);
+                    params.push_back(a["E"]->num);
+                }
+            } else if (type != "Lindemann" || !f->items.empty() ||
+                       !f->kwNames.empty()) {
+                unsupported();
+            }
+        }
+        std::string s;
+        for (size_t i = 0; i < params.size(); i++) {
+            s += fp2str(params[i], "%g") + " ";
+        }
+        addChild(kfnode, "falloff", s).addAttribute("type", type);
+    }
+
+    bool hasSpecies(const std::string& name) const {
+        for (size_t i = 0; i < m_phases.size(); i++) {
+            if (m_phases[i].speciesNames.count(name)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Build a reaction entry, following the `reaction` class and its
+    //! subclasses in ctml_writer.py.
+    void buildReaction(const Value& e, size_t number, XML_Node& rd) {
+        const std::string& f = e.str;
+        std::string type;
+        const Value* equation;
+        const Value* id;
+        const Value* order = 0;
+        const Value* options;
+        const Value* eff = 0;
+        const Value* falloff = 0;
+        std::vector<const Value*> rates;
+        std::vector<Value> plogRates;
+        std::vector<const Value*> pressures;
+        Value plogHead;
+        Value cheb[5];
+
+        if (f == "reaction") {
+            static const char* const names[] =
+                {"equation", "kf", "id", "order", "options"};
+            Args a(e, names);
+            equation = a["equation"];
+            rates.push_back(a["kf"]);
+            id = a["id"];
+            order = a["order"];
+            options = a["options"];
+        } else if (f == "three_body_reaction") {
+            static const char* const names[] =
+                {"equation", "kf", "efficiencies", "id", "options"};
+            Args a(e, names);
+            type = "threeBody";
+            equation = a["equation"];
+            rates.push_back(a["kf"]);
+            eff = a["efficiencies"];
+            id = a["id"];
+            options = a["options"];
+        } else if (f == "falloff_reaction" ||
+                   f == "chemically_activated_reaction") {
+            bool fo = (f == "falloff_reaction");
+            static const char* const falloffNames[] =
+                {"equation", "kf0", "kf", "efficiencies", "falloff", "id",
+                 "options"};
+            static const char* const chemActNames[] =
+                {"equation", "kLow", "kHigh", "efficiencies", "falloff", "id",
+                 "options"};
+            Args a = fo ? Args(e, falloffNames) : Args(e, chemActNames);
+            type = fo ? "falloff" : "chemAct";
+            equation = a["equation"];
+            const Value* k1 = a[fo ? "kf" : "kLow"];
+            const Value* k2 = a[fo ? "kf0" : "kHigh"];
+            if (!equation || !k1 || !k2) {
+                unsupported();
+            }
+            rates.push_back(k1);
+            rates.push_back(k2);
+            eff = a["efficiencies"];
+            falloff = a["falloff"];
+            id = a["id"];
+            options = a["options"];
+        } else if (f == "pdep_arrhenius") {
+            // the equation, followed by any number of (P, A, b, E) tuples
+            plogHead = e;
+            plogHead.items.resize(std::min<size_t>(e.items.size(), 1));
+            static const char* const names[] =
+                {"equation", "id", "order", "options"};
+            Args a(plogHead, names, 1);
+            type = "plog";
+            equation = a["equation"];
+            id = a["id"];
+            order = a["order"];
+            options = a["options"];
+            for (size_t i = 1; i < e.items.size(); i++) {
+                const Value& p = e.items[i];
+                if (p.kind != Value::Sequence || p.items.size() != 4) {
+                    unsupported();
+                }
+                pressures.push_back(&p.items[0]);
+                plogRates.push_back(p);
+                plogRates.back().items.erase(plogRates.back().items.begin());
+            }
+            for (size_t i = 0; i < plogRates.size(); i++) {
+                rates.push_back(&plogRates[i]);
+            }
+        } else {
+            static const char* const names[] =
+                {"equation", "Tmin", "Tmax", "Pmin", "Pmax", "coeffs", "kf",
+                 "id", "order", "options"};
+            Args a(e, names, 6);
+            type = "chebyshev";
+            equation = a["equation"];
+            id = a["id"];
+            order = a["order"];
+            options = a["options"];
+            cheb[0] = a["Tmin"] ? *a["Tmin"] : numberValue(300.0, false);
+            cheb[1] = a["Tmax"] ? *a["Tmax"] : numberValue(2500.0, false);
+            Value p;
+            p.kind = Value::Sequence;
+            p.items.push_back(numberValue(0.001, false));
+            p.items.push_back(stringValue("atm"));
+            cheb[2] = a["Pmin"] ? *a["Pmin"] : p;
+            p.items[0] = numberValue(100.0, false);
+            cheb[3] = a["Pmax"] ? *a["Pmax"] : p;
+            if (!a["coeffs"]) {
+                unsupported();
+            }
+            cheb[4] = *a["coeffs"];
+        }
+
+        // reactants and products
+        std::string eqn = getString(equation, "");
+        const char* seps[] = {"<=>", "=>", "="};
+        size_t pos = npos, len = 0;
+        bool reversible = true;
+        for (size_t i = 0; i < 3; i++) {
+            pos = eqn.find(seps[i]);
+            if (pos != npos) {
+                len = strlen(seps[i]);
+                reversible = (i != 1);
+                if (eqn.find(seps[i], pos + len) != npos) {
+                    unsupported();
+                }
+                break;
+            }
+        }
+        if (pos == npos) {
+            unsupported();
+        }
+        Composition r = reactionSpecies(eqn.substr(0, pos));
+        Composition p = reactionSpecies(eqn.substr(pos + len));
+        Composition rxnorder = r;
+        std::string orderString = getString(order, "");
+        if (!orderString.empty()) {
+            std::vector<std::string> toks = split(orderString);
+            for (size_t i = 0; i < toks.size(); i++) {
+                std::vector<std::string> kv = split(toks[i], ':');
+                double x;
+                if (kv.size() != 2 || !pyFloat(kv[1], x)) {
+                    unsupported();
+                }
+                size_t k = find(rxnorder, kv[0]);
+                if (k == npos) {
+                    unsupported();
+                }
+                rxnorder[k].second = numberValue(x, false);
+            }
+        }
+
+        // remove third bodies from the reactants and products
+        std::string effString = getString(eff, "");
+        double effm = 1.0;
+        if (type == "threeBody") {
+            for (size_t i = r.size(); i-- > 0;) {
+                if (r[i].first == "M" || r[i].first == "m") {
+                    r.erase(r.begin() + i);
+                }
+            }
+            for (size_t i = p.size(); i-- > 0;) {
+                if (p[i].first == "M" || p[i].first == "m") {
+                    p.erase(p.begin() + i);
+                }
+            }
+        } else if (type == "falloff" || type == "chemAct") {
+            erase(r, "(+");
+            erase(p, "(+");
+            if (find(r, "M)") != npos) {
+                erase(r, "M)");
+                erase(p, "M)");
+            } else if (find(r, "m)") != npos) {
+                erase(r, "m)");
+                erase(p, "m)");
+            } else {
+                Composition r0 = r;
+                for (size_t i = 0; i < r0.size(); i++) {
+                    const std::string& s = r0[i].first;
+                    if (s[s.size()-1] == ')' && s.find('(') == npos) {
+                        if (!effString.empty()) {
+                            unsupported();
+                        }
+                        effString = s.substr(0, s.size() - 1) + ":1.0";
+                        effm = 0.0;
+                        erase(r, s);
+                        erase(p, s);
+                    }
+                }
+            }
+        } else if (type == "chebyshev") {
+            const char* thirdBody[] = {"(+", "M)", "m)"};
+            for (size_t i = 0; i < 3; i++) {
+                if (find(r, thirdBody[i]) != npos) {
+                    erase(r, thirdBody[i]);
+                    erase(p, thirdBody[i]);
+                }
+            }
+        }
+
+        // reaction order, in terms of the number of moles and length
+        double mdim = 0.0, ldim = 0.0;
+        for (size_t i = 0; i < r.size(); i++) {
+            if (!hasSpecies(r[i].first)) {
+                unsupported();
+            }
+            double ns = rxnorder[find(rxnorder, r[i].first)].second.num;
+            mdim += ns;
+            ldim -= 3.0 * ns;
+        }
+
+        std::string idString = truthy(id) ? getString(id, "") :
+                               int2str(int(number), "%04i");
+        addComment(rd, "   reaction " + idString + "    ");
+        XML_Node& rx = rd.addChild("reaction");
+        rx.addAttribute("id", idString);
+        rx.addAttribute("reversible", reversible ? "yes" : "no");
+        std::vector<std::string> opts;
+        if (options) {
+            opts = getStrings(options, "");
+        }
+        const char* flags[] = {"duplicate", "negative_A", "negative_orders"};
+        for (size_t i = 0; i < 3; i++) {
+            if (std::find(opts.begin(), opts.end(), flags[i]) != opts.end()) {
+                rx.addAttribute(flags[i], "yes");
+            }
+        }
+        std::string ee = eqn;
+        std::replace(ee.begin(), ee.end(), '<', '[');
+        std::replace(ee.begin(), ee.end(), '>', ']');
+        addChild(rx, "equation", ee);
+        if (!orderString.empty()) {
+            for (size_t i = 0; i < rxnorder.size(); i++) {
+                addChild(rx, "order", repr(rxnorder[i].second))
+                    .addAttribute("species", rxnorder[i].first);
+            }
+        }
+        mdim -= 1.0;
+        ldim += 3.0;
+        if (!type.empty()) {
+            rx.addAttribute("type", type);
+        }
+
+        XML_Node& kfnode = rx.addChild("rateCoeff");
+        if (type == "threeBody") {
+            mdim += 1.0;
+            ldim -= 3.0;
+        }
+        std::string name;
+        for (size_t i = 0; i < rates.size(); i++) {
+            buildArrhenius(kfnode, rates[i], unitFactor(ldim, mdim), name);
+            if (type == "falloff") {
+                mdim += 1.0;
+                ldim -= 3.0;
+                name = "k0";
+            } else if (type == "chemAct") {
+                mdim -= 1.0;
+                ldim += 3.0;
+                name = "kHigh";
+            }
+        }
+        addChild(rx, "reactants", compositionString(r));
+        addChild(rx, "products", compositionString(p));
+
+        if (type == "threeBody" && !effString.empty()) {
+            addChild(kfnode, "efficiencies", effString)
+                .addAttribute("default", "1.0");
+        } else if (type == "falloff" || type == "chemAct") {
+            if (!effString.empty() && effm >= 0.0) {
+                addChild(kfnode, "efficiencies", effString)
+                    .addAttribute("default", reprFloat(effm));
+            }
+            buildFalloff(kfnode, falloff);
+        } else if (type == "plog") {
+            for (size_t i = 0; i < pressures.size(); i++) {
+                addFloat(*kfnode.children()[i], "P", *pressures[i]);
+            }
+        } else if (type == "chebyshev") {
+            addFloat(kfnode, "Tmin", cheb[0]);
+            addFloat(kfnode, "Tmax", cheb[1]);
+            addFloat(kfnode, "Pmin", cheb[2]);
+            addFloat(kfnode, "Pmax", cheb[3]);
+            Value& coeffs = cheb[4];
+            if (coeffs.kind != Value::Sequence || coeffs.items.empty() ||
+                    coeffs.items[0].kind != Value::Sequence ||
+                    coeffs.items[0].items.empty()) {
+                unsupported();
+            }
+            Value& c00 = coeffs.items[0].items[0];
+            c00 = numberValue(getNumber(&c00, 0.0) +
+                              std::log10(unitFactor(ldim, mdim)), false);
+            std::string s;
+            for (size_t i = 0; i < coeffs.items.size(); i++) {
+                const Value& line = coeffs.items[i];
+                if (line.kind != Value::Sequence) {
+                    unsupported();
+                }
+                for (size_t j = 0; j < line.items.size(); j++) {
+                    s += (j ? ", " : "") +
+                         fp2str(getNumber(&line.items[j], 0.0), "%12.5e");
+                }
+                if (i + 1 < coeffs.items.size()) {
+                    s += ",\n";
+                }
+            }
+            XML_Node& c = addChild(kfnode, "floatArray", s);
+            c.addAttribute("name", "coeffs");
+            c.addAttribute("degreeT", int2str(coeffs.items.size()));
+            c.addAttribute("degreeP", int2str(coeffs.items[0].items.size()));
+        }
+    }
+
+    // default units and standard-state pressure
+    std::string m_ulen, m_umol, m_umass, m_utime, m_ue, m_uenergy, m_upres;
+    Value m_pref;
+
+    // options set by the validate() entry
+    std::string m_valsp, m_valrxn;
+
+    std::vector<Value> m_elements;
+    std::vector<Value> m_species;
+    std::set<std::string> m_speciesNames;
+    std::vector<Phase> m_phases;
+    std::vector<Value> m_reactions;
+
+    //! Predefined constants and variables assigned in the input file
+    std::map<std::string, Value> m_vars;
+
+    std::vector<Token> m_tokens;
+    size_t m_pos;
+};
+
+} // end unnamed namespace
+
+bool ct2ctml_native(const std::string& cti, XML_Node& root)
+{
+    XML_Node* ctml = new XML_Node("ctml");
+    try {
+        CtiConverter converter;
+        converter.parse(cti);
+        converter.build(*ctml);
+    } catch (Unsupported&) {
+        delete ctml;
+        return false;
+    } catch (...) {
+        delete ctml;
+        throw;
+    }
+    root.mergeAsChild(*ctml);
+    return true;
+}
+
+}
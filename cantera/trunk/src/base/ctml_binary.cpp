@@ -0,0 +1,312 @@
+/**
+ * @file ctml_binary.cpp
+ * Reading and writing XML trees in the binary CTML format, a cache of the
+ * parsed tree of an input file (see \ref inputfiles).
+ */
+
+#include "cantera/base/ctml.h"
+#include "cantera/base/stringUtils.h"
+
+#include <fstream>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace Cantera;
+using namespace std;
+
+namespace ctml
+{
+
+// unnamed namespace for the description of the file layout
+namespace
+{
+
+//! Version of the binary CTML format
+const unsigned int BinaryVersion = 1;
+
+//! Value used to detect files written with a different byte order
+const unsigned int ByteOrderMark = 0x01020304;
+
+//! Index used for the parent of the root node
+const unsigned int NoParent = 0xffffffff;
+
+/*!
+ * A binary CTML file consists of the following sections, each of which is
+ * an array of the structures below. All integers are unsigned 32-bit
+ * values in the byte order of the writing machine.
+ *
+ *  - header
+ *  - string table: nStrings entries
+ *  - node table: nNodes entries, in depth-first order, so that each node
+ *    follows its parent and the children of each node appear in order
+ *  - attribute table: nAttribs entries, with the attributes of each node
+ *    stored contiguously
+ *  - string data: stringBytes characters
+ */
+struct Header {
+    char magic[8];
+    unsigned int version;
+    unsigned int byteOrder;
+    unsigned int nStrings;
+    unsigned int nNodes;
+    unsigned int nAttribs;
+    unsigned int stringBytes;
+};
+
+struct StringEntry {
+    unsigned int offset;
+    unsigned int length;
+};
+
+struct NodeEntry {
+    unsigned int name;
+    unsigned int value;
+    unsigned int parent;
+    unsigned int firstAttrib;
+    unsigned int nAttribs;
+};
+
+struct AttribEntry {
+    unsigned int key;
+    unsigned int value;
+};
+
+const char Magic[8] = {'C', 'T', 'M', 'L', 'B', 'I', 'N', '\0'};
+
+//! Tables accumulated while writing a tree
+class BinaryWriter
+{
+public:
+    unsigned int addString(const std::string& s) {
+        std::map<std::string, unsigned int>::const_iterator iter =
+            m_index.find(s);
+        if (iter != m_index.end()) {
+            return iter->second;
+        }
+        StringEntry e;
+        e.offset = static_cast<unsigned int>(m_data.size());
+        e.length = static_cast<unsigned int>(s.size());
+        m_data.append(s);
+        m_data.push_back('\0');
+        unsigned int k = static_cast<unsigned int>(m_strings.size());
+        m_strings.push_back(e);
+        m_index[s] = k;
+        return k;
+    }
+
+    void addNode(const XML_Node& node, unsigned int parent) {
+        NodeEntry e;
+        e.name = addString(node.name());
+        e.value = addString(node.value());
+        e.parent = parent;
+        const std::map<std::string, std::string>& attribs =
+            node.attribsConst();
+        e.firstAttrib = static_cast<unsigned int>(m_attribs.size());
+        e.nAttribs = static_cast<unsigned int>(attribs.size());
+        for (std::map<std::string, std::string>::const_iterator iter =
+                    attribs.begin(); iter != attribs.end(); ++iter) {
+            AttribEntry a;
+            a.key = addString(iter->first);
+            a.value = addString(iter->second);
+            m_attribs.push_back(a);
+        }
+        unsigned int k = static_cast<unsigned int>(m_nodes.size());
+        m_nodes.push_back(e);
+        const std::vector<XML_Node*>& children = node.children();
+        for (size_t i = 0; i < children.size(); i++) {
+            addNode(*children[i], k);
+        }
+    }
+
+    std::map<std::string, unsigned int> m_index;
+    std::vector<StringEntry> m_strings;
+    std::vector<NodeEntry> m_nodes;
+    std::vector<AttribEntry> m_attribs;
+    std::string m_data;
+};
+
+//! Contents of a file, memory-mapped if possible
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& file) : m_data(0), m_size(0) {
+#ifdef _WIN32
+        std::ifstream s(file.c_str(), std::ios::binary);
+        if (!s) {
+            throw CanteraError("readBinaryCTML",
+                               "cannot open " + file + " for reading");
+        }
+        s.seekg(0, std::ios::end);
+        m_size = static_cast<size_t>(s.tellg());
+        s.seekg(0, std::ios::beg);
+        m_buffer.resize(m_size);
+        if (m_size) {
+            s.read(&m_buffer[0], m_size);
+            m_data = &m_buffer[0];
+        }
+#else
+        int fd = open(file.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw CanteraError("readBinaryCTML",
+                               "cannot open " + file + " for reading");
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw CanteraError("readBinaryCTML", "cannot stat " + file);
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        if (m_size) {
+            void* p = mmap(0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                close(fd);
+                throw CanteraError("readBinaryCTML", "cannot map " + file);
+            }
+            m_data = static_cast<const char*>(p);
+        }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (m_data) {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+#endif
+    }
+
+    const char* m_data;
+    size_t m_size;
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+#ifdef _WIN32
+    std::vector<char> m_buffer;
+#endif
+};
+
+} // end unnamed namespace
+
+void writeBinaryCTML(const XML_Node& root, const std::string& file)
+{
+    BinaryWriter w;
+    w.addNode(root, NoParent);
+
+    Header h;
+    std::memcpy(h.magic, Magic, sizeof(Magic));
+    h.version = BinaryVersion;
+    h.byteOrder = ByteOrderMark;
+    h.nStrings = static_cast<unsigned int>(w.m_strings.size());
+    h.nNodes = static_cast<unsigned int>(w.m_nodes.size());
+    h.nAttribs = static_cast<unsigned int>(w.m_attribs.size());
+    h.stringBytes = static_cast<unsigned int>(w.m_data.size());
+
+    std::ofstream s(file.c_str(), std::ios::binary);
+    if (!s) {
+        throw CanteraError("writeBinaryCTML",
+                           "cannot open " + file + " for writing");
+    }
+    s.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    s.write(reinterpret_cast<const char*>(&w.m_strings[0]),
+            w.m_strings.size() * sizeof(StringEntry));
+    s.write(reinterpret_cast<const char*>(&w.m_nodes[0]),
+            w.m_nodes.size() * sizeof(NodeEntry));
+    if (!w.m_attribs.empty()) {
+        s.write(reinterpret_cast<const char*>(&w.m_attribs[0]),
+                w.m_attribs.size() * sizeof(AttribEntry));
+    }
+    s.write(w.m_data.data(), w.m_data.size());
+    if (!s) {
+        throw CanteraError("writeBinaryCTML", "error writing " + file);
+    }
+}
+
+void readBinaryCTML(const std::string& file, XML_Node& root)
+{
+    MappedFile f(file);
+    Header h;
+    if (f.m_size < sizeof(Header)) {
+        throw CanteraError("readBinaryCTML",
+                           file + " is not a binary CTML file");
+    }
+    std::memcpy(&h, f.m_data, sizeof(Header));
+    if (std::memcmp(h.magic, Magic, sizeof(Magic)) != 0) {
+        throw CanteraError("readBinaryCTML",
+                           file + " is not a binary CTML file");
+    }
+    if (h.byteOrder != ByteOrderMark) {
+        throw CanteraError("readBinaryCTML", file + " was written on a "
+                           "machine with a different byte order");
+    }
+    if (h.version != BinaryVersion) {
+        throw CanteraError("readBinaryCTML", file + " has unsupported "
+                           "version " + int2str(int(h.version)));
+    }
+    size_t size = sizeof(Header) + h.nStrings * sizeof(StringEntry) +
+                  h.nNodes * sizeof(NodeEntry) +
+                  h.nAttribs * sizeof(AttribEntry) + h.stringBytes;
+    if (f.m_size != size || h.nNodes == 0) {
+        throw CanteraError("readBinaryCTML", file + " is truncated or "
+                           "corrupted");
+    }
+
+    // The sections follow the header, and are suitably aligned since all of
+    // the entries consist of 32-bit integers.
+    const StringEntry* strings =
+        reinterpret_cast<const StringEntry*>(f.m_data + sizeof(Header));
+    const NodeEntry* nodes =
+        reinterpret_cast<const NodeEntry*>(strings + h.nStrings);
+    const AttribEntry* attribs =
+        reinterpret_cast<const AttribEntry*>(nodes + h.nNodes);
+    const char* data = reinterpret_cast<const char*>(attribs + h.nAttribs);
+
+    std::vector<std::string> str(h.nStrings);
+    for (size_t k = 0; k < h.nStrings; k++) {
+        if (strings[k].offset > h.stringBytes ||
+                strings[k].length > h.stringBytes - strings[k].offset) {
+            throw CanteraError("readBinaryCTML", file + " is corrupted");
+        }
+        str[k].assign(data + strings[k].offset, strings[k].length);
+    }
+
+    std::vector<XML_Node*> built(h.nNodes, 0);
+    for (size_t k = 0; k < h.nNodes; k++) {
+        const NodeEntry& e = nodes[k];
+        if (e.name >= h.nStrings || e.value >= h.nStrings ||
+                e.firstAttrib > h.nAttribs ||
+                e.nAttribs > h.nAttribs - e.firstAttrib ||
+                (k == 0) != (e.parent == NoParent) ||
+                (k > 0 && e.parent >= k)) {
+            throw CanteraError("readBinaryCTML", file + " is corrupted");
+        }
+        XML_Node* node;
+        if (k == 0) {
+            node = &root;
+            node->setName(str[e.name]);
+            node->addValue(str[e.value]);
+        } else {
+            // comments are restored as children named "comment"
+            node = &built[e.parent]->addChild(str[e.name], str[e.value]);
+        }
+        for (size_t i = e.firstAttrib; i < e.firstAttrib + e.nAttribs; i++) {
+            if (attribs[i].key >= h.nStrings ||
+                    attribs[i].value >= h.nStrings) {
+                throw CanteraError("readBinaryCTML", file + " is corrupted");
+            }
+            node->addAttribute(str[attribs[i].key], str[attribs[i].value]);
+        }
+        built[k] = node;
+    }
+}
+
+}
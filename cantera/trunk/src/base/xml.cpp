@@ -109,15 +109,29 @@ public:
 
 XML_Reader::XML_Reader(std::istream& input) :
     m_s(input),
+    m_pos(0),
+    m_eof(false),
     m_line(0)
 {
+    // Reading the whole stream in large blocks avoids the overhead of
+    // extracting each character from the stream separately
+    char block[8192];
+    std::streamsize n;
+    while ((n = m_s.rdbuf()->sgetn(block, sizeof(block))) > 0) {
+        m_buffer.append(block, static_cast<size_t>(n));
+    }
+    m_s.setstate(std::ios::eofbit);
 }
 
 void XML_Reader::getchr(char& ch)
 {
-    m_s.get(ch);
-    if (ch == '\n') {
-        m_line++;
+    if (m_pos < m_buffer.size()) {
+        ch = m_buffer[m_pos++];
+        if (ch == '\n') {
+            m_line++;
+        }
+    } else {
+        m_eof = true;
     }
 }
 
@@ -236,13 +250,13 @@ std::string XML_Reader::readTag(std::map<std::string, std::string>& attribs)
     bool incomment = false;
     char ch  = '-';
     while (1) {
-        if (m_s.eof() || (getchr(ch), ch == '<')) {
+        if (m_eof || (getchr(ch), ch == '<')) {
             break;
         }
     }
     char ch1 = ' ', ch2 = ' ';
     while (1) {
-        if (m_s.eof()) {
+        if (m_eof) {
             tag = "EOF";
             break;
         }
@@ -283,7 +297,7 @@ std::string XML_Reader::readValue()
     ch = '\n';
     bool front = true;
     while (1) {
-        if (m_s.eof()) {
+        if (m_eof) {
             break;
         }
         lastch = ch;
@@ -294,7 +308,7 @@ std::string XML_Reader::readValue()
             front = false;
         }
         if (ch == '<') {
-            m_s.putback(ch);
+            m_pos--;
             break;
         }
         if (front && lastch == ' ' && ch == ' ') {
@@ -308,13 +322,66 @@ std::string XML_Reader::readValue()
 
 //////////////////////////  XML_Node  /////////////////////////////////
 
+//! Index of the nodes in a tree by the values of their "id" and "name"
+//! attributes.
+/*!
+ * For each value, the matching nodes are listed in the order in which a
+ * depth-first search of the tree visits them, together with their depth below
+ * the root of the tree. The first node in such a list which is within the
+ * depth limit of a search is then the node which the search would find.
+ */
+class XML_Node::Index
+{
+public:
+    typedef std::vector<std::pair<XML_Node*, int> > NodeList;
+
+    //! Add *node*, which is *depth* levels below the root, and its children
+    void add(XML_Node* node, int depth) {
+        const map<string, string>& attribs = node->attribsConst();
+        map<string, string>::const_iterator iter = attribs.find("id");
+        if (iter != attribs.end()) {
+            m_ids[iter->second].push_back(make_pair(node, depth));
+        }
+        iter = attribs.find("name");
+        if (iter != attribs.end()) {
+            m_names[iter->second].push_back(make_pair(node, depth));
+        }
+        for (size_t i = 0; i < node->nChildren(); i++) {
+            add(&node->child(i), depth + 1);
+        }
+    }
+
+    //! The nodes where the attribute *attr* has the value *val*, or 0 if
+    //! the attribute is not indexed.
+    const NodeList* find(const std::string& attr, const std::string& val) const {
+        const map<string, NodeList>* nodes;
+        if (attr == "id") {
+            nodes = &m_ids;
+        } else if (attr == "name") {
+            nodes = &m_names;
+        } else {
+            return 0;
+        }
+        map<string, NodeList>::const_iterator iter = nodes->find(val);
+        return (iter != nodes->end()) ? &iter->second : &m_none;
+    }
+
+private:
+    map<string, NodeList> m_ids;
+    map<string, NodeList> m_names;
+
+    //! Empty list returned when no node matches
+    NodeList m_none;
+};
+
 XML_Node::XML_Node(const std::string& nm, XML_Node* const parent_) :
     m_name(nm),
     m_parent(parent_),
     m_root(0),
     m_locked(false),
     m_iscomment(false),
-    m_linenum(0)
+    m_linenum(0),
+    m_index(0)
 {
     if (!parent_) {
         m_root = this;
@@ -328,7 +395,8 @@ XML_Node::XML_Node(const XML_Node& right) :
     m_root(0),
     m_locked(false),
     m_iscomment(right.m_iscomment),
-    m_linenum(right.m_linenum)
+    m_linenum(right.m_linenum),
+    m_index(0)
 {
     m_root = this;
     m_name = right.m_name;
@@ -339,6 +407,7 @@ XML_Node::XML_Node(const XML_Node& right) :
 XML_Node& XML_Node::operator=(const XML_Node& right)
 {
     if (&right != this) {
+        dropIndex();
         for (size_t i = 0; i < m_children.size(); i++) {
             if (m_children[i]) {
                 if (m_children[i]->parent() == this) {
@@ -358,6 +427,7 @@ XML_Node::~XML_Node()
     if (m_locked) {
         writelog("XML_Node::~XML_Node: deleted a locked XML_Node: "+name());
     }
+    delete m_index;
     for (size_t i = 0; i < m_children.size(); i++) {
         if (m_children[i]) {
             if (m_children[i]->parent() == this) {
@@ -370,6 +440,7 @@ XML_Node::~XML_Node()
 
 void XML_Node::clear()
 {
+    dropIndex();
     for (size_t i = 0; i < m_children.size(); i++) {
         if (m_children[i]) {
             if (m_children[i]->parent() == this) {
@@ -395,6 +466,8 @@ void XML_Node::addComment(const std::string& comment)
 
 XML_Node& XML_Node::mergeAsChild(XML_Node& node)
 {
+    dropIndex();
+    node.dropIndex();
     m_children.push_back(&node);
     m_childindex.insert(pair<const std::string, XML_Node*>(node.name(),  m_children.back()));
     node.setRoot(root());
@@ -433,6 +506,7 @@ void XML_Node::removeChild(const XML_Node* const node)
     i = find(m_children.begin(), m_children.end(), node);
     m_children.erase(i);
     m_childindex.erase(node->name());
+    dropIndex();
 }
 
 std::string XML_Node::id() const
@@ -490,22 +564,26 @@ std::string XML_Node::operator()(const std::string& loc) const
 
 void XML_Node::addAttribute(const std::string& attrib, const std::string& value)
 {
+    dropIndex();
     m_attribs[attrib] = value;
 }
 
 void XML_Node::addAttribute(const std::string& attrib,
                             const doublereal vvalue, const std::string& fmt)
 {
+    dropIndex();
     m_attribs[attrib] = fp2str(vvalue, fmt);
 }
 
 void XML_Node::addAttribute(const std::string& aattrib, const int vvalue)
 {
+    dropIndex();
     m_attribs[aattrib] = int2str(vvalue);
 }
 
 void XML_Node::addAttribute(const std::string& aattrib, const size_t vvalue)
 {
+    dropIndex();
     m_attribs[aattrib] = int2str(vvalue);
 }
 
@@ -521,6 +599,8 @@ std::string XML_Node::attrib(const std::string& attr) const
 
 std::map<std::string,std::string>& XML_Node::attribs()
 {
+    // the attributes may be modified through the returned reference
+    dropIndex();
     return m_attribs;
 }
 
@@ -605,6 +685,23 @@ void XML_Node::_require(const std::string& a, const std::string& v) const
 XML_Node* XML_Node::findNameID(const std::string& nameTarget,
                                const std::string& idTarget) const
 {
+    if (m_index && idTarget != "") {
+        // The order in which this search visits the nodes differs from the
+        // order of the index, so the index only decides the result when
+        // there is at most one match.
+        const Index::NodeList& nodes = *m_index->find("id", idTarget);
+        XML_Node* match = 0;
+        size_t nMatches = 0;
+        for (size_t i = 0; i < nodes.size(); i++) {
+            if (nodes[i].first->name() == nameTarget) {
+                match = nodes[i].first;
+                nMatches++;
+            }
+        }
+        if (nMatches <= 1) {
+            return match;
+        }
+    }
     XML_Node* scResult = 0;
     XML_Node* sc;
     std::string idattrib = id();
@@ -674,6 +771,9 @@ XML_Node* XML_Node::findNameIDIndex(const std::string& nameTarget,
 
 XML_Node* XML_Node::findID(const std::string& id_, const int depth) const
 {
+    if (m_index) {
+        return findByAttr("id", id_, depth);
+    }
     if (hasAttrib("id")) {
         if (attrib("id") == id_) {
             return const_cast<XML_Node*>(this);
@@ -694,6 +794,17 @@ XML_Node* XML_Node::findID(const std::string& id_, const int depth) const
 XML_Node* XML_Node::findByAttr(const std::string& attr,
                                const std::string& val, int depth) const
 {
+    if (m_index) {
+        const Index::NodeList* nodes = m_index->find(attr, val);
+        if (nodes) {
+            for (size_t i = 0; i < nodes->size(); i++) {
+                if ((*nodes)[i].second <= depth) {
+                    return (*nodes)[i].first;
+                }
+            }
+            return 0;
+        }
+    }
     if (hasAttrib(attr)) {
         if (attrib(attr) == val) {
             return const_cast<XML_Node*>(this);
@@ -757,7 +868,7 @@ void XML_Node::build(std::istream& f)
     string nm, nm2, val;
     XML_Node* node = this;
     map<string, string> node_attribs;
-    while (!f.eof()) {
+    while (!r.eof()) {
         node_attribs.clear();
         nm = r.readTag(node_attribs);
 
@@ -772,7 +883,7 @@ void XML_Node::build(std::istream& f)
             nm2 = nm.substr(0,nm.size()-1);
             node = &node->addChild(nm2);
             node->addValue("");
-            node->attribs() = node_attribs;
+            node->attribs().swap(node_attribs);
             node->setLineNumber(lnum);
             node = node->parent();
         } else if (nm[0] != '/') {
@@ -780,7 +891,7 @@ void XML_Node::build(std::istream& f)
                 node = &node->addChild(nm);
                 val = r.readValue();
                 node->addValue(val);
-                node->attribs() = node_attribs;
+                node->attribs().swap(node_attribs);
                 node->setLineNumber(lnum);
             } else if (nm.substr(0,2) == "--") {
                 if (nm.substr(nm.size()-2,2) == "--") {
@@ -881,6 +992,11 @@ void XML_Node::lock()
     for (size_t i = 0; i < m_children.size(); i++) {
         m_children[i]->lock();
     }
+    if (m_root == this) {
+        delete m_index;
+        m_index = new Index();
+        m_index->add(this, 0);
+    }
 }
 
 void XML_Node::unlock()
@@ -889,6 +1005,17 @@ void XML_Node::unlock()
     for (size_t i = 0; i < m_children.size(); i++) {
         m_children[i]->unlock();
     }
+    if (m_root == this) {
+        dropIndex();
+    }
+}
+
+void XML_Node::dropIndex()
+{
+    if (m_root->m_index) {
+        delete m_root->m_index;
+        m_root->m_index = 0;
+    }
 }
 
 void XML_Node::getChildren(const std::string& nm,
@@ -1094,44 +1221,12 @@ void XML_Node::setRoot(const XML_Node& newRoot)
 XML_Node* findXMLPhase(XML_Node* root,
                        const std::string& idtarget)
 {
-    XML_Node* scResult = 0;
-    XML_Node* sc;
     if (!root) {
         return 0;
     }
-    string idattrib;
-    string rname = root->name();
-    if (rname == "phase") {
-        if (idtarget == "") {
-            return root;
-        }
-        idattrib = root->id();
-        if (idtarget == idattrib) {
-            return root;
-        }
-    }
-
-    const vector<XML_Node*> &vsc = root->children();
-    for (size_t n = 0; n < root->nChildren(); n++) {
-        sc = vsc[n];
-        if (sc->name() == "phase") {
-            if (idtarget == "") {
-                return sc;
-            }
-            idattrib = sc->id();
-            if (idtarget == idattrib) {
-                return sc;
-            }
-        }
-    }
-    for (size_t n = 0; n < root->nChildren(); n++) {
-        sc = vsc[n];
-        scResult = findXMLPhase(sc, idtarget);
-        if (scResult) {
-            return scResult;
-        }
-    }
-    return scResult;
+    // This is the same search as findNameID(), which can use the index of a
+    // locked tree
+    return root->findNameID("phase", idtarget);
 }
 
 }
@@ -64,8 +64,8 @@ int vcsUtil_root1d(double xmin, double xmax, size_t itmax,
             * dimensionless */
     double c[9], f[3], xn1, xn2, x0 = 0.0, f0 = 0.0, root, theta, xquad;
 
-    callNum++;
     if (DEBUG_MODE_ENABLED && printLvl >= 3) {
+        callNum++;
         sprintf(fileName, "rootfd_%d.log", callNum);
         fp = fopen(fileName, "w");
         fprintf(fp, " Iter   TP_its  xval   Func_val  |  Reasoning\n");
@@ -0,0 +1,377 @@
+/**
+ *  @file BatchEvaluator.cpp
+ */
+
+#include "cantera/kinetics/BatchEvaluator.h"
+#include "cantera/kinetics/GasKinetics.h"
+#include "cantera/thermo/IdealGasPhase.h"
+#include "cantera/thermo/GeneralSpeciesThermo.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace
+{
+//! Comparison of state indices by temperature, then by pressure
+class StateOrder
+{
+public:
+    StateOrder(const double* T, const double* P) : m_T(T), m_P(P) {}
+    bool operator()(size_t a, size_t b) const {
+        if (m_T[a] != m_T[b]) {
+            return m_T[a] < m_T[b];
+        } else if (m_P[a] != m_P[b]) {
+            return m_P[a] < m_P[b];
+        }
+        return a < b;
+    }
+private:
+    const double* m_T;
+    const double* m_P;
+};
+}
+
+BatchEvaluator::BatchEvaluator(Kinetics& kin) :
+    m_kin(&kin),
+    m_thermo(&kin.thermo(0)),
+    m_gas(0),
+    m_spthermo(0),
+    m_blockSize(64)
+{
+    if (kin.nPhases() != 1) {
+        throw CanteraError("BatchEvaluator::BatchEvaluator",
+                           "Kinetics manager must be for a single phase.");
+    }
+    if (dynamic_cast<IdealGasPhase*>(m_thermo)) {
+        m_gas = dynamic_cast<GasKinetics*>(&kin);
+        m_spthermo = dynamic_cast<const GeneralSpeciesThermo*>(
+                         &m_thermo->speciesThermo());
+    }
+    m_y1.resize(m_thermo->nSpecies());
+    m_work.resize(m_thermo->nSpecies());
+}
+
+void BatchEvaluator::setBlockSize(size_t n)
+{
+    if (n == 0) {
+        throw CanteraError("BatchEvaluator::setBlockSize",
+                           "Block size must be positive.");
+    }
+    m_blockSize = n;
+}
+
+void BatchEvaluator::eval(size_t nStates, const double* T, const double* P,
+                          const double* Y, double* wdot, double* hbar,
+                          double* h)
+{
+    if (!m_gas) {
+        evalStates(nStates, T, P, Y, wdot, hbar, h);
+        return;
+    }
+    for (size_t n0 = 0; n0 < nStates; n0 += m_blockSize) {
+        size_t nb = std::min(m_blockSize, nStates - n0);
+        evalBlock(nStates, n0, nb, T, P, Y, wdot, hbar, h);
+    }
+}
+
+void BatchEvaluator::evalBlock(size_t nStates, size_t n0, size_t nb,
+                               const double* T, const double* P,
+                               const double* Y, double* wdot, double* hbar,
+                               double* h)
+{
+    GasKinetics& kin = *m_gas;
+    size_t nsp = m_thermo->nSpecies();
+    size_t nr = kin.nReactions();
+    size_t nfall = kin.m_nfall;
+    const vector_fp& mw = m_thermo->molecularWeights();
+
+    m_T.resize(nb);
+    m_logT.resize(nb);
+    m_recipT.resize(nb);
+    m_P.resize(nb);
+    m_logP.resize(nb);
+    m_logC0.resize(nb);
+    m_rho.resize(nb);
+    m_mmw.resize(nb);
+    m_ctot.resize(nb);
+    m_y.resize(nsp*nb);
+    m_conc.resize(nsp*nb);
+    m_cp_R.resize(nsp*nb);
+    m_h_RT.resize(nsp*nb);
+    m_s_R.resize(nsp*nb);
+    m_mu0.resize(nsp*nb);
+    m_wdot.resize(nsp*nb);
+    m_ropf.resize(nr*nb);
+    m_ropr.resize(nr*nb);
+    m_rkcn.resize(nr*nb);
+
+    // Mass fractions, normalized in the same way as by
+    // Phase::setMassFractions. m_mmw holds the sums until it is inverted.
+    std::copy(T + n0, T + n0 + nb, m_T.begin());
+    std::fill(m_mmw.begin(), m_mmw.end(), 0.0);
+    for (size_t k = 0; k < nsp; k++) {
+        double* y = &m_y[k*nb];
+        const double* Yk = Y + k*nStates + n0;
+        for (size_t j = 0; j < nb; j++) {
+            y[j] = std::max(Yk[j], 0.0);
+            m_mmw[j] += y[j];
+        }
+    }
+    for (size_t j = 0; j < nb; j++) {
+        m_ctot[j] = 1.0 / m_mmw[j];
+    }
+    std::fill(m_mmw.begin(), m_mmw.end(), 0.0);
+    for (size_t k = 0; k < nsp; k++) {
+        double* y = &m_y[k*nb];
+        double* ym = &m_conc[k*nb];
+        double rmw = 1.0 / mw[k];
+        for (size_t j = 0; j < nb; j++) {
+            y[j] *= m_ctot[j];
+            ym[j] = y[j] * rmw;
+            m_mmw[j] += ym[j];
+        }
+    }
+
+    // Density, concentrations and pressure, as computed by IdealGasPhase
+    for (size_t j = 0; j < nb; j++) {
+        m_mmw[j] = 1.0 / m_mmw[j];
+        double rho = P[n0+j] * m_mmw[j] / (GasConstant * m_T[j]);
+        m_ctot[j] = rho / m_mmw[j];
+        m_P[j] = GasConstant * m_ctot[j] * m_T[j];
+        m_rho[j] = rho;
+    }
+    for (size_t k = 0; k < nsp; k++) {
+        double* c = &m_conc[k*nb];
+        for (size_t j = 0; j < nb; j++) {
+            c[j] *= m_rho[j];
+        }
+    }
+    for (size_t j = 0; j < nb; j++) {
+        m_logT[j] = std::log(m_T[j]);
+        m_recipT[j] = 1.0 / m_T[j];
+    }
+
+    // Species reference state properties
+    if (m_spthermo) {
+        m_spthermo->updateBatch(nb, &m_T[0], &m_cp_R[0], &m_h_RT[0],
+                                &m_s_R[0]);
+    } else {
+        SpeciesThermo& spthermo = m_thermo->speciesThermo();
+        vector_fp cp(nsp), hrt(nsp), sr(nsp);
+        for (size_t j = 0; j < nb; j++) {
+            spthermo.update(m_T[j], &cp[0], &hrt[0], &sr[0]);
+            for (size_t k = 0; k < nsp; k++) {
+                m_cp_R[k*nb + j] = cp[k];
+                m_h_RT[k*nb + j] = hrt[k];
+                m_s_R[k*nb + j] = sr[k];
+            }
+        }
+    }
+
+    // Standard chemical potentials, as computed by
+    // IdealGasPhase::getStandardChemPotentials
+    double Pref = m_thermo->speciesThermo().refPressure();
+    for (size_t k = 0; k < nsp; k++) {
+        const double* hk = &m_h_RT[k*nb];
+        const double* sk = &m_s_R[k*nb];
+        double* mu = &m_mu0[k*nb];
+        for (size_t j = 0; j < nb; j++) {
+            mu[j] = (hk[j] - sk[j]) * (GasConstant * m_T[j]);
+        }
+    }
+    for (size_t j = 0; j < nb; j++) {
+        double tmp = std::log(m_P[j] / Pref);
+        tmp *= GasConstant * m_T[j];
+        for (size_t k = 0; k < nsp; k++) {
+            m_mu0[k*nb + j] += tmp;
+        }
+    }
+
+    // Reciprocals of the equilibrium constants, as computed by
+    // GasKinetics::updateKc
+    std::fill(m_rkcn.begin(), m_rkcn.end(), 0.0);
+    kin.m_revProductStoich.incrementReactionsBatch(nb, &m_mu0[0], &m_rkcn[0]);
+    kin.m_reactantStoich.decrementReactionsBatch(nb, &m_mu0[0], &m_rkcn[0]);
+    for (size_t j = 0; j < nb; j++) {
+        m_logC0[j] = std::log(m_P[j] / (GasConstant * m_T[j]));
+    }
+    for (size_t i = 0; i < kin.m_revindex.size(); i++) {
+        size_t irxn = kin.m_revindex[i];
+        double dn = kin.m_dn[irxn];
+        double* rkc = &m_rkcn[irxn*nb];
+        for (size_t j = 0; j < nb; j++) {
+            rkc[j] = std::min(exp(rkc[j] * (1.0 / (GasConstant * m_T[j]))
+                                  - dn * m_logC0[j]), BigNumber);
+        }
+    }
+    for (size_t i = 0; i < kin.m_irrev.size(); i++) {
+        double* rkc = &m_rkcn[kin.m_irrev[i]*nb];
+        std::fill(rkc, rkc + nb, 0.0);
+    }
+
+    // Rate constants
+    std::fill(m_ropf.begin(), m_ropf.end(), 0.0);
+    kin.m_rates.updateBatch(nb, &m_logT[0], &m_recipT[0], &m_ropf[0]);
+    if (kin.m_plog_rates.nReactions()) {
+        for (size_t j = 0; j < nb; j++) {
+            m_logP[j] = std::log(m_P[j]);
+        }
+        kin.m_plog_rates.updateBatch(nb, &m_logT[0], &m_recipT[0],
+                                     &m_ropf[0], &m_logP[0]);
+    }
+    if (kin.m_cheb_rates.nReactions()) {
+        for (size_t j = 0; j < nb; j++) {
+            m_logP[j] = std::log10(m_P[j]);
+        }
+        kin.m_cheb_rates.updateBatch(nb, &m_logT[0], &m_recipT[0],
+                                     &m_ropf[0], &m_logP[0]);
+    }
+
+    // Third-body reactions
+    if (kin.m_3b_concm.workSize()) {
+        m_concm_3b.resize(kin.m_3b_concm.workSize() * nb);
+        kin.m_3b_concm.updateBatch(nb, &m_conc[0], &m_ctot[0], &m_concm_3b[0]);
+        kin.m_3b_concm.multiplyBatch(nb, &m_ropf[0], &m_concm_3b[0]);
+    }
+
+    // Falloff reactions, as computed by GasKinetics::processFalloffReactions
+    if (nfall) {
+        m_concm_falloff.resize(nfall*nb);
+        m_rfn_low.resize(nfall*nb);
+        m_rfn_high.resize(nfall*nb);
+        m_pr.resize(nfall*nb);
+        m_pr1.resize(nfall);
+        m_falloff_work.resize(kin.m_falloffn.workSize());
+        kin.m_falloff_concm.updateBatch(nb, &m_conc[0], &m_ctot[0],
+                                        &m_concm_falloff[0]);
+        kin.m_falloff_low_rates.updateBatch(nb, &m_logT[0], &m_recipT[0],
+                                            &m_rfn_low[0]);
+        kin.m_falloff_high_rates.updateBatch(nb, &m_logT[0], &m_recipT[0],
+                                             &m_rfn_high[0]);
+        for (size_t i = 0; i < nfall*nb; i++) {
+            m_pr[i] = m_concm_falloff[i] * m_rfn_low[i] /
+                      (m_rfn_high[i] + SmallNumber);
+        }
+
+        // The falloff functions are evaluated one state at a time
+        double* work = m_falloff_work.empty() ? 0 : &m_falloff_work[0];
+        for (size_t j = 0; j < nb; j++) {
+            for (size_t i = 0; i < nfall; i++) {
+                m_pr1[i] = m_pr[i*nb + j];
+            }
+            if (work) {
+                kin.m_falloffn.updateTemp(m_T[j], work);
+            }
+            kin.m_falloffn.pr_to_falloff(&m_pr1[0], work);
+            for (size_t i = 0; i < nfall; i++) {
+                m_pr[i*nb + j] = m_pr1[i];
+            }
+        }
+
+        for (size_t i = 0; i < nfall; i++) {
+            const double* k = (kin.m_rxntype[kin.m_fallindx[i]] == FALLOFF_RXN)
+                              ? &m_rfn_high[i*nb] : &m_rfn_low[i*nb];
+            double* pr = &m_pr[i*nb];
+            double* kf = &m_ropf[kin.m_fallindx[i]*nb];
+            for (size_t j = 0; j < nb; j++) {
+                kf[j] = pr[j] * k[j];
+            }
+        }
+    }
+
+    // Rates of progress, as computed by GasKinetics::updateROP
+    for (size_t i = 0; i < nr; i++) {
+        double perturb = kin.m_perturb[i];
+        double* kf = &m_ropf[i*nb];
+        double* kr = &m_ropr[i*nb];
+        const double* rkc = &m_rkcn[i*nb];
+        for (size_t j = 0; j < nb; j++) {
+            kf[j] *= perturb;
+            kr[j] = kf[j] * rkc[j];
+        }
+    }
+    kin.m_reactantStoich.multiplyBatch(nb, &m_conc[0], &m_ropf[0]);
+    kin.m_revProductStoich.multiplyBatch(nb, &m_conc[0], &m_ropr[0]);
+    for (size_t i = 0; i < nr*nb; i++) {
+        m_ropf[i] -= m_ropr[i];
+    }
+
+    // Net production rates, as computed by Kinetics::getNetProductionRates
+    std::fill(m_wdot.begin(), m_wdot.end(), 0.0);
+    kin.m_revProductStoich.incrementSpeciesBatch(nb, &m_ropf[0], &m_wdot[0]);
+    kin.m_irrevProductStoich.incrementSpeciesBatch(nb, &m_ropf[0], &m_wdot[0]);
+    kin.m_reactantStoich.decrementSpeciesBatch(nb, &m_ropf[0], &m_wdot[0]);
+    for (size_t k = 0; k < nsp; k++) {
+        std::copy(&m_wdot[k*nb], &m_wdot[k*nb] + nb,
+                  wdot + k*nStates + n0);
+    }
+
+    // Enthalpies, as computed by IdealGasPhase
+    if (hbar) {
+        for (size_t k = 0; k < nsp; k++) {
+            const double* hk = &m_h_RT[k*nb];
+            double* hb = hbar + k*nStates + n0;
+            for (size_t j = 0; j < nb; j++) {
+                hb[j] = hk[j] * (GasConstant * m_T[j]);
+            }
+        }
+    }
+    if (h) {
+        // m_rho is reused for the sums of the molar enthalpies weighted by
+        // ym = X/mmw, in the same order as Phase::mean_X
+        std::fill(m_rho.begin(), m_rho.end(), 0.0);
+        for (size_t k = 0; k < nsp; k++) {
+            const double* hk = &m_h_RT[k*nb];
+            const double* y = &m_y[k*nb];
+            double rmw = 1.0 / mw[k];
+            for (size_t j = 0; j < nb; j++) {
+                m_rho[j] += (y[j] * rmw) * hk[j];
+            }
+        }
+        for (size_t j = 0; j < nb; j++) {
+            h[n0+j] = GasConstant * m_T[j] * (m_mmw[j] * m_rho[j]) / m_mmw[j];
+        }
+    }
+}
+
+void BatchEvaluator::evalStates(size_t nStates, const double* T,
+                                const double* P, const double* Y,
+                                double* wdot, double* hbar, double* h)
+{
+    size_t nsp = m_thermo->nSpecies();
+    m_order.resize(nStates);
+    for (size_t n = 0; n < nStates; n++) {
+        m_order[n] = n;
+    }
+    sort(m_order.begin(), m_order.end(), StateOrder(T, P));
+
+    m_thermo->saveState(m_state);
+    for (size_t m = 0; m < nStates; m++) {
+        size_t n = m_order[m];
+        for (size_t k = 0; k < nsp; k++) {
+            m_y1[k] = Y[k*nStates + n];
+        }
+        m_thermo->setState_TPY(T[n], P[n], &m_y1[0]);
+
+        m_kin->getNetProductionRates(&m_work[0]);
+        for (size_t k = 0; k < nsp; k++) {
+            wdot[k*nStates + n] = m_work[k];
+        }
+        if (hbar) {
+            m_thermo->getPartialMolarEnthalpies(&m_work[0]);
+            for (size_t k = 0; k < nsp; k++) {
+                hbar[k*nStates + n] = m_work[k];
+            }
+        }
+        if (h) {
+            h[n] = m_thermo->enthalpy_mass();
+        }
+    }
+    m_thermo->restoreState(m_state);
+}
+
+}
@@ -7,18 +7,84 @@
 // Copyright 2001  California Institute of Technology
 
 #include "cantera/kinetics/GasKinetics.h"
+#include "cantera/thermo/mix_defs.h"
+#include "cantera/thermo/speciesThermoTypes.h"
+#include "cantera/numerics/funcs.h"
 
 using namespace std;
 
 namespace Cantera
 {
+
+namespace
+{
+//! Accumulates the derivatives of the rates of progress with respect to the
+//! species concentrations, \f$ \partial q_i / \partial C_j \f$, into the
+//! dense, column-major matrix of derivatives of the species net production
+//! rates. Used as the functor for StoichManagerN::multiplyDerivatives.
+class ProductionRateJacobian
+{
+public:
+    ProductionRateJacobian(const vector<vector<size_t> >& species,
+                           const vector<vector_fp>& stoich,
+                           size_t nsp, double* jac, double sign)
+        : m_species(species), m_stoich(stoich), m_nsp(nsp), m_jac(jac),
+          m_sign(sign) {}
+
+    void operator()(size_t i, size_t j, double dqdC) {
+        double* col = m_jac + m_nsp * j;
+        dqdC *= m_sign;
+        for (size_t n = 0; n < m_species[i].size(); n++) {
+            col[m_species[i][n]] += m_stoich[i][n] * dqdC;
+        }
+    }
+
+private:
+    const vector<vector<size_t> >& m_species;
+    const vector<vector_fp>& m_stoich;
+    size_t m_nsp;
+    double* m_jac;
+    double m_sign;
+};
+
+//! Temperature of row *j* of a table segment with *n* rows evenly spaced in
+//! 1/T between *xmin* and *xmax*. The temperatures at the ends of the segment
+//! are moved slightly into it, so that any thermo polynomials that change at
+//! the ends are evaluated on the side of the segment.
+double tableTemperature(double xmin, double xmax, size_t j, size_t n)
+{
+    if (j == 0) {
+        return 1.0 / (xmin * (1.0 + 1e-10));
+    } else if (j == n - 1) {
+        return 1.0 / (xmax * (1.0 - 1e-10));
+    }
+    return 1.0 / (xmin + j * (xmax - xmin) / (n - 1));
+}
+
+//! Interpolate *n* values from four consecutive rows of a table, starting
+//! at *row*, using the weights *w*.
+void interpolateRows(const double* row, size_t width, const double* w,
+                     size_t n, double* out)
+{
+    const double* r1 = row + width;
+    const double* r2 = r1 + width;
+    const double* r3 = r2 + width;
+    for (size_t k = 0; k < n; k++) {
+        out[k] = w[0] * row[k] + w[1] * r1[k] + w[2] * r2[k] + w[3] * r3[k];
+    }
+}
+}
+
 GasKinetics::GasKinetics(thermo_t* thermo) :
     BulkKinetics(thermo),
     m_nfall(0),
     m_logp_ref(0.0),
     m_logc_ref(0.0),
     m_logStandConc(0.0),
-    m_pres(0.0)
+    m_pres(0.0),
+    m_tableSize(0),
+    m_tableWidth(0),
+    m_tableError(0.0)
 {
 }
 
@@ -37,18 +103,23 @@ void GasKinetics::update_rates_T()
     doublereal logT = log(T);
 
     if (T != m_temp) {
-        if (!m_rfn.empty()) {
-            m_rates.update(T, logT, &m_rfn[0]);
+        if (m_tableSize && 1.0 / T >= m_tableX[0] &&
+            1.0 / T <= m_tableX.back()) {
+            interpolateRates(T);
+        } else {
+            if (!m_rfn.empty()) {
+                m_rates.update(T, logT, &m_rfn[0]);
+            }
+
+            if (!m_rfn_low.empty()) {
+                m_falloff_low_rates.update(T, logT, &m_rfn_low[0]);
+                m_falloff_high_rates.update(T, logT, &m_rfn_high[0]);
+            }
+            if (!falloff_work.empty()) {
+                m_falloffn.updateTemp(T, &falloff_work[0]);
+            }
+            updateKc();
         }
-
-        if (!m_rfn_low.empty()) {
-            m_falloff_low_rates.update(T, logT, &m_rfn_low[0]);
-            m_falloff_high_rates.update(T, logT, &m_rfn_high[0]);
-        }
-        if (!falloff_work.empty()) {
-            m_falloffn.updateTemp(T, &falloff_work[0]);
-        }
-        updateKc();
         m_ROP_ok = false;
     }
 
@@ -117,6 +188,200 @@ void GasKinetics::updateKc()
     }
 }
 
+void GasKinetics::setRateTabulation(doublereal Tmin, doublereal Tmax,
+                                    doublereal rtol, size_t maxSize)
+{
+    if (Tmin <= 0.0 || Tmax <= Tmin) {
+        throw CanteraError("GasKinetics::setRateTabulation",
+                           "invalid temperature range");
+    }
+    if (thermo().eosType() != cIdealGas) {
+        throw CanteraError("GasKinetics::setRateTabulation",
+                           "rate tabulation requires an ideal gas phase");
+    }
+    disableRateTabulation();
+    m_tableWidth = 2 * m_ii + 2 * m_nfall + falloff_work.size();
+
+    // The standard-state thermodynamic properties, and therefore the
+    // equilibrium constants, have discontinuous derivatives at the
+    // temperatures where the polynomial fits change. The table is split
+    // into segments at these temperatures, which are interpolated
+    // separately.
+    std::vector<double> bounds;
+    bounds.push_back(1.0 / Tmax);
+    bounds.push_back(1.0 / Tmin);
+    SpeciesThermo& spthermo = thermo().speciesThermo();
+    vector_fp c(500);
+    for (size_t k = 0; k < thermo().nSpecies(); k++) {
+        int type;
+        double tlow, thigh, pref;
+        spthermo.reportParams(k, type, &c[0], tlow, thigh, pref);
+        if (type == NASA2 || type == SHOMATE2) {
+            bounds.push_back(1.0 / c[0]);
+        } else if (type == NASA9MULTITEMP) {
+            for (size_t i = 1; i < c[0]; i++) {
+                bounds.push_back(1.0 / c[1 + 11*i]);
+            }
+        }
+    }
+    sort(bounds.begin(), bounds.end());
+    m_tableX.push_back(1.0 / Tmax);
+    for (size_t i = 0; i < bounds.size(); i++) {
+        if (bounds[i] > m_tableX.back() &&
+            bounds[i] - m_tableX.back() > 1e-8 * m_tableX.back() &&
+            bounds[i] <= 1.0 / Tmin) {
+            m_tableX.push_back(bounds[i]);
+        }
+    }
+    m_tableX.back() = 1.0 / Tmin;
+
+    vector_fp state;
+    thermo().saveState(state);
+    try {
+        m_tableStart.push_back(0);
+        for (size_t j = 0; j + 1 < m_tableX.size(); j++) {
+            double err = tabulateSegment(m_tableX[j], m_tableX[j+1], rtol,
+                                         maxSize);
+            m_tableError = std::max(m_tableError, err);
+            m_tableStart.push_back(m_table.size() / m_tableWidth);
+            m_tableH.push_back((m_tableX[j+1] - m_tableX[j]) /
+                (m_tableStart[j+1] - m_tableStart[j] - 1));
+        }
+    } catch (CanteraError&) {
+        thermo().restoreState(state);
+        disableRateTabulation();
+        throw;
+    }
+    thermo().restoreState(state);
+    m_tableSize = m_tableStart.back();
+    // force the rates to be updated
+    m_temp = 0.0;
+}
+
+void GasKinetics::disableRateTabulation()
+{
+    m_table.clear();
+    m_tableX.clear();
+    m_tableH.clear();
+    m_tableStart.clear();
+    m_tableSize = 0;
+    m_tableWidth = 0;
+    m_tableError = 0.0;
+    m_temp = 0.0;
+}
+
+doublereal GasKinetics::tabulateSegment(doublereal xmin, doublereal xmax,
+                                        doublereal rtol, size_t maxSize)
+{
+    size_t width = m_tableWidth;
+    size_t nRates = 2 * m_ii + 2 * m_nfall; // values preceding falloff_work
+    size_t n = 9;
+    vector_fp table(n * width);
+    for (size_t j = 0; j < n; j++) {
+        evalRateTableRow(tableTemperature(xmin, xmax, j, n),
+                         &table[j * width]);
+    }
+
+    vector_fp mid, interp(width), w(4), refined;
+    double err;
+    while (true) {
+        // Compare the exact and interpolated values at the midpoint of each
+        // interval, keeping the exact values for use in a refined table
+        double h = (xmax - xmin) / (n - 1);
+        mid.resize((n - 1) * width);
+        err = 0.0;
+        for (size_t j = 0; j < n - 1; j++) {
+            double* row = &mid[j * width];
+            evalRateTableRow(1.0 / (xmin + (j + 0.5) * h), row);
+            size_t i = std::min(std::max<size_t>(j, 1), n - 3);
+            cubicWeights(j + 0.5 - i, &w[0]);
+            interpolateRows(&table[(i - 1) * width], width, &w[0], width,
+                            &interp[0]);
+            for (size_t k = 0; k < width; k++) {
+                double scale = std::abs(row[k]);
+                if (k >= nRates) {
+                    scale = std::max(scale, 1.0);
+                }
+                double dev = std::abs(interp[k] - row[k]);
+                if (dev > 0.0) {
+                    err = std::max(err, (scale > 0.0) ? dev / scale : BigNumber);
+                }
+            }
+        }
+        if (err <= rtol) {
+            break;
+        }
+        if (2 * n - 1 > maxSize) {
+            throw CanteraError("GasKinetics::setRateTabulation",
+                "relative interpolation error " + fp2str(err) + " with " +
+                int2str(n) + " temperatures between " + fp2str(1.0 / xmax) +
+                " K and " + fp2str(1.0 / xmin) + " K exceeds the tolerance");
+        }
+        refined.resize((2 * n - 1) * width);
+        for (size_t j = 0; j < n; j++) {
+            copy(table.begin() + j * width, table.begin() + (j + 1) * width,
+                 refined.begin() + 2 * j * width);
+            if (j < n - 1) {
+                copy(mid.begin() + j * width, mid.begin() + (j + 1) * width,
+                     refined.begin() + (2 * j + 1) * width);
+            }
+        }
+        table.swap(refined);
+        n = 2 * n - 1;
+    }
+    m_table.insert(m_table.end(), table.begin(), table.end());
+    return err;
+}
+
+void GasKinetics::evalRateTableRow(doublereal T, doublereal* row)
+{
+    thermo().setTemperature(T);
+    m_logStandConc = log(thermo().standardConcentration());
+    double logT = log(T);
+
+    // Entries for reactions without an Arrhenius rate constant keep their
+    // current values.
+    copy(m_rfn.begin(), m_rfn.end(), row);
+    if (!m_rfn.empty()) {
+        m_rates.update(T, logT, row);
+    }
+    updateKc();
+    copy(m_rkcn.begin(), m_rkcn.end(), row + m_ii);
+    double* low = row + 2 * m_ii;
+    if (m_nfall) {
+        m_falloff_low_rates.update(T, logT, low);
+        m_falloff_high_rates.update(T, logT, low + m_nfall);
+    }
+    if (!falloff_work.empty()) {
+        m_falloffn.updateTemp(T, low + 2 * m_nfall);
+    }
+}
+
+void GasKinetics::interpolateRates(doublereal T)
+{
+    double x = 1.0 / T;
+    size_t seg = upper_bound(m_tableX.begin() + 1, m_tableX.end() - 1, x) -
+                 m_tableX.begin() - 1;
+    size_t n = m_tableStart[seg+1] - m_tableStart[seg];
+    double s = (x - m_tableX[seg]) / m_tableH[seg];
+    size_t i = std::min(std::max<size_t>(static_cast<size_t>(s), 1), n - 3);
+    double w[4];
+    cubicWeights(s - i, w);
+    const double* row = &m_table[(m_tableStart[seg] + i - 1) * m_tableWidth];
+    interpolateRows(row, m_tableWidth, w, m_ii, &m_rfn[0]);
+    interpolateRows(row + m_ii, m_tableWidth, w, m_ii, &m_rkcn[0]);
+    if (m_nfall) {
+        row += 2 * m_ii;
+        interpolateRows(row, m_tableWidth, w, m_nfall, &m_rfn_low[0]);
+        interpolateRows(row + m_nfall, m_tableWidth, w, m_nfall,
+                        &m_rfn_high[0]);
+        if (!falloff_work.empty()) {
+            interpolateRows(row + 2 * m_nfall, m_tableWidth, w,
+                            falloff_work.size(), &falloff_work[0]);
+        }
+    }
+}
+
 void GasKinetics::getEquilibriumConstants(doublereal* kc)
 {
     update_rates_T();
@@ -240,8 +505,221 @@ void GasKinetics::getFwdRateConstants(doublereal* kfwd)
     }
 }
 
+void GasKinetics::updateROPDerivatives()
+{
+    // Net stoichiometric coefficients of each reaction. These are only
+    // needed here, so they are assembled on first use.
+    if (m_netSpecies.size() != m_ii) {
+        m_netSpecies.assign(m_ii, vector<size_t>());
+        m_netStoich.assign(m_ii, vector_fp());
+        for (size_t k = 0; k < m_kk; k++) {
+            map<size_t, double> nu = m_prxn[k];
+            for (map<size_t, double>::const_iterator iter = m_rrxn[k].begin();
+                 iter != m_rrxn[k].end();
+                 ++iter) {
+                nu[iter->first] -= iter->second;
+            }
+            for (map<size_t, double>::const_iterator iter = nu.begin();
+                 iter != nu.end();
+                 ++iter) {
+                if (iter->second != 0.0) {
+                    m_netSpecies[iter->first].push_back(k);
+                    m_netStoich[iter->first].push_back(iter->second);
+                }
+            }
+        }
+    }
+
+    m_kf_eff.resize(m_ii);
+    m_kr_eff.resize(m_ii);
+    m_cprod_f.resize(m_ii);
+    m_cprod_r.resize(m_ii);
+    m_dkf_dM.resize(m_ii);
+    m_dMdC.resize(m_kk);
+
+    // Forward rate constants, including third-body concentrations, falloff
+    // functions, and perturbation factors. This overwrites m_ropf, so the
+    // rates of progress are recomputed afterwards.
+    getFwdRateConstants(&m_kf_eff[0]);
+    updateROP();
+    for (size_t i = 0; i < m_ii; i++) {
+        m_kr_eff[i] = m_kf_eff[i] * m_rkcn[i];
+    }
+
+    // Concentration products, such that q = kf * (cprod_f - cprod_r)
+    fill(m_cprod_f.begin(), m_cprod_f.end(), 1.0);
+    m_reactantStoich.multiply(&m_conc[0], &m_cprod_f[0]);
+    copy(m_rkcn.begin(), m_rkcn.begin() + m_ii, m_cprod_r.begin());
+    m_revProductStoich.multiply(&m_conc[0], &m_cprod_r[0]);
+
+    // Derivatives of the forward rate constants with respect to the enhanced
+    // third-body concentrations
+    fill(m_dkf_dM.begin(), m_dkf_dM.end(), 0.0);
+    for (size_t n = 0; n < concm_3b_values.size(); n++) {
+        size_t i = m_3b_concm.reactionIndex(n);
+        m_dkf_dM[i] = m_perturb[i] * m_rfn[i];
+    }
+    if (m_nfall) {
+        updateFalloffDerivatives();
+        for (size_t n = 0; n < m_nfall; n++) {
+            size_t i = m_fallindx[n];
+            double kbase = (m_rxntype[i] == FALLOFF_RXN) ? m_rfn_high[n]
+                                                         : m_rfn_low[n];
+            m_dkf_dM[i] = m_perturb[i] * kbase * m_falloff_dgdPr[n] *
+                          m_rfn_low[n] / (m_rfn_high[n] + SmallNumber);
+        }
+    }
+}
+
+void GasKinetics::updateFalloffDerivatives()
+{
+    // relative perturbation used for the blending function derivatives
+    const double delta = 1.0e-7;
+    m_falloff_pr.resize(m_nfall);
+    m_falloff_g.resize(m_nfall);
+    m_falloff_dgdPr.resize(m_nfall);
+    m_falloff_dgdT.resize(m_nfall);
+    m_falloff_work_T.resize(falloff_work.size());
+    double* work = (falloff_work.empty()) ? 0 : &falloff_work[0];
+    double* work_T = (falloff_work.empty()) ? 0 : &m_falloff_work_T[0];
+
+    for (size_t n = 0; n < m_nfall; n++) {
+        m_falloff_pr[n] = concm_falloff_values[n] * m_rfn_low[n] /
+                          (m_rfn_high[n] + SmallNumber);
+    }
+    copy(m_falloff_pr.begin(), m_falloff_pr.end(), m_falloff_g.begin());
+    m_falloffn.pr_to_falloff(&m_falloff_g[0], work);
+
+    // derivative with respect to the reduced pressure
+    for (size_t n = 0; n < m_nfall; n++) {
+        m_falloff_dgdPr[n] = m_falloff_pr[n] +
+                             delta * std::max(m_falloff_pr[n], Tiny);
+    }
+    m_falloffn.pr_to_falloff(&m_falloff_dgdPr[0], work);
+    for (size_t n = 0; n < m_nfall; n++) {
+        m_falloff_dgdPr[n] = (m_falloff_dgdPr[n] - m_falloff_g[n]) /
+                             (delta * std::max(m_falloff_pr[n], Tiny));
+    }
+
+    // derivative with respect to temperature at constant reduced pressure
+    double T = thermo().temperature();
+    double dT = delta * T;
+    m_falloffn.updateTemp(T + dT, work_T);
+    copy(m_falloff_pr.begin(), m_falloff_pr.end(), m_falloff_dgdT.begin());
+    m_falloffn.pr_to_falloff(&m_falloff_dgdT[0], work_T);
+    for (size_t n = 0; n < m_nfall; n++) {
+        m_falloff_dgdT[n] = (m_falloff_dgdT[n] - m_falloff_g[n]) / dT;
+    }
+}
+
+void GasKinetics::getNetProductionRates_ddC(doublereal* dwdot_dC)
+{
+    updateROPDerivatives();
+    fill(dwdot_dC, dwdot_dC + m_kk * m_kk, 0.0);
+
+    // mass-action terms
+    ProductionRateJacobian fwd(m_netSpecies, m_netStoich, m_kk, dwdot_dC, 1.0);
+    m_reactantStoich.multiplyDerivatives(&m_conc[0], &m_kf_eff[0], fwd);
+    ProductionRateJacobian rev(m_netSpecies, m_netStoich, m_kk, dwdot_dC, -1.0);
+    m_revProductStoich.multiplyDerivatives(&m_conc[0], &m_kr_eff[0], rev);
+
+    // dependence of three-body and falloff reactions on the enhanced
+    // third-body concentrations
+    for (size_t n = 0; n < concm_3b_values.size() + m_nfall; n++) {
+        size_t i;
+        if (n < concm_3b_values.size()) {
+            i = m_3b_concm.reactionIndex(n);
+            m_3b_concm.getDerivatives(n, m_kk, &m_dMdC[0]);
+        } else {
+            i = m_fallindx[n - concm_3b_values.size()];
+            m_falloff_concm.getDerivatives(n - concm_3b_values.size(), m_kk,
+                                           &m_dMdC[0]);
+        }
+        double dqdM = m_dkf_dM[i] * (m_cprod_f[i] - m_cprod_r[i]);
+        if (dqdM == 0.0) {
+            continue;
+        }
+        for (size_t m = 0; m < m_netSpecies[i].size(); m++) {
+            size_t k = m_netSpecies[i][m];
+            double nu_dqdM = m_netStoich[i][m] * dqdM;
+            for (size_t j = 0; j < m_kk; j++) {
+                dwdot_dC[k + m_kk * j] += nu_dqdM * m_dMdC[j];
+            }
+        }
+    }
+}
+
+void GasKinetics::getNetProductionRates_ddT(doublereal* dwdot_dT)
+{
+    updateROPDerivatives();
+    double T = thermo().temperature();
+    double logT = log(T);
+    m_dlnk_dT.resize(m_ii);
+
+    // temperature derivatives of the logarithms of the rate coefficients
+    fill(m_dlnk_dT.begin(), m_dlnk_dT.end(), 0.0);
+    m_rates.update_dlnkdT(T, logT, &m_dlnk_dT[0]);
+    if (m_plog_rates.nReactions()) {
+        m_plog_rates.update_dlnkdT(T, logT, &m_dlnk_dT[0]);
+    }
+    if (m_cheb_rates.nReactions()) {
+        m_cheb_rates.update_dlnkdT(T, logT, &m_dlnk_dT[0]);
+    }
+
+    // use m_ropnet for temporary storage of dkf/dT
+    vector_fp& dkf_dT = m_ropnet;
+    for (size_t i = 0; i < m_ii; i++) {
+        dkf_dT[i] = m_kf_eff[i] * m_dlnk_dT[i];
+    }
+
+    if (m_nfall) {
+        m_falloff_dlnk0_dT.resize(m_nfall);
+        m_falloff_dlnkinf_dT.resize(m_nfall);
+        m_falloff_low_rates.update_dlnkdT(T, logT, &m_falloff_dlnk0_dT[0]);
+        m_falloff_high_rates.update_dlnkdT(T, logT, &m_falloff_dlnkinf_dT[0]);
+        for (size_t n = 0; n < m_nfall; n++) {
+            size_t i = m_fallindx[n];
+            double kbase, dlnkbase_dT;
+            if (m_rxntype[i] == FALLOFF_RXN) {
+                kbase = m_rfn_high[n];
+                dlnkbase_dT = m_falloff_dlnkinf_dT[n];
+            } else { // CHEMACT_RXN
+                kbase = m_rfn_low[n];
+                dlnkbase_dT = m_falloff_dlnk0_dT[n];
+            }
+            double dPr_dT = m_falloff_pr[n] *
+                (m_falloff_dlnk0_dT[n] - m_falloff_dlnkinf_dT[n]);
+            dkf_dT[i] = m_perturb[i] * kbase *
+                (dlnkbase_dT * m_falloff_g[n] +
+                 m_falloff_dgdPr[n] * dPr_dT + m_falloff_dgdT[n]);
+        }
+    }
+
+    // temperature derivatives of the reciprocal equilibrium constants:
+    // d(ln(1/Kc))/dT = (dn - Delta H / RT) / T
+    thermo().getEnthalpy_RT(&m_grt[0]);
+    fill(m_dlnk_dT.begin(), m_dlnk_dT.end(), 0.0);
+    getRevReactionDelta(&m_grt[0], &m_dlnk_dT[0]);
+
+    // dq/dT = dkf/dT * (cprod_f - cprod_r) - kf * cprod_r * d(ln(1/Kc))/dT
+    for (size_t i = 0; i < m_ii; i++) {
+        double dlnrkc_dT = (m_dn[i] - m_dlnk_dT[i]) / T;
+        dkf_dT[i] = dkf_dT[i] * (m_cprod_f[i] - m_cprod_r[i]) -
+                    m_kf_eff[i] * m_cprod_r[i] * dlnrkc_dT;
+    }
+
+    fill(dwdot_dT, dwdot_dT + m_kk, 0.0);
+    m_revProductStoich.incrementSpecies(&dkf_dT[0], dwdot_dT);
+    m_irrevProductStoich.incrementSpecies(&dkf_dT[0], dwdot_dT);
+    m_reactantStoich.decrementSpecies(&dkf_dT[0], dwdot_dT);
+
+    // m_ropnet was used as temporary storage
+    m_ROP_ok = false;
+}
+
 void GasKinetics::addReaction(ReactionData& r)
 {
+    disableRateTabulation();
     switch (r.reactionType) {
     case ELEMENTARY_RXN:
         addElementaryReaction(r);
@@ -269,6 +747,7 @@ void GasKinetics::addReaction(ReactionData& r)
 
 void GasKinetics::addReaction(shared_ptr<Reaction> r)
 {
+    disableRateTabulation();
     switch (r->reaction_type) {
     case ELEMENTARY_RXN:
         addElementaryReaction(dynamic_cast<ElementaryReaction&>(*r));
@@ -12,6 +12,8 @@
 #include "cantera/kinetics/Reaction.h"
 #include "cantera/base/stringUtils.h"
 
+#include <set>
+
 using namespace std;
 
 namespace Cantera
@@ -435,6 +437,49 @@ double Kinetics::productStoichCoeff(size_t kSpec, size_t irxn) const
     return getValue(m_prxn[kSpec], irxn, 0.0);
 }
 
+void Kinetics::getProductionRateSparsity(std::vector<size_t>& colStart,
+                                         std::vector<size_t>& rowIndex) const
+{
+    // species participating in each reaction
+    std::vector<std::vector<size_t> > participants(m_ii);
+    for (size_t k = 0; k < m_kk; k++) {
+        for (std::map<size_t, doublereal>::const_iterator iter = m_rrxn[k].begin();
+             iter != m_rrxn[k].end(); ++iter) {
+            participants[iter->first].push_back(k);
+        }
+        for (std::map<size_t, doublereal>::const_iterator iter = m_prxn[k].begin();
+             iter != m_prxn[k].end(); ++iter) {
+            participants[iter->first].push_back(k);
+        }
+    }
+
+    // pattern[j] is the set of species whose production rate depends on the
+    // concentration of species j
+    std::vector<std::set<size_t> > pattern(m_kk);
+    for (size_t i = 0; i < m_ii; i++) {
+        const std::vector<size_t>& sp = participants[i];
+        int type = reactionType(i);
+        if (type == THREE_BODY_RXN || type == FALLOFF_RXN ||
+            type == CHEMACT_RXN) {
+            for (size_t j = 0; j < m_kk; j++) {
+                pattern[j].insert(sp.begin(), sp.end());
+            }
+        } else {
+            for (size_t n = 0; n < sp.size(); n++) {
+                pattern[sp[n]].insert(sp.begin(), sp.end());
+            }
+        }
+    }
+
+    colStart.assign(1, 0);
+    rowIndex.clear();
+    for (size_t j = 0; j < m_kk; j++) {
+        pattern[j].insert(j);
+        rowIndex.insert(rowIndex.end(), pattern[j].begin(), pattern[j].end());
+        colStart.push_back(rowIndex.size());
+    }
+}
+
 void Kinetics::getFwdRatesOfProgress(doublereal* fwdROP)
 {
     updateROP();
@@ -0,0 +1,60 @@
+/**
+ *  @file arrheniusKernel.cpp
+ *
+ *  Vectorizable evaluation of Arrhenius rate constants. This file is compiled
+ *  with flags that allow the loops to be vectorized without changing the
+ *  results. If Cantera is built with 'fast_math_kernels', the compiler may
+ *  also call vectorized versions of exp() (see src/SConscript).
+ */
+
+#include "cantera/kinetics/RateCoeffMgr.h"
+
+// With GCC on x86-64 Linux, versions of the kernel are compiled for AVX-512,
+// AVX2 and the baseline instruction set, and the version for the processor
+// the program is running on is selected when the library is loaded.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6 && \
+    defined(__x86_64__) && defined(__linux__)
+#define CT_ARRHENIUS_TARGETS \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define CT_ARRHENIUS_TARGETS
+#endif
+
+namespace Cantera
+{
+
+CT_ARRHENIUS_TARGETS
+void evalArrhenius(size_t n, const doublereal* A, const doublereal* b,
+                   const doublereal* E, doublereal T, doublereal logT,
+                   doublereal* k)
+{
+    doublereal recipT = 1.0/T;
+    for (size_t i = 0; i < n; i++) {
+        k[i] = b[i]*logT - E[i]*recipT;
+    }
+    for (size_t i = 0; i < n; i++) {
+        k[i] = A[i] * std::exp(k[i]);
+    }
+}
+
+CT_ARRHENIUS_TARGETS
+void evalArrheniusBatch(size_t n, const size_t* rxn, const doublereal* A,
+                        const doublereal* b, const doublereal* E,
+                        size_t nStates, const doublereal* logT,
+                        const doublereal* recipT, doublereal* k)
+{
+    for (size_t i = 0; i < n; i++) {
+        doublereal* ki = k + rxn[i]*nStates;
+        doublereal Ai = A[i];
+        doublereal bi = b[i];
+        doublereal Ei = E[i];
+        for (size_t j = 0; j < nStates; j++) {
+            ki[j] = bi*logT[j] - Ei*recipT[j];
+        }
+        for (size_t j = 0; j < nStates; j++) {
+            ki[j] = Ai * std::exp(ki[j]);
+        }
+    }
+}
+
+}
@@ -22,7 +22,8 @@ namespace Cantera
  *       STATIC ROUTINES DEFINED IN THIS FILE
  ***************************************************************************/
 
-static doublereal calc_damping(doublereal* x, doublereal* dx, size_t dim, int*);
+static doublereal calc_damping(doublereal* x, doublereal* dx, size_t dim, int*,
+                               doublereal& damp_old);
 static doublereal calcWeightedNorm(const doublereal [], const doublereal dx[], size_t);
 
 /***************************************************************************
@@ -42,6 +43,7 @@ solveSP::solveSP(ImplicitSurfChem* surfChemPtr, int bulkFunc) :
     m_rtol(1.0E-4),
     m_maxstep(1000),
     m_maxTotSpecies(0),
+    m_damp_old(1.0),
     m_ioflag(0)
 {
     m_numSurfPhases = 0;
@@ -315,7 +317,8 @@ int solveSP::solveSurfProb(int ifunc, doublereal time_scale, doublereal TKelvin,
          *    in any unknown.
          */
 
-        damp = calc_damping(DATA_PTR(m_CSolnSP), DATA_PTR(m_resid), m_neq, &label_d);
+        damp = calc_damping(DATA_PTR(m_CSolnSP), DATA_PTR(m_resid), m_neq, &label_d,
+                            m_damp_old);
 
         /*
          *    Calculate the weighted norm of the update vector
@@ -613,12 +616,16 @@ void solveSP::resjac_eval(SquareMatrix& jac,
  * The constant "APPROACH" sets the fraction of the distance to the boundary
  * that the step can take.  If the full step would not force any fraction
  * outside of 0-1, then Newton's method is allowed to operate normally.
+ *
+ * The damping factor may increase by at most a factor of three relative to
+ * *damp_old*, the damping factor used for the previous step, which is
+ * updated on return.
  */
-static doublereal calc_damping(doublereal x[], doublereal dxneg[], size_t dim, int* label)
+static doublereal calc_damping(doublereal x[], doublereal dxneg[], size_t dim, int* label,
+                               doublereal& damp_old)
 {
     const doublereal APPROACH = 0.80;
     doublereal    damp = 1.0, xnew, xtop, xbot;
-    static doublereal damp_old = 1.0;
 
     *label = -1;
 
@@ -278,6 +278,22 @@ int BandMatrix::solve(doublereal* b, size_t nrhs, size_t ldb)
     return info;
 }
 
+int BandMatrix::solveTranspose(const doublereal* const b, doublereal* const x)
+{
+    int info = 0;
+    if (!m_factored) {
+        info = factor();
+    }
+    if (x != b) {
+        copy(b, b + m_n, x);
+    }
+    if (info == 0)
+        ct_dgbtrs(ctlapack::Transpose, nColumns(), nSubDiagonals(),
+                  nSuperDiagonals(), 1, DATA_PTR(ludata), ldim(),
+                  DATA_PTR(ipiv()), x, nColumns(), info);
+    return info;
+}
+
 vector_fp::iterator  BandMatrix::begin()
 {
     m_factored = false;
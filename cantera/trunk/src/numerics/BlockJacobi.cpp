@@ -0,0 +1,140 @@
+/**
+ *  @file BlockJacobi.cpp
+ *
+ *  Block-Jacobi preconditioner for ODE systems.
+ */
+
+#include "cantera/numerics/BlockJacobi.h"
+#include "cantera/numerics/ctlapack.h"
+#include "cantera/base/ctexceptions.h"
+#include "cantera/base/stringUtils.h"
+
+#include <algorithm>
+#include <cfloat>
+
+using namespace std;
+
+namespace Cantera
+{
+
+BlockJacobi::BlockJacobi() :
+    m_start(1, 0),
+    m_nJacEvals(0),
+    m_analytic(false)
+{
+}
+
+void BlockJacobi::setBlocks(const std::vector<size_t>& blockStart)
+{
+    if (blockStart.size() < 2 || blockStart[0] != 0) {
+        throw CanteraError("BlockJacobi::setBlocks",
+                           "blockStart must start with 0 and contain at "
+                           "least one block");
+    }
+    size_t nb = blockStart.size() - 1;
+    m_start = blockStart;
+    m_block.resize(m_start.back());
+    m_jac.resize(nb);
+    m_lu.resize(nb);
+    for (size_t n = 0; n < nb; n++) {
+        if (m_start[n+1] <= m_start[n]) {
+            throw CanteraError("BlockJacobi::setBlocks",
+                               "Block " + int2str(n) + " is empty");
+        }
+        size_t nv = m_start[n+1] - m_start[n];
+        m_jac[n].resize(nv, nv, 0.0);
+        m_lu[n].resize(nv, nv, 0.0);
+        fill(m_block.begin() + m_start[n], m_block.begin() + m_start[n+1], n);
+    }
+    m_ydot.resize(m_start.back());
+    m_ysave.resize(m_start.back());
+    m_nJacEvals = 0;
+    m_analytic = false;
+}
+
+size_t BlockJacobi::evalJacobian(FuncEval& func, double t, double* y,
+                                 const double* ydot, const double* ewt,
+                                 double* p)
+{
+    m_nJacEvals++;
+    m_analytic = func.evalJacobianBlocks(t, y, ydot, p, m_jac);
+    if (m_analytic) {
+        return 0;
+    }
+
+    // Perturb the j-th component of every block at the same time
+    size_t nb = nBlocks();
+    size_t nmax = 0;
+    for (size_t n = 0; n < nb; n++) {
+        nmax = std::max(nmax, m_start[n+1] - m_start[n]);
+    }
+    double srur = sqrt(DBL_EPSILON);
+    for (size_t j = 0; j < nmax; j++) {
+        for (size_t n = 0; n < nb; n++) {
+            size_t k = m_start[n] + j;
+            if (k < m_start[n+1]) {
+                m_ysave[k] = y[k];
+                y[k] += std::max(srur * std::abs(m_ysave[k]), 1.0 / ewt[k]);
+            }
+        }
+        func.eval(t, y, &m_ydot[0], p);
+        for (size_t n = 0; n < nb; n++) {
+            size_t k = m_start[n] + j;
+            if (k < m_start[n+1]) {
+                double rdy = 1.0 / (y[k] - m_ysave[k]);
+                y[k] = m_ysave[k];
+                for (size_t i = m_start[n]; i < m_start[n+1]; i++) {
+                    m_jac[n](i - m_start[n], j) = (m_ydot[i] - ydot[i]) * rdy;
+                }
+            }
+        }
+    }
+    return nmax;
+}
+
+int BlockJacobi::factor(double gamma)
+{
+    for (size_t n = 0; n < nBlocks(); n++) {
+        size_t nv = m_start[n+1] - m_start[n];
+        DenseMatrix& lu = m_lu[n];
+        for (size_t j = 0; j < nv; j++) {
+            for (size_t i = 0; i < nv; i++) {
+                lu(i,j) = -gamma * m_jac[n](i,j);
+            }
+            lu(j,j) += 1.0;
+        }
+        int info = 0;
+        ct_dgetrf(nv, nv, lu.ptrColumn(0), nv, &lu.ipiv()[0], info);
+        if (info > 0) {
+            return static_cast<int>(m_start[n]) + info;
+        } else if (info < 0) {
+            throw CanteraError("BlockJacobi::factor",
+                               "DGETRF returned INFO = " + int2str(info));
+        }
+    }
+    return 0;
+}
+
+void BlockJacobi::solve(const double* b, double* x)
+{
+    if (x != b) {
+        copy(b, b + size(), x);
+    }
+    for (size_t n = 0; n < nBlocks(); n++) {
+        size_t nv = m_start[n+1] - m_start[n];
+        int info = 0;
+        ct_dgetrs(ctlapack::NoTranspose, nv, 1, m_lu[n].ptrColumn(0), nv,
+                  &m_lu[n].ipiv()[0], x + m_start[n], nv, info);
+    }
+}
+
+double BlockJacobi::jacobian(size_t i, size_t j) const
+{
+    size_t n = m_block[i];
+    if (m_block[j] != n) {
+        return 0.0;
+    }
+    return m_jac[n](i - m_start[n], j - m_start[n]);
+}
+
+}
@@ -0,0 +1,364 @@
+/**
+ *  @file BlockTridiagMatrix.cpp
+ *
+ *  Block-tridiagonal matrices.
+ */
+
+#include "cantera/numerics/BlockTridiagMatrix.h"
+#include "cantera/numerics/ctlapack.h"
+#include "cantera/base/ctexceptions.h"
+#include "cantera/base/stringUtils.h"
+
+#include <cmath>
+
+using namespace std;
+
+namespace Cantera
+{
+
+BlockTridiagMatrix::BlockTridiagMatrix() :
+    m_n(0),
+    m_factored(false),
+    m_zero(0.0)
+{
+}
+
+BlockTridiagMatrix::BlockTridiagMatrix(const std::vector<size_t>& sizes) :
+    m_n(0),
+    m_factored(false),
+    m_zero(0.0)
+{
+    resize(sizes);
+}
+
+void BlockTridiagMatrix::resize(const std::vector<size_t>& sizes)
+{
+    size_t nb = sizes.size();
+    m_sizes = sizes;
+    m_start.assign(nb + 1, 0);
+    for (size_t b = 0; b < nb; b++) {
+        if (sizes[b] == 0) {
+            throw CanteraError("BlockTridiagMatrix::resize",
+                               "block " + int2str(b) + " is empty");
+        }
+        m_start[b+1] = m_start[b] + sizes[b];
+    }
+    m_n = m_start[nb];
+    m_group.resize(m_n);
+    for (size_t b = 0; b < nb; b++) {
+        for (size_t i = m_start[b]; i < m_start[b+1]; i++) {
+            m_group[i] = b;
+        }
+    }
+
+    // Block row b spans the columns of groups b-1 to b+1, and its factors
+    // span the rows of groups b and b+1 and the columns of groups b to b+2.
+    m_offset.resize(nb);
+    m_luOffset.resize(nb);
+    size_t nData = 0, nLU = 0, nWork = 0;
+    for (size_t b = 0; b < nb; b++) {
+        size_t c0 = m_start[(b == 0) ? 0 : b - 1];
+        size_t c1 = m_start[std::min(b + 2, nb)];
+        m_offset[b] = nData;
+        nData += sizes[b] * (c1 - c0);
+
+        size_t rows = m_start[std::min(b + 2, nb)] - m_start[b];
+        size_t cols = m_start[std::min(b + 3, nb)] - m_start[b];
+        m_luOffset[b] = nLU;
+        nLU += rows * sizes[b] + sizes[b] * (cols - sizes[b]);
+        nWork = std::max(nWork, rows * cols);
+    }
+    m_data.assign(nData, 0.0);
+    m_lu.assign(nLU, 0.0);
+    m_ipiv.assign(m_n, 0);
+    m_work.assign(nWork, 0.0);
+    m_factored = false;
+}
+
+void BlockTridiagMatrix::zero()
+{
+    std::fill(m_data.begin(), m_data.end(), 0.0);
+    m_factored = false;
+}
+
+size_t BlockTridiagMatrix::index(size_t i, size_t j) const
+{
+    size_t b = m_group[i];
+    size_t c0 = m_start[(b == 0) ? 0 : b - 1];
+    size_t c1 = m_start[std::min(b + 2, m_sizes.size())];
+    if (j < c0 || j >= c1) {
+        return npos;
+    }
+    return m_offset[b] + (j - c0) * m_sizes[b] + (i - m_start[b]);
+}
+
+doublereal& BlockTridiagMatrix::value(size_t i, size_t j)
+{
+    m_factored = false;
+    size_t k = index(i, j);
+    if (k == npos) {
+        m_zero = 0.0;
+        return m_zero;
+    }
+    return m_data[k];
+}
+
+doublereal BlockTridiagMatrix::value(size_t i, size_t j) const
+{
+    size_t k = index(i, j);
+    return (k == npos) ? 0.0 : m_data[k];
+}
+
+void BlockTridiagMatrix::mult(const doublereal* b, doublereal* prod) const
+{
+    size_t nb = m_sizes.size();
+    for (size_t g = 0; g < nb; g++) {
+        size_t nr = m_sizes[g];
+        size_t c0 = m_start[(g == 0) ? 0 : g - 1];
+        size_t c1 = m_start[std::min(g + 2, nb)];
+        const doublereal* a = &m_data[m_offset[g]];
+        doublereal* p = prod + m_start[g];
+        for (size_t i = 0; i < nr; i++) {
+            p[i] = 0.0;
+        }
+        for (size_t j = c0; j < c1; j++) {
+            const doublereal* col = a + (j - c0) * nr;
+            for (size_t i = 0; i < nr; i++) {
+                p[i] += col[i] * b[j];
+            }
+        }
+    }
+}
+
+int BlockTridiagMatrix::factor()
+{
+    size_t nb = m_sizes.size();
+    for (size_t b = 0; b < nb; b++) {
+        // Working matrix containing the rows of groups b and b+1 and the
+        // columns of groups b to b+2, stored column-major.
+        size_t s = m_sizes[b];
+        size_t base = m_start[b];
+        size_t rows = m_start[std::min(b + 2, nb)] - base;
+        size_t cols = m_start[std::min(b + 3, nb)] - base;
+        doublereal* w = &m_work[0];
+
+        // Rows of group b, as modified by the elimination of group b-1
+        // (already in m_work), or taken from the matrix for the first group
+        if (b == 0) {
+            std::fill(w, w + rows * cols, 0.0);
+            size_t c1 = m_start[std::min<size_t>(2, nb)];
+            for (size_t j = 0; j < c1; j++) {
+                for (size_t i = 0; i < s; i++) {
+                    w[j*rows + i] = m_data[m_offset[0] + j*s + i];
+                }
+            }
+        } else {
+            // m_work holds an s by (cols_prev - s_prev) matrix with leading
+            // dimension s. Expand it in place to leading dimension 'rows',
+            // starting from the last column so nothing is overwritten.
+            size_t prevCols = m_start[std::min(b + 2, nb)] - base;
+            for (size_t j = cols; j-- > 0;) {
+                for (size_t i = rows; i-- > 0;) {
+                    w[j*rows + i] = (j < prevCols && i < s) ? w[j*s + i] : 0.0;
+                }
+            }
+        }
+
+        // Rows of group b+1, taken from the matrix
+        if (b + 1 < nb) {
+            size_t s1 = m_sizes[b+1];
+            const doublereal* a = &m_data[m_offset[b+1]];
+            for (size_t j = 0; j < cols; j++) {
+                for (size_t i = 0; i < s1; i++) {
+                    w[j*rows + s + i] = a[j*s1 + i];
+                }
+            }
+        }
+
+        // Eliminate the columns of group b. The panel containing these
+        // columns is factored with partial pivoting, after which the row
+        // interchanges are applied to the remaining columns, which are then
+        // updated with a triangular solve and a matrix product.
+        int info = 0;
+        ct_dgetrf(rows, s, w, rows, &m_ipiv[base], info);
+        if (info > 0) {
+            m_factored = false;
+            return int(base) + info;
+        } else if (info < 0) {
+            throw CanteraError("BlockTridiagMatrix::factor",
+                               "DGETRF returned INFO = " + int2str(info));
+        }
+        if (cols > s) {
+            doublereal* r = w + s*rows;
+            for (size_t k = 0; k < s; k++) {
+                size_t p = m_ipiv[base + k] - 1;
+                if (p != k) {
+                    for (size_t j = 0; j < cols - s; j++) {
+                        std::swap(r[j*rows + k], r[j*rows + p]);
+                    }
+                }
+            }
+            ct_dtrsm(ctlapack::Left, ctlapack::LowerTriangular,
+                     ctlapack::NoTranspose, "U", s, cols - s, 1.0, w, rows,
+                     r, rows);
+            if (rows > s) {
+                ct_dgemm(ctlapack::NoTranspose, ctlapack::NoTranspose,
+                         rows - s, cols - s, s, -1.0, w + s, rows, r, rows,
+                         1.0, r + s, rows);
+            }
+        }
+
+        // Save the factors for group b
+        doublereal* lu = &m_lu[m_luOffset[b]];
+        std::copy(w, w + rows*s, lu);
+        lu += rows*s;
+        for (size_t j = s; j < cols; j++) {
+            for (size_t i = 0; i < s; i++) {
+                *lu++ = w[j*rows + i];
+            }
+        }
+
+        // Keep the updated rows of group b+1 for the next step, with leading
+        // dimension s1
+        if (b + 1 < nb) {
+            size_t s1 = rows - s;
+            for (size_t j = s; j < cols; j++) {
+                for (size_t i = 0; i < s1; i++) {
+                    w[(j-s)*s1 + i] = w[j*rows + s + i];
+                }
+            }
+        }
+    }
+    m_factored = true;
+    return 0;
+}
+
+int BlockTridiagMatrix::solve(const doublereal* b, doublereal* x)
+{
+    if (!m_factored) {
+        int info = factor();
+        if (info) {
+            return info;
+        }
+    }
+    if (x != b) {
+        std::copy(b, b + m_n, x);
+    }
+
+    // forward elimination
+    size_t nb = m_sizes.size();
+    for (size_t g = 0; g < nb; g++) {
+        size_t s = m_sizes[g];
+        size_t rows = m_start[std::min(g + 2, nb)] - m_start[g];
+        const doublereal* lu = &m_lu[m_luOffset[g]];
+        doublereal* xg = x + m_start[g];
+        for (size_t k = 0; k < s; k++) {
+            size_t p = m_ipiv[m_start[g] + k] - 1;
+            if (p != k) {
+                std::swap(xg[k], xg[p]);
+            }
+        }
+        for (size_t k = 0; k < s; k++) {
+            const doublereal* lk = lu + k*rows;
+            doublereal xk = xg[k];
+            if (xk != 0.0) {
+                for (size_t i = k + 1; i < rows; i++) {
+                    xg[i] -= lk[i] * xk;
+                }
+            }
+        }
+    }
+
+    // back substitution
+    for (size_t g = nb; g-- > 0;) {
+        size_t s = m_sizes[g];
+        size_t rows = m_start[std::min(g + 2, nb)] - m_start[g];
+        size_t cols = m_start[std::min(g + 3, nb)] - m_start[g];
+        const doublereal* lu = &m_lu[m_luOffset[g]];
+        const doublereal* urest = lu + rows*s;
+        doublereal* xg = x + m_start[g];
+        for (size_t j = s; j < cols; j++) {
+            const doublereal* uj = urest + (j - s)*s;
+            doublereal xj = xg[j];
+            if (xj != 0.0) {
+                for (size_t i = 0; i < s; i++) {
+                    xg[i] -= uj[i] * xj;
+                }
+            }
+        }
+        for (size_t k = s; k-- > 0;) {
+            const doublereal* uk = lu + k*rows;
+            xg[k] /= uk[k];
+            doublereal xk = xg[k];
+            for (size_t i = 0; i < k; i++) {
+                xg[i] -= uk[i] * xk;
+            }
+        }
+    }
+    return 0;
+}
+
+int BlockTridiagMatrix::solveTranspose(const doublereal* b, doublereal* x)
+{
+    if (!m_factored) {
+        int info = factor();
+        if (info) {
+            return info;
+        }
+    }
+    if (x != b) {
+        std::copy(b, b + m_n, x);
+    }
+
+    // With P*A = L*U, A^T*x = b is solved by forward substitution with U^T,
+    // followed by the transposed elimination steps in reverse order.
+    size_t nb = m_sizes.size();
+    for (size_t g = 0; g < nb; g++) {
+        size_t s = m_sizes[g];
+        size_t rows = m_start[std::min(g + 2, nb)] - m_start[g];
+        size_t cols = m_start[std::min(g + 3, nb)] - m_start[g];
+        const doublereal* lu = &m_lu[m_luOffset[g]];
+        const doublereal* urest = lu + rows*s;
+        doublereal* xg = x + m_start[g];
+        for (size_t k = 0; k < s; k++) {
+            const doublereal* uk = lu + k*rows;
+            doublereal sum = xg[k];
+            for (size_t i = 0; i < k; i++) {
+                sum -= uk[i] * xg[i];
+            }
+            xg[k] = sum / uk[k];
+        }
+        for (size_t j = s; j < cols; j++) {
+            const doublereal* uj = urest + (j - s)*s;
+            doublereal sum = 0.0;
+            for (size_t i = 0; i < s; i++) {
+                sum += uj[i] * xg[i];
+            }
+            xg[j] -= sum;
+        }
+    }
+
+    for (size_t g = nb; g-- > 0;) {
+        size_t s = m_sizes[g];
+        size_t rows = m_start[std::min(g + 2, nb)] - m_start[g];
+        const doublereal* lu = &m_lu[m_luOffset[g]];
+        doublereal* xg = x + m_start[g];
+        for (size_t k = s; k-- > 0;) {
+            const doublereal* lk = lu + k*rows;
+            doublereal sum = 0.0;
+            for (size_t i = k + 1; i < rows; i++) {
+                sum += lk[i] * xg[i];
+            }
+            xg[k] -= sum;
+        }
+        for (size_t k = s; k-- > 0;) {
+            size_t p = m_ipiv[m_start[g] + k] - 1;
+            if (p != k) {
+                std::swap(xg[k], xg[p]);
+            }
+        }
+    }
+    return 0;
+}
+
+}
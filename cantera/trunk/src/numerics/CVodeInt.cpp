@@ -5,6 +5,10 @@
 // Copyright 2001  California Institute of Technology
 
 #include "CVodeInt.h"
+#include "cantera/numerics/SparseILU.h"
+#include "cantera/numerics/BlockJacobi.h"
+
+#include <iostream>
 using namespace std;
 
 // cvode includes
@@ -39,8 +43,10 @@ extern "C" {
     }
 
     /**
-     *  Function called by cvode to evaluate the Jacobian matrix.
-     *  (temporary)
+     *  Function called by cvode to evaluate the Jacobian matrix. The
+     *  Jacobian is obtained from FuncEval::getJacobian if the FuncEval
+     *  object provides it, and is otherwise formed by finite differences.
+     *  *jac_data* points to an Array2D used as work space.
      *  @ingroup odeGroup
      */
     static void cvode_jac(integer N, DenseMat J, RhsFn f, void* f_data,
@@ -58,6 +64,15 @@ extern "C" {
 
         int i,j;
         double* col_j;
+        Cantera::Array2D* jac = (Cantera::Array2D*)jac_data;
+        if (func->getJacobian(t, ydata, fydata, NULL, *jac)) {
+            for (j=0; j < N; j++) {
+                std::copy(jac->ptrColumn(j), jac->ptrColumn(j) + N,
+                          (J->data)[j]);
+            }
+            return;
+        }
+
         double ysave, dy;
         for (j=0; j < N; j++) {
             col_j = (J->data)[j];
@@ -74,6 +89,73 @@ extern "C" {
     }
 }
 
+namespace Cantera
+{
+
+//! Data needed by the preconditioner setup and solve functions
+class PrecondData
+{
+public:
+    PrecondData(FuncEval* f, Preconditioner* precon) :
+        m_func(f), m_precon(precon) {}
+    ~PrecondData() {
+        delete m_precon;
+    }
+    FuncEval* m_func;
+    Preconditioner* m_precon;
+};
+
+}
+
+extern "C" {
+
+    /**
+     *  Function called by cvode to evaluate and factor the preconditioner
+     *  matrix I - gamma*J. The Jacobian is only re-evaluated if cvode
+     *  indicates that the previous one is not usable (jok == FALSE).
+     *  @ingroup odeGroup
+     */
+    static int cvode_prec_setup(integer N, real t, N_Vector y, N_Vector fy,
+                                boole jok, boole* jcurPtr, real gamma,
+                                N_Vector ewt, real h, real uround,
+                                long int* nfePtr, void* P_data,
+                                N_Vector vtemp1, N_Vector vtemp2,
+                                N_Vector vtemp3)
+    {
+        Cantera::PrecondData* d = (Cantera::PrecondData*)P_data;
+        try {
+            if (jok) {
+                *jcurPtr = FALSE;
+            } else {
+                *nfePtr += d->m_precon->evalJacobian(*d->m_func, t, N_VDATA(y),
+                                                     N_VDATA(fy), N_VDATA(ewt));
+                *jcurPtr = TRUE;
+            }
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1;
+        }
+        // a zero pivot is a recoverable error; cvode will retry with a
+        // smaller step size or a new Jacobian
+        return d->m_precon->factor(gamma) ? 1 : 0;
+    }
+
+    /**
+     *  Function called by cvode to solve P z = r using the factors of the
+     *  preconditioner matrix.
+     *  @ingroup odeGroup
+     */
+    static int cvode_prec_solve(integer N, real t, N_Vector y, N_Vector fy,
+                                N_Vector vtemp, real gamma, N_Vector ewt,
+                                real delta, long int* nfePtr, N_Vector r,
+                                int lr, void* P_data, N_Vector z)
+    {
+        Cantera::PrecondData* d = (Cantera::PrecondData*)P_data;
+        d->m_precon->solve(N_VDATA(r), N_VDATA(z));
+        return 0;
+    }
+}
+
 namespace Cantera
 {
 CVodeInt::CVodeInt() : m_neq(0),
@@ -90,7 +172,8 @@ CVodeInt::CVodeInt() : m_neq(0),
     m_abstols(1.e-15),
     m_nabs(0),
     m_hmax(0.0),
-    m_maxsteps(20000)
+    m_maxsteps(20000),
+    m_pdata(0)
 {
     m_ropt.resize(OPT_SIZE,0.0);
     m_iopt = new long[OPT_SIZE];
@@ -109,6 +192,7 @@ CVodeInt::~CVodeInt()
         N_VFree(m_abstol);
     }
     delete[] m_iopt;
+    delete m_pdata;
 }
 
 double& CVodeInt::solution(size_t k)
@@ -231,15 +315,41 @@ void CVodeInt::initialize(double t0, FuncEval& func)
         throw CVodeErr("CVodeMalloc failed.");
     }
 
+    delete m_pdata;
+    m_pdata = 0;
+    if (m_type == GMRES + ILU) {
+        SparseILU* ilu = new SparseILU();
+        m_pdata = new PrecondData(&func, ilu);
+        vector<size_t> colStart, rowIndex;
+        func.getJacobianSparsity(colStart, rowIndex);
+        ilu->setPattern(m_neq, colStart, rowIndex);
+    } else if (m_type == GMRES + BLOCKJACOBI) {
+        BlockJacobi* bj = new BlockJacobi();
+        m_pdata = new PrecondData(&func, bj);
+        vector<size_t> blockStart;
+        func.getJacobianBlocks(blockStart);
+        bj->setBlocks(blockStart);
+    }
+    if (m_type == DENSE + JAC) {
+        m_jac.resize(m_neq, m_neq);
+    }
+    setLinearSolver();
+}
+
+void CVodeInt::setLinearSolver()
+{
     if (m_type == DENSE + NOJAC) {
         CVDense(m_cvode_mem, NULL, NULL);
     } else if (m_type == DENSE + JAC) {
-        CVDense(m_cvode_mem, cvode_jac, NULL);
+        CVDense(m_cvode_mem, cvode_jac, &m_jac);
     } else if (m_type == DIAG) {
         CVDiag(m_cvode_mem);
     } else if (m_type == GMRES) {
         CVSpgmr(m_cvode_mem, NONE, MODIFIED_GS, 0, 0.0,
                 NULL, NULL, NULL);
+    } else if (m_type == GMRES + ILU || m_type == GMRES + BLOCKJACOBI) {
+        CVSpgmr(m_cvode_mem, LEFT, MODIFIED_GS, 0, 0.0,
+                cvode_prec_setup, cvode_prec_solve, m_pdata);
     } else {
         throw CVodeErr("unsupported option");
     }
@@ -257,6 +367,9 @@ void CVodeInt::reinitialize(double t0, FuncEval& func)
 
     // pass a pointer to func in m_data
     m_data = (void*)&func;
+    if (m_pdata) {
+        m_pdata->m_func = &func;
+    }
     int result;
     if (m_itol) {
         result = CVReInit(m_cvode_mem, cvode_rhs, m_t0, m_y, m_method,
@@ -273,19 +386,7 @@ void CVodeInt::reinitialize(double t0, FuncEval& func)
     if (result != 0) {
         throw CVodeErr("CVReInit failed.");
     }
-
-    if (m_type == DENSE + NOJAC) {
-        CVDense(m_cvode_mem, NULL, NULL);
-    } else if (m_type == DENSE + JAC) {
-        CVDense(m_cvode_mem, cvode_jac, NULL);
-    } else if (m_type == DIAG) {
-        CVDiag(m_cvode_mem);
-    } else if (m_type == GMRES) {
-        CVSpgmr(m_cvode_mem, NONE, MODIFIED_GS, 0, 0.0,
-                NULL, NULL, NULL);
-    } else {
-        throw CVodeErr("unsupported option");
-    }
+    setLinearSolver();
 }
 
 void CVodeInt::integrate(double tout)
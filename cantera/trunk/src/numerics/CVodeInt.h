@@ -15,6 +15,8 @@
 namespace Cantera
 {
 
+class PrecondData;
+
 /**
  * Exception thrown when a CVODE error is encountered.
  */
@@ -82,6 +84,16 @@ private:
     vector_fp m_ropt;
     long int* m_iopt;
     void* m_data;
+
+    //! Data used by the preconditioner when the problem type is GMRES + ILU
+    //! or GMRES + BLOCKJACOBI
+    PrecondData* m_pdata;
+
+    //! Work space for the Jacobian when the problem type is DENSE + JAC
+    Array2D m_jac;
+
+    //! Attach the linear solver specified by the problem type #m_type
+    void setLinearSolver();
 };
 
 }    // namespace
@@ -175,6 +175,12 @@ void CVodesIntegrator::setSensitivityTolerances(double reltol, double abstol)
 
 void CVodesIntegrator::setProblemType(int probtype)
 {
+    if (probtype == DENSE + JAC || probtype == GMRES + ILU ||
+        probtype == GMRES + BLOCKJACOBI) {
+        throw CVodesErr("problem types DENSE + JAC, GMRES + ILU and "
+                        "GMRES + BLOCKJACOBI are only supported by the bundled "
+                        "CVODE integrator (Cantera built without Sundials)");
+    }
     m_type = probtype;
 }
 
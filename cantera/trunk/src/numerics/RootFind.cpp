@@ -206,8 +206,8 @@ int RootFind::solve(doublereal xmin, doublereal xmax, int itmax, doublereal& fun
     rfT.clear();
     rfT.reasoning = "First Point: ";
 
-    callNum++;
     if (DEBUG_MODE_ENABLED && printLvl >= 3 && writeLogAllowed_) {
+        callNum++;
         char fileName[80];
         sprintf(fileName, "RootFind_%d.log", callNum);
         fp = fopen(fileName, "w");
@@ -0,0 +1,217 @@
+/**
+ *  @file SparseILU.cpp
+ *
+ *  Incomplete LU preconditioner for sparse ODE systems.
+ */
+
+#include "cantera/numerics/SparseILU.h"
+#include "cantera/base/ctexceptions.h"
+#include "cantera/base/stringUtils.h"
+
+#include <set>
+#include <algorithm>
+#include <cfloat>
+
+using namespace std;
+
+namespace Cantera
+{
+
+SparseILU::SparseILU() :
+    m_n(0),
+    m_groupStart(1, 0),
+    m_nJacEvals(0)
+{
+}
+
+void SparseILU::setPattern(size_t n, const std::vector<size_t>& colStart,
+                           const std::vector<size_t>& rowIndex)
+{
+    if (colStart.size() != n + 1) {
+        throw CanteraError("SparseILU::setPattern",
+                           "colStart must have length n + 1");
+    }
+    m_n = n;
+    m_colStart.assign(1, 0);
+    m_rowIndex.clear();
+    m_diag.resize(n);
+    for (size_t j = 0; j < n; j++) {
+        set<size_t> rows(rowIndex.begin() + colStart[j],
+                         rowIndex.begin() + colStart[j+1]);
+        rows.insert(j);
+        if (*rows.rbegin() >= n) {
+            throw CanteraError("SparseILU::setPattern",
+                               "Row index out of range in column " + int2str(j));
+        }
+        for (set<size_t>::const_iterator iter = rows.begin();
+             iter != rows.end(); ++iter) {
+            if (*iter == j) {
+                m_diag[j] = m_rowIndex.size();
+            }
+            m_rowIndex.push_back(*iter);
+        }
+        m_colStart.push_back(m_rowIndex.size());
+    }
+    m_jac.assign(m_rowIndex.size(), 0.0);
+    m_lu.assign(m_rowIndex.size(), 0.0);
+    m_ydot.resize(n);
+    m_ysave.resize(n);
+    m_pos.assign(n, npos);
+    m_nJacEvals = 0;
+    groupColumns();
+}
+
+void SparseILU::groupColumns()
+{
+    // Transpose of the pattern, giving the columns with a nonzero in each row
+    vector<vector<size_t> > rowCols(m_n);
+    for (size_t j = 0; j < m_n; j++) {
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            rowCols[m_rowIndex[p]].push_back(j);
+        }
+    }
+
+    // Greedy coloring: assign each column to the first group which does not
+    // already contain a column sharing a nonzero row with it.
+    vector<size_t> group(m_n, npos);
+    vector<size_t> forbidden; // forbidden[g] == j if column j can't join g
+    size_t ngroups = 0;
+    for (size_t j = 0; j < m_n; j++) {
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            const vector<size_t>& cols = rowCols[m_rowIndex[p]];
+            for (size_t q = 0; q < cols.size(); q++) {
+                if (group[cols[q]] != npos) {
+                    forbidden[group[cols[q]]] = j;
+                }
+            }
+        }
+        size_t g = 0;
+        while (g < ngroups && forbidden[g] == j) {
+            g++;
+        }
+        if (g == ngroups) {
+            ngroups++;
+            forbidden.push_back(npos);
+        }
+        group[j] = g;
+    }
+
+    m_groupStart.assign(ngroups + 1, 0);
+    for (size_t j = 0; j < m_n; j++) {
+        m_groupStart[group[j] + 1]++;
+    }
+    for (size_t g = 0; g < ngroups; g++) {
+        m_groupStart[g+1] += m_groupStart[g];
+    }
+    m_groups.resize(m_n);
+    vector<size_t> next(m_groupStart.begin(), m_groupStart.end() - 1);
+    for (size_t j = 0; j < m_n; j++) {
+        m_groups[next[group[j]]++] = j;
+    }
+}
+
+size_t SparseILU::evalJacobian(FuncEval& func, double t, double* y,
+                               const double* ydot, const double* ewt,
+                               double* p)
+{
+    double srur = sqrt(DBL_EPSILON);
+    for (size_t g = 0; g + 1 < m_groupStart.size(); g++) {
+        // perturb all of the columns in this group
+        for (size_t n = m_groupStart[g]; n < m_groupStart[g+1]; n++) {
+            size_t j = m_groups[n];
+            m_ysave[j] = y[j];
+            y[j] += std::max(srur * std::abs(m_ysave[j]), 1.0 / ewt[j]);
+        }
+        func.eval(t, y, &m_ydot[0], p);
+        for (size_t n = m_groupStart[g]; n < m_groupStart[g+1]; n++) {
+            size_t j = m_groups[n];
+            double rdy = 1.0 / (y[j] - m_ysave[j]);
+            y[j] = m_ysave[j];
+            for (size_t q = m_colStart[j]; q < m_colStart[j+1]; q++) {
+                size_t i = m_rowIndex[q];
+                m_jac[q] = (m_ydot[i] - ydot[i]) * rdy;
+            }
+        }
+    }
+    m_nJacEvals++;
+    return nColumnGroups();
+}
+
+int SparseILU::factor(double gamma)
+{
+    for (size_t j = 0; j < m_n; j++) {
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            m_lu[p] = -gamma * m_jac[p];
+        }
+        m_lu[m_diag[j]] += 1.0;
+    }
+
+    // Left-looking ILU(0): column j of L and U is computed from the
+    // previously factored columns k < j, with all updates to elements outside
+    // the pattern of column j discarded.
+    for (size_t j = 0; j < m_n; j++) {
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            m_pos[m_rowIndex[p]] = p;
+        }
+        for (size_t p = m_colStart[j]; p < m_diag[j]; p++) {
+            size_t k = m_rowIndex[p];
+            double ukj = m_lu[p];
+            for (size_t q = m_diag[k] + 1; q < m_colStart[k+1]; q++) {
+                size_t pos = m_pos[m_rowIndex[q]];
+                if (pos != npos) {
+                    m_lu[pos] -= m_lu[q] * ukj;
+                }
+            }
+        }
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            m_pos[m_rowIndex[p]] = npos;
+        }
+        double pivot = m_lu[m_diag[j]];
+        if (pivot == 0.0) {
+            return static_cast<int>(j) + 1;
+        }
+        for (size_t p = m_diag[j] + 1; p < m_colStart[j+1]; p++) {
+            m_lu[p] /= pivot;
+        }
+    }
+    return 0;
+}
+
+void SparseILU::solve(const double* b, double* x)
+{
+    if (x != b) {
+        copy(b, b + m_n, x);
+    }
+    // forward substitution with the unit lower triangular factor
+    for (size_t j = 0; j < m_n; j++) {
+        double xj = x[j];
+        if (xj != 0.0) {
+            for (size_t p = m_diag[j] + 1; p < m_colStart[j+1]; p++) {
+                x[m_rowIndex[p]] -= m_lu[p] * xj;
+            }
+        }
+    }
+    // back substitution with the upper triangular factor
+    for (size_t j = m_n; j-- > 0;) {
+        x[j] /= m_lu[m_diag[j]];
+        double xj = x[j];
+        if (xj != 0.0) {
+            for (size_t p = m_colStart[j]; p < m_diag[j]; p++) {
+                x[m_rowIndex[p]] -= m_lu[p] * xj;
+            }
+        }
+    }
+}
+
+double SparseILU::jacobian(size_t i, size_t j) const
+{
+    vector<size_t>::const_iterator begin = m_rowIndex.begin() + m_colStart[j];
+    vector<size_t>::const_iterator end = m_rowIndex.begin() + m_colStart[j+1];
+    vector<size_t>::const_iterator iter = lower_bound(begin, end, i);
+    if (iter != end && *iter == i) {
+        return m_jac[iter - m_rowIndex.begin()];
+    }
+    return 0.0;
+}
+
+}
@@ -50,6 +50,15 @@ doublereal linearInterp(doublereal x, const vector_fp& xpts,
     return ff;
 }
 
+void cubicWeights(doublereal t, doublereal* w)
+{
+    doublereal tp = t + 1.0, tm = t - 1.0, tm2 = t - 2.0;
+    w[0] = - t * tm * tm2 / 6.0;
+    w[1] = tp * tm * tm2 / 2.0;
+    w[2] = - tp * t * tm2 / 2.0;
+    w[3] = tp * t * tm / 6.0;
+}
+
 //! Fits a polynomial function to a set of data points
 /*!
  *     Given a collection of points X(I) and a set of values Y(I) which
@@ -29,6 +29,7 @@ solveProb::solveProb(ResidEval* resid) :
     m_atol(0),
     m_rtol(1.0E-4),
     m_maxstep(1000),
+    m_damp_old(1.0),
     m_ioflag(0)
 {
     m_neq =   m_residFunc->nEquations();
@@ -423,7 +424,6 @@ doublereal solveProb::calc_damping(doublereal x[], doublereal dxneg[], size_t di
 {
     const doublereal APPROACH = 0.50;
     doublereal  damp = 1.0, xnew, xtop, xbot;
-    static doublereal damp_old = 1.0;
     *label = npos;
 
     for (size_t i = 0; i < dim; i++) {
@@ -475,8 +475,8 @@ doublereal solveProb::calc_damping(doublereal x[], doublereal dxneg[], size_t di
      * Only allow the damping parameter to increase by a factor of three each
      * iteration. Heuristic to avoid oscillations in the value of damp
      */
-    if (damp > damp_old*3) {
-        damp = damp_old*3;
+    if (damp > m_damp_old*3) {
+        damp = m_damp_old*3;
         *label = npos;
     }
 
@@ -484,7 +484,7 @@ doublereal solveProb::calc_damping(doublereal x[], doublereal dxneg[], size_t di
      *      Save old value of the damping parameter for use
      *      in subsequent calls.
      */
-    damp_old = damp;
+    m_damp_old = damp;
     return damp;
 
 }
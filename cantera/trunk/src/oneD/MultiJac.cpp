@@ -25,7 +25,18 @@ MultiJac::MultiJac(OneDim& r)
     m_mask.resize(m_size);
     m_elapsed = 0.0;
     m_nevals = 0;
+    m_nfactors = 0;
     m_age = 100000;
+    m_colored = true;
+    m_block = false;
+    m_xsave.resize(m_points);
+    m_rdx.resize(m_points);
+    m_loc.resize(m_points);
+    m_nv.resize(m_points);
+    for (size_t j = 0; j < m_points; j++) {
+        m_loc[j] = r.loc(j);
+        m_nv[j] = r.nVars(j);
+    }
     doublereal ff = 1.0;
     while (1.0 + ff != 1.0) {
         ff *= 0.5;
@@ -34,6 +45,54 @@ MultiJac::MultiJac(OneDim& r)
     m_rtol = 1.0e-5;
 }
 
+void MultiJac::setBlockTridiagonal(bool block)
+{
+    if (block == m_block) {
+        return;
+    }
+    m_block = block;
+    if (block) {
+        std::vector<size_t> sizes(m_points);
+        for (size_t j = 0; j < m_points; j++) {
+            sizes[j] = m_resid->nVars(j);
+        }
+        m_blocks.resize(sizes);
+        BandMatrix::resize(m_size, 0, 0);
+    } else {
+        m_blocks.resize(std::vector<size_t>());
+        BandMatrix::resize(m_size, m_resid->bandwidth(), m_resid->bandwidth());
+    }
+    m_age = 100000;
+}
+
+int MultiJac::solve(const doublereal* const b, doublereal* const x)
+{
+    if (m_block) {
+        if (!m_blocks.factored()) {
+            m_nfactors++;
+        }
+        return m_blocks.solve(b, x);
+    }
+    if (!m_factored) {
+        m_nfactors++;
+    }
+    return BandMatrix::solve(b, x);
+}
+
+int MultiJac::solveTranspose(const doublereal* const b, doublereal* const x)
+{
+    if (m_block) {
+        if (!m_blocks.factored()) {
+            m_nfactors++;
+        }
+        return m_blocks.solveTranspose(b, x);
+    }
+    if (!m_factored) {
+        m_nfactors++;
+    }
+    return BandMatrix::solveTranspose(b, x);
+}
+
 void MultiJac::updateTransient(doublereal rdt, integer* mask)
 {
     for (size_t n = 0; n < m_size; n++) {
@@ -51,47 +110,222 @@ void MultiJac::eval(doublereal* x0, doublereal* resid0, doublereal rdt)
 {
     m_nevals++;
     clock_t t0 = clock();
-    bfill(0.0);
-    size_t n, m, ipt=0, j, nv, mv, iloc;
-    doublereal rdx, dx, xsave;
-
-    for (j = 0; j < m_points; j++) {
-        nv = m_resid->nVars(j);
-        for (n = 0; n < nv; n++) {
-
-            // perturb x(n)
-            xsave = x0[ipt];
-            dx = m_atol + fabs(xsave)*m_rtol;
-            x0[ipt] = xsave + dx;
-            dx = x0[ipt] - xsave;
-            rdx = 1.0/dx;
-
-            // calculate perturbed residual
-            m_resid->eval(j, x0, DATA_PTR(m_r1), rdt, 0);
-
-            // compute nth column of Jacobian
-            for (size_t i = j - 1; i != j+2; i++) {
-                if (i != npos && i < m_points) {
-                    mv = m_resid->nVars(i);
-                    iloc = m_resid->loc(i);
-                    for (m = 0; m < mv; m++) {
-                        value(m+iloc,ipt) = (m_r1[m+iloc]
-                                             - resid0[m+iloc])*rdx;
-                    }
+    if (m_block) {
+        m_blocks.zero();
+    } else {
+        bfill(0.0);
+    }
+
+    if (m_colored) {
+        evalColored(x0, resid0);
+    } else {
+        evalColumns(x0, resid0, rdt);
+    }
+
+    for (size_t n = 0; n < m_size; n++) {
+        m_ssdiag[n] = value(n,n);
+    }
+
+    m_elapsed += double(clock() - t0)/CLOCKS_PER_SEC;
+    m_age = 0;
+    m_pending.clear();
+}
+
+void MultiJac::remap(const MultiJac& old, const std::vector<size_t>& oldPoints)
+{
+    if (oldPoints.size() != m_points) {
+        throw CanteraError("MultiJac::remap", "Expected " + int2str(m_points)
+                           + " grid points, got " + int2str(oldPoints.size()));
+    }
+    if (m_block) {
+        m_blocks.zero();
+    } else {
+        bfill(0.0);
+    }
+
+    // The block row for point i can be copied if points i-1, i and i+1 are
+    // consecutive points of the old grid with the same number of variables,
+    // and point i is at the end of the old grid if it is at the end of the
+    // new one.
+    std::vector<bool> dirty(m_points, false);
+    for (size_t i = 0; i < m_points; i++) {
+        size_t io = oldPoints[i];
+        bool clean = (io != npos && io < old.m_points
+                      && old.m_nv[io] == m_resid->nVars(i)
+                      && (i != 0 || io == 0)
+                      && (i + 1 != m_points || io + 1 == old.m_points));
+        for (size_t j = i - 1; clean && j != i + 2; j++) {
+            if (j != npos && j < m_points) {
+                size_t jo = io + j - i;
+                clean = (oldPoints[j] != npos && oldPoints[j] == jo
+                         && old.m_nv[jo] == m_resid->nVars(j));
+            }
+        }
+
+        if (!clean) {
+            // all columns coupled to this row must be evaluated
+            for (size_t j = i - 1; j != i + 2; j++) {
+                if (j != npos && j < m_points) {
+                    dirty[j] = true;
+                }
+            }
+            continue;
+        }
+
+        size_t iloc = m_resid->loc(i);
+        size_t ioloc = old.m_loc[io];
+        size_t mv = m_resid->nVars(i);
+        for (size_t j = i - 1; j != i + 2; j++) {
+            if (j == npos || j >= m_points) {
+                continue;
+            }
+            size_t jloc = m_resid->loc(j);
+            size_t joloc = old.m_loc[io + j - i];
+            size_t nv = m_resid->nVars(j);
+            for (size_t m = 0; m < mv; m++) {
+                for (size_t n = 0; n < nv; n++) {
+                    value(iloc + m, jloc + n) = old.value(ioloc + m, joloc + n);
                 }
             }
-            x0[ipt] = xsave;
-            ipt++;
         }
+        for (size_t m = 0; m < mv; m++) {
+            m_ssdiag[iloc + m] = old.m_ssdiag[ioloc + m];
+            value(iloc + m, iloc + m) = m_ssdiag[iloc + m];
+        }
+    }
 
+    m_pending.clear();
+    for (size_t j = 0; j < m_points; j++) {
+        if (dirty[j]) {
+            m_pending.push_back(j);
+        }
     }
 
-    for (n = 0; n < m_size; n++) {
-        m_ssdiag[n] = value(n,n);
+    // Evaluating the columns for one point separately costs somewhat more
+    // than the share of that point in evalColored(), so if most of the
+    // points are pending, the whole Jacobian is left to be evaluated.
+    if (4 * m_pending.size() > 3 * m_points) {
+        m_pending.clear();
+        return;
     }
+    m_age = old.m_age;
+}
 
+void MultiJac::evalPending(doublereal* x0, doublereal* resid0)
+{
+    m_nevals++;
+    clock_t t0 = clock();
+    for (size_t k = 0; k < m_pending.size(); k++) {
+        size_t j = m_pending[k];
+        evalPoint(j, x0, resid0, 0.0);
+        size_t jloc = m_resid->loc(j);
+        for (size_t n = 0; n < m_resid->nVars(j); n++) {
+            m_ssdiag[jloc + n] = value(jloc + n, jloc + n);
+        }
+    }
+    m_pending.clear();
     m_elapsed += double(clock() - t0)/CLOCKS_PER_SEC;
-    m_age = 0;
+}
+
+void MultiJac::evalColumns(doublereal* x0, doublereal* resid0, doublereal rdt)
+{
+    for (size_t j = 0; j < m_points; j++) {
+        evalPoint(j, x0, resid0, rdt);
+    }
+}
+
+void MultiJac::evalPoint(size_t j, doublereal* x0, doublereal* resid0,
+                         doublereal rdt)
+{
+    size_t nv = m_resid->nVars(j);
+    size_t ipt = m_resid->loc(j);
+    for (size_t n = 0; n < nv; n++, ipt++) {
+        // perturb x(n)
+        doublereal xsave = x0[ipt];
+        doublereal dx = m_atol + fabs(xsave)*m_rtol;
+        x0[ipt] = xsave + dx;
+        dx = x0[ipt] - xsave;
+        doublereal rdx = 1.0/dx;
+
+        // calculate perturbed residual
+        m_resid->eval(j, x0, DATA_PTR(m_r1), rdt, 0);
+
+        // compute nth column of Jacobian
+        for (size_t i = j - 1; i != j+2; i++) {
+            if (i != npos && i < m_points) {
+                size_t mv = m_resid->nVars(i);
+                size_t iloc = m_resid->loc(i);
+                for (size_t m = 0; m < mv; m++) {
+                    value(m+iloc,ipt) = (m_r1[m+iloc]
+                                         - resid0[m+iloc])*rdx;
+                }
+            }
+        }
+        x0[ipt] = xsave;
+    }
+}
+
+void MultiJac::evalColored(doublereal* x0, doublereal* resid0)
+{
+    size_t nvmax = 0;
+    for (size_t j = 0; j < m_points; j++) {
+        nvmax = std::max(nvmax, m_resid->nVars(j));
+    }
+
+    for (size_t i = 0; i < m_resid->nDomains(); i++) {
+        m_resid->domain(i).setJacobianEval(true);
+    }
+    try {
+        for (size_t j0 = 0; j0 < 3; j0++) {
+            for (size_t n = 0; n < nvmax; n++) {
+                // perturb variable n at grid points j0, j0+3, j0+6, ...
+                bool perturbed = false;
+                for (size_t j = j0; j < m_points; j += 3) {
+                    if (n < m_resid->nVars(j)) {
+                        size_t ipt = m_resid->loc(j) + n;
+                        m_xsave[j] = x0[ipt];
+                        x0[ipt] = m_xsave[j] + m_atol + fabs(m_xsave[j])*m_rtol;
+                        m_rdx[j] = 1.0/(x0[ipt] - m_xsave[j]);
+                        perturbed = true;
+                    }
+                }
+                if (!perturbed) {
+                    continue;
+                }
+
+                // calculate the perturbed residual at all points
+                m_resid->eval(npos, x0, DATA_PTR(m_r1), 0.0, 0);
+
+                // The residual at each point depends only on the perturbation
+                // of the variable at that point or one of its neighbors.
+                for (size_t j = j0; j < m_points; j += 3) {
+                    if (n >= m_resid->nVars(j)) {
+                        continue;
+                    }
+                    size_t ipt = m_resid->loc(j) + n;
+                    for (size_t i = j - 1; i != j+2; i++) {
+                        if (i != npos && i < m_points) {
+                            size_t mv = m_resid->nVars(i);
+                            size_t iloc = m_resid->loc(i);
+                            for (size_t m = 0; m < mv; m++) {
+                                value(m+iloc,ipt) = (m_r1[m+iloc]
+                                                     - resid0[m+iloc])*m_rdx[j];
+                            }
+                        }
+                    }
+                    x0[ipt] = m_xsave[j];
+                }
+            }
+        }
+    } catch (...) {
+        for (size_t i = 0; i < m_resid->nDomains(); i++) {
+            m_resid->domain(i).setJacobianEval(false);
+        }
+        throw;
+    }
+    for (size_t i = 0; i < m_resid->nDomains(); i++) {
+        m_resid->domain(i).setJacobianEval(false);
+    }
 }
 
 } // namespace
@@ -138,6 +138,26 @@ doublereal norm_square(const doublereal* x,
     return sum;
 }
 
+/**
+ * Compute the error weights \f$ w_n \f$ used by norm_square() for each
+ * solution component in one domain, and store them in `ewt`.
+ */
+void error_weights(const doublereal* x, doublereal* ewt, Domain1D& r)
+{
+    size_t nv = r.nComponents();
+    size_t np = r.nPoints();
+    for (size_t n = 0; n < nv; n++) {
+        doublereal esum = 0.0;
+        for (size_t j = 0; j < np; j++) {
+            esum += fabs(x[nv*j + n]);
+        }
+        doublereal w = r.rtol(n)*esum/np + r.atol(n);
+        for (size_t j = 0; j < np; j++) {
+            ewt[nv*j + n] = w;
+        }
+    }
+}
+
 } // end unnamed-namespace
 
 //-----------------------------------------------------------
@@ -152,7 +172,14 @@ const size_t NDAMP = 7;
 //-----------------------------------------------------------
 
 MultiNewton::MultiNewton(int sz)
-    : m_maxAge(5)
+    : m_maxAge(5),
+      m_reuseRate(0.0),
+      m_rate(1.0),
+      m_krylov(false),
+      m_krylovDim(20),
+      m_krylovTol(0.05),
+      m_krylovConverged(true),
+      m_nKrylovIters(0)
 {
     m_n  = sz;
     m_elapsed = 0.0;
@@ -164,6 +191,40 @@ void MultiNewton::resize(size_t sz)
     m_x.resize(m_n);
     m_stp.resize(m_n);
     m_stp1.resize(m_n);
+    m_rate = 1.0;
+    m_krylovConverged = true;
+    if (m_krylov) {
+        m_f.resize(m_n);
+        m_ewt.resize(m_n);
+        m_xp.resize(m_n);
+        m_fp.resize(m_n);
+        m_basis.resize(m_n * (m_krylovDim + 1));
+    }
+}
+
+void MultiNewton::setKrylov(bool krylov, size_t maxIters, doublereal tol)
+{
+    if (maxIters == 0) {
+        throw CanteraError("MultiNewton::setKrylov",
+                           "maximum number of iterations must be positive");
+    }
+    m_krylov = krylov;
+    m_krylovDim = maxIters;
+    m_krylovTol = tol;
+    m_krylovConverged = true;
+    m_hess.assign((m_krylovDim + 1) * m_krylovDim, 0.0);
+    m_cs.resize(m_krylovDim);
+    m_sn.resize(m_krylovDim);
+    m_g.resize(m_krylovDim + 1);
+    if (krylov) {
+        resize(m_n);
+    } else {
+        m_f.clear();
+        m_ewt.clear();
+        m_xp.clear();
+        m_fp.clear();
+        m_basis.clear();
+    }
 }
 
 doublereal MultiNewton::norm2(const doublereal* x,
@@ -186,6 +247,9 @@ void MultiNewton::step(doublereal* x, doublereal* step,
     size_t iok;
     size_t sz = r.size();
     r.eval(npos, x, step);
+    if (m_krylov) {
+        copy(step, step + sz, m_f.begin());
+    }
 #undef DEBUG_STEP
 #ifdef DEBUG_STEP
     vector_fp ssave(sz, 0.0);
@@ -224,6 +288,10 @@ void MultiNewton::step(doublereal* x, doublereal* step,
         throw CanteraError("MultiNewton::step",
                            "iok = "+int2str(iok));
 
+    if (m_krylov) {
+        krylovStep(x, &m_f[0], step, r, jac, loglevel);
+    }
+
 #ifdef DEBUG_STEP
     bool ok = false;
     Domain1D* d;
@@ -240,6 +308,152 @@ void MultiNewton::step(doublereal* x, doublereal* step,
 #endif
 }
 
+void MultiNewton::krylovStep(const doublereal* x, const doublereal* f,
+                             doublereal* step, OneDim& r, MultiJac& jac,
+                             int loglevel)
+{
+    // The system J*s = -f is solved with GMRES, preconditioned on the left
+    // by the stored Jacobian M. To measure convergence in the same weighted
+    // norm as the Newton iteration, the unknowns are scaled by the error
+    // weights, i.e. the system solved is (W^-1 M^-1 J W) y = W^-1 M^-1 (-f)
+    // with s = W y, starting from y = 0. The right-hand side is the scaled
+    // step computed with the stored Jacobian.
+    size_t n = m_n;
+    size_t nd = r.nDomains();
+    for (size_t i = 0; i < nd; i++) {
+        error_weights(x + r.start(i), &m_ewt[r.start(i)], r.domain(i));
+    }
+
+    doublereal* v0 = &m_basis[0];
+    doublereal beta = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        v0[i] = step[i] / m_ewt[i];
+        beta += v0[i] * v0[i];
+    }
+    beta = sqrt(beta);
+    m_krylovConverged = true;
+    if (beta == 0.0) {
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        v0[i] /= beta;
+    }
+    std::fill(m_g.begin(), m_g.end(), 0.0);
+    m_g[0] = beta;
+
+    // relative and absolute perturbations used by MultiJac
+    const doublereal rtol = jac.relativePerturbation();
+    const doublereal atol = jac.absolutePerturbation();
+
+    size_t ld = m_krylovDim + 1;
+    size_t k = 0;
+    doublereal res = beta;
+    m_krylovConverged = false;
+    while (k < m_krylovDim) {
+        // Compute w = W^-1 M^-1 J W v_k. The product of the Jacobian with u =
+        // W v_k is approximated as (f(x + h*u) - f(x))/h, where h is chosen
+        // so that no component is perturbed by more than the perturbation
+        // used for the same component when evaluating the Jacobian.
+        const doublereal* vk = &m_basis[k*n];
+        doublereal* w = &m_basis[(k+1)*n];
+        doublereal hinv = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            hinv = std::max(hinv, fabs(vk[i] * m_ewt[i]) /
+                            (atol + rtol * fabs(x[i])));
+        }
+        doublereal h = 1.0 / hinv;
+        for (size_t i = 0; i < n; i++) {
+            m_xp[i] = x[i] + h * vk[i] * m_ewt[i];
+        }
+        r.eval(npos, &m_xp[0], &m_fp[0]);
+        for (size_t i = 0; i < n; i++) {
+            m_fp[i] = (m_fp[i] - f[i]) / h;
+        }
+        if (jac.solve(&m_fp[0], &m_fp[0])) {
+            throw CanteraError("MultiNewton::krylovStep",
+                               "preconditioner solve failed");
+        }
+        for (size_t i = 0; i < n; i++) {
+            w[i] = m_fp[i] / m_ewt[i];
+        }
+        m_nKrylovIters++;
+
+        // modified Gram-Schmidt orthogonalization
+        doublereal* hk = &m_hess[k*ld];
+        for (size_t j = 0; j <= k; j++) {
+            const doublereal* vj = &m_basis[j*n];
+            doublereal dot = 0.0;
+            for (size_t i = 0; i < n; i++) {
+                dot += w[i] * vj[i];
+            }
+            hk[j] = dot;
+            for (size_t i = 0; i < n; i++) {
+                w[i] -= dot * vj[i];
+            }
+        }
+        doublereal wnorm = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            wnorm += w[i] * w[i];
+        }
+        wnorm = sqrt(wnorm);
+        hk[k+1] = wnorm;
+        if (wnorm > 0.0) {
+            for (size_t i = 0; i < n; i++) {
+                w[i] /= wnorm;
+            }
+        }
+
+        // apply the previous Givens rotations to the new column, then
+        // compute the rotation that eliminates its subdiagonal element
+        for (size_t j = 0; j < k; j++) {
+            doublereal t = m_cs[j] * hk[j] + m_sn[j] * hk[j+1];
+            hk[j+1] = -m_sn[j] * hk[j] + m_cs[j] * hk[j+1];
+            hk[j] = t;
+        }
+        doublereal d = sqrt(hk[k]*hk[k] + hk[k+1]*hk[k+1]);
+        if (d == 0.0) {
+            break;
+        }
+        m_cs[k] = hk[k] / d;
+        m_sn[k] = hk[k+1] / d;
+        hk[k] = d;
+        hk[k+1] = 0.0;
+        m_g[k+1] = -m_sn[k] * m_g[k];
+        m_g[k] *= m_cs[k];
+        res = fabs(m_g[k+1]);
+        k++;
+        if (res <= m_krylovTol * beta || wnorm == 0.0) {
+            m_krylovConverged = true;
+            break;
+        }
+    }
+
+    // Solve the upper triangular least-squares system for the coefficients
+    // of the basis vectors, then form s = W V y
+    for (size_t j = k; j-- > 0;) {
+        m_g[j] /= m_hess[j*ld + j];
+        for (size_t i = 0; i < j; i++) {
+            m_g[i] -= m_hess[j*ld + i] * m_g[j];
+        }
+    }
+    std::fill(step, step + n, 0.0);
+    for (size_t j = 0; j < k; j++) {
+        const doublereal* vj = &m_basis[j*n];
+        for (size_t i = 0; i < n; i++) {
+            step[i] += m_g[j] * vj[i];
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        step[i] *= m_ewt[i];
+    }
+
+    if (loglevel > 0) {
+        sprintf(m_buf, "\nGMRES: %s iterations, relative residual %10.3e",
+                int2str(k).c_str(), res / beta);
+        writelog(m_buf);
+    }
+}
+
 doublereal MultiNewton::boundStep(const doublereal* x0,
                                   const doublereal* step0, const OneDim& r, int loglevel)
 {
@@ -365,7 +579,18 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
     while (1 > 0) {
         // Check whether the Jacobian should be re-evaluated.
         if (jac.age() > m_maxAge) {
-            writelog("\nMaximum Jacobian age reached ("+int2str(m_maxAge)+")\n", loglevel);
+            if (m_rate < m_reuseRate) {
+                writelog("\nMaximum Jacobian age reached ("+int2str(m_maxAge)+
+                         "), but keeping Jacobian since the iteration is "
+                         "converging\n", loglevel);
+            } else {
+                writelog("\nMaximum Jacobian age reached ("+int2str(m_maxAge)+")\n", loglevel);
+                forceNewJac = true;
+            }
+        }
+        if (!m_krylovConverged && jac.age() > 1) {
+            writelog("\nRe-evaluating Jacobian, since GMRES did not converge "
+                     "with this Jacobian.\n", loglevel);
             forceNewJac = true;
         }
 
@@ -383,6 +608,7 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
         jac.incrementAge();
 
         // damp the Newton step
+        doublereal s0 = norm2(&m_x[0], &m_stp[0], r);
         m = dampStep(&m_x[0], &m_stp[0], x1, &m_stp1[0], s1, r, jac, loglevel-1, frst);
         if (loglevel == 1 && m >= 0) {
             if (frst) {
@@ -398,6 +624,9 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
             writelog(m_buf);
         }
         frst = false;
+        if (m >= 0) {
+            m_rate = (s0 > 0.0) ? s1 / s0 : 0.0;
+        }
 
         // Successful step, but not converged yet. Take the damped
         // step, and try again.
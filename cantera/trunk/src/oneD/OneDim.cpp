@@ -97,17 +97,19 @@ void OneDim::writeStats(int printTime)
 {
     saveStats();
     char buf[100];
-    sprintf(buf,"\nStatistics:\n\n Grid   Functions   Time      Jacobians   Time \n");
+    sprintf(buf,"\nStatistics:\n\n Grid   Functions   Time      Jacobians   Time      Factors   Krylov \n");
     writelog(buf);
     size_t n = m_gridpts.size();
     for (size_t i = 0; i < n; i++) {
         if (printTime) {
-            sprintf(buf,"%5s   %5i    %9.4f    %5i    %9.4f \n",
+            sprintf(buf,"%5s   %5i    %9.4f    %5i    %9.4f    %5i    %5i \n",
                     int2str(m_gridpts[i]).c_str(), m_funcEvals[i], m_funcElapsed[i],
-                    m_jacEvals[i], m_jacElapsed[i]);
+                    m_jacEvals[i], m_jacElapsed[i], m_jacFactors[i],
+                    m_krylovIters[i]);
         } else {
-            sprintf(buf,"%5s   %5i       NA        %5i        NA    \n",
-                    int2str(m_gridpts[i]).c_str(), m_funcEvals[i], m_jacEvals[i]);
+            sprintf(buf,"%5s   %5i       NA        %5i        NA       %5i    %5i \n",
+                    int2str(m_gridpts[i]).c_str(), m_funcEvals[i], m_jacEvals[i],
+                    m_jacFactors[i], m_krylovIters[i]);
         }
         writelog(buf);
     }
@@ -121,6 +123,9 @@ void OneDim::saveStats()
             m_gridpts.push_back(m_pts);
             m_jacEvals.push_back(m_jac->nEvals());
             m_jacElapsed.push_back(m_jac->elapsedTime());
+            m_jacFactors.push_back(m_jac->nFactors());
+            m_krylovIters.push_back(m_newt->nKrylovIters());
+            m_newt->clearStats();
             m_funcEvals.push_back(m_nevals);
             m_nevals = 0;
             m_funcElapsed.push_back(m_evaltime);
@@ -134,6 +139,8 @@ void OneDim::clearStats()
     m_gridpts.clear();
     m_jacEvals.clear();
     m_jacElapsed.clear();
+    m_jacFactors.clear();
+    m_krylovIters.clear();
     m_funcEvals.clear();
     m_funcElapsed.clear();
     m_nevals = 0;
@@ -141,6 +148,11 @@ void OneDim::clearStats()
 }
 
 void OneDim::resize()
+{
+    resize(std::vector<size_t>());
+}
+
+void OneDim::resize(const std::vector<size_t>& oldPoints)
 {
     m_bw = 0;
     m_nvars.clear();
@@ -187,10 +199,23 @@ void OneDim::resize()
     m_newt->resize(size());
     m_mask.resize(size());
 
-    // delete the current Jacobian evaluator and create a new one
-    delete m_jac;
+    // replace the current Jacobian evaluator with a new one with the same
+    // options, copying the valid parts of the current Jacobian if possible
+    bool colored = true, block = false;
+    MultiJac* old = m_jac;
+    if (old) {
+        colored = old->coloring();
+        block = old->blockTridiagonal();
+    }
     m_jac = new MultiJac(*this);
+    m_jac->setColoring(colored);
+    m_jac->setBlockTridiagonal(block);
     m_jac_ok = false;
+    if (old && !oldPoints.empty() && old->nEvals() > 0 &&
+            old->nPendingPoints() == 0 && old->age() <= m_ss_jac_age) {
+        m_jac->remap(*old, oldPoints);
+    }
+    delete old;
 
     for (size_t i = 0; i < m_nd; i++) {
         m_dom[i]->setJac(m_jac);
@@ -201,7 +226,11 @@ int OneDim::solve(doublereal* x, doublereal* xnew, int loglevel)
 {
     if (!m_jac_ok) {
         eval(npos, x, xnew, 0.0, 0);
-        m_jac->eval(x, xnew, 0.0);
+        if (m_jac->nPendingPoints()) {
+            m_jac->evalPending(x, xnew);
+        } else {
+            m_jac->eval(x, xnew, 0.0);
+        }
         m_jac->updateTransient(m_rdt, DATA_PTR(m_mask));
         m_jac_ok = true;
     }
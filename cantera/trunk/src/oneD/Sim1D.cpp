@@ -4,7 +4,9 @@
 
 #include "cantera/oneD/Sim1D.h"
 #include "cantera/oneD/MultiJac.h"
+#include "cantera/oneD/MultiNewton.h"
 #include "cantera/oneD/StFlow.h"
+#include "cantera/kinetics/Kinetics.h"
 #include "cantera/numerics/funcs.h"
 #include "cantera/base/xml.h"
 
@@ -16,7 +18,8 @@ namespace Cantera
 {
 
 Sim1D::Sim1D(vector<Domain1D*>& domains) :
-    OneDim(domains)
+    OneDim(domains),
+    m_param(0)
 {
     // resize the internal solution vector and the work array, and perform
     // domain-specific initialization of the solution vector.
@@ -329,6 +332,11 @@ int Sim1D::refine(int loglevel)
     doublereal xmid, zmid;
     std::vector<size_t> dsize;
 
+    // global index in the current grid of each point of the new grid, or
+    // npos for new points
+    std::vector<size_t> oldPoints;
+    size_t gstart = 0;
+
     for (size_t n = 0; n < m_nd; n++) {
         Domain1D& d = domain(n);
         Refiner& r = d.refiner();
@@ -355,6 +363,7 @@ int Sim1D::refine(int loglevel)
             if (r.keepPoint(m)) {
                 // add the current grid point to the new grid
                 znew.push_back(d.grid(m));
+                oldPoints.push_back(gstart + m);
 
                 // do the same for the solution at this point
                 for (size_t i = 0; i < comp; i++) {
@@ -370,6 +379,7 @@ int Sim1D::refine(int loglevel)
                     // add new point at midpoint
                     zmid = 0.5*(d.grid(m) + d.grid(m+1));
                     znew.push_back(zmid);
+                    oldPoints.push_back(npos);
                     np++;
 
                     // for each component, linearly interpolate
@@ -384,6 +394,7 @@ int Sim1D::refine(int loglevel)
             }
         }
         dsize.push_back(znew.size() - nstart);
+        gstart += npnow;
     }
 
     // At this point, the new grid znew and the new solution
@@ -406,7 +417,9 @@ int Sim1D::refine(int loglevel)
     // resize the work array
     m_xnew.resize(xnew.size());
 
-    resize();
+    // The Jacobian blocks for the residuals at points away from the new
+    // points are still valid, and are reused
+    resize(oldPoints);
     finalize();
     return np;
 }
@@ -560,4 +573,478 @@ void Sim1D::evalSSJacobian()
 {
     OneDim::evalSSJacobian(DATA_PTR(m_x), DATA_PTR(m_xnew));
 }
+
+void Sim1D::evalFullJacobian()
+{
+    for (size_t n = 0; n < m_nd; n++) {
+        domain(n).forceFullUpdate(true);
+    }
+    try {
+        evalSSJacobian();
+    } catch (...) {
+        for (size_t n = 0; n < m_nd; n++) {
+            domain(n).forceFullUpdate(false);
+        }
+        throw;
+    }
+    for (size_t n = 0; n < m_nd; n++) {
+        domain(n).forceFullUpdate(false);
+    }
+}
+
+void Sim1D::solveAdjoint(const doublereal* b, doublereal* lambda)
+{
+    evalFullJacobian();
+    int info = OneDim::jacobian().solveTranspose(b, lambda);
+    if (info != 0) {
+        throw CanteraError("Sim1D::solveAdjoint",
+                           "Jacobian is singular (info = " + int2str(info) +
+                           ")");
+    }
+}
+
+void Sim1D::getReactionSensitivities(Kinetics& kin, const doublereal* dgdx,
+                                     doublereal* sens, doublereal dp)
+{
+    vector_fp lambda(size()), r0(size()), r1(size());
+    solveAdjoint(dgdx, &lambda[0]);
+
+    // Update the transport properties at the current solution, and keep
+    // them while the multipliers are perturbed
+    OneDim::eval(npos, DATA_PTR(m_x), &r0[0], 0.0, 0);
+    for (size_t n = 0; n < m_nd; n++) {
+        domain(n).setJacobianEval(true);
+    }
+    size_t i = 0;
+    doublereal m = 0.0;
+    try {
+        for (i = 0; i < kin.nReactions(); i++) {
+            m = kin.multiplier(i);
+            kin.setMultiplier(i, m * (1.0 + dp));
+            OneDim::eval(npos, DATA_PTR(m_x), &r1[0], 0.0, 0);
+            kin.setMultiplier(i, m);
+            doublereal sum = 0.0;
+            for (size_t k = 0; k < size(); k++) {
+                sum += lambda[k] * (r1[k] - r0[k]);
+            }
+            sens[i] = - sum / dp;
+        }
+    } catch (...) {
+        if (i < kin.nReactions()) {
+            kin.setMultiplier(i, m);
+        }
+        for (size_t n = 0; n < m_nd; n++) {
+            domain(n).setJacobianEval(false);
+        }
+        throw;
+    }
+    for (size_t n = 0; n < m_nd; n++) {
+        domain(n).setJacobianEval(false);
+    }
+}
+
+void Sim1D::initContinuation(ContinuationParameter& param, doublereal dp,
+                             bool arclength)
+{
+    if (dp == 0.0) {
+        throw CanteraError("Sim1D::initContinuation",
+                           "The initial step must be nonzero");
+    }
+    size_t n = size();
+    m_param = &param;
+    m_arclength = arclength;
+    m_dxds.resize(n);
+    m_ewt.resize(n);
+    m_xc.resize(n);
+    m_fc.resize(n);
+    m_x1.resize(n);
+    m_dfdp.resize(n);
+    m_dxdp.resize(n);
+
+    doublereal p = param.value();
+    m_pscale = std::max(fabs(p), fabs(dp));
+    evalFullJacobian();
+    solveParameterDerivative(DATA_PTR(m_x), p);
+
+    // Start with the tangent in the direction of the initial step
+    m_dpds = (dp > 0.0) ? 1.0 : -1.0;
+    for (size_t i = 0; i < n; i++) {
+        m_dxds[i] = m_dpds * m_dxdp[i];
+    }
+    updateTangent(DATA_PTR(m_x));
+    m_ds = fabs(dp / m_dpds);
+    m_ds0 = m_ds;
+}
+
+void Sim1D::solveParameterDerivative(doublereal* x, doublereal p)
+{
+    size_t n = size();
+    doublereal h = 1.0e-7 * m_pscale;
+    m_param->setValue(p + h);
+    OneDim::eval(npos, x, DATA_PTR(m_dfdp), 0.0, 0);
+    m_param->setValue(p);
+    OneDim::eval(npos, x, DATA_PTR(m_fc), 0.0, 0);
+    for (size_t i = 0; i < n; i++) {
+        m_dfdp[i] = (m_dfdp[i] - m_fc[i]) / h;
+        m_dxdp[i] = -m_dfdp[i];
+    }
+    int info = OneDim::jacobian().solve(DATA_PTR(m_dxdp), DATA_PTR(m_dxdp));
+    if (info != 0) {
+        throw CanteraError("Sim1D::solveParameterDerivative",
+                           "Jacobian is singular (info = " + int2str(info) +
+                           ")");
+    }
+}
+
+void Sim1D::updateTangent(const doublereal* x)
+{
+    size_t n = size();
+    if (!m_arclength) {
+        for (size_t i = 0; i < n; i++) {
+            m_dxds[i] = m_dpds * m_dxdp[i];
+        }
+        return;
+    }
+
+    // Scale each component by its largest magnitude in its domain
+    for (size_t m = 0; m < m_nd; m++) {
+        Domain1D& d = domain(m);
+        size_t nv = d.nComponents();
+        size_t np = d.nPoints();
+        const doublereal* xd = x + d.loc();
+        for (size_t k = 0; k < nv; k++) {
+            doublereal xmax = 0.0;
+            for (size_t j = 0; j < np; j++) {
+                xmax = std::max(xmax, fabs(xd[nv*j + k]));
+            }
+            xmax += d.atol(k);
+            for (size_t j = 0; j < np; j++) {
+                m_ewt[d.loc() + nv*j + k] = xmax;
+            }
+        }
+    }
+
+    // The tangent is (dx/dp, 1) normalized in the scaled norm, with the
+    // sign chosen so that the direction changes as little as possible
+    doublereal norm = 1.0 / (m_pscale * m_pscale);
+    doublereal dot = m_dpds / (m_pscale * m_pscale);
+    for (size_t i = 0; i < n; i++) {
+        doublereal w2 = n * m_ewt[i] * m_ewt[i];
+        norm += m_dxdp[i] * m_dxdp[i] / w2;
+        dot += m_dxdp[i] * m_dxds[i] / w2;
+    }
+    norm = (dot < 0.0) ? -sqrt(norm) : sqrt(norm);
+    m_dpds = 1.0 / norm;
+    for (size_t i = 0; i < n; i++) {
+        m_dxds[i] = m_dxdp[i] / norm;
+    }
+}
+
+void Sim1D::predict(doublereal p0, doublereal& p)
+{
+    for (size_t n = 0; n < m_nd; n++) {
+        Domain1D& d = domain(n);
+        size_t nv = d.nComponents();
+        for (size_t j = 0; j < d.nPoints(); j++) {
+            for (size_t m = 0; m < nv; m++) {
+                size_t i = d.loc() + nv*j + m;
+                doublereal x = m_xc[i] + m_ds * m_dxds[i];
+                m_x[i] = clip(x, d.lowerBound(m), d.upperBound(m));
+            }
+        }
+    }
+    p = p0 + m_ds * m_dpds;
+}
+
+bool Sim1D::correctorStep(doublereal* x, doublereal p, doublereal p0,
+                          doublereal ds, doublereal cb, doublereal* step,
+                          doublereal& dp)
+{
+    size_t n = size();
+    m_param->setValue(p);
+    OneDim::eval(npos, x, step, 0.0);
+    for (size_t i = 0; i < n; i++) {
+        step[i] = -step[i];
+    }
+    if (OneDim::jacobian().solve(step, step)) {
+        return false;
+    }
+
+    // Bordering algorithm for the system augmented by the arclength
+    // condition (dx/ds)^T (x - xpred) + (dp/ds) (p - ppred) = 0, where
+    // the step in the solution is J^-1 (-f) + (dx/dp) dp.
+    dp = 0.0;
+    if (m_arclength) {
+        doublereal c = (p - p0 - ds * m_dpds) * m_dpds /
+                       (m_pscale * m_pscale);
+        for (size_t i = 0; i < n; i++) {
+            doublereal w2 = n * m_ewt[i] * m_ewt[i];
+            c += m_dxds[i] * (x[i] - m_xc[i] - ds * m_dxds[i] + step[i]) / w2;
+        }
+        dp = - c / cb;
+        for (size_t i = 0; i < n; i++) {
+            step[i] += dp * m_dxdp[i];
+        }
+    }
+    return true;
+}
+
+int Sim1D::correct(doublereal& p, doublereal p0, doublereal ds, int loglevel)
+{
+    size_t n = size();
+
+    // Coefficient of the parameter change in the linearized arclength
+    // condition, after eliminating the change in the solution
+    doublereal cb = m_dpds / (m_pscale * m_pscale);
+    if (m_arclength) {
+        for (size_t i = 0; i < n; i++) {
+            cb += m_dxds[i] * m_dxdp[i] / (n * m_ewt[i] * m_ewt[i]);
+        }
+    }
+
+    doublereal dp, dp1;
+    if (!correctorStep(DATA_PTR(m_x), p, p0, ds, cb, DATA_PTR(m_xnew), dp)) {
+        return -1;
+    }
+    for (int iter = 1; iter <= 8; iter++) {
+        doublereal fbound = newton().boundStep(DATA_PTR(m_x),
+                                               DATA_PTR(m_xnew), *this,
+                                               loglevel-2);
+        if (fbound < 1.0e-10) {
+            return -1;
+        }
+        doublereal s0 = newton().norm2(DATA_PTR(m_x), DATA_PTR(m_xnew),
+                                       *this);
+
+        // Damp the step until the next undamped step is smaller, as in
+        // MultiNewton::dampStep
+        doublereal damp = 1.0, ff = 1.0, s1 = 0.0;
+        size_t m;
+        for (m = 0; m < 7; m++) {
+            ff = fbound * damp;
+            for (size_t i = 0; i < n; i++) {
+                m_x1[i] = m_x[i] + ff * m_xnew[i];
+            }
+            if (!correctorStep(DATA_PTR(m_x1), p + ff * dp, p0, ds, cb,
+                               DATA_PTR(m_fc), dp1)) {
+                return -1;
+            }
+            s1 = newton().norm2(DATA_PTR(m_x1), DATA_PTR(m_fc), *this);
+            if (s1 < 1.0 || s1 < s0) {
+                break;
+            }
+            damp /= sqrt(2.0);
+        }
+        if (m == 7) {
+            return -1;
+        }
+        m_x.swap(m_x1);
+        m_xnew.swap(m_fc);
+        p += ff * dp;
+        dp = dp1;
+        if (loglevel > 1) {
+            writelog("    corrector iteration " + int2str(iter) +
+                     ": damping " + fp2str(ff) + ", log10(step) = " +
+                     fp2str(log10(s1 + SmallNumber)) + ", p = " +
+                     fp2str(p) + "\n");
+        }
+        if (ff == 1.0 && s1 < 1.0 && fabs(dp) < 1.0e-4 * m_pscale) {
+            m_param->setValue(p);
+            return iter;
+        }
+    }
+    return -1;
+}
+
+int Sim1D::continuationStep(int loglevel)
+{
+    if (!m_param) {
+        throw CanteraError("Sim1D::continuationStep",
+                           "initContinuation must be called first");
+    }
+    size_t n = size();
+    if (m_dxds.size() != n) {
+        throw CanteraError("Sim1D::continuationStep", "The grid has changed "
+                           "since the continuation was started");
+    }
+    copy(m_x.begin(), m_x.end(), m_xc.begin());
+    doublereal p0 = m_param->value();
+    doublereal p = p0;
+    int iters = -1;
+    bool newJac = false;
+    while (true) {
+        predict(p0, p);
+        iters = correct(p, p0, m_ds, loglevel);
+        if (iters > 0) {
+            break;
+        }
+
+        // Try again with a Jacobian evaluated at the predicted solution,
+        // then with a smaller step
+        if (!newJac) {
+            writelog("Continuation: re-evaluating Jacobian\n", loglevel > 1);
+            predict(p0, p);
+            m_param->setValue(p);
+            try {
+                evalFullJacobian();
+                solveParameterDerivative(DATA_PTR(m_x), p);
+                newJac = true;
+                continue;
+            } catch (CanteraError&) {
+                // singular Jacobian; fall through to reduce the step size
+            }
+        }
+        newJac = false;
+        m_ds *= 0.5;
+        writelog("Continuation: reducing step size to " + fp2str(m_ds) +
+                 "\n", loglevel > 1);
+        if (m_ds < 1.0e-3 * m_ds0) {
+            copy(m_xc.begin(), m_xc.end(), m_x.begin());
+            m_param->setValue(p0);
+            throw CanteraError("Sim1D::continuationStep",
+                               "No converged solution found with the minimum "
+                               "step size, at parameter value " + fp2str(p0));
+        }
+    }
+
+    // Update the tangent at the new solution. Use a new Jacobian if the
+    // iteration converged slowly.
+    if (iters > 4 && !newJac) {
+        evalFullJacobian();
+    }
+    try {
+        solveParameterDerivative(DATA_PTR(m_x), p);
+    } catch (CanteraError&) {
+        evalFullJacobian();
+        solveParameterDerivative(DATA_PTR(m_x), p);
+    }
+    doublereal dpds = m_dpds;
+    updateTangent(DATA_PTR(m_x));
+
+    if (iters <= 4) {
+        m_ds = std::min(1.5 * m_ds, 10.0 * m_ds0);
+    } else if (iters >= 7) {
+        m_ds *= 0.5;
+    }
+    if (loglevel > 0) {
+        writelog("Continuation step: p = " + fp2str(p) + ", " +
+                 int2str(iters) + " iterations, next step " + fp2str(m_ds) +
+                 "\n");
+    }
+    return (dpds * m_dpds < 0.0) ? 1 : 0;
+}
+
+void Sim1D::cacheSolution(const vector_fp& params)
+{
+    CachedSolution c;
+    c.params = params;
+    c.x = m_x;
+    for (size_t n = 0; n < m_nd; n++) {
+        c.grids.push_back(domain(n).grid());
+        FreeFlame* f = dynamic_cast<FreeFlame*>(&domain(n));
+        c.tfixed.push_back(f ? f->m_tfixed : Undef);
+        c.zfixed.push_back(f ? f->m_zfixed : Undef);
+    }
+    m_cache.push_back(c);
+}
+
+size_t Sim1D::restoreCachedSolution(const vector_fp& params, int loglevel)
+{
+    if (m_cache.empty()) {
+        throw CanteraError("Sim1D::restoreCachedSolution",
+                           "The solution cache is empty");
+    }
+
+    // Find the nearest solution
+    size_t inear = npos;
+    doublereal dmin = 0.0;
+    for (size_t i = 0; i < m_cache.size(); i++) {
+        const vector_fp& p = m_cache[i].params;
+        if (p.size() != params.size()) {
+            throw CanteraError("Sim1D::restoreCachedSolution",
+                               "Expected " + int2str(p.size()) +
+                               " parameters, got " + int2str(params.size()));
+        }
+        doublereal dist = 0.0;
+        for (size_t k = 0; k < p.size(); k++) {
+            doublereal scale = std::max(fabs(p[k]), fabs(params[k]));
+            if (scale > 0.0) {
+                dist += pow((p[k] - params[k]) / scale, 2);
+            }
+        }
+        if (inear == npos || dist < dmin) {
+            inear = i;
+            dmin = dist;
+        }
+    }
+    const CachedSolution& c = m_cache[inear];
+    if (loglevel > 0) {
+        writelog("Starting from cached solution " + int2str(inear) +
+                 ", relative distance " +
+                 fp2str(sqrt(dmin / std::max<size_t>(params.size(), 1))) +
+                 "\n");
+    }
+
+    // Interpolate each domain onto the current grid
+    size_t loc = 0;
+    vector_fp fc;
+    for (size_t n = 0; n < m_nd; n++) {
+        Domain1D& d = domain(n);
+        size_t nv = d.nComponents();
+        const vector_fp& grid = c.grids[n];
+        size_t np = grid.size();
+        if (loc + nv * np > c.x.size()) {
+            throw CanteraError("Sim1D::restoreCachedSolution",
+                               "Cached solution does not match the domains");
+        }
+        const doublereal* xc = &c.x[loc];
+        doublereal* x = &m_x[d.loc()];
+        loc += nv * np;
+
+        if (np == 1 || d.nPoints() == 1) {
+            for (size_t j = 0; j < d.nPoints(); j++) {
+                copy(xc, xc + nv, x + nv * j);
+            }
+            continue;
+        }
+
+        // Move the cached flame so that the temperature at the current fixed
+        // point is equal to the fixed temperature
+        doublereal shift = 0.0;
+        FreeFlame* f = dynamic_cast<FreeFlame*>(&d);
+        if (f && f->m_tfixed != Undef) {
+            doublereal t = f->m_tfixed;
+            for (size_t j = 0; j < np - 1; j++) {
+                doublereal t1 = xc[nv*j + c_offset_T];
+                doublereal t2 = xc[nv*(j+1) + c_offset_T];
+                if ((t1 - t) * (t2 - t) <= 0.0 && t1 != t2) {
+                    doublereal z = grid[j] + (t - t1) / (t2 - t1) *
+                                   (grid[j+1] - grid[j]);
+                    shift = f->m_zfixed - z;
+                    break;
+                }
+            }
+        } else if (f && c.tfixed[n] != Undef) {
+            f->m_tfixed = c.tfixed[n];
+            f->m_zfixed = c.zfixed[n];
+        }
+
+        fc.resize(np);
+        for (size_t k = 0; k < nv; k++) {
+            for (size_t j = 0; j < np; j++) {
+                fc[j] = xc[nv*j + k];
+            }
+            for (size_t j = 0; j < d.nPoints(); j++) {
+                x[nv*j + k] = linearInterp(d.grid(j) - shift, grid, fc);
+            }
+        }
+    }
+    if (loc != c.x.size()) {
+        throw CanteraError("Sim1D::restoreCachedSolution",
+                           "Cached solution does not match the domains");
+    }
+    finalize();
+    return inear;
+}
+
 }
@@ -5,17 +5,127 @@
 
 #include "cantera/oneD/StFlow.h"
 #include "cantera/base/ctml.h"
-#include "cantera/transport/TransportBase.h"
+#include "cantera/transport/TransportFactory.h"
+#include "cantera/kinetics/KineticsFactory.h"
+#include "cantera/thermo/ThermoFactory.h"
 #include "cantera/numerics/funcs.h"
 
 #include <cstdio>
 
+#ifdef THREAD_SAFE_CANTERA
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#endif
+
 using namespace ctml;
 using namespace std;
 
 namespace Cantera
 {
 
+#ifdef THREAD_SAFE_CANTERA
+//! A fixed set of threads used by StFlow::eval(). The threads are started
+//! by the constructor and then wait for tasks, so that no threads need to be
+//! created for each evaluation of the residual.
+class StFlow::WorkerPool
+{
+public:
+    typedef boost::function<void(size_t)> task_t;
+
+    //! Start the threads needed to run up to *n* tasks concurrently.
+    explicit WorkerPool(size_t n) :
+        m_task(0),
+        m_ntasks(0),
+        m_generation(0),
+        m_pending(0),
+        m_stop(false),
+        m_ids(n) {
+        for (size_t t = 1; t < n; t++) {
+            m_threads.create_thread(boost::bind(&WorkerPool::work, this, t));
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        m_threads.join_all();
+    }
+
+    //! Call `task(t)` for `t` = 0 to *n* - 1 concurrently, and return when
+    //! all of the calls are finished. Task 0 is run by the calling thread.
+    //! The tasks must not throw exceptions; errors are reported through
+    //! ThreadData::error instead.
+    void run(const task_t& task, size_t n) {
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            m_task = &task;
+            m_ntasks = n;
+            m_pending = n - 1;
+            m_generation++;
+        }
+        m_start.notify_all();
+        m_ids[0] = boost::this_thread::get_id();
+        task(0);
+        boost::mutex::scoped_lock lock(m_mutex);
+        while (m_pending) {
+            m_done.wait(lock);
+        }
+        m_task = 0;
+    }
+
+    //! Number of different threads which ran the tasks of the last call to
+    //! run() with *n* tasks.
+    size_t nThreadsUsed(size_t n) const {
+        std::vector<boost::thread::id> ids(m_ids.begin(), m_ids.begin() + n);
+        std::sort(ids.begin(), ids.end());
+        return std::unique(ids.begin(), ids.end()) - ids.begin();
+    }
+
+private:
+    //! Run task *t* of each call to run() which has more than *t* tasks.
+    void work(size_t t) {
+        size_t generation = 0;
+        while (true) {
+            const task_t* task;
+            {
+                boost::mutex::scoped_lock lock(m_mutex);
+                while (!m_stop && (m_generation == generation ||
+                                   t >= m_ntasks)) {
+                    m_start.wait(lock);
+                }
+                if (m_stop) {
+                    return;
+                }
+                generation = m_generation;
+                task = m_task;
+            }
+            m_ids[t] = boost::this_thread::get_id();
+            (*task)(t);
+            boost::mutex::scoped_lock lock(m_mutex);
+            if (--m_pending == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+    boost::thread_group m_threads;
+    boost::mutex m_mutex;
+    boost::condition_variable m_start; //!< Signals new tasks or stopping
+    boost::condition_variable m_done; //!< Signals that all tasks are done
+    const task_t* m_task; //!< Tasks of the current call to run()
+    size_t m_ntasks; //!< Number of tasks of the current call to run()
+    size_t m_generation; //!< Number of calls to run()
+    size_t m_pending; //!< Tasks not yet finished by the worker threads
+    bool m_stop; //!< Set to stop the worker threads
+    std::vector<boost::thread::id> m_ids; //!< Thread which ran each task
+};
+#endif
+
 StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     Domain1D(nsp+4, points),
     m_press(-1.0),
@@ -28,12 +138,16 @@ StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     m_epsilon_right(0.0),
     m_do_soret(false),
     m_transport_option(-1),
-    m_do_radiation(false)
+    m_do_radiation(false),
+    m_nthreads(1),
+    m_nthreads_used(1),
+    m_pool(0)
 {
     m_type = cFlowType;
 
     m_points = points;
     m_thermo = ph;
+    clearThreadData();
 
     if (ph == 0) {
         return;    // used to create a dummy object
@@ -64,7 +178,6 @@ StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     m_multidiff.resize(m_nsp*m_nsp*m_points);
     m_flux.resize(m_nsp,m_points);
     m_wdot.resize(m_nsp,m_points, 0.0);
-    m_ybar.resize(m_nsp);
     m_qdotRadiation.resize(m_points, 0.0);
 
     //-------------- default solution bounds --------------------
@@ -104,6 +217,11 @@ StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     m_kRadiating[1] = (kr != npos) ? kr : m_thermo->speciesIndex("h2o");
 }
 
+StFlow::~StFlow()
+{
+    clearThreadData();
+}
+
 void StFlow::resize(size_t ncomponents, size_t points)
 {
     Domain1D::resize(ncomponents, points);
@@ -152,6 +270,7 @@ void StFlow::setTransport(Transport& trans, bool withSoret)
 {
     m_trans = &trans;
     m_do_soret = withSoret;
+    clearThreadData();
 
     int model = m_trans->model();
     if (model == cMulticomponent || model == CK_Multicomponent) {
@@ -182,24 +301,107 @@ void StFlow::enableSoret(bool withSoret)
     }
 }
 
-void StFlow::setGas(const doublereal* x, size_t j)
+void StFlow::setNThreads(size_t n)
+{
+    clearThreadData();
+#ifdef THREAD_SAFE_CANTERA
+    if (n == 0) {
+        n = std::max<size_t>(boost::thread::hardware_concurrency(), 1);
+    }
+#endif
+    m_nthreads = std::max<size_t>(n, 1);
+}
+
+void StFlow::clearThreadData()
+{
+#ifdef THREAD_SAFE_CANTERA
+    delete m_pool;
+#endif
+    m_pool = 0;
+    for (size_t i = 1; i < m_threadData.size(); i++) {
+        delete m_threadData[i].trans;
+        delete m_threadData[i].kin;
+        delete m_threadData[i].thermo;
+    }
+    m_threadData.resize(1);
+    m_threadData[0].thermo = m_thermo;
+    m_threadData[0].kin = m_kin;
+    m_threadData[0].trans = m_trans;
+}
+
+void StFlow::prepareThreads(size_t n)
+{
+    while (m_threadData.size() < n) {
+        ThreadData td;
+        try {
+            ThermoPhase* ph = newPhase(m_thermo->xml());
+            td.thermo = dynamic_cast<IdealGasPhase*>(ph);
+            if (!td.thermo) {
+                delete ph;
+                throw CanteraError("StFlow::prepareThreads",
+                    "copy of phase '" + m_thermo->id() + "' is not an "
+                    "IdealGasPhase");
+            }
+            if (m_kin->nPhases() != 1) {
+                throw CanteraError("StFlow::prepareThreads",
+                    "kinetics managers with more than one phase are not "
+                    "supported");
+            }
+            std::vector<ThermoPhase*> phases(1, td.thermo);
+            td.kin = newKineticsMgr(m_thermo->xml(), phases);
+            std::string model;
+            switch (m_trans->model()) {
+            case cMixtureAveraged:
+                model = "Mix";
+                break;
+            case cMulticomponent:
+                model = "Multi";
+                break;
+            case CK_MixtureAveraged:
+                model = "CK_Mix";
+                break;
+            case CK_Multicomponent:
+                model = "CK_Multi";
+                break;
+            default:
+                throw CanteraError("StFlow::prepareThreads",
+                                   "unknown transport model.");
+            }
+            td.trans = newTransportMgr(model, td.thermo);
+        } catch (...) {
+            delete td.kin;
+            delete td.thermo;
+            throw;
+        }
+        m_threadData.push_back(td);
+    }
+
+    for (size_t t = 1; t < n; t++) {
+        for (size_t i = 0; i < m_kin->nReactions(); i++) {
+            m_threadData[t].kin->setMultiplier(i, m_kin->multiplier(i));
+        }
+    }
+}
+
+void StFlow::setGas(IdealGasPhase& gas, const doublereal* x, size_t j)
 {
-    m_thermo->setTemperature(T(x,j));
+    gas.setTemperature(T(x,j));
     const doublereal* yy = x + m_nv*j + c_offset_Y;
-    m_thermo->setMassFractions_NoNorm(yy);
-    m_thermo->setPressure(m_press);
+    gas.setMassFractions_NoNorm(yy);
+    gas.setPressure(m_press);
 }
 
-void StFlow::setGasAtMidpoint(const doublereal* x, size_t j)
+void StFlow::setGasAtMidpoint(ThreadData& td, const doublereal* x, size_t j)
 {
-    m_thermo->setTemperature(0.5*(T(x,j)+T(x,j+1)));
+    td.thermo->setTemperature(0.5*(T(x,j)+T(x,j+1)));
     const doublereal* yyj = x + m_nv*j + c_offset_Y;
     const doublereal* yyjp = x + m_nv*(j+1) + c_offset_Y;
+    td.ybar.resize(m_nsp);
     for (size_t k = 0; k < m_nsp; k++) {
-        m_ybar[k] = 0.5*(yyj[k] + yyjp[k]);
+        td.ybar[k] = 0.5*(yyj[k] + yyjp[k]);
     }
-    m_thermo->setMassFractions_NoNorm(DATA_PTR(m_ybar));
-    m_thermo->setPressure(m_press);
+    td.thermo->setMassFractions_NoNorm(DATA_PTR(td.ybar));
+    td.thermo->setPressure(m_press);
 }
 
 void StFlow::_finalize(const doublereal* x)
@@ -260,30 +462,112 @@ void StFlow::eval(size_t jg, doublereal* xg,
     size_t j0 = std::max<size_t>(jmin, 1) - 1;
     size_t j1 = std::min(jmax+1,m_points-1);
 
-    size_t j, k;
-
-    //-----------------------------------------------------
-    //              update properties
-    //-----------------------------------------------------
+    bool transport = m_force_full_update || (jg == npos && !m_jac_eval);
+    size_t nThreads = (jg == npos) ? std::min(m_nthreads, jmax - jmin + 1) : 1;
+#ifndef THREAD_SAFE_CANTERA
+    nThreads = 1;
+#endif
 
-    updateThermo(x, j0, j1);
-    // update transport properties only if a Jacobian is not being evaluated
     if (jg == npos) {
-        updateTransport(x, j0, j1);
+        m_nthreads_used = nThreads;
+    }
+
+    if (nThreads == 1) {
+        //-----------------------------------------------------
+        //              update properties
+        //-----------------------------------------------------
+
+        updateThermo(x, j0, j1);
+        // update transport properties only if a Jacobian is not being
+        // evaluated
+        if (transport) {
+            updateTransport(x, j0, j1);
+        }
+
+        // update the species diffusive mass fluxes whether or not a
+        // Jacobian is being evaluated
+        updateDiffFluxes(x, j0, j1);
+        updateRadiation(x, jmin, jmax);
+
+        //----------------------------------------------------
+        // evaluate the residual equations at all required
+        // grid points
+        //----------------------------------------------------
+        evalResidual(m_threadData[0], x, rsd, diag, rdt, jmin, jmax);
+        return;
+    }
+
+#ifdef THREAD_SAFE_CANTERA
+    // Evaluate the properties and then the residual equations for contiguous
+    // blocks of grid points in parallel. The values computed at each point
+    // do not depend on how the points are divided among the threads.
+    prepareThreads(nThreads);
+    size_t np = jmax - jmin + 1;
+    for (size_t t = 0; t < nThreads; t++) {
+        ThreadData& td = m_threadData[t];
+        td.jmin = jmin + (t * np) / nThreads;
+        td.jmax = jmin + ((t + 1) * np) / nThreads - 1;
+        td.error.clear();
+    }
+
+    if (!m_pool) {
+        m_pool = new WorkerPool(m_nthreads);
+    }
+    m_pool->run(boost::bind(&StFlow::evalPropertiesBlock, this, _1, x, j1,
+                            transport), nThreads);
+    m_nthreads_used = m_pool->nThreadsUsed(nThreads);
+    for (size_t t = 0; t < nThreads; t++) {
+        if (!m_threadData[t].error.empty()) {
+            throw CanteraError("StFlow::eval", m_threadData[t].error);
+        }
     }
 
-    // update the species diffusive mass fluxes whether or not a
-    // Jacobian is being evaluated
     updateDiffFluxes(x, j0, j1);
+    updateRadiation(x, jmin, jmax);
 
+    m_pool->run(boost::bind(&StFlow::evalResidualBlock, this, _1, x, rsd,
+                            diag, rdt), nThreads);
+    for (size_t t = 0; t < nThreads; t++) {
+        if (!m_threadData[t].error.empty()) {
+            throw CanteraError("StFlow::eval", m_threadData[t].error);
+        }
+    }
+#endif
+}
 
-    //----------------------------------------------------
-    // evaluate the residual equations at all required
-    // grid points
-    //----------------------------------------------------
+void StFlow::evalPropertiesBlock(size_t t, doublereal* x, size_t jlast,
+                                 bool transport)
+{
+    ThreadData* td = &m_threadData[t];
+    try {
+        updateThermo(*td, x, td->jmin, td->jmax);
+        if (transport) {
+            updateTransport(*td, x, td->jmin, std::min(td->jmax + 1, jlast));
+        }
+    } catch (std::exception& err) {
+        td->error = err.what();
+    } catch (...) {
+        // Exceptions must not escape from the worker threads
+        td->error = "unknown exception in StFlow::evalPropertiesBlock";
+    }
+}
 
-    doublereal sum, sum2, dtdzj;
+void StFlow::evalResidualBlock(size_t t, doublereal* x, doublereal* rsd,
+                               integer* diag, doublereal rdt)
+{
+    ThreadData* td = &m_threadData[t];
+    try {
+        evalResidual(*td, x, rsd, diag, rdt, td->jmin, td->jmax);
+    } catch (std::exception& err) {
+        td->error = err.what();
+    } catch (...) {
+        // Exceptions must not escape from the worker threads
+        td->error = "unknown exception in StFlow::evalResidualBlock";
+    }
+}
 
+void StFlow::updateRadiation(const doublereal* x, size_t jmin, size_t jmax)
+{
     // calculation of qdotRadiation
 
     // The simple radiation model used was established by Y. Liu and B. Rogg [Y.
@@ -349,6 +633,15 @@ void StFlow::eval(size_t jg, doublereal* xg,
         }
     }
 
+}
+
+void StFlow::evalResidual(ThreadData& td, doublereal* x, doublereal* rsd,
+                          integer* diag, doublereal rdt, size_t jmin,
+                          size_t jmax)
+{
+    size_t j, k;
+    doublereal sum, sum2, dtdzj;
+
     for (j = jmin; j <= jmax; j++) {
         //----------------------------------------------
         //         left boundary
@@ -412,7 +705,7 @@ void StFlow::eval(size_t jg, doublereal* xg,
             //   = M_k\omega_k
             //
             //-------------------------------------------------
-            getWdot(x,j);
+            getWdot(td, x, j);
 
             doublereal convec, diffus;
             for (k = 0; k < m_nsp; k++) {
@@ -437,11 +730,11 @@ void StFlow::eval(size_t jg, doublereal* xg,
 
             if (m_do_energy[j]) {
 
-                setGas(x,j);
+                setGas(*td.thermo, x, j);
 
                 // heat release term
-                const vector_fp& h_RT = m_thermo->enthalpy_RT_ref();
-                const vector_fp& cp_R = m_thermo->cp_R_ref();
+                const vector_fp& h_RT = td.thermo->enthalpy_RT_ref();
+                const vector_fp& cp_R = td.thermo->cp_R_ref();
 
                 sum = 0.0;
                 sum2 = 0.0;
@@ -475,31 +768,32 @@ void StFlow::eval(size_t jg, doublereal* xg,
     }
 }
 
-void StFlow::updateTransport(doublereal* x, size_t j0, size_t j1)
+void StFlow::updateTransport(ThreadData& td, doublereal* x, size_t j0,
+                             size_t j1)
 {
     if (m_transport_option == c_Mixav_Transport) {
         for (size_t j = j0; j < j1; j++) {
-            setGasAtMidpoint(x,j);
-            m_visc[j] = (m_dovisc ? m_trans->viscosity() : 0.0);
-            m_trans->getMixDiffCoeffs(DATA_PTR(m_diff) + j*m_nsp);
-            m_tcon[j] = m_trans->thermalConductivity();
+            setGasAtMidpoint(td, x, j);
+            m_visc[j] = (m_dovisc ? td.trans->viscosity() : 0.0);
+            td.trans->getMixDiffCoeffs(DATA_PTR(m_diff) + j*m_nsp);
+            m_tcon[j] = td.trans->thermalConductivity();
         }
     } else if (m_transport_option == c_Multi_Transport) {
         for (size_t j = j0; j < j1; j++) {
-            setGasAtMidpoint(x,j);
-            doublereal wtm = m_thermo->meanMolecularWeight();
-            doublereal rho = m_thermo->density();
-            m_visc[j] = (m_dovisc ? m_trans->viscosity() : 0.0);
-            m_trans->getMultiDiffCoeffs(m_nsp, &m_multidiff[mindex(0,0,j)]);
+            setGasAtMidpoint(td, x, j);
+            doublereal wtm = td.thermo->meanMolecularWeight();
+            doublereal rho = td.thermo->density();
+            m_visc[j] = (m_dovisc ? td.trans->viscosity() : 0.0);
+            td.trans->getMultiDiffCoeffs(m_nsp, &m_multidiff[mindex(0,0,j)]);
 
             // Use m_diff as storage for the factor outside the summation
             for (size_t k = 0; k < m_nsp; k++) {
                 m_diff[k+j*m_nsp] = m_wt[k] * rho / (wtm*wtm);
             }
 
-            m_tcon[j] = m_trans->thermalConductivity();
+            m_tcon[j] = td.trans->thermalConductivity();
             if (m_do_soret) {
-                m_trans->getThermalDiffCoeffs(m_dthermal.ptrColumn(0) + j*m_nsp);
+                td.trans->getThermalDiffCoeffs(m_dthermal.ptrColumn(0) + j*m_nsp);
             }
         }
     }
@@ -8,9 +8,249 @@
 
 #include "cantera/thermo/GeneralSpeciesThermo.h"
 #include "cantera/thermo/SpeciesThermoFactory.h"
+#include "cantera/thermo/NasaPoly2.h"
+#include "cantera/thermo/ShomatePoly.h"
+#include "cantera/thermo/Nasa9PolyMultiTempRegion.h"
+
+#include <typeinfo>
 
 namespace Cantera
 {
+
+namespace
+{
+// Each of these functions evaluates the properties of all of the species in
+// a group, where c points to the coefficients of the temperature region that
+// contains T. The expressions are the same as those used by NasaPoly1,
+// ShomatePoly and Nasa9Poly1, respectively.
+
+void updateNasa7(doublereal T, const vector_fp* c,
+                 const std::vector<size_t>& species,
+                 doublereal* cp_R, doublereal* h_RT, doublereal* s_R)
+{
+    doublereal T2 = T * T;
+    doublereal T3 = T2 * T;
+    doublereal T4 = T3 * T;
+    doublereal recipT = 1.0 / T;
+    doublereal logT = std::log(T);
+    const doublereal* a0 = &c[0][0];
+    const doublereal* a1 = &c[1][0];
+    const doublereal* a2 = &c[2][0];
+    const doublereal* a3 = &c[3][0];
+    const doublereal* a4 = &c[4][0];
+    const doublereal* a5 = &c[5][0];
+    const doublereal* a6 = &c[6][0];
+    for (size_t m = 0; m < species.size(); m++) {
+        doublereal ct0 = a0[m];
+        doublereal ct1 = a1[m]*T;
+        doublereal ct2 = a2[m]*T2;
+        doublereal ct3 = a3[m]*T3;
+        doublereal ct4 = a4[m]*T4;
+        size_t k = species[m];
+        cp_R[k] = ct0 + ct1 + ct2 + ct3 + ct4;
+        h_RT[k] = ct0 + 0.5*ct1 + 1.0/3.0*ct2 + 0.25*ct3 + 0.2*ct4
+                  + a5[m]*recipT;
+        s_R[k] = ct0*logT + ct1 + 0.5*ct2 + 1.0/3.0*ct3 + 0.25*ct4 + a6[m];
+    }
+}
+
+void updateShomate(doublereal T, const vector_fp* c,
+                   const std::vector<size_t>& species,
+                   doublereal* cp_R, doublereal* h_RT, doublereal* s_R)
+{
+    doublereal t = 1.e-3*T;
+    doublereal t2 = t * t;
+    doublereal t3 = t2 * t;
+    doublereal recipT2 = 1.0 / t2;
+    doublereal logt = std::log(t);
+    doublereal recipR = 1.0 / GasConstant;
+    doublereal recipRT = 1.0 / (GasConstant * T);
+    const doublereal* A = &c[0][0];
+    const doublereal* B = &c[1][0];
+    const doublereal* C = &c[2][0];
+    const doublereal* D = &c[3][0];
+    const doublereal* E = &c[4][0];
+    const doublereal* F = &c[5][0];
+    const doublereal* G = &c[6][0];
+    for (size_t m = 0; m < species.size(); m++) {
+        doublereal Bt = B[m]*t;
+        doublereal Ct2 = C[m]*t2;
+        doublereal Dt3 = D[m]*t3;
+        doublereal Etm2 = E[m]*recipT2;
+        doublereal cp = A[m] + Bt + Ct2 + Dt3 + Etm2;
+        doublereal h = t*(A[m] + 0.5*Bt + 1.0/3.0*Ct2 + 0.25*Dt3 - Etm2)
+                       + F[m];
+        doublereal s = A[m]*logt + Bt + 0.5*Ct2 + 1.0/3.0*Dt3 - 0.5*Etm2
+                       + G[m];
+        size_t k = species[m];
+        cp_R[k] = 1.e3 * cp * recipR;
+        h_RT[k] = 1.e6 * h * recipRT;
+        s_R[k] = 1.e3 * s * recipR;
+    }
+}
+
+void updateNasa9(doublereal T, const vector_fp* c,
+                 const std::vector<size_t>& species,
+                 doublereal* cp_R, doublereal* h_RT, doublereal* s_R)
+{
+    doublereal T2 = T * T;
+    doublereal T3 = T2 * T;
+    doublereal T4 = T3 * T;
+    doublereal recipT = 1.0 / T;
+    doublereal recipT2 = recipT / T;
+    doublereal logT = std::log(T);
+    const doublereal* a0 = &c[0][0];
+    const doublereal* a1 = &c[1][0];
+    const doublereal* a2 = &c[2][0];
+    const doublereal* a3 = &c[3][0];
+    const doublereal* a4 = &c[4][0];
+    const doublereal* a5 = &c[5][0];
+    const doublereal* a6 = &c[6][0];
+    const doublereal* a7 = &c[7][0];
+    const doublereal* a8 = &c[8][0];
+    for (size_t m = 0; m < species.size(); m++) {
+        doublereal ct0 = a0[m] * recipT2;
+        doublereal ct1 = a1[m] * recipT;
+        doublereal ct2 = a2[m];
+        doublereal ct3 = a3[m] * T;
+        doublereal ct4 = a4[m] * T2;
+        doublereal ct5 = a5[m] * T3;
+        doublereal ct6 = a6[m] * T4;
+        size_t k = species[m];
+        cp_R[k] = ct0 + ct1 + ct2 + ct3 + ct4 + ct5 + ct6;
+        h_RT[k] = -ct0 + logT*ct1 + ct2 + 0.5*ct3 + 1.0/3.0*ct4
+                  + 0.25*ct5 + 0.2*ct6 + a7[m] * recipT;
+        s_R[k] = -0.5*ct0 - ct1 + logT*ct2 + ct3 + 0.5*ct4
+                 + 1.0/3.0*ct5 + 0.25*ct6 + a8[m];
+    }
+}
+
+// Versions of the functions above for n temperatures, where the outputs for
+// species k are stored at k*n, ..., k*n+n-1 and c points to the coefficients
+// of the first temperature region. For the two-region parameterizations, the
+// coefficients are selected separately for each temperature, so that the
+// loops over the temperatures can be vectorized. For NASA9, the index of the
+// temperature region for each temperature is given by `region`; since the
+// coefficients are then gathered from different arrays for each temperature,
+// this loop is generally not vectorized.
+
+void updateNasa7Batch(size_t n, const doublereal* T, const doublereal* logT,
+                      doublereal Tmid, const vector_fp* c,
+                      const std::vector<size_t>& species,
+                      doublereal* cp_R, doublereal* h_RT, doublereal* s_R)
+{
+    for (size_t m = 0; m < species.size(); m++) {
+        // coefficients of the low (l) and high (h) temperature regions
+        doublereal l0 = c[0][m], l1 = c[1][m], l2 = c[2][m], l3 = c[3][m],
+                   l4 = c[4][m], l5 = c[5][m], l6 = c[6][m];
+        doublereal h0 = c[7][m], h1 = c[8][m], h2 = c[9][m], h3 = c[10][m],
+                   h4 = c[11][m], h5 = c[12][m], h6 = c[13][m];
+        size_t k = species[m];
+        doublereal* cp = cp_R + k*n;
+        doublereal* h = h_RT + k*n;
+        doublereal* s = s_R + k*n;
+        for (size_t j = 0; j < n; j++) {
+            bool low = (T[j] <= Tmid);
+            doublereal a0 = low ? l0 : h0;
+            doublereal a1 = low ? l1 : h1;
+            doublereal a2 = low ? l2 : h2;
+            doublereal a3 = low ? l3 : h3;
+            doublereal a4 = low ? l4 : h4;
+            doublereal a5 = low ? l5 : h5;
+            doublereal a6 = low ? l6 : h6;
+            doublereal T2 = T[j] * T[j];
+            doublereal T3 = T2 * T[j];
+            doublereal T4 = T3 * T[j];
+            doublereal ct0 = a0;
+            doublereal ct1 = a1*T[j];
+            doublereal ct2 = a2*T2;
+            doublereal ct3 = a3*T3;
+            doublereal ct4 = a4*T4;
+            cp[j] = ct0 + ct1 + ct2 + ct3 + ct4;
+            h[j] = ct0 + 0.5*ct1 + 1.0/3.0*ct2 + 0.25*ct3 + 0.2*ct4
+                   + a5*(1.0 / T[j]);
+            s[j] = ct0*logT[j] + ct1 + 0.5*ct2 + 1.0/3.0*ct3 + 0.25*ct4 + a6;
+        }
+    }
+}
+
+void updateShomateBatch(size_t n, const doublereal* T, const doublereal* logt,
+                        doublereal Tmid, const vector_fp* c,
+                        const std::vector<size_t>& species,
+                        doublereal* cp_R, doublereal* h_RT, doublereal* s_R)
+{
+    doublereal recipR = 1.0 / GasConstant;
+    for (size_t m = 0; m < species.size(); m++) {
+        // coefficients of the low (l) and high (h) temperature regions
+        doublereal lA = c[0][m], lB = c[1][m], lC = c[2][m], lD = c[3][m],
+                   lE = c[4][m], lF = c[5][m], lG = c[6][m];
+        doublereal hA = c[7][m], hB = c[8][m], hC = c[9][m], hD = c[10][m],
+                   hE = c[11][m], hF = c[12][m], hG = c[13][m];
+        size_t k = species[m];
+        doublereal* cpk = cp_R + k*n;
+        doublereal* hk = h_RT + k*n;
+        doublereal* sk = s_R + k*n;
+        for (size_t j = 0; j < n; j++) {
+            doublereal t = 1.e-3*T[j];
+            bool low = (1000 * t <= Tmid);
+            doublereal A = low ? lA : hA;
+            doublereal B = low ? lB : hB;
+            doublereal C = low ? lC : hC;
+            doublereal D = low ? lD : hD;
+            doublereal E = low ? lE : hE;
+            doublereal F = low ? lF : hF;
+            doublereal G = low ? lG : hG;
+            doublereal t2 = t * t;
+            doublereal t3 = t2 * t;
+            doublereal recipT2 = 1.0 / t2;
+            doublereal Bt = B*t;
+            doublereal Ct2 = C*t2;
+            doublereal Dt3 = D*t3;
+            doublereal Etm2 = E*recipT2;
+            doublereal cp = A + Bt + Ct2 + Dt3 + Etm2;
+            doublereal h = t*(A + 0.5*Bt + 1.0/3.0*Ct2 + 0.25*Dt3 - Etm2) + F;
+            doublereal s = A*logt[j] + Bt + 0.5*Ct2 + 1.0/3.0*Dt3 - 0.5*Etm2 + G;
+            cpk[j] = 1.e3 * cp * recipR;
+            hk[j] = 1.e6 * h * (1.0 / (GasConstant * T[j]));
+            sk[j] = 1.e3 * s * recipR;
+        }
+    }
+}
+
+void updateNasa9Batch(size_t n, const doublereal* T, const doublereal* logT,
+                      const size_t* region, const vector_fp* c,
+                      const std::vector<size_t>& species,
+                      doublereal* cp_R, doublereal* h_RT, doublereal* s_R)
+{
+    for (size_t m = 0; m < species.size(); m++) {
+        size_t k = species[m];
+        doublereal* cp = cp_R + k*n;
+        doublereal* h = h_RT + k*n;
+        doublereal* s = s_R + k*n;
+        for (size_t j = 0; j < n; j++) {
+            const vector_fp* a = c + 9*region[j];
+            doublereal T2 = T[j] * T[j];
+            doublereal T3 = T2 * T[j];
+            doublereal T4 = T3 * T[j];
+            doublereal recipT = 1.0 / T[j];
+            doublereal recipT2 = recipT / T[j];
+            doublereal ct0 = a[0][m] * recipT2;
+            doublereal ct1 = a[1][m] * recipT;
+            doublereal ct2 = a[2][m];
+            doublereal ct3 = a[3][m] * T[j];
+            doublereal ct4 = a[4][m] * T2;
+            doublereal ct5 = a[5][m] * T3;
+            doublereal ct6 = a[6][m] * T4;
+            cp[j] = ct0 + ct1 + ct2 + ct3 + ct4 + ct5 + ct6;
+            h[j] = -ct0 + logT[j]*ct1 + ct2 + 0.5*ct3 + 1.0/3.0*ct4
+                   + 0.25*ct5 + 0.2*ct6 + a[7][m] * recipT;
+            s[j] = -0.5*ct0 - ct1 + logT[j]*ct2 + ct3 + 0.5*ct4
+                   + 1.0/3.0*ct5 + 0.25*ct6 + a[8][m];
+        }
+    }
+}
+}
+
 GeneralSpeciesThermo::GeneralSpeciesThermo() :
     m_tlow_max(0.0),
     m_thigh_min(1.0E30),
@@ -24,7 +264,10 @@ GeneralSpeciesThermo::GeneralSpeciesThermo(const GeneralSpeciesThermo& b) :
     m_speciesLoc(b.m_speciesLoc),
     m_tlow_max(b.m_tlow_max),
     m_thigh_min(b.m_thigh_min),
-    m_p0(b.m_p0)
+    m_p0(b.m_p0),
+    m_groups(b.m_groups),
+    m_groupLoc(b.m_groupLoc),
+    m_packed(b.m_packed)
 {
     clear();
     // Copy SpeciesThermoInterpTypes from 'b'
@@ -62,6 +305,9 @@ GeneralSpeciesThermo::operator=(const GeneralSpeciesThermo& b)
     m_tlow_max = b.m_tlow_max;
     m_thigh_min = b.m_thigh_min;
     m_p0 = b.m_p0;
+    m_groups = b.m_groups;
+    m_groupLoc = b.m_groupLoc;
+    m_packed = b.m_packed;
 
     return *this;
 }
@@ -132,9 +378,85 @@ void GeneralSpeciesThermo::install_STIT(SpeciesThermoInterpType* stit_ptr)
     // Calculate max and min T
     m_tlow_max = std::max(stit_ptr->minTemp(), m_tlow_max);
     m_thigh_min = std::min(stit_ptr->maxTemp(), m_thigh_min);
+
+    // Species are evaluated from packed coefficients only if all of the
+    // species with this parameterization type can be.
+    std::map<int, bool>::iterator packed = m_packed.find(type);
+    if (packed == m_packed.end() || packed->second) {
+        vector_fp bounds, coeffs;
+        m_packed[type] = getPackedCoeffs(stit_ptr, bounds, coeffs);
+        if (m_packed[type]) {
+            addToGroup(index, type, bounds, coeffs);
+        }
+    }
     markInstalled(index);
 }
 
+bool GeneralSpeciesThermo::getPackedCoeffs(
+    const SpeciesThermoInterpType* stit_ptr, vector_fp& bounds,
+    vector_fp& coeffs)
+{
+    // Only the exact classes are handled, since derived classes could
+    // evaluate the properties differently.
+    const std::type_info& stit_type = typeid(*stit_ptr);
+    size_t n;
+    int type;
+    doublereal tlow, thigh, pref;
+    if (stit_type == typeid(NasaPoly2)) {
+        const NasaPoly2* sp = static_cast<const NasaPoly2*>(stit_ptr);
+        bounds.assign(1, sp->m_midT);
+        coeffs.resize(14);
+        sp->mnp_low.reportParameters(n, type, tlow, thigh, pref, &coeffs[0]);
+        sp->mnp_high.reportParameters(n, type, tlow, thigh, pref, &coeffs[7]);
+    } else if (stit_type == typeid(ShomatePoly2)) {
+        const ShomatePoly2* sp = static_cast<const ShomatePoly2*>(stit_ptr);
+        bounds.assign(1, sp->m_midT);
+        coeffs.resize(14);
+        sp->msp_low.reportParameters(n, type, tlow, thigh, pref, &coeffs[0]);
+        sp->msp_high.reportParameters(n, type, tlow, thigh, pref, &coeffs[7]);
+    } else if (stit_type == typeid(Nasa9PolyMultiTempRegion)) {
+        const Nasa9PolyMultiTempRegion* sp =
+            static_cast<const Nasa9PolyMultiTempRegion*>(stit_ptr);
+        bounds.clear();
+        coeffs.resize(9 * sp->m_numTempRegions);
+        // Nasa9Poly1 reports [1, tlow, thigh, 9 coefficients]
+        doublereal c[12];
+        for (size_t i = 0; i < sp->m_numTempRegions; i++) {
+            sp->m_regionPts[i]->reportParameters(n, type, tlow, thigh, pref, c);
+            if (i != 0) {
+                bounds.push_back(sp->m_lowerTempBounds[i]);
+            }
+            std::copy(c + 3, c + 12, coeffs.begin() + 9 * i);
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void GeneralSpeciesThermo::addToGroup(size_t k, int type,
+                                      const vector_fp& bounds,
+                                      const vector_fp& coeffs)
+{
+    size_t n = 0;
+    while (n < m_groups.size() &&
+           (m_groups[n].type != type || m_groups[n].bounds != bounds)) {
+        n++;
+    }
+    if (n == m_groups.size()) {
+        m_groups.push_back(PolyGroup());
+        m_groups[n].type = type;
+        m_groups[n].bounds = bounds;
+        m_groups[n].coeffs.resize(coeffs.size());
+    }
+    PolyGroup& group = m_groups[n];
+    m_groupLoc[k] = std::make_pair(n, group.species.size());
+    group.species.push_back(k);
+    for (size_t j = 0; j < coeffs.size(); j++) {
+        group.coeffs[j].push_back(coeffs[j]);
+    }
+}
+
 void GeneralSpeciesThermo::installPDSShandler(size_t k, PDSS* PDSS_ptr,
         VPSSMgr* vpssmgr_ptr)
 {
@@ -154,9 +476,45 @@ void GeneralSpeciesThermo::update_one(size_t k, doublereal t, doublereal* cp_R,
 void GeneralSpeciesThermo::update(doublereal t, doublereal* cp_R,
                                   doublereal* h_RT, doublereal* s_R) const
 {
+    for (size_t n = 0; n < m_groups.size(); n++) {
+        const PolyGroup& group = m_groups[n];
+        if (!getValue(m_packed, group.type)) {
+            continue;
+        }
+        // Find the temperature region, using the same comparisons as the
+        // SpeciesThermoInterpType objects
+        size_t region = 0;
+        switch (group.type) {
+        case NASA2:
+            region = (t <= group.bounds[0]) ? 0 : 1;
+            updateNasa7(t, &group.coeffs[7*region], group.species,
+                        cp_R, h_RT, s_R);
+            break;
+        case SHOMATE2:
+            region = (1000 * (1.e-3 * t) <= group.bounds[0]) ? 0 : 1;
+            updateShomate(t, &group.coeffs[7*region], group.species,
+                          cp_R, h_RT, s_R);
+            break;
+        case NASA9MULTITEMP:
+            while (region < group.bounds.size() &&
+                   t >= group.bounds[region]) {
+                region++;
+            }
+            updateNasa9(t, &group.coeffs[9*region], group.species,
+                        cp_R, h_RT, s_R);
+            break;
+        default:
+            throw CanteraError("GeneralSpeciesThermo::update",
+                               "Unexpected type: " + int2str(group.type));
+        }
+    }
+
     STIT_map::const_iterator iter = m_sp.begin();
     tpoly_map::iterator jter = m_tpoly.begin();
     for (; iter != m_sp.end(); iter++, jter++) {
+        if (getValue(m_packed, iter->first)) {
+            continue;
+        }
         const std::vector<SpeciesThermoInterpType*>& species = iter->second;
         double* tpoly = &jter->second[0];
         species[0]->updateTemperaturePoly(t, tpoly);
@@ -166,6 +524,83 @@ void GeneralSpeciesThermo::update(doublereal t, doublereal* cp_R,
     }
 }
 
+void GeneralSpeciesThermo::updateBatch(size_t n, const doublereal* T,
+                                       doublereal* cp_R, doublereal* h_RT,
+                                       doublereal* s_R) const
+{
+    if (n == 0) {
+        return;
+    }
+    vector_fp logT(n), logt;
+    std::vector<size_t> region;
+    for (size_t j = 0; j < n; j++) {
+        logT[j] = std::log(T[j]);
+    }
+
+    for (size_t g = 0; g < m_groups.size(); g++) {
+        const PolyGroup& group = m_groups[g];
+        if (!getValue(m_packed, group.type)) {
+            continue;
+        }
+        switch (group.type) {
+        case NASA2:
+            updateNasa7Batch(n, T, &logT[0], group.bounds[0], &group.coeffs[0],
+                             group.species, cp_R, h_RT, s_R);
+            break;
+        case SHOMATE2:
+            if (logt.empty()) {
+                logt.resize(n);
+                for (size_t j = 0; j < n; j++) {
+                    logt[j] = std::log(1.e-3*T[j]);
+                }
+            }
+            updateShomateBatch(n, T, &logt[0], group.bounds[0],
+                               &group.coeffs[0], group.species,
+                               cp_R, h_RT, s_R);
+            break;
+        case NASA9MULTITEMP:
+            region.assign(n, 0);
+            for (size_t j = 0; j < n; j++) {
+                while (region[j] < group.bounds.size() &&
+                       T[j] >= group.bounds[region[j]]) {
+                    region[j]++;
+                }
+            }
+            updateNasa9Batch(n, T, &logT[0], &region[0], &group.coeffs[0],
+                             group.species, cp_R, h_RT, s_R);
+            break;
+        default:
+            throw CanteraError("GeneralSpeciesThermo::updateBatch",
+                               "Unexpected type: " + int2str(group.type));
+        }
+    }
+
+    // Evaluate the remaining species one temperature at a time
+    vector_fp cp1, h1, s1;
+    STIT_map::const_iterator iter = m_sp.begin();
+    for (; iter != m_sp.end(); iter++) {
+        if (getValue(m_packed, iter->first)) {
+            continue;
+        }
+        if (cp1.empty()) {
+            size_t nsp = m_speciesLoc.rbegin()->first + 1;
+            cp1.resize(nsp);
+            h1.resize(nsp);
+            s1.resize(nsp);
+        }
+        const std::vector<SpeciesThermoInterpType*>& species = iter->second;
+        for (size_t j = 0; j < n; j++) {
+            for (size_t m = 0; m < species.size(); m++) {
+                species[m]->updatePropertiesTemp(T[j], &cp1[0], &h1[0], &s1[0]);
+                size_t k = species[m]->speciesIndex();
+                cp_R[k*n + j] = cp1[k];
+                h_RT[k*n + j] = h1[k];
+                s_R[k*n + j] = s1[k];
+            }
+        }
+    }
+}
+
 int GeneralSpeciesThermo::reportType(size_t index) const
 {
     const SpeciesThermoInterpType* sp = provideSTIT(index);
@@ -262,6 +697,16 @@ void GeneralSpeciesThermo::modifyOneHf298(const size_t k, const doublereal Hf298
     SpeciesThermoInterpType* sp_ptr = provideSTIT(k);
     if (sp_ptr) {
         sp_ptr->modifyOneHf298(k, Hf298New);
+        std::map<size_t, std::pair<size_t, size_t> >::const_iterator loc =
+            m_groupLoc.find(k);
+        if (loc != m_groupLoc.end()) {
+            vector_fp bounds, coeffs;
+            getPackedCoeffs(sp_ptr, bounds, coeffs);
+            PolyGroup& group = m_groups[loc->second.first];
+            for (size_t j = 0; j < coeffs.size(); j++) {
+                group.coeffs[j][loc->second.second] = coeffs[j];
+            }
+        }
     }
 }
 
@@ -28,6 +28,28 @@
 namespace Cantera
 {
 
+namespace
+{
+//! Ids of the cached values used by this class. These are assigned during
+//! static initialization; see ValueCache.
+const int cacheId_density = ValueCache::getId();
+const int cacheId_A_Debye = ValueCache::getId();
+const int cacheId_dA_DebyedT = ValueCache::getId();
+const int cacheId_d2A_DebyedT2 = ValueCache::getId();
+const int cacheId_dA_DebyedP = ValueCache::getId();
+const int cacheId_lnActCoeff = ValueCache::getId();
+const int cacheId_dlnActCoeff_dT = ValueCache::getId();
+const int cacheId_d2lnActCoeff_dT2 = ValueCache::getId();
+const int cacheId_dlnActCoeff_dP = ValueCache::getId();
+
+//! Flags for the quantities evaluated by
+//! HMWSoln::s_updatePitzer_lnMolalityActCoeff()
+const int PITZER_VALUE = 1;
+const int PITZER_DT = 2;
+const int PITZER_DT2 = 4;
+const int PITZER_DP = 8;
+}
+
 HMWSoln::HMWSoln() :
     m_formPitzer(PITZERFORM_BASE),
     m_formPitzerTemp(PITZER_TEMP_CONSTANT),
@@ -70,6 +92,8 @@ HMWSoln::HMWSoln() :
     CROP_ln_gamma_k_min(-5.0),
     CROP_ln_gamma_k_max(15.0),
     m_last_is(-1.0),
+    m_pitzerDerivs(0),
+    m_pitzerCurrent(0),
     m_debugCalc(0)
 {
     for (size_t i = 0; i < 17; i++) {
@@ -120,6 +144,8 @@ HMWSoln::HMWSoln(const std::string& inputFile, const std::string& id_) :
     CROP_ln_gamma_k_min(-5.0),
     CROP_ln_gamma_k_max(15.0),
     m_last_is(-1.0),
+    m_pitzerDerivs(0),
+    m_pitzerCurrent(0),
     m_debugCalc(0)
 {
     for (int i = 0; i < 17; i++) {
@@ -171,6 +197,8 @@ HMWSoln::HMWSoln(XML_Node& phaseRoot, const std::string& id_) :
     CROP_ln_gamma_k_min(-5.0),
     CROP_ln_gamma_k_max(15.0),
     m_last_is(-1.0),
+    m_pitzerDerivs(0),
+    m_pitzerCurrent(0),
     m_debugCalc(0)
 {
     for (int i = 0; i < 17; i++) {
@@ -222,6 +250,8 @@ HMWSoln::HMWSoln(const HMWSoln& b) :
     CROP_ln_gamma_k_min(-5.0),
     CROP_ln_gamma_k_max(15.0),
     m_last_is(-1.0),
+    m_pitzerDerivs(0),
+    m_pitzerCurrent(0),
     m_debugCalc(0)
 {
     /*
@@ -383,6 +413,8 @@ HMWSoln& HMWSoln::operator=(const HMWSoln& b)
         CROP_ln_gamma_k_min   = b.CROP_ln_gamma_k_min;
         CROP_ln_gamma_k_max   = b.CROP_ln_gamma_k_max;
         CROP_speciesCropped_  = b.CROP_speciesCropped_;
+        m_pitzerDerivs        = b.m_pitzerDerivs;
+        m_pitzerCurrent       = b.m_pitzerCurrent;
 
         m_debugCalc           = b.m_debugCalc;
     }
@@ -526,8 +558,7 @@ void HMWSoln::setPressure(doublereal p)
 
 void HMWSoln::calcDensity()
 {
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
+    CachedScalar cached = m_cache.getScalar(cacheId_density);
     if(cached.validate(temperature(), pressure(), stateMFNumber())) {
         return;
     }
@@ -855,8 +886,7 @@ double HMWSoln::A_Debye_TP(double tempArg, double presArg) const
         P = presArg;
     }
 
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
+    CachedScalar cached = m_cache.getScalar(cacheId_A_Debye);
     if(cached.validate(T, P)) {
         return m_A_Debye;
     }
@@ -886,12 +916,18 @@ double HMWSoln::dA_DebyedT_TP(double tempArg, double presArg) const
         P = presArg;
     }
     doublereal dAdT;
+    CachedScalar cached = m_cache.getScalar(cacheId_dA_DebyedT);
     switch (m_form_A_Debye) {
     case A_DEBYE_CONST:
         dAdT = 0.0;
         break;
     case A_DEBYE_WATER:
-        dAdT = m_waterProps->ADebye(T, P, 1);
+        if(cached.validate(T, P)) {
+            dAdT = cached.value;
+        } else {
+            dAdT = m_waterProps->ADebye(T, P, 1);
+            cached.value = dAdT;
+        }
         break;
     default:
         throw CanteraError("HMWSoln::dA_DebyedT_TP", "shouldn't be here");
@@ -911,8 +947,7 @@ double HMWSoln::dA_DebyedP_TP(double tempArg, double presArg) const
     }
 
     double dAdP;
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
+    CachedScalar cached = m_cache.getScalar(cacheId_dA_DebyedP);
     switch (m_form_A_Debye) {
     case A_DEBYE_CONST:
         dAdP = 0.0;
@@ -976,12 +1011,18 @@ double HMWSoln::d2A_DebyedT2_TP(double tempArg, double presArg) const
         P = presArg;
     }
     double d2AdT2;
+    CachedScalar cached = m_cache.getScalar(cacheId_d2A_DebyedT2);
     switch (m_form_A_Debye) {
     case A_DEBYE_CONST:
         d2AdT2 = 0.0;
         break;
     case A_DEBYE_WATER:
-        d2AdT2 = m_waterProps->ADebye(T, P, 2);
+        if(cached.validate(T, P)) {
+            d2AdT2 = cached.value;
+        } else {
+            d2AdT2 = m_waterProps->ADebye(T, P, 2);
+            cached.value = d2AdT2;
+        }
         break;
     default:
         throw CanteraError("HMWSoln::d2A_DebyedT2_TP", "shouldn't be here");
@@ -1132,8 +1173,7 @@ void HMWSoln::initLengths()
 
 void HMWSoln::s_update_lnMolalityActCoeff() const
 {
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
+    CachedScalar cached = m_cache.getScalar(cacheId_lnActCoeff);
     if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
         return;
     }
@@ -1179,9 +1219,11 @@ void HMWSoln::s_update_lnMolalityActCoeff() const
     s_updateIMS_lnMolalityActCoeff();
 
     /*
-     * Now do the main calculation.
+     * Now do the main calculation, along with any derivatives of the
+     * activity coefficients which have been requested before.
      */
-    s_updatePitzer_lnMolalityActCoeff();
+    m_pitzerCurrent = PITZER_VALUE | m_pitzerDerivs;
+    s_updatePitzer_lnMolalityActCoeff(m_pitzerCurrent);
 
     double xmolSolvent = moleFraction(m_indexSolvent);
     double xx = std::max(m_xmolSolventMIN, xmolSolvent);
@@ -1673,7 +1715,7 @@ void HMWSoln::s_updatePitzer_CoeffWRTemp(int doDerivs) const
 
 }
 
-void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
+void HMWSoln::s_updatePitzer_lnMolalityActCoeff(int quantities) const
 {
     /*
      * HKM -> Assumption is made that the solvent is
@@ -1690,22 +1732,113 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     const double* molality = DATA_PTR(m_molalitiesCropped);
 
     /*
-     * These are data inputs about the Pitzer correlation. They come
-     * from the input file for the Pitzer model.
-     */
-    const double* beta0MX =  DATA_PTR(m_Beta0MX_ij);
-    const double* beta1MX =  DATA_PTR(m_Beta1MX_ij);
-    const double* beta2MX =  DATA_PTR(m_Beta2MX_ij);
-    const double* CphiMX  =  DATA_PTR(m_CphiMX_ij);
-    const double* thetaij =  DATA_PTR(m_Theta_ij);
+     * For fixed molalities, the Pitzer expressions are linear in the
+     * Pitzer coefficients and in A_Debye. The temperature and pressure
+     * derivatives of the activity coefficients are therefore given by the
+     * same sums, with the coefficients replaced by their derivatives as
+     * computed by s_updatePitzer_CoeffWRTemp(). All of the requested
+     * quantities are accumulated together, so that the functions of the
+     * ionic strength and the loops over the species are shared between
+     * them. The E-theta terms depend only on the ionic strength, so they
+     * only contribute to the activity coefficients themselves.
+     *
+     * The arrays below hold the data for each of the nq requested
+     * quantities. The activity coefficients, if requested, come first.
+     */
+    const double* beta0MX[4];
+    const double* beta1MX[4];
+    const double* beta2MX[4];
+    const double* CphiMX[4];
+    const double* thetaij[4];
+    const double* psi_ijk[4];
+    const Array2D* lambda_nj[4];
+    const double* mu_nnn[4];
+    double* BMX[4];
+    double* BprimeMX[4];
+    double* BphiMX[4];
+    double* Phi[4];
+    double* Phiphi[4];
+    double* CMX[4];
+    double* lnActCoeff[4];
+    double Aphi[4];
+    int nq = 0;
+    if (quantities & PITZER_VALUE) {
+        beta0MX[nq] = DATA_PTR(m_Beta0MX_ij);
+        beta1MX[nq] = DATA_PTR(m_Beta1MX_ij);
+        beta2MX[nq] = DATA_PTR(m_Beta2MX_ij);
+        CphiMX[nq] = DATA_PTR(m_CphiMX_ij);
+        thetaij[nq] = DATA_PTR(m_Theta_ij);
+        psi_ijk[nq] = DATA_PTR(m_Psi_ijk);
+        lambda_nj[nq] = &m_Lambda_nj;
+        mu_nnn[nq] = DATA_PTR(m_Mu_nnn);
+        BMX[nq] = DATA_PTR(m_BMX_IJ);
+        BprimeMX[nq] = DATA_PTR(m_BprimeMX_IJ);
+        BphiMX[nq] = DATA_PTR(m_BphiMX_IJ);
+        Phi[nq] = DATA_PTR(m_Phi_IJ);
+        Phiphi[nq] = DATA_PTR(m_PhiPhi_IJ);
+        CMX[nq] = DATA_PTR(m_CMX_IJ);
+        lnActCoeff[nq] = DATA_PTR(m_lnActCoeffMolal_Unscaled);
+        Aphi[nq++] = A_Debye_TP() / 3.0;
+    }
+    if (quantities & PITZER_DT) {
+        beta0MX[nq] = DATA_PTR(m_Beta0MX_ij_L);
+        beta1MX[nq] = DATA_PTR(m_Beta1MX_ij_L);
+        beta2MX[nq] = DATA_PTR(m_Beta2MX_ij_L);
+        CphiMX[nq] = DATA_PTR(m_CphiMX_ij_L);
+        thetaij[nq] = DATA_PTR(m_Theta_ij_L);
+        psi_ijk[nq] = DATA_PTR(m_Psi_ijk_L);
+        lambda_nj[nq] = &m_Lambda_nj_L;
+        mu_nnn[nq] = DATA_PTR(m_Mu_nnn_L);
+        BMX[nq] = DATA_PTR(m_BMX_IJ_L);
+        BprimeMX[nq] = DATA_PTR(m_BprimeMX_IJ_L);
+        BphiMX[nq] = DATA_PTR(m_BphiMX_IJ_L);
+        Phi[nq] = DATA_PTR(m_Phi_IJ_L);
+        Phiphi[nq] = DATA_PTR(m_PhiPhi_IJ_L);
+        CMX[nq] = DATA_PTR(m_CMX_IJ_L);
+        lnActCoeff[nq] = DATA_PTR(m_dlnActCoeffMolaldT_Unscaled);
+        Aphi[nq++] = dA_DebyedT_TP() / 3.0;
+    }
+    if (quantities & PITZER_DT2) {
+        beta0MX[nq] = DATA_PTR(m_Beta0MX_ij_LL);
+        beta1MX[nq] = DATA_PTR(m_Beta1MX_ij_LL);
+        beta2MX[nq] = DATA_PTR(m_Beta2MX_ij_LL);
+        CphiMX[nq] = DATA_PTR(m_CphiMX_ij_LL);
+        thetaij[nq] = DATA_PTR(m_Theta_ij_LL);
+        psi_ijk[nq] = DATA_PTR(m_Psi_ijk_LL);
+        lambda_nj[nq] = &m_Lambda_nj_LL;
+        mu_nnn[nq] = DATA_PTR(m_Mu_nnn_LL);
+        BMX[nq] = DATA_PTR(m_BMX_IJ_LL);
+        BprimeMX[nq] = DATA_PTR(m_BprimeMX_IJ_LL);
+        BphiMX[nq] = DATA_PTR(m_BphiMX_IJ_LL);
+        Phi[nq] = DATA_PTR(m_Phi_IJ_LL);
+        Phiphi[nq] = DATA_PTR(m_PhiPhi_IJ_LL);
+        CMX[nq] = DATA_PTR(m_CMX_IJ_LL);
+        lnActCoeff[nq] = DATA_PTR(m_d2lnActCoeffMolaldT2_Unscaled);
+        Aphi[nq++] = d2A_DebyedT2_TP() / 3.0;
+    }
+    if (quantities & PITZER_DP) {
+        beta0MX[nq] = DATA_PTR(m_Beta0MX_ij_P);
+        beta1MX[nq] = DATA_PTR(m_Beta1MX_ij_P);
+        beta2MX[nq] = DATA_PTR(m_Beta2MX_ij_P);
+        CphiMX[nq] = DATA_PTR(m_CphiMX_ij_P);
+        thetaij[nq] = DATA_PTR(m_Theta_ij_P);
+        psi_ijk[nq] = DATA_PTR(m_Psi_ijk_P);
+        lambda_nj[nq] = &m_Lambda_nj_P;
+        mu_nnn[nq] = DATA_PTR(m_Mu_nnn_P);
+        BMX[nq] = DATA_PTR(m_BMX_IJ_P);
+        BprimeMX[nq] = DATA_PTR(m_BprimeMX_IJ_P);
+        BphiMX[nq] = DATA_PTR(m_BphiMX_IJ_P);
+        Phi[nq] = DATA_PTR(m_Phi_IJ_P);
+        Phiphi[nq] = DATA_PTR(m_PhiPhi_IJ_P);
+        CMX[nq] = DATA_PTR(m_CMX_IJ_P);
+        lnActCoeff[nq] = DATA_PTR(m_dlnActCoeffMolaldP_Unscaled);
+        Aphi[nq++] = dA_DebyedP_TP() / 3.0;
+    }
+    const bool doValue = (quantities & PITZER_VALUE) != 0;
+
     const double* alpha1MX =  DATA_PTR(m_Alpha1MX_ij);
     const double* alpha2MX =  DATA_PTR(m_Alpha2MX_ij);
 
-    const double* psi_ijk =  DATA_PTR(m_Psi_ijk);
-    //n = k + j * m_kk + i * m_kk * m_kk;
-
-
-    double* gamma_Unscaled = DATA_PTR(m_gamma_tmp);
     /*
      * Local variables defined by Coltrin
      */
@@ -1723,21 +1856,20 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
      * molalitysum is the sum of the molalities over all solutes,
      * even those with zero charge.
      */
+    double molalitysum = 0.0;
     double molalitysumUncropped = 0.0;
 
     double* gfunc    =  DATA_PTR(m_gfunc_IJ);
     double* g2func   =  DATA_PTR(m_g2func_IJ);
     double* hfunc    =  DATA_PTR(m_hfunc_IJ);
     double* h2func   =  DATA_PTR(m_h2func_IJ);
-    double* BMX      =  DATA_PTR(m_BMX_IJ);
-    double* BprimeMX =  DATA_PTR(m_BprimeMX_IJ);
-    double* BphiMX   =  DATA_PTR(m_BphiMX_IJ);
-    double* Phi      =  DATA_PTR(m_Phi_IJ);
     double* Phiprime =  DATA_PTR(m_Phiprime_IJ);
-    double* Phiphi   =  DATA_PTR(m_PhiPhi_IJ);
-    double* CMX      =  DATA_PTR(m_CMX_IJ);
 
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    /*
+     * Debug printing only covers the activity coefficients themselves
+     */
+    const bool debug = DEBUG_MODE_ENABLED && m_debugCalc && doValue;
+    if (debug) {
         printf("\n Debugging information from hmw_act \n");
     }
     /*
@@ -1753,6 +1885,7 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
         Is += charge(n) * charge(n) * molality[n];
         //      total molar charge
         molarcharge +=  fabs(charge(n)) * molality[n];
+        molalitysum += molality[n];
         molalitysumUncropped += m_molalities[n];
     }
     Is *= 0.5;
@@ -1762,38 +1895,40 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
      */
     m_IionicMolality = Is;
     sqrtIs = sqrt(Is);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    if (debug) {
         printf(" Step 1: \n");
         printf(" ionic strenth      = %14.7le \n total molar "
                "charge = %14.7le \n", Is, molarcharge);
     }
 
-    /*
-     * The following call to calc_lambdas() calculates all 16 elements
-     * of the elambda and elambda1 arrays, given the value of the
-     * ionic strength (Is)
-     */
-    calc_lambdas(Is);
+    if (doValue) {
+        /*
+         * The following call to calc_lambdas() calculates all 16 elements
+         * of the elambda and elambda1 arrays, given the value of the
+         * ionic strength (Is)
+         */
+        calc_lambdas(Is);
 
-    /*
-     * ----- Step 2:  Find the coefficients E-theta and -------------------
-     *                E-thetaprime for all combinations of positive
-     *                unlike charges up to 4
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 2: \n");
-    }
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
-                       z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
+        /*
+         * ----- Step 2:  Find the coefficients E-theta and -------------------
+         *                E-thetaprime for all combinations of positive
+         *                unlike charges up to 4
+         */
+        if (debug) {
+            printf(" Step 2: \n");
+        }
+        for (int z1 = 1; z1 <=4; z1++) {
+            for (int z2 =1; z2 <=4; z2++) {
+                calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
+                if (debug) {
+                    printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
+                           z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
+                }
             }
         }
     }
 
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    if (debug) {
         printf(" Step 3: \n");
         printf(" Species          Species            g(x) "
                " hfunc(x)   \n");
@@ -1829,7 +1964,11 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                     hfunc[counterIJ] = 0.0;
                 }
 
-                if (beta2MX[counterIJ] != 0.0) {
+                bool hasBeta2 = false;
+                for (int q = 0; q < nq; q++) {
+                    hasBeta2 = hasBeta2 || (beta2MX[q][counterIJ] != 0.0);
+                }
+                if (hasBeta2) {
                     double x2 = sqrtIs * alpha2MX[counterIJ];
                     if (x2 > 1.0E-100) {
                         g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
@@ -1844,7 +1983,7 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                 gfunc[counterIJ] = 0.0;
                 hfunc[counterIJ] = 0.0;
             }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            if (debug) {
                 std::string sni = speciesName(i);
                 std::string snj = speciesName(j);
                 printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
@@ -1857,7 +1996,7 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
      * --------- SUBSECTION TO CALCULATE BMX, BprimeMX, BphiMX ----------
      * --------- Agrees with Pitzer, Eq. (49), (51), (55)
      */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    if (debug) {
         printf(" Step 4: \n");
         printf(" Species          Species            BMX    "
                "BprimeMX    BphiMX   \n");
@@ -1875,34 +2014,30 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
              * both species have a non-zero charge, and one is positive
              * and the other is negative
              */
-            if (charge(i)*charge(j) < 0.0) {
-                BMX[counterIJ]  = beta0MX[counterIJ]
-                                  + beta1MX[counterIJ] * gfunc[counterIJ]
-                                  + beta2MX[counterIJ] * g2func[counterIJ];
-
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    printf("%d %g: %g %g %g %g\n",
-                           (int) counterIJ,  BMX[counterIJ], beta0MX[counterIJ],
-                           beta1MX[counterIJ], beta2MX[counterIJ], gfunc[counterIJ]);
-                }
-                if (Is > 1.0E-150) {
-                    BprimeMX[counterIJ] = (beta1MX[counterIJ] * hfunc[counterIJ]/Is +
-                                           beta2MX[counterIJ] * h2func[counterIJ]/Is);
+            for (int q = 0; q < nq; q++) {
+                if (charge(i)*charge(j) < 0.0) {
+                    BMX[q][counterIJ]  = beta0MX[q][counterIJ]
+                                         + beta1MX[q][counterIJ] * gfunc[counterIJ]
+                                         + beta2MX[q][counterIJ] * g2func[counterIJ];
+                    if (Is > 1.0E-150) {
+                        BprimeMX[q][counterIJ] = (beta1MX[q][counterIJ] * hfunc[counterIJ]/Is +
+                                                  beta2MX[q][counterIJ] * h2func[counterIJ]/Is);
+                    } else {
+                        BprimeMX[q][counterIJ] = 0.0;
+                    }
+                    BphiMX[q][counterIJ] = BMX[q][counterIJ] + Is*BprimeMX[q][counterIJ];
                 } else {
-                    BprimeMX[counterIJ] = 0.0;
+                    BMX[q][counterIJ]      = 0.0;
+                    BprimeMX[q][counterIJ] = 0.0;
+                    BphiMX[q][counterIJ]   = 0.0;
                 }
-                BphiMX[counterIJ]   = BMX[counterIJ] + Is*BprimeMX[counterIJ];
-            } else {
-                BMX[counterIJ]      = 0.0;
-                BprimeMX[counterIJ] = 0.0;
-                BphiMX[counterIJ]   = 0.0;
             }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            if (debug) {
                 std::string sni = speciesName(i);
                 std::string snj = speciesName(j);
                 printf(" %-16s %-16s %11.7f %11.7f %11.7f \n",
                        sni.c_str(), snj.c_str(),
-                       BMX[counterIJ], BprimeMX[counterIJ], BphiMX[counterIJ]);
+                       BMX[0][counterIJ], BprimeMX[0][counterIJ], BphiMX[0][counterIJ]);
             }
         }
     }
@@ -1911,7 +2046,7 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
      * --------- SUBSECTION TO CALCULATE CMX ----------
      * --------- Agrees with Pitzer, Eq. (53).
      */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    if (debug) {
         printf(" Step 5: \n");
         printf(" Species          Species            CMX \n");
     }
@@ -1926,17 +2061,19 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
              * both species have a non-zero charge, and one is positive
              * and the other is negative
              */
-            if (charge(i)*charge(j) < 0.0) {
-                CMX[counterIJ] = CphiMX[counterIJ]/
-                                 (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                CMX[counterIJ] = 0.0;
+            for (int q = 0; q < nq; q++) {
+                if (charge(i)*charge(j) < 0.0) {
+                    CMX[q][counterIJ] = CphiMX[q][counterIJ]/
+                                        (2.0* sqrt(fabs(charge(i)*charge(j))));
+                } else {
+                    CMX[q][counterIJ] = 0.0;
+                }
             }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            if (debug) {
                 std::string sni = speciesName(i);
                 std::string snj = speciesName(j);
                 printf(" %-16s %-16s %11.7f \n", sni.c_str(), snj.c_str(),
-                       CMX[counterIJ]);
+                       CMX[0][counterIJ]);
             }
         }
     }
@@ -1945,7 +2082,7 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
      * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
      * --------- Agrees with Pitzer, Eq. 72, 73, 74
      */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    if (debug) {
         printf(" Step 6: \n");
         printf(" Species          Species            Phi_ij "
                " Phiprime_ij  Phi^phi_ij \n");
@@ -1962,22 +2099,32 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
              * and the other is negative
              */
             if (charge(i)*charge(j) > 0) {
-                int z1 = (int) fabs(charge(i));
-                int z2 = (int) fabs(charge(j));
-                Phi[counterIJ] = thetaij[counterIJ] + etheta[z1][z2];
-                Phiprime[counterIJ] = etheta_prime[z1][z2];
-                Phiphi[counterIJ] = Phi[counterIJ] + Is * Phiprime[counterIJ];
+                for (int q = 0; q < nq; q++) {
+                    Phi[q][counterIJ] = thetaij[q][counterIJ];
+                    Phiphi[q][counterIJ] = Phi[q][counterIJ];
+                }
+                if (doValue) {
+                    int z1 = (int) fabs(charge(i));
+                    int z2 = (int) fabs(charge(j));
+                    Phi[0][counterIJ] += etheta[z1][z2];
+                    Phiprime[counterIJ] = etheta_prime[z1][z2];
+                    Phiphi[0][counterIJ] = Phi[0][counterIJ] + Is * Phiprime[counterIJ];
+                }
             } else {
-                Phi[counterIJ]      = 0.0;
-                Phiprime[counterIJ] = 0.0;
-                Phiphi[counterIJ]   = 0.0;
+                for (int q = 0; q < nq; q++) {
+                    Phi[q][counterIJ]    = 0.0;
+                    Phiphi[q][counterIJ] = 0.0;
+                }
+                if (doValue) {
+                    Phiprime[counterIJ] = 0.0;
+                }
             }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            if (debug) {
                 std::string sni = speciesName(i);
                 std::string snj = speciesName(j);
                 printf(" %-16s %-16s %10.6f %10.6f %10.6f \n",
                        sni.c_str(), snj.c_str(),
-                       Phi[counterIJ], Phiprime[counterIJ], Phiphi[counterIJ]);
+                       Phi[0][counterIJ], Phiprime[counterIJ], Phiphi[0][counterIJ]);
             }
         }
     }
@@ -1986,14 +2133,16 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
      * ------------- SUBSECTION FOR CALCULATION OF F ----------------------
      * ------------ Agrees with Pitzer Eqn. (65) --------------------------
      */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    if (debug) {
         printf(" Step 7: \n");
     }
-    double Aphi = A_Debye_TP() / 3.0;
-    double F = -Aphi * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                 + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" initial value of F = %10.6f \n", F);
+    double F[4];
+    for (int q = 0; q < nq; q++) {
+        F[q] = -Aphi[q] * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
+                           + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
+    }
+    if (debug) {
+        printf(" initial value of F = %10.6f \n", F[0]);
     }
     for (size_t i = 1; i < m_kk-1; i++) {
         for (size_t j = i+1; j < m_kk; j++) {
@@ -2007,21 +2156,23 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
              * and the other is negative
              */
             if (charge(i)*charge(j) < 0) {
-                F = F + molality[i]*molality[j] * BprimeMX[counterIJ];
+                for (int q = 0; q < nq; q++) {
+                    F[q] = F[q] + molality[i]*molality[j] * BprimeMX[q][counterIJ];
+                }
             }
             /*
              * Both species have a non-zero charge, and they
              * have the same sign
              */
-            if (charge(i)*charge(j) > 0) {
-                F = F + molality[i]*molality[j] * Phiprime[counterIJ];
+            if (doValue && charge(i)*charge(j) > 0) {
+                F[0] = F[0] + molality[i]*molality[j] * Phiprime[counterIJ];
             }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" F = %10.6f \n", F);
+            if (debug) {
+                printf(" F = %10.6f \n", F[0]);
             }
         }
     }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    if (debug) {
         printf(" Step 8: Summing in All Contributions to Activity Coefficients \n");
     }
 
@@ -2033,20 +2184,17 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
          *          -> Equations agree with Pitzer, eqn.(63)
          */
         if (charge(i) > 0.0) {
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            if (debug) {
                 std::string sni = speciesName(i);
                 printf("  Contributions to ln(ActCoeff_%s):\n", sni.c_str());
+                printf("      Unary term:                                      z*z*F = %10.5f\n",
+                       charge(i)*charge(i)*F[0]);
             }
             // species i is the cation (positive) to calc the actcoeff
-            double zsqF = charge(i)*charge(i)*F;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf("      Unary term:                                      z*z*F = %10.5f\n", zsqF);
+            double sum1[4], sum2[4], sum3[4], sum4[4], sum5[4];
+            for (int q = 0; q < nq; q++) {
+                sum1[q] = sum2[q] = sum3[q] = sum4[q] = sum5[q] = 0.0;
             }
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
             for (size_t j = 1; j < m_kk; j++) {
                 /*
                  * Find the counterIJ for the symmetric binary interaction
@@ -2056,14 +2204,16 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
 
                 if (charge(j) < 0.0) {
                     // sum over all anions
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX[counterIJ] + molarcharge*CMX[counterIJ]);
-                    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+                    for (int q = 0; q < nq; q++) {
+                        sum1[q] = sum1[q] + molality[j]*
+                                  (2.0*BMX[q][counterIJ] + molarcharge*CMX[q][counterIJ]);
+                    }
+                    if (debug) {
                         std::string snj = speciesName(j) + ":";
                         printf("      Bin term with %-13s                  2 m_j BMX = %10.5f\n", snj.c_str(),
-                               molality[j]*2.0*BMX[counterIJ]);
+                               molality[j]*2.0*BMX[0][counterIJ]);
                         printf("                                                   m_j Z CMX = %10.5f\n",
-                               molality[j]* molarcharge*CMX[counterIJ]);
+                               molality[j]* molarcharge*CMX[0][counterIJ]);
                     }
                     if (j < m_kk-1) {
                         /*
@@ -2075,57 +2225,54 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                             // an inner sum over all anions
                             if (charge(k) < 0.0) {
                                 n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk[n];
-                                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                    if (psi_ijk[n] != 0.0) {
-                                        std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                        printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                               molality[j]*molality[k]*psi_ijk[n]);
-                                    }
+                                for (int q = 0; q < nq; q++) {
+                                    sum3[q] = sum3[q] + molality[j]*molality[k]*psi_ijk[q][n];
+                                }
+                                if (debug && psi_ijk[0][n] != 0.0) {
+                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
+                                    printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
+                                           molality[j]*molality[k]*psi_ijk[0][n]);
                                 }
                             }
                         }
                     }
                 }
 
-
                 if (charge(j) > 0.0) {
                     // sum over all cations
                     if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi[counterIJ]);
-                        if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                            if ((molality[j] * Phi[counterIJ])!= 0.0) {
-                                std::string snj = speciesName(j) + ":";
-                                printf("      Phi term with %-12s                2 m_j Phi_cc = %10.5f\n", snj.c_str(),
-                                       molality[j]*(2.0*Phi[counterIJ]));
-                            }
+                        for (int q = 0; q < nq; q++) {
+                            sum2[q] = sum2[q] + molality[j]*(2.0*Phi[q][counterIJ]);
+                        }
+                        if (debug && (molality[j] * Phi[0][counterIJ])!= 0.0) {
+                            std::string snj = speciesName(j) + ":";
+                            printf("      Phi term with %-12s                2 m_j Phi_cc = %10.5f\n", snj.c_str(),
+                                   molality[j]*(2.0*Phi[0][counterIJ]));
                         }
                     }
                     for (size_t k = 1; k < m_kk; k++) {
                         if (charge(k) < 0.0) {
                             // two inner sums over anions
-
                             n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk[n];
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if (psi_ijk[n] != 0.0) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
-                                }
-                            }
                             /*
                              * Find the counterIJ for the j,k interaction
                              */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 + (fabs(charge(i))*
-                                           molality[j]*molality[k]*CMX[counterIJ2]);
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if ((molality[j]*molality[k]*CMX[counterIJ2]) != 0.0) {
+                            size_t counterIJ2 = m_CounterIJ[m_kk*j + k];
+                            for (int q = 0; q < nq; q++) {
+                                sum2[q] = sum2[q] + molality[j]*molality[k]*psi_ijk[q][n];
+                                sum4[q] = sum4[q] + (fabs(charge(i))*
+                                                     molality[j]*molality[k]*CMX[q][counterIJ2]);
+                            }
+                            if (debug) {
+                                if (psi_ijk[0][n] != 0.0) {
+                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
+                                    printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
+                                           molality[j]*molality[k]*psi_ijk[0][n]);
+                                }
+                                if ((molality[j]*molality[k]*CMX[0][counterIJ2]) != 0.0) {
                                     std::string snj = speciesName(j) + "," + speciesName(k) + ":";
                                     printf("      Tern CMX term on %-16s abs(z_i) m_j m_k CMX = %10.5f\n", snj.c_str(),
-                                           fabs(charge(i))* molality[j]*molality[k]*CMX[counterIJ2]);
+                                           fabs(charge(i))* molality[j]*molality[k]*CMX[0][counterIJ2]);
                                 }
                             }
                         }
@@ -2136,13 +2283,13 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                  * Handle neutral j species
                  */
                 if (charge(j) == 0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj(j,i);
-                    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                        if ((molality[j]*2.0*m_Lambda_nj(j,i)) != 0.0) {
-                            std::string snj = speciesName(j) + ":";
-                            printf("      Lambda term with %-12s                 2 m_j lam_ji = %10.5f\n", snj.c_str(),
-                                   molality[j]*2.0*m_Lambda_nj(j,i));
-                        }
+                    for (int q = 0; q < nq; q++) {
+                        sum5[q] = sum5[q] + molality[j]*2.0*(*lambda_nj[q])(j,i);
+                    }
+                    if (debug && (molality[j]*2.0*m_Lambda_nj(j,i)) != 0.0) {
+                        std::string snj = speciesName(j) + ":";
+                        printf("      Lambda term with %-12s                 2 m_j lam_ji = %10.5f\n", snj.c_str(),
+                               molality[j]*2.0*m_Lambda_nj(j,i));
                     }
                     /*
                      * Zeta interaction term
@@ -2152,15 +2299,17 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                             size_t izeta = j;
                             size_t jzeta = i;
                             n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta = psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta;
-                                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Zeta term on %-16s         m_n m_a zeta_nMa = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
+                            for (int q = 0; q < nq; q++) {
+                                double zeta = psi_ijk[q][n];
+                                if (zeta != 0.0) {
+                                    sum5[q] = sum5[q] + molality[j]*molality[k]*zeta;
                                 }
                             }
+                            if (debug && psi_ijk[0][n] != 0.0) {
+                                std::string snj = speciesName(j) + "," + speciesName(k) + ":";
+                                printf("      Zeta term on %-16s         m_n m_a zeta_nMa = %10.5f\n", snj.c_str(),
+                                       molality[j]*molality[k]*psi_ijk[0][n]);
+                            }
                         }
                     }
                 }
@@ -2169,12 +2318,14 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
              * Add all of the contributions up to yield the log of the
              * solute activity coefficients (molality scale)
              */
-            m_lnActCoeffMolal_Unscaled[i] = zsqF + sum1 + sum2 + sum3 + sum4 + sum5;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            for (int q = 0; q < nq; q++) {
+                double zsqF = charge(i)*charge(i)*F[q];
+                lnActCoeff[q][i] = zsqF + sum1[q] + sum2[q] + sum3[q] + sum4[q] + sum5[q];
+            }
+            if (debug) {
                 std::string sni = speciesName(i);
                 printf("      Net %-16s                        lngamma[i] =  %9.5f         gamma[i]=%10.6f \n",
-                       sni.c_str(), m_lnActCoeffMolal_Unscaled[i], gamma_Unscaled[i]);
+                       sni.c_str(), lnActCoeff[0][i], exp(lnActCoeff[0][i]));
             }
         }
 
@@ -2184,20 +2335,17 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
          *          -> Equations agree with Pitzer, eqn.(64)
          */
         if (charge(i) < 0) {
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            if (debug) {
                 std::string sni = speciesName(i);
                 printf("  Contributions to ln(ActCoeff_%s):\n", sni.c_str());
+                printf("      Unary term:                                      z*z*F = %10.5f\n",
+                       charge(i)*charge(i)*F[0]);
             }
             //          species i is an anion (negative)
-            double zsqF = charge(i)*charge(i)*F;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf("      Unary term:                                      z*z*F = %10.5f\n", zsqF);
+            double sum1[4], sum2[4], sum3[4], sum4[4], sum5[4];
+            for (int q = 0; q < nq; q++) {
+                sum1[q] = sum2[q] = sum3[q] = sum4[q] = sum5[q] = 0.0;
             }
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
             for (size_t j = 1; j < m_kk; j++) {
                 /*
                  * Find the counterIJ for the symmetric binary interaction
@@ -2209,27 +2357,29 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                  * For Anions, do the cation interactions.
                  */
                 if (charge(j) > 0) {
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX[counterIJ]+molarcharge*CMX[counterIJ]);
-                    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+                    for (int q = 0; q < nq; q++) {
+                        sum1[q] = sum1[q] + molality[j]*
+                                  (2.0*BMX[q][counterIJ]+molarcharge*CMX[q][counterIJ]);
+                    }
+                    if (debug) {
                         std::string snj = speciesName(j) + ":";
                         printf("      Bin term with %-13s                  2 m_j BMX = %10.5f\n", snj.c_str(),
-                               molality[j]*2.0*BMX[counterIJ]);
+                               molality[j]*2.0*BMX[0][counterIJ]);
                         printf("                                                   m_j Z CMX = %10.5f\n",
-                               molality[j]* molarcharge*CMX[counterIJ]);
+                               molality[j]* molarcharge*CMX[0][counterIJ]);
                     }
                     if (j < m_kk-1) {
                         for (size_t k = j+1; k < m_kk; k++) {
                             // an inner sum over all cations
                             if (charge(k) > 0) {
                                 n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk[n];
-                                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                    if (psi_ijk[n] != 0.0) {
-                                        std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                        printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                               molality[j]*molality[k]*psi_ijk[n]);
-                                    }
+                                for (int q = 0; q < nq; q++) {
+                                    sum3[q] = sum3[q] + molality[j]*molality[k]*psi_ijk[q][n];
+                                }
+                                if (debug && psi_ijk[0][n] != 0.0) {
+                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
+                                    printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
+                                           molality[j]*molality[k]*psi_ijk[0][n]);
                                 }
                             }
                         }
@@ -2242,40 +2392,39 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                 if (charge(j) < 0.0) {
                     //  sum over all anions
                     if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi[counterIJ]);
-                        if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                            if ((molality[j] * Phi[counterIJ])!= 0.0) {
-                                std::string snj = speciesName(j) + ":";
-                                printf("      Phi term with %-12s                2 m_j Phi_aa = %10.5f\n", snj.c_str(),
-                                       molality[j]*(2.0*Phi[counterIJ]));
-                            }
+                        for (int q = 0; q < nq; q++) {
+                            sum2[q] = sum2[q] + molality[j]*(2.0*Phi[q][counterIJ]);
+                        }
+                        if (debug && (molality[j] * Phi[0][counterIJ])!= 0.0) {
+                            std::string snj = speciesName(j) + ":";
+                            printf("      Phi term with %-12s                2 m_j Phi_aa = %10.5f\n", snj.c_str(),
+                                   molality[j]*(2.0*Phi[0][counterIJ]));
                         }
                     }
                     for (size_t k = 1; k < m_kk; k++) {
                         if (charge(k) > 0.0) {
                             // two inner sums over cations
                             n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk[n];
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if (psi_ijk[n] != 0.0) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
-                                }
-                            }
                             /*
                              * Find the counterIJ for the symmetric binary interaction
                              */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 +
-                                   (fabs(charge(i))*
-                                    molality[j]*molality[k]*CMX[counterIJ2]);
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if ((molality[j]*molality[k]*CMX[counterIJ2]) != 0.0) {
+                            size_t counterIJ2 = m_CounterIJ[m_kk*j + k];
+                            for (int q = 0; q < nq; q++) {
+                                sum2[q] = sum2[q] + molality[j]*molality[k]*psi_ijk[q][n];
+                                sum4[q] = sum4[q] +
+                                          (fabs(charge(i))*
+                                           molality[j]*molality[k]*CMX[q][counterIJ2]);
+                            }
+                            if (debug) {
+                                if (psi_ijk[0][n] != 0.0) {
+                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
+                                    printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
+                                           molality[j]*molality[k]*psi_ijk[0][n]);
+                                }
+                                if ((molality[j]*molality[k]*CMX[0][counterIJ2]) != 0.0) {
                                     std::string snj = speciesName(j) + "," + speciesName(k) + ":";
                                     printf("      Tern CMX term on %-16s abs(z_i) m_j m_k CMX = %10.5f\n", snj.c_str(),
-                                           fabs(charge(i))* molality[j]*molality[k]*CMX[counterIJ2]);
+                                           fabs(charge(i))* molality[j]*molality[k]*CMX[0][counterIJ2]);
                                 }
                             }
                         }
@@ -2286,13 +2435,13 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                  * for Anions, do the neutral species interaction
                  */
                 if (charge(j) == 0.0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj(j,i);
-                    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                        if ((molality[j]*2.0*m_Lambda_nj(j,i)) != 0.0) {
-                            std::string snj = speciesName(j) + ":";
-                            printf("      Lambda term with %-12s                 2 m_j lam_ji = %10.5f\n", snj.c_str(),
-                                   molality[j]*2.0*m_Lambda_nj(j,i));
-                        }
+                    for (int q = 0; q < nq; q++) {
+                        sum5[q] = sum5[q] + molality[j]*2.0*(*lambda_nj[q])(j,i);
+                    }
+                    if (debug && (molality[j]*2.0*m_Lambda_nj(j,i)) != 0.0) {
+                        std::string snj = speciesName(j) + ":";
+                        printf("      Lambda term with %-12s                 2 m_j lam_ji = %10.5f\n", snj.c_str(),
+                               molality[j]*2.0*m_Lambda_nj(j,i));
                     }
                     /*
                      * Zeta interaction term
@@ -2303,25 +2452,29 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                             size_t jzeta = k;
                             size_t kzeta = i;
                             n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta = psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta;
-                                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Zeta term on %-16s         m_n m_c zeta_ncX = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
+                            for (int q = 0; q < nq; q++) {
+                                double zeta = psi_ijk[q][n];
+                                if (zeta != 0.0) {
+                                    sum5[q] = sum5[q] + molality[j]*molality[k]*zeta;
                                 }
                             }
+                            if (debug && psi_ijk[0][n] != 0.0) {
+                                std::string snj = speciesName(j) + "," + speciesName(k) + ":";
+                                printf("      Zeta term on %-16s         m_n m_c zeta_ncX = %10.5f\n", snj.c_str(),
+                                       molality[j]*molality[k]*psi_ijk[0][n]);
+                            }
                         }
                     }
                 }
             }
-            m_lnActCoeffMolal_Unscaled[i] = zsqF + sum1 + sum2 + sum3 + sum4 + sum5;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            for (int q = 0; q < nq; q++) {
+                double zsqF = charge(i)*charge(i)*F[q];
+                lnActCoeff[q][i] = zsqF + sum1[q] + sum2[q] + sum3[q] + sum4[q] + sum5[q];
+            }
+            if (debug) {
                 std::string sni = speciesName(i);
                 printf("      Net %-16s                        lngamma[i] =  %9.5f             gamma[i]=%10.6f\n",
-                       sni.c_str(), m_lnActCoeffMolal_Unscaled[i], gamma_Unscaled[i]);
+                       sni.c_str(), lnActCoeff[0][i], exp(lnActCoeff[0][i]));
             }
         }
         /*
@@ -2330,20 +2483,22 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
          *        -> Equations agree with Pitzer,
          */
         if (charge(i) == 0.0) {
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            if (debug) {
                 std::string sni = speciesName(i);
                 printf("  Contributions to ln(ActCoeff_%s):\n", sni.c_str());
             }
-            double sum1 = 0.0;
-            double sum3 = 0.0;
+            double sum1[4], sum3[4];
+            for (int q = 0; q < nq; q++) {
+                sum1[q] = sum3[q] = 0.0;
+            }
             for (size_t j = 1; j < m_kk; j++) {
-                sum1 = sum1 + molality[j]*2.0*m_Lambda_nj(i,j);
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    if (m_Lambda_nj(i,j) != 0.0) {
-                        std::string snj = speciesName(j) + ":";
-                        printf("      Lambda_n term on %-16s     2 m_j lambda_n_j = %10.5f\n", snj.c_str(),
-                               molality[j]*2.0*m_Lambda_nj(i,j));
-                    }
+                for (int q = 0; q < nq; q++) {
+                    sum1[q] = sum1[q] + molality[j]*2.0*(*lambda_nj[q])(i,j);
+                }
+                if (debug && m_Lambda_nj(i,j) != 0.0) {
+                    std::string snj = speciesName(j) + ":";
+                    printf("      Lambda_n term on %-16s     2 m_j lambda_n_j = %10.5f\n", snj.c_str(),
+                           molality[j]*2.0*m_Lambda_nj(i,j));
                 }
                 /*
                  * Zeta term -> we piggyback on the psi term
@@ -2352,36 +2507,35 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                     for (size_t k = 1; k < m_kk; k++) {
                         if (charge(k) < 0.0) {
                             size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 = sum3 + molality[j]*molality[k]*psi_ijk[n];
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if (psi_ijk[n] != 0.0) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Zeta term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
-                                }
+                            for (int q = 0; q < nq; q++) {
+                                sum3[q] = sum3[q] + molality[j]*molality[k]*psi_ijk[q][n];
+                            }
+                            if (debug && psi_ijk[0][n] != 0.0) {
+                                std::string snj = speciesName(j) + "," + speciesName(k) + ":";
+                                printf("      Zeta term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
+                                       molality[j]*molality[k]*psi_ijk[0][n]);
                             }
                         }
                     }
                 }
             }
-            double sum2 = 3.0 * molality[i]* molality[i] * m_Mu_nnn[i];
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            for (int q = 0; q < nq; q++) {
+                double sum2 = 3.0 * molality[i]* molality[i] * mu_nnn[q][i];
+                lnActCoeff[q][i] = sum1[q] + sum2 + sum3[q];
+            }
+            if (debug) {
                 if (m_Mu_nnn[i] != 0.0) {
                     printf("      Mu_nnn term              3 m_n m_n Mu_n_n = %10.5f\n",
                            3.0 * molality[i]* molality[i] * m_Mu_nnn[i]);
                 }
-            }
-            m_lnActCoeffMolal_Unscaled[i] = sum1 + sum2 + sum3;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
                 std::string sni = speciesName(i);
                 printf("      Net %-16s                        lngamma[i] =  %9.5f             gamma[i]=%10.6f\n",
-                       sni.c_str(), m_lnActCoeffMolal_Unscaled[i], gamma_Unscaled[i]);
+                       sni.c_str(), lnActCoeff[0][i], exp(lnActCoeff[0][i]));
             }
         }
 
     }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
+    if (debug) {
         printf(" Step 9: \n");
     }
     /*
@@ -2389,13 +2543,7 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
      * -------- -> equations agree with my notes, Eqn. (117).
      *          -> Equations agree with Pitzer, eqn.(62)
      */
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
+    double sum1[4], sum2[4], sum3[4], sum4[4], sum5[4], sum6[4], sum7[4];
     /*
      * term1 is the DH term in the osmotic coefficient expression
      * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
@@ -2403,7 +2551,11 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
      * Is = Ionic strength on the molality scale (units of (gmol/kg))
      * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
      */
-    double term1 = -Aphi * pow(Is,1.5) / (1.0 + 1.2 * sqrt(Is));
+    double term1[4];
+    for (int q = 0; q < nq; q++) {
+        sum1[q] = sum2[q] = sum3[q] = sum4[q] = sum5[q] = sum6[q] = sum7[q] = 0.0;
+        term1[q] = -Aphi[q] * pow(Is,1.5) / (1.0 + 1.2 * sqrt(Is));
+    }
 
     for (size_t j = 1; j < m_kk; j++) {
         /*
@@ -2418,8 +2570,10 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                     size_t n = m_kk*j + k;
                     size_t counterIJ = m_CounterIJ[n];
 
-                    sum1 = sum1 + molality[j]*molality[k]*
-                           (BphiMX[counterIJ] + molarcharge*CMX[counterIJ]);
+                    for (int q = 0; q < nq; q++) {
+                        sum1[q] = sum1[q] + molality[j]*molality[k]*
+                                  (BphiMX[q][counterIJ] + molarcharge*CMX[q][counterIJ]);
+                    }
                 }
             }
 
@@ -2436,13 +2590,17 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                      */
                     size_t n = m_kk*j + k;
                     size_t counterIJ = m_CounterIJ[n];
-                    sum2 = sum2 + molality[j]*molality[k]*Phiphi[counterIJ];
+                    for (int q = 0; q < nq; q++) {
+                        sum2[q] = sum2[q] + molality[j]*molality[k]*Phiphi[q][counterIJ];
+                    }
                     for (size_t m = 1; m < m_kk; m++) {
                         if (charge(m) < 0.0) {
                             // species m is an anion
                             n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 = sum2 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk[n];
+                            for (int q = 0; q < nq; q++) {
+                                sum2[q] = sum2[q] +
+                                          molality[j]*molality[k]*molality[m]*psi_ijk[q][n];
+                            }
                         }
                     }
                 }
@@ -2467,12 +2625,16 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                     size_t n = m_kk*j + k;
                     size_t counterIJ = m_CounterIJ[n];
 
-                    sum3 = sum3 + molality[j]*molality[k]*Phiphi[counterIJ];
+                    for (int q = 0; q < nq; q++) {
+                        sum3[q] = sum3[q] + molality[j]*molality[k]*Phiphi[q][counterIJ];
+                    }
                     for (size_t m = 1; m < m_kk; m++) {
                         if (charge(m) > 0.0) {
                             n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 = sum3 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk[n];
+                            for (int q = 0; q < nq; q++) {
+                                sum3[q] = sum3[q] +
+                                          molality[j]*molality[k]*molality[m]*psi_ijk[q][n];
+                            }
                         }
                     }
                 }
@@ -2485,16 +2647,24 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
         if (charge(j) == 0) {
             for (size_t k = 1; k < m_kk; k++) {
                 if (charge(k) < 0.0) {
-                    sum4 = sum4 + molality[j]*molality[k]*m_Lambda_nj(j,k);
+                    for (int q = 0; q < nq; q++) {
+                        sum4[q] = sum4[q] + molality[j]*molality[k]*(*lambda_nj[q])(j,k);
+                    }
                 }
                 if (charge(k) > 0.0) {
-                    sum5 = sum5 + molality[j]*molality[k]*m_Lambda_nj(j,k);
+                    for (int q = 0; q < nq; q++) {
+                        sum5[q] = sum5[q] + molality[j]*molality[k]*(*lambda_nj[q])(j,k);
+                    }
                 }
                 if (charge(k) == 0.0) {
                     if (k > j) {
-                        sum6 = sum6 + molality[j]*molality[k]*m_Lambda_nj(j,k);
+                        for (int q = 0; q < nq; q++) {
+                            sum6[q] = sum6[q] + molality[j]*molality[k]*(*lambda_nj[q])(j,k);
+                        }
                     } else if (k == j) {
-                        sum6 = sum6 + 0.5 * molality[j]*molality[k]*m_Lambda_nj(j,k);
+                        for (int q = 0; q < nq; q++) {
+                            sum6[q] = sum6[q] + 0.5 * molality[j]*molality[k]*(*lambda_nj[q])(j,k);
+                        }
                     }
                 }
                 if (charge(k) < 0.0) {
@@ -2503,75 +2673,105 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                         if (charge(m) > 0.0) {
                             size_t jzeta = m;
                             size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta = psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta;
+                            for (int q = 0; q < nq; q++) {
+                                double zeta = psi_ijk[q][n];
+                                if (zeta != 0.0) {
+                                    sum7[q] += molality[izeta]*molality[jzeta]*molality[k]*zeta;
+                                }
                             }
                         }
                     }
                 }
             }
-            sum7 += molality[j]*molality[j]*molality[j]*m_Mu_nnn[j];
+            for (int q = 0; q < nq; q++) {
+                sum7[q] += molality[j]*molality[j]*molality[j]*mu_nnn[q][j];
+            }
         }
     }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-    /*
-     * Calculate the osmotic coefficient from
-     *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-     */
-    double osmotic_coef;
-    if (molalitysumUncropped > 1.0E-150) {
-        osmotic_coef = 1.0 + (sum_m_phi_minus_1 / molalitysumUncropped);
-    } else {
-        osmotic_coef = 1.0;
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
-               "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
-               term1, sum1, sum2, sum3, sum4, sum5);
-        printf("     sum_m_phi_minus_1=%10.6f        osmotic_coef=%10.6f\n",
-               sum_m_phi_minus_1, osmotic_coef);
-        printf(" Step 10: \n");
+
+    for (int q = 0; q < nq; q++) {
+        double sum_m_phi_minus_1 = 2.0 *
+            (term1[q] + sum1[q] + sum2[q] + sum3[q] + sum4[q] + sum5[q] + sum6[q] + sum7[q]);
+        if (q == 0 && doValue) {
+            /*
+             * Calculate the osmotic coefficient from
+             *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
+             */
+            double osmotic_coef;
+            if (molalitysumUncropped > 1.0E-150) {
+                osmotic_coef = 1.0 + (sum_m_phi_minus_1 / molalitysumUncropped);
+            } else {
+                osmotic_coef = 1.0;
+            }
+            if (debug) {
+                printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
+                       "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
+                       term1[0], sum1[0], sum2[0], sum3[0], sum4[0], sum5[0]);
+                printf("     sum_m_phi_minus_1=%10.6f        osmotic_coef=%10.6f\n",
+                       sum_m_phi_minus_1, osmotic_coef);
+                printf(" Step 10: \n");
+            }
+            double lnwateract = -(m_weightSolvent/1000.0) * molalitysumUncropped * osmotic_coef;
+
+            /*
+             * In Cantera, we define the activity coefficient of the solvent as
+             *
+             *     act_0 = actcoeff_0 * Xmol_0
+             *
+             * We have just computed act_0. However, this routine returns
+             *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
+             */
+            double xmolSolvent = moleFraction(m_indexSolvent);
+            double xx = std::max(m_xmolSolventMIN, xmolSolvent);
+            lnActCoeff[0][0] = lnwateract - log(xx);
+            if (debug) {
+                double wateract = exp(lnwateract);
+                printf(" Weight of Solvent = %16.7g\n", m_weightSolvent);
+                printf(" molalitySumUncropped = %16.7g\n", molalitysumUncropped);
+                printf(" ln_a_water=%10.6f a_water=%10.6f\n\n",
+                       lnwateract, wateract);
+            }
+        } else {
+            /*
+             * The derivatives of the solvent activity coefficient are
+             * evaluated at constant (cropped) molalities
+             */
+            double d_osmotic_coef;
+            if (molalitysum > 1.0E-150) {
+                d_osmotic_coef = sum_m_phi_minus_1 / molalitysum;
+            } else {
+                d_osmotic_coef = 0.0;
+            }
+            lnActCoeff[q][0] = -(m_weightSolvent/1000.0) * molalitysum * d_osmotic_coef;
+        }
     }
-    double lnwateract = -(m_weightSolvent/1000.0) * molalitysumUncropped * osmotic_coef;
+}
 
+void HMWSoln::s_updatePitzer_derivatives(int quantity) const
+{
     /*
-     * In Cantera, we define the activity coefficient of the solvent as
-     *
-     *     act_0 = actcoeff_0 * Xmol_0
-     *
-     * We have just computed act_0. However, this routine returns
-     *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
+     * Once requested, a derivative is evaluated along with the activity
+     * coefficients whenever the state changes.
      */
-    double xmolSolvent = moleFraction(m_indexSolvent);
-    double xx = std::max(m_xmolSolventMIN, xmolSolvent);
-    m_lnActCoeffMolal_Unscaled[0] = lnwateract - log(xx);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        double wateract = exp(lnwateract);
-        printf(" Weight of Solvent = %16.7g\n", m_weightSolvent);
-        printf(" molalitySumUncropped = %16.7g\n", molalitysumUncropped);
-        printf(" ln_a_water=%10.6f a_water=%10.6f\n\n",
-               lnwateract, wateract);
+    m_pitzerDerivs |= quantity;
+    s_update_lnMolalityActCoeff();
+    if (!(m_pitzerCurrent & quantity)) {
+        s_updatePitzer_lnMolalityActCoeff(quantity);
+        m_pitzerCurrent |= quantity;
     }
 }
 
 void HMWSoln::s_update_dlnMolalityActCoeff_dT() const
 {
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
+    CachedScalar cached = m_cache.getScalar(cacheId_dlnActCoeff_dT);
     if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
         return;
     }
 
     /*
-     *  Zero the unscaled 2nd derivatives
-     */
-    m_dlnActCoeffMolaldT_Unscaled.assign(m_kk, 0.0);
-    /*
-     *  Do the actual calculation of the unscaled temperature derivatives
+     *  Make sure that the unscaled temperature derivatives are current
      */
-    s_updatePitzer_dlnMolalityActCoeff_dT();
+    s_updatePitzer_derivatives(PITZER_DT);
 
     for (size_t k = 1; k < m_kk; k++) {
         if (CROP_speciesCropped_[k] == 2) {
@@ -2587,2288 +2787,56 @@ void HMWSoln::s_update_dlnMolalityActCoeff_dT() const
      *  Do the pH scaling to the derivatives
      */
     s_updateScaling_pHScaling_dT();
-
-
 }
 
-void HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT() const
+void HMWSoln::s_update_d2lnMolalityActCoeff_dT2() const
 {
-    /*
-     * It may be assumed that the Pitzer activity coefficient routine is
-     * called immediately preceding the calling of this routine. Therefore,
-     * some quantities do not need to be recalculated in this routine.
-     */
-
-    /*
-     * HKM -> Assumption is made that the solvent is
-     *        species 0.
-     */
-#ifdef DEBUG_MODE
-    m_debugCalc = 0;
-#endif
-    if (m_indexSolvent != 0) {
-        throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT",
-                           "Wrong index solvent value!");
+    CachedScalar cached = m_cache.getScalar(cacheId_d2lnActCoeff_dT2);
+    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
+        return;
     }
 
-    const double* molality  =  DATA_PTR(m_molalitiesCropped);
-    const double* beta0MX_L =  DATA_PTR(m_Beta0MX_ij_L);
-    const double* beta1MX_L =  DATA_PTR(m_Beta1MX_ij_L);
-    const double* beta2MX_L =  DATA_PTR(m_Beta2MX_ij_L);
-    const double* CphiMX_L  =  DATA_PTR(m_CphiMX_ij_L);
-    const double* thetaij_L =  DATA_PTR(m_Theta_ij_L);
-    const double* alpha1MX   =  DATA_PTR(m_Alpha1MX_ij);
-    const double* alpha2MX   =  DATA_PTR(m_Alpha2MX_ij);
-    const double* psi_ijk_L =  DATA_PTR(m_Psi_ijk_L);
-    double* d_gamma_dT_Unscaled   =  DATA_PTR(m_gamma_tmp);
-    /*
-     * Local variables defined by Coltrin
-     */
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-    /*
-     * Molality based ionic strength of the solution
-     */
-    double Is = 0.0;
     /*
-     * Molarcharge of the solution: In Pitzer's notation,
-     * this is his variable called "Z".
-     */
-    double molarcharge = 0.0;
-    /*
-     * molalitysum is the sum of the molalities over all solutes,
-     * even those with zero charge.
+     * Make sure that the unscaled 2nd derivatives are current
      */
-    double molalitysum = 0.0;
+    s_updatePitzer_derivatives(PITZER_DT2);
 
-    double* gfunc    =  DATA_PTR(m_gfunc_IJ);
-    double* g2func   =  DATA_PTR(m_g2func_IJ);
-    double* hfunc    =  DATA_PTR(m_hfunc_IJ);
-    double* h2func   =  DATA_PTR(m_h2func_IJ);
-    double* BMX_L    =  DATA_PTR(m_BMX_IJ_L);
-    double* BprimeMX_L= DATA_PTR(m_BprimeMX_IJ_L);
-    double* BphiMX_L =  DATA_PTR(m_BphiMX_IJ_L);
-    double* Phi_L    =  DATA_PTR(m_Phi_IJ_L);
-    double* Phiprime =  DATA_PTR(m_Phiprime_IJ);
-    double* Phiphi_L =  DATA_PTR(m_PhiPhi_IJ_L);
-    double* CMX_L    =  DATA_PTR(m_CMX_IJ_L);
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf("\n Debugging information from "
-               "s_Pitzer_dlnMolalityActCoeff_dT()\n");
+    for (size_t k = 1; k < m_kk; k++) {
+        if (CROP_speciesCropped_[k] == 2) {
+            m_d2lnActCoeffMolaldT2_Unscaled[k] = 0.0;
+        }
     }
-    /*
-     * Make sure the counter variables are setup
-     */
-    counterIJ_setup();
 
-    /*
-     * ---------- Calculate common sums over solutes ---------------------
-     */
-    for (size_t n = 1; n < m_kk; n++) {
-        //      ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        //      total molar charge
-        molarcharge +=  fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
+    if (CROP_speciesCropped_[0]) {
+        m_d2lnActCoeffMolaldT2_Unscaled[0] = 0.0;
     }
-    Is *= 0.5;
 
     /*
-     * Store the ionic molality in the object for reference.
+     * Scale the 2nd derivatives
      */
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 1: \n");
-        printf(" ionic strenth      = %14.7le \n total molar "
-               "charge = %14.7le \n", Is, molarcharge);
+    s_updateScaling_pHScaling_dT2();
+}
+
+void HMWSoln::s_update_dlnMolalityActCoeff_dP() const
+{
+    CachedScalar cached = m_cache.getScalar(cacheId_dlnActCoeff_dP);
+    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
+        return;
     }
 
-    /*
-     * The following call to calc_lambdas() calculates all 16 elements
-     * of the elambda and elambda1 arrays, given the value of the
-     * ionic strength (Is)
-     */
-    calc_lambdas(Is);
+    s_updatePitzer_derivatives(PITZER_DP);
 
-    /*
-     * ----- Step 2:  Find the coefficients E-theta and -------------------
-     *                E-thetaprime for all combinations of positive
-     *                unlike charges up to 4
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 2: \n");
-    }
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
-                       z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
-            }
+    for (size_t k = 1; k < m_kk; k++) {
+        if (CROP_speciesCropped_[k] == 2) {
+            m_dlnActCoeffMolaldP_Unscaled[k] = 0.0;
         }
     }
 
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 3: \n");
-        printf(" Species          Species            g(x) "
-               " hfunc(x)   \n");
-    }
-
-    /*
-     *  calculate g(x) and hfunc(x) for each cation-anion pair MX
-     *   In the original literature, hfunc, was called gprime. However,
-     *   it's not the derivative of g(x), so I renamed it.
-     */
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * Only loop over oppositely charge species
-             */
-            if (charge(i)*charge(j) < 0) {
-                /*
-                 * x is a reduced function variable
-                 */
-                double x1 = sqrtIs * alpha1MX[counterIJ];
-                if (x1 > 1.0E-100) {
-                    gfunc[counterIJ]     =  2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
-                    hfunc[counterIJ] = -2.0 *
-                                       (1.0-(1.0 + x1 + 0.5 * x1 *x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    gfunc[counterIJ] = 0.0;
-                    hfunc[counterIJ] = 0.0;
-                }
-
-                if (beta2MX_L[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * alpha2MX[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        h2func[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        g2func[counterIJ] = 0.0;
-                        h2func[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                gfunc[counterIJ] = 0.0;
-                hfunc[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
-                       gfunc[counterIJ], hfunc[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE BMX_L, BprimeMX_L, BphiMX_L ----------
-     * ------- These are now temperature derivatives of the
-     *         previously calculated quantities.
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 4: \n");
-        printf(" Species          Species            BMX    "
-               "BprimeMX    BphiMX   \n");
-    }
-
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                BMX_L[counterIJ]  = beta0MX_L[counterIJ]
-                                    + beta1MX_L[counterIJ] * gfunc[counterIJ]
-                                    + beta2MX_L[counterIJ] * gfunc[counterIJ];
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    printf("%d %g: %g %g %g %g\n",
-                           (int) counterIJ,  BMX_L[counterIJ], beta0MX_L[counterIJ],
-                           beta1MX_L[counterIJ],  beta2MX_L[counterIJ], gfunc[counterIJ]);
-                }
-                if (Is > 1.0E-150) {
-                    BprimeMX_L[counterIJ] = (beta1MX_L[counterIJ] * hfunc[counterIJ]/Is +
-                                             beta2MX_L[counterIJ] * h2func[counterIJ]/Is);
-                } else {
-                    BprimeMX_L[counterIJ] = 0.0;
-                }
-                BphiMX_L[counterIJ] = BMX_L[counterIJ] + Is*BprimeMX_L[counterIJ];
-            } else {
-                BMX_L[counterIJ]      = 0.0;
-                BprimeMX_L[counterIJ] = 0.0;
-                BphiMX_L[counterIJ]     = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f %11.7f %11.7f \n",
-                       sni.c_str(), snj.c_str(),
-                       BMX_L[counterIJ], BprimeMX_L[counterIJ], BphiMX_L[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * --------- SUBSECTION TO CALCULATE CMX_L ----------
-     * ---------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 5: \n");
-        printf(" Species          Species            CMX \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                CMX_L[counterIJ] = CphiMX_L[counterIJ]/
-                                   (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                CMX_L[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f \n", sni.c_str(), snj.c_str(),
-                       CMX_L[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-     * --------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 6: \n");
-        printf(" Species          Species            Phi_ij "
-               " Phiprime_ij  Phi^phi_ij \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) > 0) {
-                Phi_L[counterIJ] = thetaij_L[counterIJ];
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_L[counterIJ] = Phi_L[counterIJ] + Is * Phiprime[counterIJ];
-            } else {
-                Phi_L[counterIJ]      = 0.0;
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_L[counterIJ]   = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %10.6f %10.6f %10.6f \n",
-                       sni.c_str(), snj.c_str(),
-                       Phi_L[counterIJ], Phiprime[counterIJ], Phiphi_L[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ----------- SUBSECTION FOR CALCULATION OF dFdT ---------------------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 7: \n");
-    }
-    double dA_DebyedT = dA_DebyedT_TP();
-    double dAphidT = dA_DebyedT /3.0;
-    double dFdT = -dAphidT * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                       + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" initial value of dFdT = %10.6f \n", dFdT);
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0) {
-                dFdT = dFdT + molality[i]*molality[j] * BprimeMX_L[counterIJ];
-            }
-            /*
-             * Both species have a non-zero charge, and they
-             * have the same sign, e.g., both positive or both negative.
-             */
-            if (charge(i)*charge(j) > 0) {
-                dFdT = dFdT + molality[i]*molality[j] * Phiprime[counterIJ];
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" dFdT = %10.6f \n", dFdT);
-            }
-        }
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 8: \n");
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-        /*
-         * -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR CATIONS -----
-         * --
-         */
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqdFdT = charge(i)*charge(i)*dFdT;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_L[counterIJ] + molarcharge*CMX_L[counterIJ]);
-                    if (j < m_kk-1) {
-                        /*
-                         * This term is the ternary interaction involving the
-                         * non-duplicate sum over double anions, j, k, with
-                         * respect to the cation, i.
-                         */
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_L[n];
-                            }
-                        }
-                    }
-                }
-
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_L[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_L[n];
-                            /*
-                             * Find the counterIJ for the j,k interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 + (fabs(charge(i))*
-                                           molality[j]*molality[k]*CMX_L[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * Handle neutral j species
-                 */
-                if (charge(j) == 0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_L(j,i);
-                }
-                /*
-                 * Zeta interaction term
-                 */
-                for (size_t k = 1; k < m_kk; k++) {
-                    if (charge(k) < 0.0) {
-                        size_t izeta = j;
-                        size_t jzeta = i;
-                        n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                        double zeta_L = psi_ijk_L[n];
-                        if (zeta_L != 0.0) {
-                            sum5 = sum5 + molality[j]*molality[k]*zeta_L;
-                        }
-                    }
-                }
-            }
-            /*
-             * Add all of the contributions up to yield the log of the
-             * solute activity coefficients (molality scale)
-             */
-            m_dlnActCoeffMolaldT_Unscaled[i] =
-                zsqdFdT + sum1 + sum2 + sum3 + sum4 + sum5;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lngamma[i]=%10.6f gamma[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldT_Unscaled[i], d_gamma_dT_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqdFdT, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-
-        /*
-         * ------ SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR ANIONS ------
-         *
-         */
-        if (charge(i) < 0) {
-            //          species i is an anion (negative)
-            double zsqdFdT = charge(i)*charge(i)*dFdT;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                /*
-                 * For Anions, do the cation interactions.
-                 */
-                if (charge(j) > 0) {
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_L[counterIJ] + molarcharge*CMX_L[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_L[n];
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * For Anions, do the other anion interactions.
-                 */
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_L[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_L[n];
-                            /*
-                             * Find the counterIJ for the symmetric binary interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 +
-                                   (fabs(charge(i))*
-                                    molality[j]*molality[k]*CMX_L[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0.0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_L(j,i);
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_L = psi_ijk_L[n];
-                            if (zeta_L != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_L;
-                            }
-                        }
-                    }
-                }
-            }
-            m_dlnActCoeffMolaldT_Unscaled[i] =
-                zsqdFdT + sum1 + sum2 + sum3 + sum4 + sum5;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lngamma[i]=%10.6f gamma[i]=%10.6f\n",
-                       sni.c_str(), m_dlnActCoeffMolaldT_Unscaled[i], d_gamma_dT_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqdFdT, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-        /*
-         * ------ SUBSECTION FOR CALCULATING NEUTRAL SOLUTE ACT COEFF -------
-         * ------ -> equations agree with my notes,
-         *        -> Equations agree with Pitzer,
-         */
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 = sum1 + molality[j]*2.0*m_Lambda_nj_L(i,j);
-                /*
-                 * Zeta term -> we piggyback on the psi term
-                 */
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 = sum3 + molality[j]*molality[k]*psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_L[i];
-            m_dlnActCoeffMolaldT_Unscaled[i] = sum1 + sum2 + sum3;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lngamma[i]=%10.6f gamma[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldT_Unscaled[i], d_gamma_dT_Unscaled[i]);
-            }
-        }
-
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 9: \n");
-    }
-    /*
-     * ------ SUBSECTION FOR CALCULATING THE d OSMOTIC COEFF dT ---------
-     *
-     */
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-    /*
-     * term1 is the temperature derivative of the
-     * DH term in the osmotic coefficient expression
-     * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
-     *                          implementations.
-     * Is = Ionic strength on the molality scale (units of (gmol/kg))
-     * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-     */
-    double term1 = -dAphidT * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        /*
-         * Loop Over Cations
-         */
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 = sum1 + molality[j]*molality[k]*
-                           (BphiMX_L[counterIJ] + molarcharge*CMX_L[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between 2 cations.
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 = sum2 + molality[j]*molality[k]*Phiphi_L[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 = sum2 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Anions
-         */
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between two anions
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 = sum3 + molality[j]*molality[k]*Phiphi_L[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 = sum3 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Neutral Species
-         */
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 = sum4 + molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 = sum5 + molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 = sum6 + molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                    } else if (k == j) {
-                        sum6 = sum6 + 0.5 * molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_L = psi_ijk_L[n];
-                            if (zeta_L != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_L;
-                            }
-                        }
-                    }
-                }
-            }
-            sum7 += molality[j]*molality[j]*molality[j]*m_Mu_nnn_L[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-    /*
-     * Calculate the osmotic coefficient from
-     *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-     */
-    double d_osmotic_coef_dT;
-    if (molalitysum > 1.0E-150) {
-        d_osmotic_coef_dT = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d_osmotic_coef_dT = 0.0;
-    }
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
-               "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
-               term1, sum1, sum2, sum3, sum4, sum5);
-        printf("     sum_m_phi_minus_1=%10.6f        d_osmotic_coef_dT =%10.6f\n",
-               sum_m_phi_minus_1, d_osmotic_coef_dT);
-        printf(" Step 10: \n");
-    }
-    double d_lnwateract_dT = -(m_weightSolvent/1000.0) * molalitysum * d_osmotic_coef_dT;
-
-    /*
-     * In Cantera, we define the activity coefficient of the solvent as
-     *
-     *     act_0 = actcoeff_0 * Xmol_0
-     *
-     * We have just computed act_0. However, this routine returns
-     *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-     */
-    m_dlnActCoeffMolaldT_Unscaled[0] = d_lnwateract_dT;
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        double d_wateract_dT = exp(d_lnwateract_dT);
-        printf(" d_ln_a_water_dT = %10.6f d_a_water_dT=%10.6f\n\n",
-               d_lnwateract_dT, d_wateract_dT);
-    }
-}
-
-void HMWSoln::s_update_d2lnMolalityActCoeff_dT2() const
-{
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
-    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
-        return;
-    }
-
-    /*
-     *  Zero the unscaled 2nd derivatives
-     */
-    m_d2lnActCoeffMolaldT2_Unscaled.assign(m_kk, 0.0);
-    /*
-     * Calculate the unscaled 2nd derivatives
-     */
-    s_updatePitzer_d2lnMolalityActCoeff_dT2();
-
-    for (size_t k = 1; k < m_kk; k++) {
-        if (CROP_speciesCropped_[k] == 2) {
-            m_d2lnActCoeffMolaldT2_Unscaled[k] = 0.0;
-        }
-    }
-
-    if (CROP_speciesCropped_[0]) {
-        m_d2lnActCoeffMolaldT2_Unscaled[0] = 0.0;
-    }
-
-    /*
-     * Scale the 2nd derivatives
-     */
-    s_updateScaling_pHScaling_dT2();
-}
-
-void HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2() const
-{
-    /*
-     * HKM -> Assumption is made that the solvent is species 0.
-     */
-#ifdef DEBUG_MODE
-    m_debugCalc = 0;
-#endif
-    if (m_indexSolvent != 0) {
-        throw CanteraError("HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2",
-                           "Wrong index solvent value!");
-    }
-
-    const double* molality  =  DATA_PTR(m_molalitiesCropped);
-    const double* beta0MX_LL=  DATA_PTR(m_Beta0MX_ij_LL);
-    const double* beta1MX_LL=  DATA_PTR(m_Beta1MX_ij_LL);
-    const double* beta2MX_LL=  DATA_PTR(m_Beta2MX_ij_LL);
-    const double* CphiMX_LL =  DATA_PTR(m_CphiMX_ij_LL);
-    const double* thetaij_LL=  DATA_PTR(m_Theta_ij_LL);
-    const double* alpha1MX  =  DATA_PTR(m_Alpha1MX_ij);
-    const double* alpha2MX  =  DATA_PTR(m_Alpha2MX_ij);
-    const double* psi_ijk_LL=  DATA_PTR(m_Psi_ijk_LL);
-
-    /*
-     * Local variables defined by Coltrin
-     */
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-    /*
-     * Molality based ionic strength of the solution
-     */
-    double Is = 0.0;
-    /*
-     * Molarcharge of the solution: In Pitzer's notation,
-     * this is his variable called "Z".
-     */
-    double molarcharge = 0.0;
-    /*
-     * molalitysum is the sum of the molalities over all solutes,
-     * even those with zero charge.
-     */
-    double molalitysum = 0.0;
-
-    double* gfunc    =  DATA_PTR(m_gfunc_IJ);
-    double* g2func   =  DATA_PTR(m_g2func_IJ);
-    double* hfunc    =  DATA_PTR(m_hfunc_IJ);
-    double* h2func   =  DATA_PTR(m_h2func_IJ);
-    double* BMX_LL   =  DATA_PTR(m_BMX_IJ_LL);
-    double* BprimeMX_LL=DATA_PTR(m_BprimeMX_IJ_LL);
-    double* BphiMX_LL=  DATA_PTR(m_BphiMX_IJ_LL);
-    double* Phi_LL   =  DATA_PTR(m_Phi_IJ_LL);
-    double* Phiprime =  DATA_PTR(m_Phiprime_IJ);
-    double* Phiphi_LL=  DATA_PTR(m_PhiPhi_IJ_LL);
-    double* CMX_LL   =  DATA_PTR(m_CMX_IJ_LL);
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf("\n Debugging information from "
-               "s_Pitzer_d2lnMolalityActCoeff_dT2()\n");
-    }
-    /*
-     * Make sure the counter variables are setup
-     */
-    counterIJ_setup();
-
-
-    /*
-     * ---------- Calculate common sums over solutes ---------------------
-     */
-    for (size_t n = 1; n < m_kk; n++) {
-        //      ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        //      total molar charge
-        molarcharge +=  fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
-    }
-    Is *= 0.5;
-
-    /*
-     * Store the ionic molality in the object for reference.
-     */
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 1: \n");
-        printf(" ionic strenth      = %14.7le \n total molar "
-               "charge = %14.7le \n", Is, molarcharge);
-    }
-
-    /*
-     * The following call to calc_lambdas() calculates all 16 elements
-     * of the elambda and elambda1 arrays, given the value of the
-     * ionic strength (Is)
-     */
-    calc_lambdas(Is);
-
-    /*
-     * ----- Step 2:  Find the coefficients E-theta and -------------------
-     *                E-thetaprime for all combinations of positive
-     *                unlike charges up to 4
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 2: \n");
-    }
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
-                       z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
-            }
-        }
-    }
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 3: \n");
-        printf(" Species          Species            g(x) "
-               " hfunc(x)   \n");
-    }
-
-    /*
-     *
-     *  calculate gfunc(x) and hfunc(x) for each cation-anion pair MX
-     *   In the original literature, hfunc, was called gprime. However,
-     *   it's not the derivative of gfunc(x), so I renamed it.
-     */
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * Only loop over oppositely charge species
-             */
-            if (charge(i)*charge(j) < 0) {
-                /*
-                 * x is a reduced function variable
-                 */
-                double x1 = sqrtIs * alpha1MX[counterIJ];
-                if (x1 > 1.0E-100) {
-                    gfunc[counterIJ] =  2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 *x1);
-                    hfunc[counterIJ] = -2.0*
-                                       (1.0-(1.0 + x1 + 0.5*x1 * x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    gfunc[counterIJ] = 0.0;
-                    hfunc[counterIJ] = 0.0;
-                }
-
-                if (beta2MX_LL[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * alpha2MX[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        h2func[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        g2func[counterIJ] = 0.0;
-                        h2func[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                gfunc[counterIJ] = 0.0;
-                hfunc[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
-                       gfunc[counterIJ], hfunc[counterIJ]);
-            }
-        }
-    }
-    /*
-     * ------- SUBSECTION TO CALCULATE BMX_L, BprimeMX_LL, BphiMX_L ----------
-     * ------- These are now temperature derivatives of the
-     *         previously calculated quantities.
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 4: \n");
-        printf(" Species          Species            BMX    "
-               "BprimeMX    BphiMX   \n");
-    }
-
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                BMX_LL[counterIJ]  = beta0MX_LL[counterIJ]
-                                     + beta1MX_LL[counterIJ] * gfunc[counterIJ]
-                                     + beta2MX_LL[counterIJ] * g2func[counterIJ];
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    printf("%d %g: %g %g %g %g\n",
-                           (int) counterIJ,  BMX_LL[counterIJ], beta0MX_LL[counterIJ],
-                           beta1MX_LL[counterIJ], beta2MX_LL[counterIJ], gfunc[counterIJ]);
-                }
-                if (Is > 1.0E-150) {
-                    BprimeMX_LL[counterIJ] = (beta1MX_LL[counterIJ] * hfunc[counterIJ]/Is +
-                                              beta2MX_LL[counterIJ] * h2func[counterIJ]/Is);
-                } else {
-                    BprimeMX_LL[counterIJ] = 0.0;
-                }
-                BphiMX_LL[counterIJ] = BMX_LL[counterIJ] + Is*BprimeMX_LL[counterIJ];
-            } else {
-                BMX_LL[counterIJ]      = 0.0;
-                BprimeMX_LL[counterIJ] = 0.0;
-                BphiMX_LL[counterIJ]     = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f %11.7f %11.7f \n",
-                       sni.c_str(), snj.c_str(),
-                       BMX_LL[counterIJ], BprimeMX_LL[counterIJ], BphiMX_LL[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * --------- SUBSECTION TO CALCULATE CMX_LL ----------
-     * ---------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 5: \n");
-        printf(" Species          Species            CMX \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                CMX_LL[counterIJ] = CphiMX_LL[counterIJ]/
-                                    (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                CMX_LL[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f \n", sni.c_str(), snj.c_str(),
-                       CMX_LL[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-     * --------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 6: \n");
-        printf(" Species          Species            Phi_ij "
-               " Phiprime_ij  Phi^phi_ij \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) > 0) {
-                Phi_LL[counterIJ] = thetaij_LL[counterIJ];
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_LL[counterIJ] = Phi_LL[counterIJ];
-            } else {
-                Phi_LL[counterIJ]      = 0.0;
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_LL[counterIJ]   = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %10.6f %10.6f %10.6f \n",
-                       sni.c_str(), snj.c_str(),
-                       Phi_LL[counterIJ], Phiprime[counterIJ], Phiphi_LL[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ----------- SUBSECTION FOR CALCULATION OF d2FdT2 ---------------------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 7: \n");
-    }
-    double d2AphidT2 = d2A_DebyedT2_TP() / 3.0;
-    double d2FdT2 = -d2AphidT2 * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                           + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" initial value of d2FdT2 = %10.6f \n", d2FdT2);
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0) {
-                d2FdT2 = d2FdT2 + molality[i]*molality[j] * BprimeMX_LL[counterIJ];
-            }
-            /*
-             * Both species have a non-zero charge, and they
-             * have the same sign, e.g., both positive or both negative.
-             */
-            if (charge(i)*charge(j) > 0) {
-                d2FdT2 = d2FdT2 + molality[i]*molality[j] * Phiprime[counterIJ];
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" d2FdT2 = %10.6f \n", d2FdT2);
-            }
-        }
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 8: \n");
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-
-        /*
-         * -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR CATIONS -----
-         * --
-         */
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqd2FdT2 = charge(i)*charge(i)*d2FdT2;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_LL[counterIJ] + molarcharge*CMX_LL[counterIJ]);
-                    if (j < m_kk-1) {
-                        /*
-                         * This term is the ternary interaction involving the
-                         * non-duplicate sum over double anions, j, k, with
-                         * respect to the cation, i.
-                         */
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_LL[n];
-                            }
-                        }
-                    }
-                }
-
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_LL[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_LL[n];
-                            /*
-                             * Find the counterIJ for the j,k interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 + (fabs(charge(i))*
-                                           molality[j]*molality[k]*CMX_LL[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * Handle neutral j species
-                 */
-                if (charge(j) == 0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_LL(j,i);
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta_LL = psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-            /*
-             * Add all of the contributions up to yield the log of the
-             * solute activity coefficients (molality scale)
-             */
-            m_d2lnActCoeffMolaldT2_Unscaled[i] =
-                zsqd2FdT2 + sum1 + sum2 + sum3 + sum4 + sum5;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s d2lngammadT2[i]=%10.6f \n",
-                       sni.c_str(), m_d2lnActCoeffMolaldT2_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqd2FdT2, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-
-
-        /*
-         * ------ SUBSECTION FOR CALCULATING THE d2ACTCOEFFdT2 FOR ANIONS ------
-         *
-         */
-        if (charge(i) < 0) {
-            //          species i is an anion (negative)
-            double zsqd2FdT2 = charge(i)*charge(i)*d2FdT2;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                /*
-                 * For Anions, do the cation interactions.
-                 */
-                if (charge(j) > 0) {
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_LL[counterIJ] + molarcharge*CMX_LL[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_LL[n];
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * For Anions, do the other anion interactions.
-                 */
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_LL[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_LL[n];
-                            /*
-                             * Find the counterIJ for the symmetric binary interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 +
-                                   (fabs(charge(i))*
-                                    molality[j]*molality[k]*CMX_LL[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0.0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_LL(j,i);
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_LL = psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-            m_d2lnActCoeffMolaldT2_Unscaled[i] =
-                zsqd2FdT2 + sum1 + sum2 + sum3 + sum4 + sum5;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s d2lngammadT2[i]=%10.6f\n",
-                       sni.c_str(), m_d2lnActCoeffMolaldT2_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqd2FdT2, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-        /*
-         * ------ SUBSECTION FOR CALCULATING NEUTRAL SOLUTE ACT COEFF -------
-         * ------ -> equations agree with my notes,
-         *        -> Equations agree with Pitzer,
-         */
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 = sum1 + molality[j]*2.0*m_Lambda_nj_LL(i,j);
-                /*
-                 * Zeta term -> we piggyback on the psi term
-                 */
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 = sum3 + molality[j]*molality[k]*psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_LL[i];
-            m_d2lnActCoeffMolaldT2_Unscaled[i] = sum1 + sum2 + sum3;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s d2lngammadT2[i]=%10.6f \n",
-                       sni.c_str(), m_d2lnActCoeffMolaldT2_Unscaled[i]);
-            }
-        }
-
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 9: \n");
-    }
-
-    /*
-     * ------ SUBSECTION FOR CALCULATING THE d2 OSMOTIC COEFF dT2 ---------
-     */
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-    /*
-     * term1 is the temperature derivative of the
-     * DH term in the osmotic coefficient expression
-     * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
-     *                          implementations.
-     * Is = Ionic strength on the molality scale (units of (gmol/kg))
-     * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-     */
-    double term1 = -d2AphidT2 * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        /*
-         * Loop Over Cations
-         */
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 = sum1 + molality[j]*molality[k]*
-                           (BphiMX_LL[counterIJ] + molarcharge*CMX_LL[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between 2 cations.
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 = sum2 + molality[j]*molality[k]*Phiphi_LL[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 = sum2 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Anions
-         */
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between two anions
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 = sum3 + molality[j]*molality[k]*Phiphi_LL[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 = sum3 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Neutral Species
-         */
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 = sum4 + molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 = sum5 + molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 = sum6 + molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                    } else if (k == j) {
-                        sum6 = sum6 + 0.5 * molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_LL = psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-
-            sum7 += molality[j] * molality[j] * molality[j] * m_Mu_nnn_LL[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-    /*
-     * Calculate the osmotic coefficient from
-     *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-     */
-    double d2_osmotic_coef_dT2;
-    if (molalitysum > 1.0E-150) {
-        d2_osmotic_coef_dT2 = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d2_osmotic_coef_dT2 = 0.0;
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
-               "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
-               term1, sum1, sum2, sum3, sum4, sum5);
-        printf("     sum_m_phi_minus_1=%10.6f        d2_osmotic_coef_dT2=%10.6f\n",
-               sum_m_phi_minus_1, d2_osmotic_coef_dT2);
-        printf(" Step 10: \n");
-    }
-    double d2_lnwateract_dT2 = -(m_weightSolvent/1000.0) * molalitysum * d2_osmotic_coef_dT2;
-
-    /*
-     * In Cantera, we define the activity coefficient of the solvent as
-     *
-     *     act_0 = actcoeff_0 * Xmol_0
-     *
-     * We have just computed act_0. However, this routine returns
-     *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-     */
-    m_d2lnActCoeffMolaldT2_Unscaled[0] = d2_lnwateract_dT2;
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        double d2_wateract_dT2 = exp(d2_lnwateract_dT2);
-        printf(" d2_ln_a_water_dT2 = %10.6f d2_a_water_dT2=%10.6f\n\n",
-               d2_lnwateract_dT2, d2_wateract_dT2);
-    }
-}
-
-void HMWSoln::s_update_dlnMolalityActCoeff_dP() const
-{
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
-    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
-        return;
-    }
-
-    m_dlnActCoeffMolaldP_Unscaled.assign(m_kk, 0.0);
-    s_updatePitzer_dlnMolalityActCoeff_dP();
-
-    for (size_t k = 1; k < m_kk; k++) {
-        if (CROP_speciesCropped_[k] == 2) {
-            m_dlnActCoeffMolaldP_Unscaled[k] = 0.0;
-        }
-    }
-
-    if (CROP_speciesCropped_[0]) {
-        m_dlnActCoeffMolaldP_Unscaled[0] = 0.0;
-    }
-
-    s_updateScaling_pHScaling_dP();
-}
-
-void HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP() const
-{
-    /*
-     * HKM -> Assumption is made that the solvent is species 0.
-     */
-#ifdef DEBUG_MODE
-    m_debugCalc = 0;
-#endif
-    if (m_indexSolvent != 0) {
-        throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP",
-                           "Wrong index solvent value!");
-    }
-
-    const double* molality  =  DATA_PTR(m_molalitiesCropped);
-    const double* beta0MX_P =  DATA_PTR(m_Beta0MX_ij_P);
-    const double* beta1MX_P =  DATA_PTR(m_Beta1MX_ij_P);
-    const double* beta2MX_P =  DATA_PTR(m_Beta2MX_ij_P);
-    const double* CphiMX_P  =  DATA_PTR(m_CphiMX_ij_P);
-    const double* thetaij_P =  DATA_PTR(m_Theta_ij_P);
-    const double* alpha1MX  =  DATA_PTR(m_Alpha1MX_ij);
-    const double* alpha2MX  =  DATA_PTR(m_Alpha2MX_ij);
-    const double* psi_ijk_P =  DATA_PTR(m_Psi_ijk_P);
-
-    /*
-     * Local variables defined by Coltrin
-     */
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-    /*
-     * Molality based ionic strength of the solution
-     */
-    double Is = 0.0;
-    /*
-     * Molarcharge of the solution: In Pitzer's notation,
-     * this is his variable called "Z".
-     */
-    double molarcharge = 0.0;
-    /*
-     * molalitysum is the sum of the molalities over all solutes,
-     * even those with zero charge.
-     */
-    double molalitysum = 0.0;
-
-    double* gfunc    =  DATA_PTR(m_gfunc_IJ);
-    double* g2func   =  DATA_PTR(m_g2func_IJ);
-    double* hfunc    =  DATA_PTR(m_hfunc_IJ);
-    double* h2func   =  DATA_PTR(m_h2func_IJ);
-    double* BMX_P    =  DATA_PTR(m_BMX_IJ_P);
-    double* BprimeMX_P= DATA_PTR(m_BprimeMX_IJ_P);
-    double* BphiMX_P =  DATA_PTR(m_BphiMX_IJ_P);
-    double* Phi_P    =  DATA_PTR(m_Phi_IJ_P);
-    double* Phiprime =  DATA_PTR(m_Phiprime_IJ);
-    double* Phiphi_P =  DATA_PTR(m_PhiPhi_IJ_P);
-    double* CMX_P    =  DATA_PTR(m_CMX_IJ_P);
-
-    double currTemp = temperature();
-    double currPres = pressure();
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf("\n Debugging information from "
-               "s_Pitzer_dlnMolalityActCoeff_dP()\n");
-    }
-    /*
-     * Make sure the counter variables are setup
-     */
-    counterIJ_setup();
-
-    /*
-     * ---------- Calculate common sums over solutes ---------------------
-     */
-    for (size_t n = 1; n < m_kk; n++) {
-        //      ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        //      total molar charge
-        molarcharge +=  fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
-    }
-    Is *= 0.5;
-
-    /*
-     * Store the ionic molality in the object for reference.
-     */
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 1: \n");
-        printf(" ionic strenth      = %14.7le \n total molar "
-               "charge = %14.7le \n", Is, molarcharge);
-    }
-
-    /*
-     * The following call to calc_lambdas() calculates all 16 elements
-     * of the elambda and elambda1 arrays, given the value of the
-     * ionic strength (Is)
-     */
-    calc_lambdas(Is);
-
-
-    /*
-     * ----- Step 2:  Find the coefficients E-theta and -------------------
-     *                E-thetaprime for all combinations of positive
-     *                unlike charges up to 4
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 2: \n");
-    }
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
-                       z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
-            }
-        }
-    }
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 3: \n");
-        printf(" Species          Species            g(x) "
-               " hfunc(x)   \n");
-    }
-
-    /*
-     *
-     *  calculate g(x) and hfunc(x) for each cation-anion pair MX
-     *   In the original literature, hfunc, was called gprime. However,
-     *   it's not the derivative of g(x), so I renamed it.
-     */
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * Only loop over oppositely charge species
-             */
-            if (charge(i)*charge(j) < 0) {
-                /*
-                 * x is a reduced function variable
-                 */
-                double x1 = sqrtIs * alpha1MX[counterIJ];
-                if (x1 > 1.0E-100) {
-                    gfunc[counterIJ] =  2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
-                    hfunc[counterIJ] = -2.0*
-                                       (1.0-(1.0 + x1 + 0.5 * x1 * x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    gfunc[counterIJ] = 0.0;
-                    hfunc[counterIJ] = 0.0;
-                }
-
-                if (beta2MX_P[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * alpha2MX[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        h2func[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        g2func[counterIJ] = 0.0;
-                        h2func[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                gfunc[counterIJ] = 0.0;
-                hfunc[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
-                       gfunc[counterIJ], hfunc[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE BMX_P, BprimeMX_P, BphiMX_P ----------
-     * ------- These are now temperature derivatives of the
-     *         previously calculated quantities.
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 4: \n");
-        printf(" Species          Species            BMX    "
-               "BprimeMX    BphiMX   \n");
-    }
-
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                BMX_P[counterIJ]  = beta0MX_P[counterIJ]
-                                    + beta1MX_P[counterIJ] * gfunc[counterIJ]
-                                    + beta2MX_P[counterIJ] * g2func[counterIJ];
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    printf("%d %g: %g %g %g %g\n",
-                           (int) counterIJ,  BMX_P[counterIJ], beta0MX_P[counterIJ],
-                           beta1MX_P[counterIJ], beta2MX_P[counterIJ], gfunc[counterIJ]);
-                }
-                if (Is > 1.0E-150) {
-                    BprimeMX_P[counterIJ] = (beta1MX_P[counterIJ] * hfunc[counterIJ]/Is +
-                                             beta2MX_P[counterIJ] * h2func[counterIJ]/Is);
-                } else {
-                    BprimeMX_P[counterIJ] = 0.0;
-                }
-                BphiMX_P[counterIJ] = BMX_P[counterIJ] + Is*BprimeMX_P[counterIJ];
-            } else {
-                BMX_P[counterIJ]      = 0.0;
-                BprimeMX_P[counterIJ] = 0.0;
-                BphiMX_P[counterIJ]     = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f %11.7f %11.7f \n",
-                       sni.c_str(), snj.c_str(),
-                       BMX_P[counterIJ], BprimeMX_P[counterIJ], BphiMX_P[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * --------- SUBSECTION TO CALCULATE CMX_P ----------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 5: \n");
-        printf(" Species          Species            CMX \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                CMX_P[counterIJ] = CphiMX_P[counterIJ]/
-                                   (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                CMX_P[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f \n", sni.c_str(), snj.c_str(),
-                       CMX_P[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-     * --------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 6: \n");
-        printf(" Species          Species            Phi_ij "
-               " Phiprime_ij  Phi^phi_ij \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) > 0) {
-                Phi_P[counterIJ] = thetaij_P[counterIJ];
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_P[counterIJ] = Phi_P[counterIJ] + Is * Phiprime[counterIJ];
-            } else {
-                Phi_P[counterIJ]      = 0.0;
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_P[counterIJ]   = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %10.6f %10.6f %10.6f \n",
-                       sni.c_str(), snj.c_str(),
-                       Phi_P[counterIJ], Phiprime[counterIJ], Phiphi_P[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ----------- SUBSECTION FOR CALCULATION OF dFdT ---------------------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 7: \n");
-    }
-    double dA_DebyedP = dA_DebyedP_TP(currTemp, currPres);
-    double dAphidP = dA_DebyedP /3.0;
-    double dFdP = -dAphidP * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                       + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" initial value of dFdP = %10.6f \n", dFdP);
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0) {
-                dFdP = dFdP + molality[i]*molality[j] * BprimeMX_P[counterIJ];
-            }
-            /*
-             * Both species have a non-zero charge, and they
-             * have the same sign, e.g., both positive or both negative.
-             */
-            if (charge(i)*charge(j) > 0) {
-                dFdP = dFdP + molality[i]*molality[j] * Phiprime[counterIJ];
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" dFdP = %10.6f \n", dFdP);
-            }
-        }
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 8: \n");
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-
-        /*
-         * -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdP FOR CATIONS -----
-         */
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqdFdP = charge(i)*charge(i)*dFdP;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_P[counterIJ] + molarcharge*CMX_P[counterIJ]);
-                    if (j < m_kk-1) {
-                        /*
-                         * This term is the ternary interaction involving the
-                         * non-duplicate sum over double anions, j, k, with
-                         * respect to the cation, i.
-                         */
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_P[n];
-                            }
-                        }
-                    }
-                }
-
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_P[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_P[n];
-                            /*
-                             * Find the counterIJ for the j,k interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 + (fabs(charge(i))*
-                                           molality[j]*molality[k]*CMX_P[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_P(j,i);
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta_P = psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
-                }
-            }
-
-            /*
-             * Add all of the contributions up to yield the log of the
-             * solute activity coefficients (molality scale)
-             */
-            m_dlnActCoeffMolaldP_Unscaled[i] =
-                zsqdFdP + sum1 + sum2 + sum3 + sum4 + sum5;
-
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lngamma[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldP_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqdFdP, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-
-
-        /*
-         * ------ SUBSECTION FOR CALCULATING THE dACTCOEFFdP FOR ANIONS ------
-         */
-        if (charge(i) < 0) {
-            //          species i is an anion (negative)
-            double zsqdFdP = charge(i)*charge(i)*dFdP;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                /*
-                 * For Anions, do the cation interactions.
-                 */
-                if (charge(j) > 0) {
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_P[counterIJ] + molarcharge*CMX_P[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_P[n];
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * For Anions, do the other anion interactions.
-                 */
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_P[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_P[n];
-                            /*
-                             * Find the counterIJ for the symmetric binary interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 +
-                                   (fabs(charge(i))*
-                                    molality[j]*molality[k]*CMX_P[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0.0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_P(j,i);
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_P = psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
-                }
-            }
-            m_dlnActCoeffMolaldP_Unscaled[i] =
-                zsqdFdP + sum1 + sum2 + sum3 + sum4 + sum5;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lndactcoeffmolaldP[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldP_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqdFdP, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-
-        /*
-         * ------ SUBSECTION FOR CALCULATING d NEUTRAL SOLUTE ACT COEFF dP -------
-         */
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 +=  molality[j]*2.0*m_Lambda_nj_P(i,j);
-                /*
-                 * Zeta term -> we piggyback on the psi term
-                 */
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 = sum3 + molality[j]*molality[k]*psi_ijk_P[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_P[i];
-            m_dlnActCoeffMolaldP_Unscaled[i] = sum1 + sum2 + sum3;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s dlnActCoeffMolaldP[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldP_Unscaled[i]);
-            }
-        }
-
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 9: \n");
-    }
-
-    /*
-     * ------ SUBSECTION FOR CALCULATING THE d OSMOTIC COEFF dP ---------
-     */
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-    /*
-     * term1 is the temperature derivative of the
-     * DH term in the osmotic coefficient expression
-     * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
-     *                          implementations.
-     * Is = Ionic strength on the molality scale (units of (gmol/kg))
-     * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-     */
-    double term1 = -dAphidP * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        /*
-         * Loop Over Cations
-         */
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 = sum1 + molality[j]*molality[k]*
-                           (BphiMX_P[counterIJ] + molarcharge*CMX_P[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between 2 cations.
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 = sum2 + molality[j]*molality[k]*Phiphi_P[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 = sum2 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_P[n];
-                        }
-                    }
-                }
-            }
-        }
-
-
-        /*
-         * Loop Over Anions
-         */
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between two anions
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 = sum3 + molality[j]*molality[k]*Phiphi_P[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 = sum3 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_P[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Neutral Species
-         */
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 = sum4 + molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 = sum5 + molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 = sum6 + molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                    } else if (k == j) {
-                        sum6 = sum6 + 0.5 * molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_P = psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
-                }
-            }
-
-            sum7 += molality[j] * molality[j] * molality[j] * m_Mu_nnn_P[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-
-    /*
-     * Calculate the osmotic coefficient from
-     *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-     */
-    double d_osmotic_coef_dP;
-    if (molalitysum > 1.0E-150) {
-        d_osmotic_coef_dP = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d_osmotic_coef_dP = 0.0;
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
-               "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
-               term1, sum1, sum2, sum3, sum4, sum5);
-        printf("     sum_m_phi_minus_1=%10.6f        d_osmotic_coef_dP =%10.6f\n",
-               sum_m_phi_minus_1, d_osmotic_coef_dP);
-        printf(" Step 10: \n");
+    if (CROP_speciesCropped_[0]) {
+        m_dlnActCoeffMolaldP_Unscaled[0] = 0.0;
     }
-    double d_lnwateract_dP = -(m_weightSolvent/1000.0) * molalitysum * d_osmotic_coef_dP;
 
-
-    /*
-     * In Cantera, we define the activity coefficient of the solvent as
-     *
-     *     act_0 = actcoeff_0 * Xmol_0
-     *
-     * We have just computed act_0. However, this routine returns
-     *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-     */
-    m_dlnActCoeffMolaldP_Unscaled[0] = d_lnwateract_dP;
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        double d_wateract_dP = exp(d_lnwateract_dP);
-        printf(" d_ln_a_water_dP = %10.6f d_a_water_dP=%10.6f\n\n",
-               d_lnwateract_dP, d_wateract_dP);
-    }
+    s_updateScaling_pHScaling_dP();
 }
 
 void HMWSoln::calc_lambdas(double is) const
@@ -13,6 +13,13 @@ using namespace std;
 namespace Cantera
 {
 
+namespace
+{
+//! Id of the cached reference state properties. Assigned during static
+//! initialization; see ValueCache.
+const int cacheId_refThermo = ValueCache::getId();
+}
+
 IdealGasPhase::IdealGasPhase() :
     m_p0(-1.0),
     m_logc0(0.0)
@@ -369,8 +376,7 @@ void IdealGasPhase::setToEquilState(const doublereal* mu_RT)
 
 void IdealGasPhase::_updateThermo() const
 {
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
+    CachedScalar cached = m_cache.getScalar(cacheId_refThermo);
     doublereal tnow = temperature();
 
     // If the temperature has changed since the last time these
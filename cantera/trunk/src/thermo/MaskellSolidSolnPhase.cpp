@@ -19,6 +19,14 @@
 namespace Cantera
 {
 
+namespace
+{
+//! Ids of the cached values used by this class. These are assigned during
+//! static initialization; see ValueCache.
+const int cacheId_actCoeff = ValueCache::getId();
+const int cacheId_thermo = ValueCache::getId();
+}
+
 MaskellSolidSolnPhase::MaskellSolidSolnPhase() :
     m_Pref(OneAtm),
     m_Pcurrent(OneAtm),
@@ -145,8 +153,7 @@ void MaskellSolidSolnPhase::setMolarDensity(const doublereal n)
 void MaskellSolidSolnPhase::getActivityCoefficients(doublereal* ac) const
 {
     _updateThermo();
-    static const int cacheId = m_cache.getId();
-    CachedArray cached = m_cache.getArray(cacheId);
+    CachedArray cached = m_cache.getArray(cacheId_actCoeff);
     if (!cached.validate(temperature(), pressure(), stateMFNumber())) {
         cached.value.resize(2);
 
@@ -292,8 +299,7 @@ void MaskellSolidSolnPhase::initThermoXML(XML_Node& phaseNode, const std::string
 void MaskellSolidSolnPhase::_updateThermo() const
 {
     assert(m_kk == 2);
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
+    CachedScalar cached = m_cache.getScalar(cacheId_thermo);
     /*
      * Update the thermodynamic functions of the reference state.
      */
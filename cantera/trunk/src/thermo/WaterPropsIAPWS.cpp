@@ -12,6 +12,7 @@
 #include "cantera/thermo/WaterPropsIAPWS.h"
 #include "cantera/base/ctexceptions.h"
 #include "cantera/base/stringUtils.h"
+#include "cantera/numerics/funcs.h"
 
 namespace Cantera
 {
@@ -36,12 +37,61 @@ static const doublereal M_water = 18.015268;
  */
 static const doublereal Rgas = 8.314371E3;   // Joules kmol-1 K-1
 
+namespace {
+
+//! Weights *w* of the cubic interpolation at position *s* in a row of *n*
+//! equally spaced values. Returns the index of the first of the four values
+//! used.
+size_t cubicStencil(double s, size_t n, double* w)
+{
+    size_t i = std::min(std::max<size_t>(static_cast<size_t>(s), 1), n - 3);
+    cubicWeights(s - i, w);
+    return i - 1;
+}
+
+//! Interpolate in a table with *nP* columns, using the values in rows *j*
+//! to *j* + 3 and columns *i* to *i* + 3 with the weights *wT* and *wP*.
+double interpolateTable(const double* table, size_t nP, size_t j,
+                        const double* wT, size_t i, const double* wP)
+{
+    double value = 0.0;
+    for (size_t k = 0; k < 4; k++) {
+        const double* row = table + (j + k) * nP + i;
+        value += wT[k] * (wP[0] * row[0] + wP[1] * row[1] +
+                          wP[2] * row[2] + wP[3] * row[3]);
+    }
+    return value;
+}
+
+//! Reduced density of liquid water at (*T*, *P*), found by solving the
+//! equation of state.
+double liquidDelta(WaterPropsIAPWS& water, double T, double P)
+{
+    double rho = water.density(T, P, WATER_LIQUID);
+    if (rho <= 0.0) {
+        throw CanteraError("WaterPropsIAPWS::setDensityTabulation",
+                           "No liquid density found at (T,P) = " +
+                           fp2str(T) + "  " + fp2str(P));
+    }
+    return rho / Rho_c;
+}
+
+}
+
 // Base constructor
 WaterPropsIAPWS::WaterPropsIAPWS() :
     m_phi(0),
     tau(-1.0),
     delta(-1.0),
-    iState(-30000)
+    iState(-30000),
+    m_useTable(false),
+    m_tableTmin(0.0),
+    m_tableHT(0.0),
+    m_tableHP(0.0),
+    m_tableNT(0),
+    m_tableNP(0),
+    m_tableRtol(0.0),
+    m_tableError(0.0)
 {
     m_phi = new WaterPropsIAPWSphi();
 }
@@ -50,7 +100,17 @@ WaterPropsIAPWS::WaterPropsIAPWS(const WaterPropsIAPWS& b) :
     m_phi(0),
     tau(b.tau),
     delta(b.delta),
-    iState(b.iState)
+    iState(b.iState),
+    m_useTable(b.m_useTable),
+    m_tableTmin(b.m_tableTmin),
+    m_tableHT(b.m_tableHT),
+    m_tableHP(b.m_tableHP),
+    m_tableNT(b.m_tableNT),
+    m_tableNP(b.m_tableNP),
+    m_tableRtol(b.m_tableRtol),
+    m_tableError(b.m_tableError),
+    m_tablePsat(b.m_tablePsat),
+    m_tableDelta(b.m_tableDelta)
 {
     m_phi = new WaterPropsIAPWSphi();
     m_phi->tdpolycalc(tau, delta);
@@ -64,6 +124,16 @@ WaterPropsIAPWS& WaterPropsIAPWS::operator=(const WaterPropsIAPWS& b)
     tau = b.tau;
     delta = b.delta;
     iState = b.iState;
+    m_useTable = b.m_useTable;
+    m_tableTmin = b.m_tableTmin;
+    m_tableHT = b.m_tableHT;
+    m_tableHP = b.m_tableHP;
+    m_tableNT = b.m_tableNT;
+    m_tableNP = b.m_tableNP;
+    m_tableRtol = b.m_tableRtol;
+    m_tableError = b.m_tableError;
+    m_tablePsat = b.m_tablePsat;
+    m_tableDelta = b.m_tableDelta;
     m_phi->tdpolycalc(tau, delta);
     return *this;
 }
@@ -111,6 +181,18 @@ doublereal  WaterPropsIAPWS::pressure() const
 doublereal WaterPropsIAPWS::density(doublereal temperature, doublereal pressure,
                                     int phase, doublereal rhoguess)
 {
+    if (phase == WATER_LIQUID && (rhoguess == -1.0 || rhoguess > Rho_c)) {
+        doublereal dd = interpolateDelta(temperature, pressure);
+        if (dd > 0.0) {
+            doublereal p_red = pressure * M_water / (Rgas * temperature * Rho_c);
+            doublereal ddNew = m_phi->dfindStep(p_red, T_c / temperature, dd);
+            if (fabs(ddNew - dd) <= m_tableRtol * dd) {
+                setState_TR(temperature, ddNew * Rho_c);
+                return ddNew * Rho_c;
+            }
+        }
+    }
+
     doublereal deltaGuess = 0.0;
     if (rhoguess == -1.0) {
         if (phase != -1) {
@@ -229,6 +311,132 @@ doublereal WaterPropsIAPWS::density_const(doublereal pressure,
     return density_retn;
 }
 
+void WaterPropsIAPWS::setDensityTabulation(doublereal Tmin, doublereal Tmax,
+                                           doublereal Pmax, doublereal rtol,
+                                           size_t maxSize)
+{
+    if (Tmin < 273.16 || Tmax >= T_c || Tmin >= Tmax) {
+        throw CanteraError("WaterPropsIAPWS::setDensityTabulation",
+                           "Temperature range " + fp2str(Tmin) + " - " +
+                           fp2str(Tmax) + " K must be between 273.16 K and "
+                           "the critical temperature");
+    }
+    doublereal Pspan = Pmax - psat_est(Tmin);
+    if (Pspan <= 0.0) {
+        throw CanteraError("WaterPropsIAPWS::setDensityTabulation",
+                           "Pmax is below the saturation pressure at Tmin");
+    }
+    disableDensityTabulation();
+    doublereal tauSave = tau;
+    doublereal deltaSave = delta;
+
+    size_t nT = 9, nP = 9;
+    double wT[4], wP[4];
+    while (true) {
+        m_tableTmin = Tmin;
+        m_tableHT = (Tmax - Tmin) / (nT - 1);
+        m_tableHP = Pspan / (nP - 1);
+        m_tablePsat.resize(nT);
+        m_tableDelta.resize(nT * nP);
+        for (size_t j = 0; j < nT; j++) {
+            double T = Tmin + j * m_tableHT;
+            m_tablePsat[j] = psat_est(T);
+            for (size_t i = 0; i < nP; i++) {
+                m_tableDelta[j * nP + i] =
+                    liquidDelta(*this, T, m_tablePsat[j] + i * m_tableHP);
+            }
+        }
+
+        // Compare the exact and interpolated values at the midpoints between
+        // the tabulated temperatures, and between the tabulated pressures
+        double errT = 0.0;
+        for (size_t j = 0; j < nT - 1; j++) {
+            size_t jj = cubicStencil(j + 0.5, nT, wT);
+            const double* ps = &m_tablePsat[jj];
+            double psat = wT[0] * ps[0] + wT[1] * ps[1] + wT[2] * ps[2] +
+                          wT[3] * ps[3];
+            for (size_t i = 0; i < nP; i++) {
+                double exact = liquidDelta(*this, Tmin + (j + 0.5) * m_tableHT,
+                                           psat + i * m_tableHP);
+                size_t ii = cubicStencil(i, nP, wP);
+                double interp = interpolateTable(&m_tableDelta[0], nP, jj, wT,
+                                                 ii, wP);
+                errT = std::max(errT, fabs(interp - exact) / exact);
+            }
+        }
+        double errP = 0.0;
+        for (size_t j = 0; j < nT; j++) {
+            size_t jj = cubicStencil(j, nT, wT);
+            for (size_t i = 0; i < nP - 1; i++) {
+                double exact = liquidDelta(*this, Tmin + j * m_tableHT,
+                    m_tablePsat[j] + (i + 0.5) * m_tableHP);
+                size_t ii = cubicStencil(i + 0.5, nP, wP);
+                double interp = interpolateTable(&m_tableDelta[0], nP, jj, wT,
+                                                 ii, wP);
+                errP = std::max(errP, fabs(interp - exact) / exact);
+            }
+        }
+        m_tableError = std::max(errT, errP);
+        if (m_tableError <= rtol) {
+            break;
+        }
+        if ((errT > rtol && 2 * nT - 1 > maxSize) ||
+            (errP > rtol && 2 * nP - 1 > maxSize)) {
+            disableDensityTabulation();
+            throw CanteraError("WaterPropsIAPWS::setDensityTabulation",
+                "relative interpolation error " + fp2str(std::max(errT, errP)) +
+                " with " + int2str(nT) + " temperatures and " + int2str(nP) +
+                " pressures exceeds the tolerance");
+        }
+        if (errT > rtol) {
+            nT = 2 * nT - 1;
+        }
+        if (errP > rtol) {
+            nP = 2 * nP - 1;
+        }
+    }
+    m_tableNT = nT;
+    m_tableNP = nP;
+    m_tableRtol = rtol;
+    m_useTable = true;
+
+    if (tauSave > 0.0) {
+        setState_TR(T_c / tauSave, deltaSave * Rho_c);
+    }
+}
+
+void WaterPropsIAPWS::disableDensityTabulation()
+{
+    m_useTable = false;
+    m_tableNT = 0;
+    m_tableNP = 0;
+    m_tableError = 0.0;
+    m_tablePsat.clear();
+    m_tableDelta.clear();
+}
+
+doublereal WaterPropsIAPWS::interpolateDelta(doublereal temperature,
+                                             doublereal pressure) const
+{
+    if (!m_useTable) {
+        return -1.0;
+    }
+    double s = (temperature - m_tableTmin) / m_tableHT;
+    if (s < 0.0 || s > m_tableNT - 1.0) {
+        return -1.0;
+    }
+    double wT[4], wP[4];
+    size_t j = cubicStencil(s, m_tableNT, wT);
+    const double* ps = &m_tablePsat[j];
+    double r = (pressure - (wT[0] * ps[0] + wT[1] * ps[1] + wT[2] * ps[2] +
+                            wT[3] * ps[3])) / m_tableHP;
+    if (r < 0.0 || r > m_tableNP - 1.0) {
+        return -1.0;
+    }
+    size_t i = cubicStencil(r, m_tableNP, wP);
+    return interpolateTable(&m_tableDelta[0], m_tableNP, j, wT, i, wP);
+}
+
 doublereal WaterPropsIAPWS::density() const
 {
     return delta * Rho_c;
@@ -363,7 +571,7 @@ void WaterPropsIAPWS::corr1(doublereal temperature, doublereal pressure,
 
 doublereal WaterPropsIAPWS::psat(doublereal temperature, int waterState)
 {
-    static int method = 1;
+    const int method = 1;
     doublereal densLiq = -1.0, densGas = -1.0, delGRT = 0.0;
     doublereal dp, pcorr;
     if (temperature >= T_c) {
@@ -1016,6 +1016,7 @@ doublereal  WaterPropsIAPWSphi::dfind(doublereal  p_red, doublereal  tau, double
     doublereal  dd = deltaGuess;
     bool conv = false;
     doublereal  deldd = dd;
+    doublereal  lastStep = 1.0;
     doublereal  pcheck = 1.0E-30 + 1.0E-8 * p_red;
     for (int n = 0; n < 200; n++) {
         /*
@@ -1042,6 +1043,7 @@ doublereal  WaterPropsIAPWSphi::dfind(doublereal  p_red, doublereal  tau, double
          * the initial guess outwards and start a new iteration.
          */
         if (dpddelta <= 0.0) {
+            lastStep = 1.0;
             if (deltaGuess > 1.0) {
                 dd = dd * 1.05;
             }
@@ -1080,7 +1082,8 @@ doublereal  WaterPropsIAPWSphi::dfind(doublereal  p_red, doublereal  tau, double
          * updated the reduced density value
          */
         dd = dd + deldd;
-        if (fabs(deldd/dd) < 1.0E-14) {
+        lastStep = fabs(deldd/dd);
+        if (lastStep < 1.0E-14) {
             conv = true;
             break;
         }
@@ -1092,14 +1095,30 @@ doublereal  WaterPropsIAPWSphi::dfind(doublereal  p_red, doublereal  tau, double
         }
     }
     /*
-     * Check for convergence, and return 0.0 if it wasn't achieved.
+     * Check for convergence, and return 0.0 if it wasn't achieved. For
+     * the liquid at low pressures, neither of the tests above may be
+     * satisfied because of round-off errors, so also accept a density
+     * for which the last update was negligible.
      */
-    if (! conv) {
+    if (! conv && lastStep > 1.0E-12) {
         dd = 0.0;
     }
     return dd;
 }
 
+doublereal WaterPropsIAPWSphi::dfindStep(doublereal p_red, doublereal tau,
+                                         doublereal delta)
+{
+    tdpolycalc(tau, delta);
+    doublereal q1 = phiR_d();
+    doublereal q2 = phiR_dd();
+    doublereal dpddelta = 1.0 + 2.0 * delta * q1 + delta * delta * q2;
+    if (dpddelta <= 0.0) {
+        return -1.0;
+    }
+    return delta - (delta + delta * delta * q1 - p_red) / dpddelta;
+}
+
 doublereal  WaterPropsIAPWSphi::gibbs_RT() const
 {
     doublereal  delta = DELTAsave;
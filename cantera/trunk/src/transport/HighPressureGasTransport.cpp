@@ -262,11 +262,8 @@ void HighPressureGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* c
     // Having corrected m_bdiff for pressure and concentration effects, the
     //    routine now procedes the same as in the low-pressure case:
 
-    // evaluate L0000 if the temperature or concentrations have
-    // changed since it was last evaluated.
-    if (!m_l0000_ok) {
-        eval_L0000(DATA_PTR(molefracs));
-    }
+    // evaluate L0000 with the corrected binary diffusion coefficients
+    eval_L0000(DATA_PTR(molefracs));
 
     // invert L00,00
     int ierr = invert(m_Lmatrix, m_nsp);
@@ -274,7 +271,8 @@ void HighPressureGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* c
         throw CanteraError("HighPressureGasTransport::getMultiDiffCoeffs",
                             string(" invert returned ierr = ")+int2str(ierr));
     }
-    m_l0000_ok = false;           // matrix is overwritten by inverse
+    // The inverse differs from the low-pressure one used by MultiTransport
+    m_l0000_inv_ok = false;
     m_lmatrix_soln_ok = false;
 
     doublereal pres = m_thermo->pressure();
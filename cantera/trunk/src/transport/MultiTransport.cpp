@@ -9,6 +9,7 @@
 
 #include "cantera/transport/MultiTransport.h"
 #include "cantera/thermo/IdealGasPhase.h"
+#include "cantera/numerics/ctlapack.h"
 #include "cantera/base/stringUtils.h"
 
 using namespace std;
@@ -44,7 +45,13 @@ void MultiTransport::init(ThermoPhase* thermo, int mode, int log_level)
     GasTransport::init(thermo, mode, log_level);
 
     // the L matrix
-    m_Lmatrix.resize(3*m_nsp, 3*m_nsp);
+    m_Lmatrix.resize(m_nsp, m_nsp);
+    m_L0010.resize(m_nsp, m_nsp);
+    m_L1010.resize(m_nsp, m_nsp);
+    m_L0010_solved.resize(m_nsp, m_nsp);
+    m_L1001.resize(m_nsp, m_nsp);
+    m_L1001_scaled.resize(m_nsp, m_nsp);
+    m_L0101.resize(m_nsp);
     m_a.resize(3*m_nsp, 1.0);
     m_b.resize(3*m_nsp, 0.0);
     m_aa.resize(m_nsp, m_nsp, 0.0);
@@ -62,7 +69,7 @@ void MultiTransport::init(ThermoPhase* thermo, int mode, int log_level)
 
     // set flags all false
     m_abc_ok = false;
-    m_l0000_ok = false;
+    m_l0000_inv_ok = false;
     m_lmatrix_soln_ok = false;
 
     m_thermal_tlast = 0.0;
@@ -115,6 +122,7 @@ void MultiTransport::getThermalDiffCoeffs(doublereal* const dt)
 void MultiTransport::solveLMatrixEquation()
 {
     // if T has changed, update the temperature-dependent properties.
+    update_T();
     updateThermal_T();
     update_C();
     if (m_lmatrix_soln_ok) {
@@ -122,9 +130,7 @@ void MultiTransport::solveLMatrixEquation()
     }
 
     // Copy the mole fractions twice into the last two blocks of
-    // the right-hand-side vector m_b. The first block of m_b was
-    // set to zero when it was created, and is not modified so
-    // doesn't need to be reset to zero.
+    // the right-hand-side vector m_b. The first block of m_b is zero.
     for (size_t k = 0; k < m_nsp; k++) {
         m_b[k] = 0.0;
         m_b[k + m_nsp] = m_molefracs[k];
@@ -132,12 +138,9 @@ void MultiTransport::solveLMatrixEquation()
     }
 
     // Set the right-hand side vector to zero in the 3rd block for
-    // all species with no internal energy modes.  The
-    // corresponding third-block rows and columns will be set to
-    // zero, except on the diagonal of L01,01, where they are set
-    // to 1.0. This has the effect of eliminating these equations
-    // from the system, since the equation becomes: m_a[2*m_nsp +
-    // k] = 0.0.
+    // all species with no internal energy modes. The corresponding
+    // unknowns are then zero, and these equations are dropped from the
+    // system.
 
     // Note that this differs from the Chemkin procedure, where
     // all *monatomic* species are excluded. Since monatomic
@@ -150,36 +153,74 @@ void MultiTransport::solveLMatrixEquation()
         }
     }
 
-    // evaluate the submatrices of the L matrix
-    m_Lmatrix.resize(3*m_nsp, 3*m_nsp, 0.0);
-
-    //! Evaluate the upper-left block of the L matrix.
-    eval_L0000(DATA_PTR(m_molefracs));
+    // evaluate the submatrices of the L matrix. The blocks L00,01 and
+    // L01,00 are zero, L10,00 and L01,10 are the transposes of L00,10 and
+    // L10,01, and L01,01 is diagonal, so only L00,00 (as its inverse), L00,10,
+    // L10,10, L10,01 and the diagonal of L01,01 are stored.
+    invert_L0000();
     eval_L0010(DATA_PTR(m_molefracs));
-    eval_L0001();
-    eval_L1000();
     eval_L1010(DATA_PTR(m_molefracs));
     eval_L1001(DATA_PTR(m_molefracs));
-    eval_L0100();
-    eval_L0110();
     eval_L0101(DATA_PTR(m_molefracs));
 
-    // Solve it using GMRES or LU decomposition. The last solution
-    // in m_a should provide a good starting guess, so convergence
-    // should be fast.
+    // Eliminate the internal energy unknowns a2 = (b2 - L01,10*a1) / L01,01
+    // from the equations for the second block. Species without internal
+    // modes have a2 = 0 and are skipped.
+    copy(m_b.begin(), m_b.begin() + 2*m_nsp, m_a.begin());
+    for (size_t j = 0; j < m_nsp; j++) {
+        doublereal rdiag = hasInternalModes(j) ? 1.0 / m_L0101[j] : 0.0;
+        doublereal bj = m_b[j + 2*m_nsp];
+        for (size_t i = 0; i < m_nsp; i++) {
+            m_L1001_scaled(i,j) = rdiag * m_L1001(i,j);
+            m_a[i + m_nsp] -= m_L1001_scaled(i,j) * bj;
+        }
+    }
+    ct_dgemm(ctlapack::NoTranspose, ctlapack::Transpose, m_nsp, m_nsp, m_nsp,
+             -1.0, m_L1001_scaled.ptrColumn(0), m_nsp, m_L1001.ptrColumn(0),
+             m_nsp, 1.0, m_L1010.ptrColumn(0), m_nsp);
+
+    // The first block of the right-hand side is zero, so a0 = -L00,00^-1 *
+    // L00,10 * a1. Eliminating a0 as well leaves a system of size K for a1,
+    // which is solved by LU decomposition. The inverse of L00,00 is shared
+    // with getMultiDiffCoeffs(), so that evaluating both the multicomponent
+    // diffusion coefficients and the thermal conductivity at a state takes
+    // one inversion and one LU decomposition of size K, instead of an
+    // inversion of size K and an LU decomposition of size 2K.
+    ct_dgemm(ctlapack::NoTranspose, ctlapack::NoTranspose, m_nsp, m_nsp,
+             m_nsp, 1.0, m_Lmatrix.ptrColumn(0), m_nsp, m_L0010.ptrColumn(0),
+             m_nsp, 0.0, m_L0010_solved.ptrColumn(0), m_nsp);
+    ct_dgemm(ctlapack::Transpose, ctlapack::NoTranspose, m_nsp, m_nsp, m_nsp,
+             -1.0, m_L0010.ptrColumn(0), m_nsp, m_L0010_solved.ptrColumn(0),
+             m_nsp, 1.0, m_L1010.ptrColumn(0), m_nsp);
 
-    copy(m_b.begin(), m_b.end(), m_a.begin());
     try {
-        solve(m_Lmatrix, DATA_PTR(m_a));
+        solve(m_L1010, DATA_PTR(m_a) + m_nsp);
     } catch (CanteraError& err) {
         err.save();
         throw CanteraError("MultiTransport::solveLMatrixEquation",
                            "error in solving L matrix.");
     }
+    for (size_t i = 0; i < m_nsp; i++) {
+        doublereal sum = 0.0;
+        for (size_t j = 0; j < m_nsp; j++) {
+            sum -= m_L0010_solved(i,j) * m_a[j + m_nsp];
+        }
+        m_a[i] = sum;
+    }
+
+    // back-substitute for the internal energy unknowns
+    for (size_t j = 0; j < m_nsp; j++) {
+        doublereal sum = 0.0;
+        if (hasInternalModes(j)) {
+            sum = m_b[j + 2*m_nsp] / m_L0101[j];
+            for (size_t i = 0; i < m_nsp; i++) {
+                sum -= m_L1001_scaled(i,j) * m_a[i + m_nsp];
+            }
+        }
+        m_a[j + 2*m_nsp] = sum;
+    }
+
     m_lmatrix_soln_ok = true;
-    m_molefracs_last = m_molefracs;
-    // L matrix is overwritten with LU decomposition
-    m_l0000_ok = false;
 }
 
 void MultiTransport::getSpeciesFluxes(size_t ndim, const doublereal* const grad_T,
@@ -404,20 +445,9 @@ void MultiTransport::getMultiDiffCoeffs(const size_t ld, doublereal* const d)
     update_T();
     updateThermal_T();
 
-    // evaluate L0000 if the temperature or concentrations have
-    // changed since it was last evaluated.
-    if (!m_l0000_ok) {
-        eval_L0000(DATA_PTR(m_molefracs));
-    }
-
-    // invert L00,00
-    int ierr = invert(m_Lmatrix, m_nsp);
-    if (ierr != 0) {
-        throw CanteraError("MultiTransport::getMultiDiffCoeffs",
-                           string(" invert returned ierr = ")+int2str(ierr));
-    }
-    m_l0000_ok = false;           // matrix is overwritten by inverse
-    m_lmatrix_soln_ok = false;
+    // invert L00,00 if the temperature or concentrations have changed since
+    // it was last inverted.
+    invert_L0000();
 
     doublereal prefactor = 16.0 * m_temp
                            * m_thermo->meanMolecularWeight()/(25.0 * p);
@@ -444,7 +474,7 @@ void MultiTransport::update_T()
     // redone, and the L matrix reevaluated.
     m_abc_ok  = false;
     m_lmatrix_soln_ok = false;
-    m_l0000_ok = false;
+    m_l0000_inv_ok = false;
 }
 
 void MultiTransport::update_C()
@@ -458,7 +488,7 @@ void MultiTransport::update_C()
         if (m_molefracs[k] != m_molefracs_last[k]) {
             // If any mole fractions have changed, signal that concentration-
             // dependent quantities will need to be recomputed before use.
-            m_l0000_ok = false;
+            m_l0000_inv_ok = false;
             m_lmatrix_soln_ok = false;
         }
     }
@@ -564,6 +594,22 @@ void MultiTransport::eval_L0000(const doublereal* const x)
     }
 }
 
+void MultiTransport::invert_L0000()
+{
+    if (m_l0000_inv_ok) {
+        return;
+    }
+    eval_L0000(DATA_PTR(m_molefracs));
+    int ierr = invert(m_Lmatrix);
+    if (ierr != 0) {
+        throw CanteraError("MultiTransport::invert_L0000",
+                           string(" invert returned ierr = ")+int2str(ierr));
+    }
+    m_l0000_inv_ok = true;
+    // The mole fractions are compared to these in update_C()
+    m_molefracs_last = m_molefracs;
+}
+
 void MultiTransport::eval_L0010(const doublereal* const x)
 {
     doublereal prefactor = 1.6*m_temp;
@@ -574,24 +620,15 @@ void MultiTransport::eval_L0010(const doublereal* const x)
         wj = m_mw[j];
         sum = 0.0;
         for (size_t i = 0; i < m_nsp; i++) {
-            m_Lmatrix(i,j + m_nsp) = - prefactor * x[i] * xj * m_mw[i] *
+            m_L0010(i,j) = - prefactor * x[i] * xj * m_mw[i] *
                                      (1.2 * m_cstar(j,i) - 1.0) /
                                      ((wj + m_mw[i]) * m_bdiff(j,i));
 
             //  the next term is independent of "j";
             //  need to do it for the "j,j" term
-            sum -= m_Lmatrix(i,j+m_nsp);
-        }
-        m_Lmatrix(j,j+m_nsp) += sum;
-    }
-}
-
-void MultiTransport::eval_L1000()
-{
-    for (size_t j = 0; j < m_nsp; j++) {
-        for (size_t i = 0; i < m_nsp; i++) {
-            m_Lmatrix(i+m_nsp,j) = m_Lmatrix(j,i+m_nsp);
+            sum -= m_L0010(i,j);
         }
+        m_L0010(j,j) += sum;
     }
 }
 
@@ -624,7 +661,7 @@ void MultiTransport::eval_L1010(const doublereal* x)
                                          (constant3 +
                                           (m_crot[i]/m_rotrelax[i])));   //  see Eq. (12.125)
 
-            m_Lmatrix(i+m_nsp,j+m_nsp) = constant1*x[i]*m_mw[i] /(m_mw[j]*term1) *
+            m_L1010(i,j) = constant1*x[i]*m_mw[i] /(m_mw[j]*term1) *
                                          (constant2 - threemjsq*m_bstar(i,j)
                                           - term2*m_mw[j]);
 
@@ -633,7 +670,7 @@ void MultiTransport::eval_L1010(const doublereal* x)
                     (6.25 - 3.0*m_bstar(i,j)) + term2*m_mw[i]);
         }
 
-        m_Lmatrix(j+m_nsp,j+m_nsp) -= sum*constant1;
+        m_L1010(j,j) -= sum*constant1;
     }
 }
 
@@ -641,8 +678,6 @@ void MultiTransport::eval_L1001(const doublereal* x)
 {
     doublereal prefactor = 32.00*m_temp/(5.00*Pi);
     doublereal constant, sum;
-    size_t n2 = 2*m_nsp;
-    int npoly = 0;
     for (size_t j = 0; j < m_nsp; j++) {
         //        collect terms that depend only on "j"
         if (hasInternalModes(j)) {
@@ -650,55 +685,25 @@ void MultiTransport::eval_L1001(const doublereal* x)
             sum = 0.0;
             for (size_t i = 0; i < m_nsp; i++) {
                 //           see Eq. (12.127)
-                m_Lmatrix(i+m_nsp,j+n2) = constant * m_astar(j,i) * x[i] /
-                                          ((m_mw[j] + m_mw[i]) * m_bdiff(j,i));
-                sum += m_Lmatrix(i+m_nsp,j+n2);
+                m_L1001(i,j) = constant * m_astar(j,i) * x[i] /
+                               ((m_mw[j] + m_mw[i]) * m_bdiff(j,i));
+                sum += m_L1001(i,j);
             }
-            npoly++;
-            m_Lmatrix(j+m_nsp,j+n2) += sum;
+            m_L1001(j,j) += sum;
         } else {
             for (size_t i = 0; i < m_nsp; i++) {
-                m_Lmatrix(i+m_nsp,j+n2) = 0.0;
+                m_L1001(i,j) = 0.0;
             }
         }
     }
 }
 
-void MultiTransport::eval_L0001()
-{
-    size_t n2 = 2*m_nsp;
-    for (size_t j = 0; j < m_nsp; j++) {
-        for (size_t i = 0; i < m_nsp; i++) {
-            m_Lmatrix(i,j+n2) = 0.0;
-        }
-    }
-}
-
-void MultiTransport::eval_L0100()
-{
-    size_t n2 = 2*m_nsp;
-    for (size_t j = 0; j < m_nsp; j++)
-        for (size_t i = 0; i < m_nsp; i++) {
-            m_Lmatrix(i+n2,j) = 0.0;    //  see Eq. (12.123)
-        }
-}
-
-void MultiTransport::eval_L0110()
-{
-    size_t n2 = 2*m_nsp;
-    for (size_t j = 0; j < m_nsp; j++)
-        for (size_t i = 0; i < m_nsp; i++) {
-            m_Lmatrix(i+n2,j+m_nsp) = m_Lmatrix(j+m_nsp,i+n2);    //  see Eq. (12.123)
-        }
-}
-
 void MultiTransport::eval_L0101(const doublereal* x)
 {
     const doublereal fivepi = 5.00*Pi;
     const doublereal eightoverpi = 8.0 / Pi;
 
     doublereal prefactor = 4.00*m_temp;
-    size_t n2 = 2*m_nsp;
     doublereal constant1, constant2, diff_int, sum;
     for (size_t i = 0; i < m_nsp; i++) {
         if (hasInternalModes(i)) {
@@ -710,20 +715,17 @@ void MultiTransport::eval_L0101(const doublereal* x)
             for (size_t k = 0; k < m_nsp; k++) {
                 //           see Eq. (12.131)
                 diff_int = m_bdiff(i,k);
-                m_Lmatrix(k+n2,i+n2) = 0.0;
                 sum += x[k]/diff_int;
                 if (k != i) sum += x[k]*m_astar(i,k)*constant2 /
                                        (m_mw[k]*diff_int);
             }
             //        see Eq. (12.130)
-            m_Lmatrix(i+n2,i+n2) =
+            m_L0101[i] =
                 - eightoverpi*m_mw[i]*x[i]*x[i]*m_crot[i] /
                 (m_cinternal[i]*m_cinternal[i]*GasConstant*m_visc[i]*m_rotrelax[i])
                 - constant1*sum;
         } else {
-            for (size_t k = 0; k < m_nsp; k++) {
-                m_Lmatrix(i+n2,i+n2) = 1.0;
-            }
+            m_L0101[i] = 1.0;
         }
     }
 }
@@ -118,6 +118,20 @@ void FlowReactor::evalEqs(doublereal time, doublereal* y,
     }
 }
 
+bool FlowReactor::getMultiplierDerivativeProducts(doublereal t,
+        const doublereal* lambda, doublereal* prod)
+{
+    m_thermo->restoreState(m_state);
+    const vector_fp& mw = m_thermo->molecularWeights();
+    doublereal rrho = 1.0/m_thermo->density();
+    vector_fp w(m_nsp);
+    for (size_t k = 0; k < m_nsp; k++) {
+        w[k] = lambda[k+2] * mw[k] * rrho;
+    }
+    multiplierProducts(&w[0], prod);
+    return true;
+}
+
 size_t FlowReactor::componentIndex(const string& nm) const
 {
     // check for a gas species name
@@ -52,6 +52,7 @@ void IdealGasConstPressureReactor::initialize(doublereal t0)
 {
     ConstPressureReactor::initialize(t0);
     m_hk.resize(m_nsp, 0.0);
+    m_cpk.resize(m_nsp, 0.0);
 }
 
 void IdealGasConstPressureReactor::updateState(doublereal* y)
@@ -133,6 +134,142 @@ void IdealGasConstPressureReactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+bool IdealGasConstPressureReactor::getJacobian(doublereal t,
+                                               doublereal* params,
+                                               Array2D& J)
+{
+    // Surface chemistry is not included
+    if (m_nv != m_nsp + 2) {
+        return false;
+    }
+
+    m_thermo->restoreState(m_state);
+    double T = m_thermo->temperature();
+    double cp = m_thermo->cp_mass();
+
+    // temperature derivative of cp, by a one-sided difference
+    double dT = 1.0e-6 * T;
+    m_thermo->setTemperature(T + dT);
+    double dcpdT = (m_thermo->cp_mass() - cp) / dT;
+    m_thermo->restoreState(m_state);
+
+    applySensitivity(params);
+    m_thermo->getPartialMolarEnthalpies(&m_hk[0]);
+    m_thermo->getPartialMolarCp(&m_cpk[0]);
+    const vector_fp& mw = m_thermo->molecularWeights();
+    const doublereal* Y = m_thermo->massFractions();
+    vector_fp C(m_nsp), X(m_nsp);
+    m_thermo->getConcentrations(&C[0]);
+    m_thermo->getMoleFractions(&X[0]);
+    double rho = m_thermo->density();
+    double Wmean = m_thermo->meanMolecularWeight();
+
+    m_dwdot_dC.resize(m_nsp * m_nsp);
+    m_dwdot_dT.resize(m_nsp);
+    if (m_chem) {
+        m_kin->getNetProductionRates(&m_wdot[0]);
+        m_kin->getNetProductionRates_ddC(&m_dwdot_dC[0]);
+        m_kin->getNetProductionRates_ddT(&m_dwdot_dT[0]);
+    } else {
+        fill(m_wdot.begin(), m_wdot.end(), 0.0);
+        fill(m_dwdot_dC.begin(), m_dwdot_dC.end(), 0.0);
+        fill(m_dwdot_dT.begin(), m_dwdot_dT.end(), 0.0);
+    }
+    const double* dwdC = &m_dwdot_dC[0];
+    evalWalls(t);
+
+    // Total mass flow rate of the inlets, and the mass flow rates of each
+    // species and the enthalpy carried by the inlets
+    double mdot_in = 0.0, Hdot_in = 0.0;
+    vector_fp mdot_k(m_nsp, 0.0);
+    for (size_t i = 0; i < m_inlet.size(); i++) {
+        double mdot = m_inlet[i]->massFlowRate(t);
+        mdot_in += mdot;
+        Hdot_in += m_inlet[i]->enthalpy_mass() * mdot;
+        for (size_t k = 0; k < m_nsp; k++) {
+            mdot_k[k] += m_inlet[i]->outletSpeciesMassFlowRate(k);
+        }
+    }
+
+    // At constant pressure, the concentrations vary with temperature as 1/T
+    // and with the mass fractions through the mean molecular weight. These
+    // derivatives are expressed in terms of DC[k] = sum_j (d wdot_k / d C_j)
+    // * C_j and DX[k] = sum_j (d wdot_k / d C_j) * X_j.
+    vector_fp DC(m_nsp, 0.0), DX(m_nsp, 0.0);
+    for (size_t j = 0; j < m_nsp; j++) {
+        for (size_t k = 0; k < m_nsp; k++) {
+            DC[k] += dwdC[k + m_nsp*j] * C[j];
+            DX[k] += dwdC[k + m_nsp*j] * X[j];
+        }
+    }
+
+    double m = m_mass;
+    double V = m_vol;
+    J.zero();
+
+    // species equations
+    vector_fp dwdT(m_nsp);
+    double H = 0.0; // volumetric heat release rate
+    for (size_t k = 0; k < m_nsp; k++) {
+        dwdT[k] = m_dwdot_dT[k] - DC[k] / T;
+        H += m_wdot[k] * m_hk[k];
+        double WV_m = mw[k] * V / m;
+        J(k+2, 0) = -(mdot_k[k] - mdot_in * Y[k]) / (m * m);
+        J(k+2, 1) = WV_m * (dwdT[k] + m_wdot[k] / T);
+        for (size_t j = 0; j < m_nsp; j++) {
+            J(k+2, j+2) = (mw[k] * (dwdC[k + m_nsp*j] - DX[k])
+                           + m_wdot[k] * WV_m * Wmean) / mw[j];
+        }
+        J(k+2, k+2) -= mdot_in / m;
+    }
+
+    // energy equation, dT/dt = N / (m * cp)
+    if (m_energy) {
+        double N = Hdot_in - m_Q - V * H;
+        double dNdm = -V * H / m;
+        double dNdT = -V * H / T;
+        for (size_t k = 0; k < m_nsp; k++) {
+            N -= m_hk[k] / mw[k] * mdot_k[k];
+            dNdT -= V * (dwdT[k] * m_hk[k] + m_wdot[k] * m_cpk[k])
+                    + m_cpk[k] / mw[k] * mdot_k[k];
+        }
+        double mcp = m * cp;
+        double dTdt = N / mcp;
+        J(1, 0) = (dNdm - dTdt * cp) / mcp;
+        J(1, 1) = (dNdT - dTdt * m * dcpdT) / mcp;
+        for (size_t j = 0; j < m_nsp; j++) {
+            double dNdY = -V * Wmean * H;
+            for (size_t k = 0; k < m_nsp; k++) {
+                dNdY -= V * rho * m_hk[k] * (dwdC[k + m_nsp*j] - DX[k]);
+            }
+            dNdY /= mw[j];
+            J(1, j+2) = (dNdY - dTdt * m * m_cpk[j] / mw[j]) / mcp;
+        }
+    }
+
+    resetSensitivity(params);
+    return true;
+}
+
+bool IdealGasConstPressureReactor::getMultiplierDerivativeProducts(
+        doublereal t, const doublereal* lambda, doublereal* prod)
+{
+    m_thermo->restoreState(m_state);
+    m_thermo->getPartialMolarEnthalpies(&m_hk[0]);
+    const vector_fp& mw = m_thermo->molecularWeights();
+    double mcp = m_mass * m_thermo->cp_mass();
+    vector_fp w(m_nsp);
+    for (size_t k = 0; k < m_nsp; k++) {
+        w[k] = lambda[k+2] * mw[k] * m_vol / m_mass;
+        if (m_energy) {
+            // heat release
+            w[k] -= lambda[1] * m_hk[k] * m_vol / mcp;
+        }
+    }
+    multiplierProducts(&w[0], prod);
+    return true;
+}
+
 size_t IdealGasConstPressureReactor::componentIndex(const string& nm) const
 {
     size_t k = speciesIndex(nm);
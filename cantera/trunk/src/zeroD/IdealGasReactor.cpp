@@ -52,6 +52,7 @@ void IdealGasReactor::initialize(doublereal t0)
 {
     Reactor::initialize(t0);
     m_uk.resize(m_nsp, 0.0);
+    m_cvk.resize(m_nsp, 0.0);
 }
 
 void IdealGasReactor::updateState(doublereal* y)
@@ -150,6 +151,145 @@ void IdealGasReactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+bool IdealGasReactor::getJacobian(doublereal t, doublereal* params,
+                                  Array2D& J)
+{
+    // Surface chemistry is not included
+    if (m_nv != m_nsp + 3) {
+        return false;
+    }
+
+    m_thermo->restoreState(m_state);
+    double T = m_thermo->temperature();
+    double cv = m_thermo->cv_mass();
+
+    // temperature derivative of cv, by a one-sided difference
+    double dT = 1.0e-6 * T;
+    m_thermo->setTemperature(T + dT);
+    double dcvdT = (m_thermo->cv_mass() - cv) / dT;
+    m_thermo->restoreState(m_state);
+
+    applySensitivity(params);
+    m_thermo->getPartialMolarIntEnergies(&m_uk[0]);
+    m_thermo->getPartialMolarCp(&m_cvk[0]);
+    for (size_t k = 0; k < m_nsp; k++) {
+        m_cvk[k] -= GasConstant;
+    }
+    const vector_fp& mw = m_thermo->molecularWeights();
+    const doublereal* Y = m_thermo->massFractions();
+    vector_fp C(m_nsp);
+    m_thermo->getConcentrations(&C[0]);
+
+    m_dwdot_dC.resize(m_nsp * m_nsp);
+    m_dwdot_dT.resize(m_nsp);
+    if (m_chem) {
+        m_kin->getNetProductionRates(&m_wdot[0]);
+        m_kin->getNetProductionRates_ddC(&m_dwdot_dC[0]);
+        m_kin->getNetProductionRates_ddT(&m_dwdot_dT[0]);
+    } else {
+        fill(m_wdot.begin(), m_wdot.end(), 0.0);
+        fill(m_dwdot_dC.begin(), m_dwdot_dC.end(), 0.0);
+        fill(m_dwdot_dT.begin(), m_dwdot_dT.end(), 0.0);
+    }
+    const double* dwdC = &m_dwdot_dC[0];
+    evalWalls(t);
+
+    // Total mass flow rates of the outlets and inlets, and the mass flow
+    // rates of each species and the enthalpy carried by the inlets
+    double mdot_out = 0.0, mdot_in = 0.0, Hdot_in = 0.0;
+    vector_fp mdot_k(m_nsp, 0.0);
+    for (size_t i = 0; i < m_outlet.size(); i++) {
+        mdot_out += m_outlet[i]->massFlowRate(t);
+    }
+    for (size_t i = 0; i < m_inlet.size(); i++) {
+        double mdot = m_inlet[i]->massFlowRate(t);
+        mdot_in += mdot;
+        Hdot_in += m_inlet[i]->enthalpy_mass() * mdot;
+        for (size_t k = 0; k < m_nsp; k++) {
+            mdot_k[k] += m_inlet[i]->outletSpeciesMassFlowRate(k);
+        }
+    }
+
+    // The concentrations are proportional to m/V, so the derivatives of
+    // the production rates with respect to m and V are proportional to
+    // DC[k] = sum_j (d wdot_k / d C_j) * C_j
+    vector_fp DC(m_nsp, 0.0);
+    for (size_t j = 0; j < m_nsp; j++) {
+        for (size_t k = 0; k < m_nsp; k++) {
+            DC[k] += dwdC[k + m_nsp*j] * C[j];
+        }
+    }
+
+    double m = m_mass;
+    double V = m_vol;
+    double rho = m / V;
+    J.zero();
+
+    // species equations
+    for (size_t k = 0; k < m_nsp; k++) {
+        double WV_m = mw[k] * V / m;
+        double inflow = mdot_k[k] - mdot_in * Y[k];
+        J(k+3, 0) = WV_m * (DC[k] - m_wdot[k]) / m - inflow / (m * m);
+        J(k+3, 1) = mw[k] * (m_wdot[k] - DC[k]) / m;
+        J(k+3, 2) = WV_m * m_dwdot_dT[k];
+        for (size_t j = 0; j < m_nsp; j++) {
+            J(k+3, j+3) = mw[k] * dwdC[k + m_nsp*j] / mw[j];
+        }
+        J(k+3, k+3) -= mdot_in / m;
+    }
+
+    // energy equation, dT/dt = N / (m * cv)
+    if (m_energy) {
+        double P = m_pressure;
+        double N = Hdot_in - P * m_vdot - m_Q - mdot_out * P * V / m;
+        double dNdm = -m_vdot * P / m;
+        double dNdV = m_vdot * P / V;
+        double dNdT = -(m_vdot + mdot_out * V / m) * P / T;
+        for (size_t k = 0; k < m_nsp; k++) {
+            N -= (V * m_wdot[k] + mdot_k[k] / mw[k]) * m_uk[k];
+            dNdm -= V * m_uk[k] * DC[k] / m;
+            dNdV += m_uk[k] * (DC[k] - m_wdot[k]);
+            dNdT -= V * (m_uk[k] * m_dwdot_dT[k] + m_wdot[k] * m_cvk[k])
+                    + m_cvk[k] / mw[k] * mdot_k[k];
+        }
+        double mcv = m * cv;
+        double dTdt = N / mcv;
+        J(2, 0) = (dNdm - dTdt * cv) / mcv;
+        J(2, 1) = dNdV / mcv;
+        J(2, 2) = (dNdT - dTdt * m * dcvdT) / mcv;
+        for (size_t j = 0; j < m_nsp; j++) {
+            double dNdY = -(rho * m_vdot + mdot_out) * GasConstant * T;
+            for (size_t k = 0; k < m_nsp; k++) {
+                dNdY -= V * rho * m_uk[k] * dwdC[k + m_nsp*j];
+            }
+            dNdY /= mw[j];
+            J(2, j+3) = (dNdY - dTdt * m * m_cvk[j] / mw[j]) / mcv;
+        }
+    }
+
+    resetSensitivity(params);
+    return true;
+}
+
+bool IdealGasReactor::getMultiplierDerivativeProducts(doublereal t,
+        const doublereal* lambda, doublereal* prod)
+{
+    m_thermo->restoreState(m_state);
+    m_thermo->getPartialMolarIntEnergies(&m_uk[0]);
+    const vector_fp& mw = m_thermo->molecularWeights();
+    double mcv = m_mass * m_thermo->cv_mass();
+    vector_fp w(m_nsp);
+    for (size_t k = 0; k < m_nsp; k++) {
+        w[k] = lambda[k+3] * mw[k] * m_vol / m_mass;
+        if (m_energy) {
+            // heat release
+            w[k] -= lambda[2] * m_uk[k] * m_vol / mcv;
+        }
+    }
+    multiplierProducts(&w[0], prod);
+    return true;
+}
+
 size_t IdealGasReactor::componentIndex(const string& nm) const
 {
     size_t k = speciesIndex(nm);
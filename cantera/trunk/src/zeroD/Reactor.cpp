@@ -392,6 +392,99 @@ size_t Reactor::componentIndex(const string& nm) const
     }
 }
 
+void Reactor::getJacobianSparsity(std::vector<size_t>& colStart,
+                                  std::vector<size_t>& rowIndex)
+{
+    size_t kstart = componentIndex(m_thermo->speciesName(0));
+    size_t kend = kstart + m_nsp;
+
+    // Gas phase species are coupled through surface reactions as well as
+    // through the homogeneous kinetics
+    bool dense = (kend < m_nv);
+    vector<size_t> kinStart, kinRows;
+    if (m_chem && !dense) {
+        m_kin->getProductionRateSparsity(kinStart, kinRows);
+    }
+
+    colStart.assign(1, 0);
+    rowIndex.clear();
+    for (size_t j = 0; j < m_nv; j++) {
+        if (j < kstart || j >= kend || dense) {
+            for (size_t i = 0; i < m_nv; i++) {
+                rowIndex.push_back(i);
+            }
+        } else {
+            size_t k = j - kstart;
+            for (size_t i = 0; i < kstart; i++) {
+                rowIndex.push_back(i);
+            }
+            if (kinStart.empty()) {
+                rowIndex.push_back(j);
+            } else {
+                for (size_t p = kinStart[k]; p < kinStart[k+1]; p++) {
+                    if (kinRows[p] < m_nsp) {
+                        rowIndex.push_back(kinRows[p] + kstart);
+                    }
+                }
+            }
+        }
+        colStart.push_back(rowIndex.size());
+    }
+}
+
+bool Reactor::getMultiplierDerivativeProducts(doublereal t,
+        const doublereal* lambda, doublereal* prod)
+{
+    m_thermo->restoreState(m_state);
+    size_t kstart = componentIndex(m_thermo->speciesName(0));
+    const vector_fp& mw = m_thermo->molecularWeights();
+    vector_fp w(m_nsp);
+    for (size_t k = 0; k < m_nsp; k++) {
+        w[k] = lambda[kstart + k] * mw[k] * m_vol / m_mass;
+    }
+    multiplierProducts(&w[0], prod);
+    return true;
+}
+
+void Reactor::multiplierProducts(const doublereal* w, doublereal* prod)
+{
+    size_t nr = nReactions();
+    if (!m_chem) {
+        fill(prod, prod + nr, 0.0);
+        return;
+    }
+    // The production rates are wdot_k = sum_i nu_ki * m_i * r_i, where r_i
+    // is the net rate of progress for a unit multiplier
+    vector_fp ropnet(nr);
+    m_kin->getNetRatesOfProgress(&ropnet[0]);
+    m_kin->getReactionDelta(w, prod);
+    for (size_t i = 0; i < nr; i++) {
+        prod[i] *= ropnet[i];
+    }
+}
+
+void Reactor::getMultiplierDerivatives(doublereal t, doublereal* y,
+                                       doublereal* params, Array2D& dfdp)
+{
+    size_t nr = nReactions();
+    dfdp.resize(m_nv, nr);
+    vector_fp ydot0(m_nv), ydot1(m_nv);
+    evalEqs(t, y, &ydot0[0], params);
+
+    // The governing equations are linear in the multipliers, so a large step
+    // can be used to limit the roundoff error
+    double dp = 0.01;
+    for (size_t i = 0; i < nr; i++) {
+        double mult = m_kin->multiplier(i);
+        m_kin->setMultiplier(i, mult * (1.0 + dp));
+        evalEqs(t, y, &ydot1[0], params);
+        m_kin->setMultiplier(i, mult);
+        for (size_t j = 0; j < m_nv; j++) {
+            dfdp(j, i) = (ydot1[j] - ydot0[j]) / dp;
+        }
+    }
+}
+
 void Reactor::applySensitivity(double* params)
 {
     if (!params) {
@@ -4,18 +4,372 @@
 #include "cantera/zeroD/Wall.h"
 
 #include <cstdio>
+#include <memory>
 
 using namespace std;
 
 namespace Cantera
 {
 
+//! The backward problem of the adjoint sensitivity analysis of a ReactorNet.
+/*!
+ * The independent variable is \f$ s = -t \f$, and the state vector consists
+ * of the adjoint variables \f$ \lambda \f$, one for each component of the
+ * state vector of the network, followed by the integrals \f$ q \f$, one for
+ * each reaction rate multiplier:
+ *
+ * \f[ \frac{d\lambda}{ds} = J^T \lambda, \qquad
+ *     \frac{dq_i}{ds} = \lambda^T \frac{\partial f}{\partial \ln p_i} \f]
+ *
+ * The forward solution is interpolated between the states stored at every
+ * time step, which are recomputed from the nearest checkpoint as needed.
+ * The Jacobian of the backward problem is lower block triangular, so the
+ * block-Jacobi preconditioner formed from \f$ J^T \f$ and unit blocks for
+ * the integrals is effective for the GMRES iterations. If Cantera is built
+ * with Sundials, where this preconditioner is not available, the backward
+ * problem is solved with a dense finite difference Jacobian instead.
+ */
+class ReactorNetAdjoint : public FuncEval
+{
+public:
+    explicit ReactorNetAdjoint(ReactorNet& net);
+
+    virtual size_t neq() {
+        return m_nv + m_np;
+    }
+    virtual void eval(double s, double* z, double* zdot, double* p);
+    virtual void getInitialConditions(double s0, size_t leny, double* z);
+    virtual void getJacobianBlocks(std::vector<size_t>& blockStart);
+    virtual bool evalJacobianBlocks(double s, double* z, const double* zdot,
+                                    double* p, std::vector<Array2D>& J);
+
+    //! Integrate the network from its current time to *tf*, storing a
+    //! checkpoint every ReactorNet::m_adjointInterval steps.
+    void forward(double tf);
+
+    //! Integrate the adjoint equations from *tf* back to the initial time.
+    void backward(const double* dgdy, double* sens);
+
+    //! Return the network to the final state of the forward integration.
+    void restore();
+
+protected:
+    //! The solution stored at every time step between two checkpoints,
+    //! with its time derivatives
+    struct Segment {
+        vector_fp t, y, ydot;
+    };
+
+    //! Recompute the solution between checkpoints *c* and *c+1*
+    void recompute(size_t c);
+
+    //! Interpolate the forward solution at time *t*
+    void interpolate(double t, double* y);
+
+    //! Evaluate the forward solution and its Jacobian at time *t*
+    void update(double t);
+
+    ReactorNet& m_net;
+    size_t m_nv; //!< number of forward state variables
+    size_t m_np; //!< number of rate multipliers
+
+    //! Checkpoint times, ending with the final time
+    vector_fp m_tcheck;
+
+    //! States at the checkpoints
+    vector_fp m_ycheck;
+
+    //! Recomputed segments, indexed by the checkpoint at their start. At
+    //! most two segments are kept.
+    std::map<size_t, Segment> m_segments;
+
+    //! Unit sensitivity parameters for ReactorNet::eval
+    vector_fp m_params;
+
+    //! Start of the sensitivity parameters of each reactor in #m_params
+    std::vector<size_t> m_sensStart;
+
+    //! Start of the rate multipliers of each reactor in the integrals
+    std::vector<size_t> m_multStart;
+
+    const double* m_dgdy;
+
+    //! Time of the last call to update()
+    double m_tlast;
+    bool m_updated;
+
+    //! `true` if the Jacobian is given by ReactorNet::getJacobian
+    bool m_analyticJac;
+
+    vector_fp m_y, m_ydot, m_ydot1;
+
+    //! Jacobian of the forward problem at #m_tlast
+    Array2D m_J;
+
+    //! Finite difference derivatives with respect to the rate multipliers,
+    //! for reactors which do not provide the products directly
+    std::vector<Array2D> m_dfdp;
+    std::vector<bool> m_dfdpCurrent;
+};
+
+ReactorNetAdjoint::ReactorNetAdjoint(ReactorNet& net) :
+    m_net(net),
+    m_nv(net.neq()),
+    m_np(net.nAdjointParams()),
+    m_dgdy(0),
+    m_tlast(0.0),
+    m_updated(false),
+    m_analyticJac(false),
+    m_y(m_nv),
+    m_ydot(m_nv),
+    m_ydot1(m_nv),
+    m_J(m_nv, m_nv),
+    m_dfdp(net.nReactors()),
+    m_dfdpCurrent(net.nReactors(), false)
+{
+    m_params.assign(std::max<size_t>(net.nparams(), 1), 1.0);
+    m_sensStart.assign(1, 0);
+    m_multStart.assign(1, 0);
+    for (size_t n = 0; n < net.nReactors(); n++) {
+        m_sensStart.push_back(m_sensStart.back() + net.m_nparams[n]);
+        m_multStart.push_back(m_multStart.back() +
+                              net.reactor(n).nReactions());
+    }
+    // Reactor::getJacobian neglects the dependence of walls and flow devices
+    // on the state, which is not accurate enough for the adjoint equations
+    if (net.nReactors() == 1) {
+        Reactor& r = net.reactor(0);
+        m_analyticJac = (r.nWalls() == 0 && r.nInlets() == 0 &&
+                         r.nOutlets() == 0);
+    }
+}
+
+void ReactorNetAdjoint::forward(double tf)
+{
+    Integrator& integ = *m_net.m_integ;
+    double t = m_net.m_time;
+    if (tf <= t) {
+        throw CanteraError("ReactorNet::advanceAdjoint", "The final time (" +
+            fp2str(tf) + ") must be later than the current time (" +
+            fp2str(t) + ").");
+    }
+    m_tcheck.push_back(t);
+    m_ycheck.insert(m_ycheck.end(), integ.solution(),
+                    integ.solution() + m_nv);
+    size_t nsteps = 0;
+    while (t < tf) {
+        t = integ.step(tf);
+        if (++nsteps % m_net.m_adjointInterval == 0 && t < tf) {
+            m_tcheck.push_back(t);
+            m_ycheck.insert(m_ycheck.end(), integ.solution(),
+                            integ.solution() + m_nv);
+        }
+    }
+    integ.integrate(tf);
+    m_tcheck.push_back(tf);
+    m_ycheck.insert(m_ycheck.end(), integ.solution(),
+                    integ.solution() + m_nv);
+    m_net.m_time = tf;
+    m_net.updateState(integ.solution());
+}
+
+void ReactorNetAdjoint::backward(const double* dgdy, double* sens)
+{
+    m_dgdy = dgdy;
+    std::auto_ptr<Integrator> integ(newIntegrator("CVODE"));
+    integ->setMethod(BDF_Method);
+#ifdef HAS_SUNDIALS
+    // the block-Jacobi preconditioner is not available with CVODES
+    integ->setProblemType(DENSE + NOJAC);
+#else
+    integ->setProblemType(GMRES + BLOCKJACOBI);
+#endif
+    integ->setIterator(Newton_Iter);
+    integ->setTolerances(m_net.m_rtolsens, m_net.m_atolsens);
+    integ->initialize(-m_tcheck.back(), *this);
+    for (size_t c = m_tcheck.size() - 1; c-- > 0;) {
+        integ->integrate(-m_tcheck[c]);
+    }
+    copy(integ->solution() + m_nv, integ->solution() + m_nv + m_np, sens);
+}
+
+void ReactorNetAdjoint::restore()
+{
+    double* yf = &m_ycheck[m_nv * (m_tcheck.size() - 1)];
+    m_net.m_time = m_tcheck.back();
+    m_net.updateState(yf);
+    m_net.m_integ->reinitialize(m_net.m_time, m_net);
+    m_net.m_integrator_init = true;
+}
+
+void ReactorNetAdjoint::recompute(size_t c)
+{
+    Integrator& integ = *m_net.m_integ;
+    Segment& seg = m_segments[c];
+    double t = m_tcheck[c];
+    double tend = m_tcheck[c+1];
+    m_net.updateState(&m_ycheck[m_nv * c]);
+    integ.reinitialize(t, m_net);
+    while (true) {
+        double* y = integ.solution();
+        seg.t.push_back(t);
+        seg.y.insert(seg.y.end(), y, y + m_nv);
+        m_net.eval(t, y, &m_ydot[0], &m_params[0]);
+        seg.ydot.insert(seg.ydot.end(), m_ydot.begin(), m_ydot.end());
+        if (t >= tend) {
+            break;
+        }
+        t = integ.step(tend);
+    }
+
+    // Discard the segment furthest from the current one
+    if (m_segments.size() > 2) {
+        map<size_t, Segment>::iterator furthest = m_segments.begin();
+        if (c - m_segments.begin()->first <
+                m_segments.rbegin()->first - c) {
+            furthest = --m_segments.end();
+        }
+        m_segments.erase(furthest);
+    }
+}
+
+void ReactorNetAdjoint::interpolate(double t, double* y)
+{
+    // The backward integrator may evaluate the equations slightly beyond
+    // the initial time, where the end state is used instead of extrapolating
+    t = std::min(std::max(t, m_tcheck.front()), m_tcheck.back());
+    size_t nseg = m_tcheck.size() - 1;
+    size_t c = upper_bound(m_tcheck.begin(), m_tcheck.end(), t) -
+               m_tcheck.begin();
+    c = std::min(std::max<size_t>(c, 1) - 1, nseg - 1);
+    if (m_segments.find(c) == m_segments.end()) {
+        recompute(c);
+    }
+    const Segment& seg = m_segments[c];
+
+    // cubic Hermite interpolation between the enclosing time steps
+    size_t j = upper_bound(seg.t.begin(), seg.t.end(), t) - seg.t.begin();
+    j = std::min(std::max<size_t>(j, 1) - 1, seg.t.size() - 2);
+    double h = seg.t[j+1] - seg.t[j];
+    double x = (t - seg.t[j]) / h;
+    double h00 = (1 + 2*x) * (1 - x) * (1 - x);
+    double h10 = x * (1 - x) * (1 - x) * h;
+    double h01 = x * x * (3 - 2*x);
+    double h11 = x * x * (x - 1) * h;
+    const double* y0 = &seg.y[m_nv * j];
+    const double* f0 = &seg.ydot[m_nv * j];
+    for (size_t i = 0; i < m_nv; i++) {
+        y[i] = h00 * y0[i] + h10 * f0[i] + h01 * y0[i + m_nv] +
+               h11 * f0[i + m_nv];
+    }
+}
+
+void ReactorNetAdjoint::update(double t)
+{
+    if (m_updated && t == m_tlast) {
+        return;
+    }
+    interpolate(t, &m_y[0]);
+    double* y = &m_y[0];
+    double* params = &m_params[0];
+    if (!m_analyticJac ||
+            !m_net.getJacobian(t, y, &m_ydot[0], params, m_J)) {
+        m_net.eval(t, y, &m_ydot[0], params);
+        for (size_t j = 0; j < m_nv; j++) {
+            double ysave = y[j];
+            double dy = 1.0e-7 * fabs(ysave) + 1.0e-12;
+            y[j] = ysave + dy;
+            dy = y[j] - ysave;
+            m_net.eval(t, y, &m_ydot1[0], params);
+            for (size_t i = 0; i < m_nv; i++) {
+                m_J(i, j) = (m_ydot1[i] - m_ydot[i]) / dy;
+            }
+            // Restore the unperturbed state so that each evaluation starts
+            // from the same point, e.g. for the iteration which determines
+            // the temperature from the internal energy
+            y[j] = ysave;
+            m_net.updateState(y);
+        }
+    }
+    m_dfdpCurrent.assign(m_dfdpCurrent.size(), false);
+    m_tlast = t;
+    m_updated = true;
+}
+
+void ReactorNetAdjoint::eval(double s, double* z, double* zdot, double* p)
+{
+    double t = -s;
+    update(t);
+    for (size_t i = 0; i < m_nv; i++) {
+        double sum = 0.0;
+        for (size_t j = 0; j < m_nv; j++) {
+            sum += m_J(j, i) * z[j];
+        }
+        zdot[i] = sum;
+    }
+
+    for (size_t n = 0; n < m_net.nReactors(); n++) {
+        Reactor& r = m_net.reactor(n);
+        double* lambda = z + m_net.m_start[n];
+        double* prod = zdot + m_nv + m_multStart[n];
+        if (r.getMultiplierDerivativeProducts(t, lambda, prod)) {
+            continue;
+        }
+        Array2D& dfdp = m_dfdp[n];
+        if (!m_dfdpCurrent[n]) {
+            r.getMultiplierDerivatives(t, &m_y[m_net.m_start[n]],
+                                       &m_params[0] + m_sensStart[n], dfdp);
+            m_dfdpCurrent[n] = true;
+        }
+        for (size_t i = 0; i < dfdp.nColumns(); i++) {
+            double sum = 0.0;
+            for (size_t j = 0; j < dfdp.nRows(); j++) {
+                sum += dfdp(j, i) * lambda[j];
+            }
+            prod[i] = sum;
+        }
+    }
+}
+
+void ReactorNetAdjoint::getInitialConditions(double s0, size_t leny,
+                                             double* z)
+{
+    copy(m_dgdy, m_dgdy + m_nv, z);
+    fill(z + m_nv, z + m_nv + m_np, 0.0);
+}
+
+void ReactorNetAdjoint::getJacobianBlocks(std::vector<size_t>& blockStart)
+{
+    blockStart.resize(m_np + 2);
+    blockStart[0] = 0;
+    for (size_t i = 0; i <= m_np; i++) {
+        blockStart[i+1] = m_nv + i;
+    }
+}
+
+bool ReactorNetAdjoint::evalJacobianBlocks(double s, double* z,
+        const double* zdot, double* p, std::vector<Array2D>& J)
+{
+    update(-s);
+    J[0].resize(m_nv, m_nv);
+    for (size_t j = 0; j < m_nv; j++) {
+        for (size_t i = 0; i < m_nv; i++) {
+            J[0](i, j) = m_J(j, i);
+        }
+    }
+    for (size_t i = 1; i <= m_np; i++) {
+        J[i].resize(1, 1);
+        J[i](0, 0) = 0.0;
+    }
+    return true;
+}
+
 ReactorNet::ReactorNet() :
     m_integ(0), m_time(0.0), m_init(false), m_integrator_init(false),
     m_nv(0), m_rtol(1.0e-9), m_rtolsens(1.0e-4),
     m_atols(1.0e-15), m_atolsens(1.0e-4),
-    m_maxstep(-1.0), m_maxErrTestFails(0),
-    m_verbose(false), m_ntotpar(0)
+    m_maxstep(-1.0), m_maxErrTestFails(0), m_linearSolverType("DENSE"),
+    m_verbose(false), m_ntotpar(0), m_adjointInterval(100)
 {
     m_integ = newIntegrator("CVODE");
 
@@ -38,6 +392,26 @@ ReactorNet::~ReactorNet()
     delete m_integ;
 }
 
+void ReactorNet::setLinearSolverType(const std::string& type)
+{
+    if (type == "DENSE") {
+        m_integ->setProblemType(DENSE + NOJAC);
+    } else if (type == "DENSE_ANALYTIC") {
+        m_integ->setProblemType(DENSE + JAC);
+    } else if (type == "GMRES") {
+        m_integ->setProblemType(GMRES);
+    } else if (type == "ILU_GMRES") {
+        m_integ->setProblemType(GMRES + ILU);
+    } else if (type == "BLOCK_JACOBI_GMRES") {
+        m_integ->setProblemType(GMRES + BLOCKJACOBI);
+    } else {
+        throw CanteraError("ReactorNet::setLinearSolverType",
+                           "Unknown linear solver type: '" + type + "'");
+    }
+    m_linearSolverType = type;
+    m_init = false;
+}
+
 void ReactorNet::initialize()
 {
     size_t n, nv;
@@ -140,6 +514,50 @@ double ReactorNet::step(doublereal time)
     return m_time;
 }
 
+size_t ReactorNet::nAdjointParams()
+{
+    size_t np = 0;
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        np += m_reactors[n]->nReactions();
+    }
+    return np;
+}
+
+void ReactorNet::advanceAdjoint(doublereal time, const doublereal* dgdy,
+                                doublereal* sens)
+{
+    if (!m_init) {
+        if (m_maxstep < 0.0) {
+            m_maxstep = time - m_time;
+        }
+        initialize();
+    } else if (!m_integrator_init) {
+        reinitialize();
+    }
+    ReactorNetAdjoint adjoint(*this);
+    adjoint.forward(time);
+    try {
+        adjoint.backward(dgdy, sens);
+    } catch (...) {
+        adjoint.restore();
+        throw;
+    }
+    adjoint.restore();
+}
+
+void ReactorNet::advanceAdjoint(doublereal time, const std::string& component,
+                                doublereal* sens, size_t reactor)
+{
+    size_t k = globalComponentIndex(component, reactor);
+    vector_fp dgdy(m_nv, 0.0);
+    dgdy[k] = 1.0;
+    advanceAdjoint(time, &dgdy[0], sens);
+    double yk = m_integ->solution(k);
+    for (size_t i = 0; i < nAdjointParams(); i++) {
+        sens[i] /= yk;
+    }
+}
+
 void ReactorNet::addReactor(Reactor* r, bool iown)
 {
     warn_deprecated("ReactorNet::addReactor(Reactor*)",
@@ -207,6 +625,66 @@ void ReactorNet::evalJacobian(doublereal t, doublereal* y,
     }
 }
 
+bool ReactorNet::getJacobian(doublereal t, doublereal* y, doublereal* ydot,
+                             doublereal* p, Array2D& J)
+{
+    updateState(y);
+    J.zero();
+    size_t pstart = 0;
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        size_t nv = m_reactors[n]->neq();
+        m_jacWork.resize(nv, nv);
+        if (!m_reactors[n]->getJacobian(t, p ? p + pstart : 0, m_jacWork)) {
+            return false;
+        }
+        for (size_t j = 0; j < nv; j++) {
+            for (size_t i = 0; i < nv; i++) {
+                J(m_start[n] + i, m_start[n] + j) = m_jacWork(i, j);
+            }
+        }
+        pstart += m_nparams[n];
+    }
+    return true;
+}
+
+void ReactorNet::getJacobianBlocks(std::vector<size_t>& blockStart)
+{
+    blockStart = m_start;
+}
+
+bool ReactorNet::evalJacobianBlocks(double t, double* y, const double* ydot,
+                                    double* p, std::vector<Array2D>& J)
+{
+    updateState(y);
+    size_t pstart = 0;
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        size_t nv = m_reactors[n]->neq();
+        J[n].resize(nv, nv);
+        if (!m_reactors[n]->getJacobian(t, p ? p + pstart : 0, J[n])) {
+            return false;
+        }
+        pstart += m_nparams[n];
+    }
+    return true;
+}
+
+void ReactorNet::getJacobianSparsity(std::vector<size_t>& colStart,
+                                     std::vector<size_t>& rowIndex)
+{
+    colStart.assign(1, 0);
+    rowIndex.clear();
+    vector<size_t> start, rows;
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        m_reactors[n]->getJacobianSparsity(start, rows);
+        for (size_t j = 0; j + 1 < start.size(); j++) {
+            for (size_t p = start[j]; p < start[j+1]; p++) {
+                rowIndex.push_back(rows[p] + m_start[n]);
+            }
+            colStart.push_back(rowIndex.size());
+        }
+    }
+}
+
 void ReactorNet::updateState(doublereal* y)
 {
     for (size_t n = 0; n < m_reactors.size(); n++) {
@@ -0,0 +1,467 @@
+/**
+ *  @file ReactorNetEnsemble.cpp
+ */
+
+#include "cantera/zeroD/ReactorNetEnsemble.h"
+#include "cantera/zeroD/ReactorFactory.h"
+#include "cantera/zeroD/Wall.h"
+#include "cantera/zeroD/flowControllers.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/kinetics/KineticsFactory.h"
+#include "cantera/base/stringUtils.h"
+
+#include <limits>
+
+#ifdef THREAD_SAFE_CANTERA
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace
+{
+//! Index of *x* in *v*, or npos if it is not found
+template<class T>
+size_t indexOf(const std::vector<T*>& v, const T* x)
+{
+    for (size_t i = 0; i < v.size(); i++) {
+        if (v[i] == x) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+//! The objects making up the copy of the reactor network for one case
+struct NetworkCopy {
+    ~NetworkCopy() {
+        for (size_t i = 0; i < devices.size(); i++) {
+            delete devices[i];
+        }
+        for (size_t i = 0; i < walls.size(); i++) {
+            delete walls[i];
+        }
+        for (size_t i = 0; i < reactors.size(); i++) {
+            delete reactors[i];
+        }
+    }
+    ReactorNet net;
+    std::vector<ReactorBase*> reactors;
+    std::vector<Wall*> walls;
+    std::vector<FlowDevice*> devices;
+};
+}
+
+//! Holds the copies of the phases and kinetics managers used by one thread,
+//! and integrates cases using them.
+class ReactorNetEnsemble::Worker
+{
+public:
+    explicit Worker(ReactorNetEnsemble& ens) : m_ens(ens), m_neq(0) {
+        try {
+            for (size_t i = 0; i < ens.m_phases.size(); i++) {
+                m_phases.push_back(newPhase(ens.m_phases[i]->xml()));
+            }
+            for (size_t j = 0; j < ens.m_kinetics.size(); j++) {
+                std::vector<thermo_t*> phases;
+                for (size_t n = 0; n < ens.m_kinPhases[j].size(); n++) {
+                    phases.push_back(m_phases[ens.m_kinPhases[j][n]]);
+                }
+                Kinetics* tmpl = ens.m_kinetics[j];
+                size_t irxn = tmpl->reactionPhaseIndex();
+                m_kinetics.push_back(newKineticsMgr(phases[irxn]->xml(), phases));
+                for (size_t i = 0; i < tmpl->nReactions(); i++) {
+                    m_kinetics.back()->setMultiplier(i, tmpl->multiplier(i));
+                }
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    ~Worker() {
+        clear();
+    }
+
+    //! Integrate cases until none are left
+    void runAll() {
+        size_t icase;
+        while ((icase = m_ens.nextCase()) != npos) {
+            run(icase);
+        }
+    }
+
+    //! Integrate case *icase* and store the results in the ensemble
+    void run(size_t icase);
+
+    size_t neq() const {
+        return m_neq;
+    }
+
+private:
+    //! Create the copy of the reactor network for case *icase*
+    void build(size_t icase, NetworkCopy& copy);
+
+    void clear() {
+        for (size_t j = 0; j < m_kinetics.size(); j++) {
+            delete m_kinetics[j];
+        }
+        for (size_t i = 0; i < m_phases.size(); i++) {
+            delete m_phases[i];
+        }
+        m_kinetics.clear();
+        m_phases.clear();
+    }
+
+    ReactorNetEnsemble& m_ens;
+    std::vector<thermo_t*> m_phases;
+    std::vector<Kinetics*> m_kinetics;
+    size_t m_neq;
+};
+
+void ReactorNetEnsemble::Worker::build(size_t icase, NetworkCopy& copy)
+{
+    const Case& c = m_ens.m_cases[icase];
+    for (size_t i = 0; i < m_ens.m_reactors.size(); i++) {
+        ReactorBase* tmpl = m_ens.m_reactors[i];
+        copy.reactors.push_back(ReactorFactory::factory()->newReactor(tmpl->type()));
+        ReactorBase* r = copy.reactors.back();
+        r->setName(tmpl->name());
+        r->setInitialVolume(tmpl->volume());
+
+        thermo_t* phase = m_phases[m_ens.m_reactorPhase[i]];
+        phase->restoreState(m_ens.m_reactorState[i]);
+        if (i == c.reactor) {
+            phase->setState_TPX(c.T, c.P, c.X);
+        }
+        r->setThermoMgr(*phase);
+
+        Reactor* reactor = dynamic_cast<Reactor*>(r);
+        if (reactor) {
+            Reactor* tmplReactor = dynamic_cast<Reactor*>(tmpl);
+            if (m_ens.m_reactorKin[i] != npos) {
+                reactor->setKineticsMgr(*m_kinetics[m_ens.m_reactorKin[i]]);
+            }
+            if (tmplReactor->chemistryEnabled()) {
+                reactor->enableChemistry();
+            } else {
+                reactor->disableChemistry();
+            }
+            reactor->setEnergy(tmplReactor->energyEnabled());
+        }
+    }
+
+    for (size_t i = 0; i < m_ens.m_walls.size(); i++) {
+        copy.walls.push_back(m_ens.m_walls[i]->duplMyselfAsWall());
+        copy.walls.back()->install(*copy.reactors[m_ens.m_wallReactors[i].first],
+                                   *copy.reactors[m_ens.m_wallReactors[i].second]);
+    }
+
+    for (size_t i = 0; i < m_ens.m_devices.size(); i++) {
+        copy.devices.push_back(m_ens.m_devices[i]->duplMyselfAsFlowDevice());
+    }
+    for (size_t i = 0; i < m_ens.m_devices.size(); i++) {
+        PressureController* pc = dynamic_cast<PressureController*>(copy.devices[i]);
+        if (pc && pc->master()) {
+            pc->setMaster(copy.devices[indexOf(m_ens.m_devices,
+                                               pc->master())]);
+        }
+        copy.devices[i]->install(*copy.reactors[m_ens.m_deviceReactors[i].first],
+                                 *copy.reactors[m_ens.m_deviceReactors[i].second]);
+    }
+
+    for (size_t i = 0; i < m_ens.m_net->nReactors(); i++) {
+        copy.net.addReactor(dynamic_cast<Reactor&>(*copy.reactors[i]));
+    }
+    ReactorNet& tmpl = *m_ens.m_net;
+    copy.net.setTolerances(tmpl.rtol(), tmpl.atol());
+    copy.net.setLinearSolverType(tmpl.linearSolverType());
+    copy.net.setMaxTimeStep(tmpl.maxTimeStep());
+    copy.net.setMaxErrTestFails(tmpl.maxErrTestFails());
+}
+
+void ReactorNetEnsemble::Worker::run(size_t icase)
+{
+    double tEnd = m_ens.m_tEnd;
+    try {
+        NetworkCopy copy;
+        build(icase, copy);
+        ReactorBase& r = *copy.reactors[m_ens.m_ignitionReactor];
+        double t = 0.0;
+        double T = r.temperature();
+        double dTdt_max = -BigNumber;
+        double tau = std::numeric_limits<double>::quiet_NaN();
+        while (t < tEnd) {
+            double tprev = t;
+            double Tprev = T;
+            t = copy.net.step(tEnd);
+            T = r.temperature();
+            double dTdt = (T - Tprev) / (t - tprev);
+            if (dTdt > dTdt_max) {
+                dTdt_max = dTdt;
+                tau = 0.5 * (t + tprev);
+            }
+            if (m_ens.m_saveHistory) {
+                const double* y = copy.net.integrator().solution();
+                m_ens.m_times[icase].push_back(t);
+                m_ens.m_solution[icase].insert(m_ens.m_solution[icase].end(),
+                                               y, y + copy.net.neq());
+            }
+        }
+        m_neq = copy.net.neq();
+        m_ens.m_tau[icase] = tau;
+        m_ens.m_Tfinal[icase] = T;
+    } catch (std::exception& err) {
+        m_ens.m_error[icase] = err.what();
+    }
+}
+
+ReactorNetEnsemble::ReactorNetEnsemble(ReactorNet& net) :
+    m_net(&net),
+    m_ignitionReactor(0),
+    m_saveHistory(false),
+    m_tEnd(0.0),
+    m_neq(0),
+    m_next(0)
+{
+    for (size_t i = 0; i < net.nReactors(); i++) {
+        m_reactors.push_back(&net.reactor(i));
+    }
+    for (size_t i = 0; i < net.nReactors(); i++) {
+        addTemplateReactor(&net.reactor(i));
+    }
+
+    // Record the initial states of all the reactors, without changing the
+    // states of the template phases
+    std::vector<vector_fp> phaseStates(m_phases.size());
+    for (size_t i = 0; i < m_phases.size(); i++) {
+        m_phases[i]->saveState(phaseStates[i]);
+    }
+    m_reactorState.resize(m_reactors.size());
+    for (size_t i = 0; i < m_reactors.size(); i++) {
+        m_reactors[i]->restoreState();
+        m_reactors[i]->contents().saveState(m_reactorState[i]);
+    }
+    for (size_t i = 0; i < m_phases.size(); i++) {
+        m_phases[i]->restoreState(phaseStates[i]);
+    }
+}
+
+ReactorNetEnsemble::~ReactorNetEnsemble()
+{
+}
+
+void ReactorNetEnsemble::addTemplateReactor(ReactorBase* r)
+{
+    size_t index = indexOf(m_reactors, r);
+    if (index == npos) {
+        index = m_reactors.size();
+        m_reactors.push_back(r);
+    }
+    m_reactorPhase.resize(m_reactors.size(), npos);
+    m_reactorKin.resize(m_reactors.size(), npos);
+    if (m_reactorPhase[index] != npos) {
+        return; // already added
+    }
+    if (r->type() == FlowReactorType) {
+        throw CanteraError("ReactorNetEnsemble::addTemplateReactor",
+                           "FlowReactor is not supported.");
+    }
+
+    m_reactorPhase[index] = addTemplatePhase(&r->contents());
+    Reactor* reactor = dynamic_cast<Reactor*>(r);
+    Kinetics* kin = (reactor) ? reactor->kineticsMgr() : 0;
+    if (kin) {
+        size_t j = indexOf(m_kinetics, kin);
+        if (j == npos) {
+            j = m_kinetics.size();
+            m_kinetics.push_back(kin);
+            m_kinPhases.push_back(std::vector<size_t>());
+            for (size_t n = 0; n < kin->nPhases(); n++) {
+                m_kinPhases[j].push_back(addTemplatePhase(&kin->thermo(n)));
+            }
+        }
+        m_reactorKin[index] = j;
+    }
+
+    for (size_t n = 0; n < r->nWalls(); n++) {
+        Wall* w = &r->wall(n);
+        if (indexOf(m_walls, w) == npos) {
+            if (w->kinetics(0) || w->kinetics(1)) {
+                throw CanteraError("ReactorNetEnsemble::addTemplateReactor",
+                                   "Walls with surface reactions are not "
+                                   "supported.");
+            }
+            m_walls.push_back(w);
+            ReactorBase* left = &w->left();
+            ReactorBase* right = const_cast<ReactorBase*>(&w->right());
+            addTemplateReactor(left);
+            addTemplateReactor(right);
+            m_wallReactors.push_back(std::make_pair(indexOf(m_reactors, left),
+                                                    indexOf(m_reactors, right)));
+        }
+    }
+
+    std::vector<FlowDevice*> devices;
+    for (size_t n = 0; n < r->nInlets(); n++) {
+        devices.push_back(&r->inlet(n));
+    }
+    for (size_t n = 0; n < r->nOutlets(); n++) {
+        devices.push_back(&r->outlet(n));
+    }
+    for (size_t n = 0; n < devices.size(); n++) {
+        FlowDevice* d = devices[n];
+        if (indexOf(m_devices, d) == npos) {
+            m_devices.push_back(d);
+            ReactorBase* in = &d->in();
+            ReactorBase* out = const_cast<ReactorBase*>(&d->out());
+            addTemplateReactor(in);
+            addTemplateReactor(out);
+            m_deviceReactors.push_back(std::make_pair(indexOf(m_reactors, in),
+                                                      indexOf(m_reactors, out)));
+        }
+    }
+}
+
+size_t ReactorNetEnsemble::addTemplatePhase(thermo_t* ph)
+{
+    size_t i = indexOf(m_phases, ph);
+    if (i == npos) {
+        i = m_phases.size();
+        m_phases.push_back(ph);
+    }
+    return i;
+}
+
+size_t ReactorNetEnsemble::addCase(double T, double P, const std::string& X,
+                                   size_t reactor)
+{
+    if (reactor >= m_net->nReactors()) {
+        throw IndexError("ReactorNetEnsemble::addCase", "reactors", reactor,
+                         m_net->nReactors()-1);
+    }
+    Case c;
+    c.T = T;
+    c.P = P;
+    c.X = X;
+    c.reactor = reactor;
+    m_cases.push_back(c);
+    return m_cases.size() - 1;
+}
+
+void ReactorNetEnsemble::setIgnitionReactor(size_t reactor)
+{
+    if (reactor >= m_net->nReactors()) {
+        throw IndexError("ReactorNetEnsemble::setIgnitionReactor", "reactors",
+                         reactor, m_net->nReactors()-1);
+    }
+    m_ignitionReactor = reactor;
+}
+
+size_t ReactorNetEnsemble::nextCase()
+{
+    ScopedLock lock(m_next_mutex);
+    if (m_next < m_cases.size()) {
+        return m_next++;
+    }
+    return npos;
+}
+
+void ReactorNetEnsemble::run(double tEnd, size_t nThreads)
+{
+    size_t nc = nCases();
+    m_tEnd = tEnd;
+    m_next = 0;
+    m_tau.assign(nc, std::numeric_limits<double>::quiet_NaN());
+    m_Tfinal.assign(nc, std::numeric_limits<double>::quiet_NaN());
+    m_times.assign(nc, vector_fp());
+    m_solution.assign(nc, vector_fp());
+    m_error.assign(nc, "");
+    if (nc == 0) {
+        return;
+    }
+
+#ifdef THREAD_SAFE_CANTERA
+    if (nThreads == 0) {
+        nThreads = std::max<size_t>(boost::thread::hardware_concurrency(), 1);
+    }
+    nThreads = std::min(nThreads, nc);
+#else
+    nThreads = 1;
+#endif
+
+    // The phases and kinetics managers are copied serially, since the
+    // construction of the copies reads the XML trees of the template phases
+    std::vector<Worker*> workers;
+    try {
+        for (size_t i = 0; i < nThreads; i++) {
+            workers.push_back(new Worker(*this));
+        }
+        if (nThreads == 1) {
+            workers[0]->runAll();
+        } else {
+#ifdef THREAD_SAFE_CANTERA
+            boost::thread_group threads;
+            for (size_t i = 0; i < nThreads; i++) {
+                threads.create_thread(boost::bind(&Worker::runAll, workers[i]));
+            }
+            threads.join_all();
+#endif
+        }
+    } catch (...) {
+        for (size_t i = 0; i < workers.size(); i++) {
+            delete workers[i];
+        }
+        throw;
+    }
+
+    for (size_t i = 0; i < workers.size(); i++) {
+        m_neq = std::max(m_neq, workers[i]->neq());
+        delete workers[i];
+    }
+}
+
+void ReactorNetEnsemble::checkCaseIndex(size_t icase) const
+{
+    if (icase >= m_tau.size()) {
+        throw IndexError("ReactorNetEnsemble::checkCaseIndex", "results",
+                         icase, m_tau.size()-1);
+    }
+}
+
+double ReactorNetEnsemble::ignitionDelay(size_t icase) const
+{
+    checkCaseIndex(icase);
+    return m_tau[icase];
+}
+
+double ReactorNetEnsemble::finalTemperature(size_t icase) const
+{
+    checkCaseIndex(icase);
+    return m_Tfinal[icase];
+}
+
+const vector_fp& ReactorNetEnsemble::times(size_t icase) const
+{
+    checkCaseIndex(icase);
+    return m_times[icase];
+}
+
+const vector_fp& ReactorNetEnsemble::solution(size_t icase) const
+{
+    checkCaseIndex(icase);
+    return m_solution[icase];
+}
+
+const std::string& ReactorNetEnsemble::error(size_t icase) const
+{
+    checkCaseIndex(icase);
+    return m_error[icase];
+}
+
+}
@@ -18,6 +18,18 @@ Wall::Wall() : m_left(0), m_right(0),
     }
 }
 
+Wall* Wall::duplMyselfAsWall() const
+{
+    if (m_chem[0] || m_chem[1]) {
+        throw CanteraError("Wall::duplMyselfAsWall",
+                           "Walls with surface reactions can not be duplicated.");
+    }
+    Wall* w = new Wall(*this);
+    w->m_left = 0;
+    w->m_right = 0;
+    return w;
+}
+
 bool Wall::install(ReactorBase& rleft, ReactorBase& rright)
 {
     // check if wall is already installed
@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+#include "cantera/base/ctml.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/transport.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace Cantera
+{
+
+TEST(BinaryCTML, tree_round_trip)
+{
+    XML_Node* doc = get_XML_File("gri30.xml");
+    ctml::writeBinaryCTML(*doc, "gri30-test.ctmlb");
+    XML_Node copy;
+    ctml::readBinaryCTML("gri30-test.ctmlb", copy);
+
+    std::stringstream s1, s2;
+    doc->write(s1);
+    copy.write(s2);
+    EXPECT_EQ(s1.str(), s2.str());
+}
+
+TEST(BinaryCTML, mechanism_from_phase)
+{
+    IdealGasMix gas("gri30.xml", "gri30_mix");
+    ctml::writeBinaryCTML(gas.xml().root(), "gri30-phase.ctmlb");
+    IdealGasMix gas2("gri30-phase.ctmlb", "gri30_mix");
+    ASSERT_EQ(gas.nSpecies(), gas2.nSpecies());
+    ASSERT_EQ(gas.nReactions(), gas2.nReactions());
+
+    gas.setState_TPX(1500.0, OneAtm, "CH4:1.0, O2:2.0, N2:7.52, OH:0.01");
+    gas2.setState_TPX(1500.0, OneAtm, "CH4:1.0, O2:2.0, N2:7.52, OH:0.01");
+    EXPECT_EQ(gas.enthalpy_mass(), gas2.enthalpy_mass());
+    vector_fp w1(gas.nSpecies()), w2(gas.nSpecies());
+    gas.getNetProductionRates(&w1[0]);
+    gas2.getNetProductionRates(&w2[0]);
+    for (size_t k = 0; k < gas.nSpecies(); k++) {
+        EXPECT_EQ(w1[k], w2[k]) << gas.speciesName(k);
+    }
+
+    Transport* tr1 = newDefaultTransportMgr(&gas);
+    Transport* tr2 = newDefaultTransportMgr(&gas2);
+    EXPECT_EQ(tr1->viscosity(), tr2->viscosity());
+    delete tr1;
+    delete tr2;
+}
+
+TEST(BinaryCTML, invalid_file)
+{
+    std::ofstream out("invalid.ctmlb");
+    out << "<ctml></ctml>\n";
+    out.close();
+    XML_Node x;
+    EXPECT_THROW(ctml::readBinaryCTML("invalid.ctmlb", x), CanteraError);
+    EXPECT_THROW(ctml::readBinaryCTML("nonexistent.ctmlb", x), CanteraError);
+}
+
+}
@@ -0,0 +1,223 @@
+#include "gtest/gtest.h"
+#include "cantera/numerics/BlockJacobi.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/zeroD/IdealGasReactor.h"
+#include "cantera/zeroD/ReactorNet.h"
+#include "cantera/zeroD/Reservoir.h"
+#include "cantera/zeroD/flowControllers.h"
+
+namespace Cantera
+{
+
+//! Linear system dy/dt = A*y where A is block diagonal, with blocks of
+//! sizes 2, 3 and 4
+class BlockSystem : public FuncEval
+{
+public:
+    BlockSystem() : A(9, 9, 0.0), analytic(false) {
+        start.push_back(0);
+        start.push_back(2);
+        start.push_back(5);
+        start.push_back(9);
+        for (size_t n = 0; n < 3; n++) {
+            for (size_t i = start[n]; i < start[n+1]; i++) {
+                for (size_t j = start[n]; j < start[n+1]; j++) {
+                    A(i,j) = (i == j) ? -3.0 - 0.5 * i : 0.2 * (i + 1) - 0.3 * j;
+                }
+            }
+        }
+    }
+    virtual void eval(double t, double* y, double* ydot, double* p) {
+        A.mult(y, ydot);
+    }
+    virtual void getInitialConditions(double t0, size_t leny, double* y) {
+        for (size_t i = 0; i < leny; i++) {
+            y[i] = 1.0 + 0.1 * i;
+        }
+    }
+    virtual size_t neq() {
+        return A.nRows();
+    }
+    virtual void getJacobianBlocks(std::vector<size_t>& blockStart) {
+        blockStart = start;
+    }
+    virtual bool evalJacobianBlocks(double t, double* y, const double* ydot,
+                                    double* p, std::vector<Array2D>& J) {
+        if (!analytic) {
+            return false;
+        }
+        for (size_t n = 0; n < 3; n++) {
+            for (size_t i = start[n]; i < start[n+1]; i++) {
+                for (size_t j = start[n]; j < start[n+1]; j++) {
+                    J[n](i - start[n], j - start[n]) = A(i,j);
+                }
+            }
+        }
+        return true;
+    }
+    DenseMatrix A;
+    std::vector<size_t> start;
+    bool analytic;
+};
+
+void checkBlockJacobi(BlockSystem& f)
+{
+    size_t n = f.neq();
+    std::vector<size_t> blockStart;
+    f.getJacobianBlocks(blockStart);
+    BlockJacobi bj;
+    bj.setBlocks(blockStart);
+    EXPECT_EQ((size_t) 3, bj.nBlocks());
+    EXPECT_EQ(n, bj.size());
+
+    vector_fp y(n), ydot(n), ewt(n, 1e8);
+    f.getInitialConditions(0.0, n, &y[0]);
+    f.eval(0.0, &y[0], &ydot[0], 0);
+    size_t nfe = bj.evalJacobian(f, 0.0, &y[0], &ydot[0], &ewt[0]);
+    EXPECT_EQ(f.analytic, bj.analyticJacobian());
+    // finite differences need one evaluation per column of the largest block
+    EXPECT_EQ(f.analytic ? (size_t) 0 : (size_t) 4, nfe);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_DOUBLE_EQ(1.0 + 0.1 * i, y[i]);
+        for (size_t j = 0; j < n; j++) {
+            EXPECT_NEAR(f.A(i,j), bj.jacobian(i,j), 1e-6);
+        }
+    }
+
+    // The matrix is block diagonal, so the factorization is exact
+    double gamma = 0.3;
+    ASSERT_EQ(0, bj.factor(gamma));
+    DenseMatrix P(n, n, 0.0);
+    vector_fp b(n), x(n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            P(i,j) = (i == j) - gamma * bj.jacobian(i,j);
+        }
+        b[i] = sin(1.0 + i);
+    }
+    bj.solve(&b[0], &x[0]);
+    solve(P, &b[0]);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(b[i], x[i], 1e-10);
+    }
+}
+
+TEST(BlockJacobi, finite_difference)
+{
+    BlockSystem f;
+    checkBlockJacobi(f);
+}
+
+TEST(BlockJacobi, analytic)
+{
+    BlockSystem f;
+    f.analytic = true;
+    checkBlockJacobi(f);
+}
+
+TEST(BlockJacobi, singular)
+{
+    BlockSystem f;
+    f.analytic = true;
+    std::vector<size_t> blockStart;
+    f.getJacobianBlocks(blockStart);
+    BlockJacobi bj;
+    bj.setBlocks(blockStart);
+    vector_fp y(9), ydot(9), ewt(9, 1e8);
+    // I - gamma*A is singular in the second block when gamma = 1/A(2,2) and
+    // the rest of the block is zero
+    f.A(2,3) = f.A(2,4) = f.A(3,2) = f.A(4,2) = 0.0;
+    bj.evalJacobian(f, 0.0, &y[0], &ydot[0], &ewt[0]);
+    EXPECT_EQ(3, bj.factor(1.0 / f.A(2,2)));
+}
+
+TEST(BlockJacobi, empty_block)
+{
+    BlockJacobi bj;
+    std::vector<size_t> blockStart(3, 0);
+    blockStart[2] = 3;
+    EXPECT_THROW(bj.setBlocks(blockStart), CanteraError);
+}
+
+//! A chain of stirred reactors, each fed by the previous one. Reactors of
+//! class Reactor do not provide a Jacobian, while IdealGasReactors do.
+class ReactorChain
+{
+public:
+    ReactorChain(size_t n, const std::string& solver, bool ideal) :
+        gas("h2o2.xml", "ohmech")
+    {
+        gas.setState_TPX(300.0, OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+        inlet.insert(gas);
+        outlet.insert(gas);
+        for (size_t i = 0; i < n; i++) {
+            gas.setState_TPX(1000.0 + 20.0 * i, OneAtm,
+                             "H2:2.0, O2:1.0, AR:4.0");
+            if (ideal) {
+                reactors.push_back(new IdealGasReactor());
+            } else {
+                reactors.push_back(new Reactor());
+            }
+            reactors[i]->insert(gas);
+            net.addReactor(*reactors[i]);
+        }
+        for (size_t i = 0; i <= n; i++) {
+            mfcs.push_back(new MassFlowController());
+            mfcs[i]->install((i == 0) ? (ReactorBase&) inlet : *reactors[i-1],
+                             (i == n) ? (ReactorBase&) outlet : *reactors[i]);
+            mfcs[i]->setMassFlowRate(1e-3);
+        }
+        net.setLinearSolverType(solver);
+    }
+
+    ~ReactorChain() {
+        for (size_t i = 0; i < reactors.size(); i++) {
+            delete reactors[i];
+        }
+        for (size_t i = 0; i < mfcs.size(); i++) {
+            delete mfcs[i];
+        }
+    }
+
+    IdealGasMix gas;
+    Reservoir inlet, outlet;
+    std::vector<Reactor*> reactors;
+    std::vector<MassFlowController*> mfcs;
+    ReactorNet net;
+};
+
+#ifdef HAS_SUNDIALS
+TEST(BlockJacobi, reactor_chain)
+{
+    // The block-Jacobi preconditioner is not available with CVODES
+    ReactorNet net;
+    EXPECT_THROW(net.setLinearSolverType("BLOCK_JACOBI_GMRES"), CanteraError);
+}
+#else
+void checkReactorChain(bool ideal)
+{
+    size_t n = 6;
+    ReactorChain dense(n, "DENSE", ideal);
+    ReactorChain block(n, "BLOCK_JACOBI_GMRES", ideal);
+    dense.net.advance(0.05);
+    block.net.advance(0.05);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(dense.reactors[i]->temperature(),
+                    block.reactors[i]->temperature(),
+                    1e-4 * dense.reactors[i]->temperature());
+    }
+    EXPECT_GT(dense.reactors[n-1]->temperature(), 1500.0);
+}
+
+TEST(BlockJacobi, reactor_chain)
+{
+    checkReactorChain(true);
+}
+
+TEST(BlockJacobi, reactor_chain_finite_difference)
+{
+    checkReactorChain(false);
+}
+#endif
+
+}
@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include "cantera/base/ctml.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/transport.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace Cantera
+{
+
+static std::string readInput(const std::string& name)
+{
+    std::ifstream s(findInputFile(name).c_str());
+    std::stringstream text;
+    text << s.rdbuf();
+    return text.str();
+}
+
+static void compareGases(IdealGasMix& gas, IdealGasMix& gas2, const std::string& X)
+{
+    ASSERT_EQ(gas.nSpecies(), gas2.nSpecies());
+    ASSERT_EQ(gas.nReactions(), gas2.nReactions());
+    gas.setState_TPX(1500.0, OneAtm, X);
+    gas2.setState_TPX(1500.0, OneAtm, X);
+    EXPECT_EQ(gas.enthalpy_mass(), gas2.enthalpy_mass());
+    vector_fp w1(gas.nSpecies()), w2(gas.nSpecies());
+    gas.getNetProductionRates(&w1[0]);
+    gas2.getNetProductionRates(&w2[0]);
+    for (size_t k = 0; k < gas.nSpecies(); k++) {
+        EXPECT_DOUBLE_EQ(w1[k], w2[k]) << gas.speciesName(k);
+    }
+}
+
+TEST(NativeCti, gri30)
+{
+    XML_Node root;
+    ASSERT_TRUE(ctml::ct2ctml_native(readInput("gri30.cti"), root));
+    IdealGasMix gas(root, "gri30_mix");
+    IdealGasMix gas2("gri30.xml", "gri30_mix");
+    compareGases(gas, gas2, "CH4:1.0, O2:2.0, N2:7.52, OH:0.01");
+
+    Transport* tr1 = newDefaultTransportMgr(&gas);
+    Transport* tr2 = newDefaultTransportMgr(&gas2);
+    EXPECT_DOUBLE_EQ(tr1->viscosity(), tr2->viscosity());
+    delete tr1;
+    delete tr2;
+}
+
+TEST(NativeCti, pdep_reactions)
+{
+    XML_Node root;
+    ASSERT_TRUE(ctml::ct2ctml_native(readInput("pdep-test.cti"), root));
+    IdealGasMix gas(root, "gas");
+    IdealGasMix gas2("pdep-test.xml", "gas");
+    compareGases(gas, gas2, "R1A:0.3, R1B:0.6, P1:0.1, H:0.1, R2:0.2, "
+                 "R3:0.2, R4:0.2, R5:0.2, R6:0.2");
+}
+
+TEST(NativeCti, unsupported_input)
+{
+    // surface phases are left to the Python converter
+    std::string cti =
+        "ideal_interface(name='surf', elements='H', species='H(S)',\n"
+        "                site_density=2.7e-9)\n";
+    XML_Node root;
+    EXPECT_FALSE(ctml::ct2ctml_native(cti, root));
+    EXPECT_EQ((size_t) 0, root.nChildren());
+
+    // function definitions are not evaluated
+    EXPECT_FALSE(ctml::ct2ctml_native("def f(x):\n    return x\n", root));
+    EXPECT_FALSE(ctml::ct2ctml_native("ideal_gas(name='gas'", root));
+}
+
+}
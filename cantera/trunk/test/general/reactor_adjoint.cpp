@@ -0,0 +1,220 @@
+#include "gtest/gtest.h"
+#include "cantera/zeroD/IdealGasReactor.h"
+#include "cantera/zeroD/IdealGasConstPressureReactor.h"
+#include "cantera/zeroD/ConstPressureReactor.h"
+#include "cantera/zeroD/ReactorNet.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+//! Reactor which leaves the derivatives with respect to the multipliers to
+//! be computed by finite differences
+class FiniteDifferenceReactor : public IdealGasReactor
+{
+public:
+    virtual bool getMultiplierDerivativeProducts(doublereal t,
+            const doublereal* lambda, doublereal* prod) {
+        return false;
+    }
+};
+
+class ReactorAdjointTest : public testing::Test
+{
+public:
+    ReactorAdjointTest() : gas("h2o2.xml", "ohmech") {
+        gas.setState_TPX(1000.0, OneAtm, "H2:2.0, O2:1.0, AR:5.0");
+        gas.saveState(state0);
+    }
+
+    //! Integrate a network containing *r* to *tf*, and return the value of
+    //! *component* at that time
+    double integrate(Reactor& r, double tf, const std::string& component) {
+        gas.restoreState(state0);
+        r.insert(gas);
+        ReactorNet net;
+        net.addReactor(r);
+        net.setTolerances(1e-11, 1e-20);
+        net.advance(tf);
+        return net.integrator().solution(net.globalComponentIndex(component));
+    }
+
+    //! Compare the adjoint sensitivities of *component* at *tf* with
+    //! central differences for the reactions in *rxns*
+    void check(Reactor& r, double tf, const std::string& component,
+               const std::vector<size_t>& rxns, size_t interval) {
+        gas.restoreState(state0);
+        r.insert(gas);
+        ReactorNet net;
+        net.addReactor(r);
+        net.setTolerances(1e-11, 1e-20);
+        net.setSensitivityTolerances(1e-8, 1e-10);
+        net.setAdjointCheckpointInterval(interval);
+        ASSERT_EQ(gas.nReactions(), net.nAdjointParams());
+        vector_fp sens(net.nAdjointParams());
+        net.advanceAdjoint(tf, component, &sens[0]);
+        EXPECT_DOUBLE_EQ(tf, net.time());
+        double y0 = net.integrator().solution(
+                        net.globalComponentIndex(component));
+        EXPECT_NEAR(integrate(r, tf, component), y0, 1e-7 * std::abs(y0));
+
+        double dp = 1e-4;
+        for (size_t m = 0; m < rxns.size(); m++) {
+            size_t i = rxns[m];
+            gas.setMultiplier(i, 1.0 + dp);
+            double yp = integrate(r, tf, component);
+            gas.setMultiplier(i, 1.0 - dp);
+            double ym = integrate(r, tf, component);
+            gas.setMultiplier(i, 1.0);
+            double fd = (yp - ym) / (2 * dp * y0);
+            EXPECT_NEAR(fd, sens[i], 1e-3 * std::abs(fd) + 1e-6)
+                << "reaction " << i;
+        }
+    }
+
+    //! Compare the products given by getMultiplierDerivativeProducts with
+    //! those formed from the finite difference derivatives
+    void checkProducts(Reactor& r) {
+        gas.restoreState(state0);
+        r.insert(gas);
+        ReactorNet net;
+        net.addReactor(r);
+        net.advance(2e-4);
+
+        size_t nv = net.neq();
+        size_t nr = gas.nReactions();
+        vector_fp y(nv), lambda(nv), prod(nr);
+        net.getInitialConditions(0.0, nv, &y[0]);
+        net.updateState(&y[0]);
+        for (size_t j = 0; j < nv; j++) {
+            lambda[j] = (j % 3 + 1.0) / std::max(std::abs(y[j]), 1e-8);
+        }
+        Array2D dfdp;
+        r.getMultiplierDerivatives(0.0, &y[0], 0, dfdp);
+        ASSERT_EQ(nv, dfdp.nRows());
+        ASSERT_EQ(nr, dfdp.nColumns());
+        ASSERT_TRUE(r.getMultiplierDerivativeProducts(0.0, &lambda[0],
+                                                      &prod[0]));
+        for (size_t i = 0; i < nr; i++) {
+            double fd = 0.0, scale = 0.0;
+            for (size_t j = 0; j < nv; j++) {
+                fd += lambda[j] * dfdp(j, i);
+                scale += std::abs(lambda[j] * dfdp(j, i));
+            }
+            EXPECT_NEAR(fd, prod[i], 1e-6 * scale) << "reaction " << i;
+        }
+    }
+
+    IdealGasMix gas;
+    vector_fp state0;
+};
+
+TEST_F(ReactorAdjointTest, products_Reactor)
+{
+    Reactor r;
+    checkProducts(r);
+}
+
+TEST_F(ReactorAdjointTest, products_IdealGasReactor)
+{
+    IdealGasReactor r;
+    checkProducts(r);
+}
+
+TEST_F(ReactorAdjointTest, products_ConstPressureReactor)
+{
+    ConstPressureReactor r;
+    checkProducts(r);
+}
+
+TEST_F(ReactorAdjointTest, products_IdealGasConstPressureReactor)
+{
+    IdealGasConstPressureReactor r;
+    checkProducts(r);
+}
+
+TEST_F(ReactorAdjointTest, IdealGasReactor_temperature)
+{
+    IdealGasReactor r;
+    std::vector<size_t> rxns;
+    rxns.push_back(2); // H2 + O <=> H + OH
+    rxns.push_back(5); // H + O2 + M <=> HO2 + M
+    rxns.push_back(9); // H + O2 <=> O + OH
+    rxns.push_back(16); // H + HO2 <=> 2 OH
+    rxns.push_back(19); // H2 + OH <=> H + H2O
+    check(r, 2.5e-4, "T", rxns, 100);
+}
+
+// Base Reactor without an analytic Jacobian, with frequent checkpoints
+TEST_F(ReactorAdjointTest, Reactor_OH)
+{
+    Reactor r;
+    std::vector<size_t> rxns;
+    rxns.push_back(0);
+    rxns.push_back(9);
+    rxns.push_back(17);
+    rxns.push_back(26);
+    check(r, 2e-4, "OH", rxns, 7);
+}
+
+TEST_F(ReactorAdjointTest, IdealGasConstPressureReactor_H2O)
+{
+    IdealGasConstPressureReactor r;
+    std::vector<size_t> rxns;
+    rxns.push_back(5);
+    rxns.push_back(9);
+    rxns.push_back(15);
+    rxns.push_back(19);
+    check(r, 2.5e-4, "H2O", rxns, 20);
+}
+
+TEST_F(ReactorAdjointTest, finite_difference_multipliers)
+{
+    FiniteDifferenceReactor r;
+    std::vector<size_t> rxns;
+    rxns.push_back(5);
+    rxns.push_back(9);
+    rxns.push_back(16);
+    check(r, 2.5e-4, "T", rxns, 50);
+}
+
+TEST_F(ReactorAdjointTest, checkpoint_interval)
+{
+    IdealGasReactor r1, r2;
+    vector_fp sens1(gas.nReactions()), sens2(gas.nReactions());
+    r1.insert(gas);
+    ReactorNet net1;
+    net1.addReactor(r1);
+    net1.setSensitivityTolerances(1e-7, 1e-9);
+    net1.setAdjointCheckpointInterval(3);
+    net1.advanceAdjoint(2.5e-4, "T", &sens1[0]);
+
+    gas.restoreState(state0);
+    r2.insert(gas);
+    ReactorNet net2;
+    net2.addReactor(r2);
+    net2.setSensitivityTolerances(1e-7, 1e-9);
+    net2.setAdjointCheckpointInterval(100000);
+    net2.advanceAdjoint(2.5e-4, "T", &sens2[0]);
+    for (size_t i = 0; i < sens1.size(); i++) {
+        EXPECT_NEAR(sens2[i], sens1[i], 1e-4 * std::abs(sens2[i]) + 1e-7);
+    }
+
+    // integration can continue from the final state
+    net1.advance(4e-4);
+    net2.advance(4e-4);
+    EXPECT_NEAR(r1.temperature(), r2.temperature(), 1e-6);
+}
+
+TEST_F(ReactorAdjointTest, invalid_time)
+{
+    IdealGasReactor r;
+    r.insert(gas);
+    ReactorNet net;
+    net.addReactor(r);
+    net.advance(1e-5);
+    vector_fp sens(gas.nReactions());
+    EXPECT_THROW(net.advanceAdjoint(1e-5, "T", &sens[0]), CanteraError);
+}
+
+}
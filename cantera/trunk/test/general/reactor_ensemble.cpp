@@ -0,0 +1,164 @@
+#include "gtest/gtest.h"
+#include "cantera/zeroD/ReactorNetEnsemble.h"
+#include "cantera/zeroD/IdealGasReactor.h"
+#include "cantera/zeroD/Reservoir.h"
+#include "cantera/zeroD/Wall.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+class ReactorNetEnsembleTest : public testing::Test
+{
+public:
+    ReactorNetEnsembleTest() :
+        gas("h2o2.xml", "ohmech"),
+        air("air.xml", "air")
+    {
+        gas.setState_TPX(1000.0, OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+        r.insert(gas);
+        air.setState_TPX(300.0, OneAtm, "O2:0.21, N2:0.79");
+        env.insert(air);
+        w.install(r, env);
+        w.setHeatTransferCoeff(50.0);
+        net.addReactor(r);
+    }
+
+    //! Integrate the template network directly, starting at (T, P, X)
+    void ignite(double T, double P, const std::string& X, double tEnd,
+                double& tau, double& Tfinal) {
+        gas.setState_TPX(T, P, X);
+        r.insert(gas);
+        ReactorNet net2;
+        net2.addReactor(r);
+        net2.setTolerances(net.rtol(), net.atol());
+        net2.setLinearSolverType(net.linearSolverType());
+        net2.setMaxTimeStep(net.maxTimeStep());
+        net2.setMaxErrTestFails(net.maxErrTestFails());
+        double t = 0.0, dTdt_max = -BigNumber;
+        Tfinal = r.temperature();
+        while (t < tEnd) {
+            double tprev = t, Tprev = Tfinal;
+            t = net2.step(tEnd);
+            Tfinal = r.temperature();
+            if ((Tfinal - Tprev) / (t - tprev) > dTdt_max) {
+                dTdt_max = (Tfinal - Tprev) / (t - tprev);
+                tau = 0.5 * (t + tprev);
+            }
+        }
+    }
+
+    IdealGasMix gas;
+    IdealGasMix air;
+    IdealGasReactor r;
+    Reservoir env;
+    Wall w;
+    ReactorNet net;
+};
+
+TEST_F(ReactorNetEnsembleTest, ignition_delay)
+{
+    ReactorNetEnsemble ensemble(net);
+    // template state is not modified by the constructor
+    EXPECT_DOUBLE_EQ(1000.0, gas.temperature());
+    EXPECT_DOUBLE_EQ(300.0, air.temperature());
+
+    double T0[] = {950.0, 1000.0, 1100.0, 1200.0, 1050.0};
+    std::string X = "H2:2.0, O2:1.0, AR:4.0";
+    for (size_t i = 0; i < 5; i++) {
+        EXPECT_EQ(i, ensemble.addCase(T0[i], 2*OneAtm, X));
+    }
+    ensemble.run(0.005, 3);
+
+    for (size_t i = 0; i < 5; i++) {
+        double tau = 0.0, Tfinal = 0.0;
+        ignite(T0[i], 2*OneAtm, X, 0.005, tau, Tfinal);
+        EXPECT_EQ("", ensemble.error(i));
+        EXPECT_DOUBLE_EQ(tau, ensemble.ignitionDelay(i));
+        EXPECT_DOUBLE_EQ(Tfinal, ensemble.finalTemperature(i));
+        EXPECT_TRUE(ensemble.times(i).empty());
+    }
+
+    // the ignition delay decreases with increasing initial temperature
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 5; j++) {
+            if (T0[i] < T0[j]) {
+                EXPECT_GT(ensemble.ignitionDelay(i), ensemble.ignitionDelay(j))
+                    << "T0 = " << T0[i] << ", " << T0[j];
+            }
+        }
+    }
+}
+
+TEST_F(ReactorNetEnsembleTest, template_settings)
+{
+    std::string X = "H2:2.0, O2:1.0, AR:4.0";
+    ReactorNetEnsemble reference(net);
+    reference.addCase(1000.0, 2*OneAtm, X);
+    reference.run(0.005);
+
+    net.setTolerances(1e-8, 1e-14);
+    net.setLinearSolverType("GMRES");
+    net.setMaxTimeStep(2e-4);
+    net.setMaxErrTestFails(5);
+    for (size_t i = 0; i < gas.nReactions(); i++) {
+        gas.setMultiplier(i, 2.0);
+    }
+    ReactorNetEnsemble ensemble(net);
+    ensemble.addCase(1000.0, 2*OneAtm, X);
+    ensemble.setSaveHistory();
+    ensemble.run(0.005);
+
+    // The copy of the network integrates exactly like the template
+    double tau = 0.0, Tfinal = 0.0;
+    ignite(1000.0, 2*OneAtm, X, 0.005, tau, Tfinal);
+    EXPECT_EQ("", ensemble.error(0));
+    EXPECT_DOUBLE_EQ(tau, ensemble.ignitionDelay(0));
+    EXPECT_DOUBLE_EQ(Tfinal, ensemble.finalTemperature(0));
+
+    // Faster reactions give a shorter ignition delay
+    EXPECT_LT(ensemble.ignitionDelay(0), 0.8 * reference.ignitionDelay(0));
+
+    const vector_fp& t = ensemble.times(0);
+    ASSERT_GT(t.size(), (size_t) 1);
+    EXPECT_LE(t[0], 2e-4 * (1 + 1e-10));
+    for (size_t n = 1; n < t.size(); n++) {
+        EXPECT_LE(t[n] - t[n-1], 2e-4 * (1 + 1e-10));
+    }
+}
+
+TEST_F(ReactorNetEnsembleTest, history)
+{
+    ReactorNetEnsemble ensemble(net);
+    ensemble.addCase(1100.0, OneAtm, "H2:1.0, O2:1.0, AR:2.0");
+    ensemble.addCase(1100.0, OneAtm, "H2:1.0, O2:1.0, AR:2.0");
+    ensemble.setSaveHistory();
+    ensemble.run(0.002, 2);
+    ASSERT_EQ(gas.nSpecies() + 3, ensemble.neq());
+    for (size_t i = 0; i < 2; i++) {
+        const vector_fp& t = ensemble.times(i);
+        const vector_fp& y = ensemble.solution(i);
+        ASSERT_GT(t.size(), (size_t) 10);
+        EXPECT_GE(t.back(), 0.002);
+        EXPECT_EQ(t.size() * ensemble.neq(), y.size());
+        // component 2 of an IdealGasReactor is the temperature
+        EXPECT_DOUBLE_EQ(ensemble.finalTemperature(i), y[y.size() - ensemble.neq() + 2]);
+    }
+    EXPECT_EQ(ensemble.times(0), ensemble.times(1));
+    EXPECT_EQ(ensemble.solution(0), ensemble.solution(1));
+}
+
+TEST_F(ReactorNetEnsembleTest, errors)
+{
+    ReactorNetEnsemble ensemble(net);
+    EXPECT_THROW(ensemble.addCase(1000.0, OneAtm, "H2:1.0", 1), CanteraError);
+    ensemble.addCase(1000.0, OneAtm, "H2:1.0, O2:1.0");
+    ensemble.addCase(1000.0, OneAtm, "H2:1.0, XX:1.0");
+    ensemble.run(1e-4);
+    EXPECT_EQ("", ensemble.error(0));
+    EXPECT_NE("", ensemble.error(1));
+    EXPECT_TRUE(ensemble.ignitionDelay(1) != ensemble.ignitionDelay(1)); // NaN
+    EXPECT_THROW(ensemble.ignitionDelay(2), CanteraError);
+}
+
+}
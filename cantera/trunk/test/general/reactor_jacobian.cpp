@@ -0,0 +1,187 @@
+#include "gtest/gtest.h"
+#include "cantera/zeroD/IdealGasReactor.h"
+#include "cantera/zeroD/IdealGasConstPressureReactor.h"
+#include "cantera/zeroD/ReactorNet.h"
+#include "cantera/zeroD/Reservoir.h"
+#include "cantera/zeroD/flowControllers.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+class ReactorJacobianTest : public testing::Test
+{
+public:
+    ReactorJacobianTest() :
+        gas("gri30.xml", "gri30"),
+        feed("gri30.xml", "gri30")
+    {
+        gas.setState_TPX(1500.0, 2 * OneAtm, "CH4:0.05, O2:0.18, N2:0.7, "
+                         "AR:0.01, H2O:0.03, CO:0.01, H:0.002, OH:0.003, "
+                         "O:0.001, CH3:0.001, HO2:0.0005");
+        feed.setState_TPX(400.0, 2 * OneAtm, "CH4:1.0, O2:2.0, N2:7.52");
+        upstream.insert(feed);
+        downstream.insert(feed);
+    }
+
+    //! Compare the analytic Jacobian of a network containing *r* with a
+    //! central difference approximation.
+    void check(Reactor& r, bool flow) {
+        r.insert(gas);
+        ReactorNet net;
+        net.addReactor(r);
+        MassFlowController inlet, outlet;
+        if (flow) {
+            inlet.install(upstream, r);
+            inlet.setMassFlowRate(0.02);
+            outlet.install(r, downstream);
+            outlet.setMassFlowRate(0.03);
+        }
+        net.advance(1e-6);
+
+        size_t nv = net.neq();
+        vector_fp y(nv), ydot(nv), yp(nv), ydotp(nv), ydotm(nv);
+        net.getInitialConditions(0.0, nv, &y[0]);
+        Array2D J(nv, nv), Jfd(nv, nv);
+        ASSERT_TRUE(net.getJacobian(0.0, &y[0], &ydot[0], 0, J));
+
+        for (size_t j = 0; j < nv; j++) {
+            double dy = 1e-6 * std::abs(y[j]) + 1e-14;
+            yp = y;
+            yp[j] = y[j] + dy;
+            net.eval(0.0, &yp[0], &ydotp[0], 0);
+            yp[j] = y[j] - dy;
+            net.eval(0.0, &yp[0], &ydotm[0], 0);
+            for (size_t i = 0; i < nv; i++) {
+                Jfd(i,j) = (ydotp[i] - ydotm[i]) / (2 * dy);
+            }
+        }
+        net.updateState(&y[0]);
+
+        // scale each row by the largest change in the rate of change of
+        // state variable i caused by a unit relative change in any of the
+        // state variables. Rows for inert species (e.g. AR, which appears in
+        // reactions only as a collision partner) contain only round-off
+        // error, so the scale is bounded below by that of the other rows.
+        vector_fp scale(nv, 0.0);
+        for (size_t i = 0; i < nv; i++) {
+            for (size_t j = 0; j < nv; j++) {
+                scale[i] = std::max(scale[i], std::abs(Jfd(i,j) * y[j]));
+            }
+        }
+        double maxScale = *std::max_element(scale.begin() + 3, scale.end());
+        for (size_t i = 0; i < nv; i++) {
+            scale[i] = std::max(scale[i], 1e-6 * maxScale);
+            for (size_t j = 0; j < nv; j++) {
+                double yscale = std::max(std::abs(y[j]), 1e-10);
+                EXPECT_NEAR(Jfd(i,j), J(i,j),
+                            1e-5 * std::abs(Jfd(i,j)) + 1e-6 * scale[i] / yscale)
+                    << "i = " << i << ", j = " << j;
+            }
+        }
+    }
+
+    IdealGasMix gas;
+    IdealGasMix feed;
+    Reservoir upstream;
+    Reservoir downstream;
+};
+
+TEST_F(ReactorJacobianTest, const_volume)
+{
+    IdealGasReactor r;
+    check(r, false);
+}
+
+TEST_F(ReactorJacobianTest, const_volume_flow)
+{
+    IdealGasReactor r;
+    check(r, true);
+}
+
+TEST_F(ReactorJacobianTest, const_pressure)
+{
+    IdealGasConstPressureReactor r;
+    check(r, false);
+}
+
+TEST_F(ReactorJacobianTest, const_pressure_flow)
+{
+    IdealGasConstPressureReactor r;
+    check(r, true);
+}
+
+TEST_F(ReactorJacobianTest, no_energy)
+{
+    IdealGasReactor r;
+    r.setEnergy(0);
+    check(r, true);
+}
+
+TEST_F(ReactorJacobianTest, base_reactor)
+{
+    // The general Reactor class does not provide a Jacobian
+    Reactor r;
+    r.insert(gas);
+    ReactorNet net;
+    net.addReactor(r);
+    net.advance(1e-6);
+    size_t nv = net.neq();
+    vector_fp y(nv), ydot(nv);
+    Array2D J(nv, nv);
+    net.getInitialConditions(0.0, nv, &y[0]);
+    EXPECT_FALSE(net.getJacobian(0.0, &y[0], &ydot[0], 0, J));
+}
+
+//! Counts the Jacobian evaluations requested by the integrator
+class CountingReactorNet : public ReactorNet
+{
+public:
+    CountingReactorNet() : nJacobians(0) {}
+    virtual bool getJacobian(doublereal t, doublereal* y, doublereal* ydot,
+                             doublereal* p, Array2D& J) {
+        nJacobians++;
+        return ReactorNet::getJacobian(t, y, ydot, p, J);
+    }
+    int nJacobians;
+};
+
+#ifdef HAS_SUNDIALS
+TEST_F(ReactorJacobianTest, integrate)
+{
+    // CVODES does not use the analytic Jacobian
+    ReactorNet net;
+    EXPECT_THROW(net.setLinearSolverType("DENSE_ANALYTIC"), CanteraError);
+}
+#else
+TEST_F(ReactorJacobianTest, integrate)
+{
+    // Integration using the analytic Jacobian gives the same result as
+    // integration with a finite difference Jacobian
+    gas.setState_TPX(1300.0, OneAtm, "CH4:1.0, O2:2.0, N2:7.52");
+    vector_fp T(2), Y(2);
+    const char* solvers[] = {"DENSE", "DENSE_ANALYTIC"};
+    for (size_t n = 0; n < 2; n++) {
+        IdealGasConstPressureReactor r;
+        r.insert(gas);
+        CountingReactorNet net;
+        net.addReactor(r);
+        net.setLinearSolverType(solvers[n]);
+        net.setTolerances(1e-9, 1e-15);
+        net.advance(0.1);
+        // The integrator uses the analytic Jacobian only if requested
+        if (n == 0) {
+            EXPECT_EQ(0, net.nJacobians);
+        } else {
+            EXPECT_GT(net.nJacobians, 0);
+        }
+        T[n] = r.temperature();
+        Y[n] = r.massFraction(gas.speciesIndex("CO2"));
+    }
+    EXPECT_GT(T[0], 2000.0);
+    EXPECT_NEAR(T[0], T[1], 1e-4 * T[0]);
+    EXPECT_NEAR(Y[0], Y[1], 1e-4 * Y[0]);
+}
+#endif
+
+} // namespace Cantera
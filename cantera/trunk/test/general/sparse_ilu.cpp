@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+#include "cantera/numerics/SparseILU.h"
+#include "cantera/numerics/DenseMatrix.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/zeroD/Reactor.h"
+#include "cantera/zeroD/ReactorNet.h"
+
+namespace Cantera
+{
+
+//! Linear system dy/dt = A*y with a tridiagonal matrix A
+class TridiagonalSystem : public FuncEval
+{
+public:
+    explicit TridiagonalSystem(size_t n) : A(n, n, 0.0) {
+        for (size_t i = 0; i < n; i++) {
+            A(i,i) = -2.0 - 0.1 * i;
+            if (i > 0) {
+                A(i,i-1) = 1.0 + 0.05 * i;
+            }
+            if (i + 1 < n) {
+                A(i,i+1) = 0.7;
+            }
+        }
+    }
+    virtual void eval(double t, double* y, double* ydot, double* p) {
+        A.mult(y, ydot);
+    }
+    virtual void getInitialConditions(double t0, size_t leny, double* y) {
+        std::fill(y, y + leny, 1.0);
+    }
+    virtual size_t neq() {
+        return A.nRows();
+    }
+    virtual void getJacobianSparsity(std::vector<size_t>& colStart,
+                                     std::vector<size_t>& rowIndex) {
+        colStart.assign(1, 0);
+        rowIndex.clear();
+        for (size_t j = 0; j < neq(); j++) {
+            for (size_t i = (j > 0) ? j - 1 : 0; i < std::min(j + 2, neq()); i++) {
+                rowIndex.push_back(i);
+            }
+            colStart.push_back(rowIndex.size());
+        }
+    }
+    DenseMatrix A;
+};
+
+TEST(SparseILU, tridiagonal)
+{
+    size_t n = 20;
+    TridiagonalSystem f(n);
+    std::vector<size_t> colStart, rowIndex;
+    f.getJacobianSparsity(colStart, rowIndex);
+    SparseILU ilu;
+    ilu.setPattern(n, colStart, rowIndex);
+    EXPECT_EQ((size_t) 3, ilu.nColumnGroups());
+    EXPECT_EQ(3*n - 2, ilu.nNonzeros());
+
+    vector_fp y(n), ydot(n), ewt(n, 1e8);
+    f.getInitialConditions(0.0, n, &y[0]);
+    f.eval(0.0, &y[0], &ydot[0], 0);
+    ilu.evalJacobian(f, 0.0, &y[0], &ydot[0], &ewt[0]);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_DOUBLE_EQ(1.0, y[i]);
+        for (size_t j = 0; j < n; j++) {
+            EXPECT_NEAR(f.A(i,j), ilu.jacobian(i,j), 1e-6);
+        }
+    }
+
+    // There is no fill-in for a tridiagonal matrix, so the incomplete
+    // factorization is exact.
+    double gamma = 0.3;
+    ASSERT_EQ(0, ilu.factor(gamma));
+    DenseMatrix P(n, n, 0.0);
+    vector_fp b(n), x(n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            P(i,j) = (i == j) - gamma * ilu.jacobian(i,j);
+        }
+        b[i] = sin(1.0 + i);
+    }
+    ilu.solve(&b[0], &x[0]);
+    solve(P, &b[0]);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(b[i], x[i], 1e-12);
+    }
+}
+
+TEST(SparseILU, dense_pattern)
+{
+    size_t n = 5;
+    TridiagonalSystem f(n);
+    std::vector<size_t> colStart, rowIndex;
+    f.FuncEval::getJacobianSparsity(colStart, rowIndex);
+    SparseILU ilu;
+    ilu.setPattern(n, colStart, rowIndex);
+    EXPECT_EQ(n, ilu.nColumnGroups());
+    EXPECT_EQ(n*n, ilu.nNonzeros());
+}
+
+#ifdef HAS_SUNDIALS
+TEST(SparseILU, reactor_ignition)
+{
+    // The ILU preconditioner is not available with CVODES
+    ReactorNet net;
+    EXPECT_THROW(net.setLinearSolverType("ILU_GMRES"), CanteraError);
+}
+#else
+TEST(SparseILU, reactor_ignition)
+{
+    IdealGasMix gas("gri30.xml", "gri30");
+    double T[2];
+    for (int n = 0; n < 2; n++) {
+        gas.setState_TPX(1000.0, OneAtm, "H2:2.0, O2:1.0, N2:3.76");
+        Reactor r;
+        r.insert(gas);
+        ReactorNet net;
+        net.addReactor(r);
+        if (n == 1) {
+            net.setLinearSolverType("ILU_GMRES");
+        }
+        net.advance(0.01);
+        T[n] = r.temperature();
+    }
+    EXPECT_GT(T[0], 2000);
+    EXPECT_NEAR(T[0], T[1], 1e-3 * T[0]);
+}
+#endif
+
+}
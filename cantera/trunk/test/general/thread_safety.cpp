@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "cantera/base/ct_thread.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/zeroD/Reactor.h"
+#include "cantera/zeroD/ReactorNet.h"
+
+#ifdef THREAD_SAFE_CANTERA
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+namespace Cantera
+{
+
+#ifdef THREAD_SAFE_CANTERA
+
+//! Integrate an adiabatic, constant volume H2/O2 reactor through ignition,
+//! creating all of the objects used.
+void ignite(double T0, double* T, double* nsteps)
+{
+    IdealGasMix gas("h2o2.xml", "ohmech");
+    gas.setState_TPX(T0, OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+    Reactor r;
+    r.insert(gas);
+    ReactorNet net;
+    net.addReactor(r);
+    double t = 0.0;
+    *nsteps = 0;
+    while (t < 0.01) {
+        t = net.step(0.01);
+        *nsteps += 1;
+    }
+    *T = r.temperature();
+}
+
+TEST(ThreadSafety, concurrent_reactor_networks)
+{
+    const size_t nThreads = 8;
+    const size_t nRepeat = 4;
+    vector_fp Tref(nThreads), stepsRef(nThreads);
+    for (size_t i = 0; i < nThreads; i++) {
+        ignite(1000.0 + 10*i, &Tref[i], &stepsRef[i]);
+        EXPECT_GT(Tref[i], 2000.0);
+    }
+
+    // Each thread creates and integrates its own objects. The results should
+    // be identical to those computed serially.
+    for (size_t rep = 0; rep < nRepeat; rep++) {
+        vector_fp T(nThreads), steps(nThreads);
+        boost::thread_group threads;
+        for (size_t i = 0; i < nThreads; i++) {
+            threads.create_thread(boost::bind(ignite, 1000.0 + 10*i,
+                                              &T[i], &steps[i]));
+        }
+        threads.join_all();
+        for (size_t i = 0; i < nThreads; i++) {
+            EXPECT_EQ(Tref[i], T[i]);
+            EXPECT_EQ(stepsRef[i], steps[i]);
+        }
+    }
+}
+
+#else
+
+// Cantera was compiled without build_thread_safe, so the tests above can't be
+// run. Report a disabled test so that this is visible in the test output.
+TEST(ThreadSafety, DISABLED_requires_build_thread_safe) {}
+
+#endif
+
+}
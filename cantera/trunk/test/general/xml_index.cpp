@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "cantera/base/ctml.h"
+
+#include <sstream>
+
+namespace Cantera
+{
+
+TEST(XmlIndex, same_results_when_locked)
+{
+    XML_Node* doc = get_XML_File("gri30.xml");
+    XML_Node tree(*doc);
+    std::vector<XML_Node*> species =
+        tree.findID("species_data", 3)->getChildren("species");
+    std::vector<XML_Node*> reactions =
+        tree.findID("reaction_data", 3)->getChildren("reaction");
+    ASSERT_GT(species.size(), (size_t) 0);
+    ASSERT_GT(reactions.size(), (size_t) 0);
+
+    std::vector<XML_Node*> expected;
+    for (int locked = 0; locked < 2; locked++) {
+        if (locked) {
+            tree.lock();
+        }
+        std::vector<XML_Node*> found;
+        for (size_t k = 0; k < species.size(); k++) {
+            found.push_back(tree.findByAttr("name", species[k]->attrib("name")));
+            found.push_back(tree.findByAttr("name", species[k]->attrib("name"), 1));
+        }
+        for (size_t i = 0; i < reactions.size(); i++) {
+            found.push_back(tree.findID(reactions[i]->id()));
+            found.push_back(tree.findID(reactions[i]->id(), 2));
+        }
+        found.push_back(tree.findID("gri30_mix"));
+        found.push_back(tree.findID("no_such_id"));
+        found.push_back(tree.findNameID("phase", "gri30_multi"));
+        found.push_back(tree.findNameID("species", "gri30_mix"));
+        found.push_back(findXMLPhase(&tree, "gri30_mix"));
+        found.push_back(tree.findByAttr("title", "GRI-Mech 3.0"));
+        if (locked) {
+            ASSERT_EQ(expected.size(), found.size());
+            for (size_t i = 0; i < found.size(); i++) {
+                EXPECT_EQ(expected[i], found[i]) << "i = " << i;
+            }
+        } else {
+            expected = found;
+        }
+    }
+    EXPECT_EQ(species[0], expected[0]);
+    EXPECT_EQ((XML_Node*) 0, expected[1]);
+    EXPECT_EQ(reactions[0], expected[2 * species.size()]);
+    tree.unlock();
+}
+
+TEST(XmlIndex, modified_tree)
+{
+    XML_Node* doc = get_XML_File("gri30.xml");
+    XML_Node tree(*doc);
+    tree.lock();
+    XML_Node* phase = findXMLPhase(&tree, "gri30_mix");
+    ASSERT_TRUE(phase != 0);
+    phase->addAttribute("id", "renamed");
+    EXPECT_EQ(phase, findXMLPhase(&tree, "renamed"));
+    EXPECT_EQ((XML_Node*) 0, tree.findID("gri30_mix"));
+
+    XML_Node& extra = phase->addChild("extra");
+    extra.addAttribute("name", "extra_node");
+    EXPECT_EQ(&extra, tree.findByAttr("name", "extra_node"));
+    tree.unlock();
+}
+
+TEST(XmlReader, build_from_stream)
+{
+    std::stringstream s;
+    s << "<?xml version=\"1.0\"?>\n"
+      << "<ctml>\n"
+      << "  <!-- a comment -->\n"
+      << "  <a x='1' y=\"two\">\n"
+      << "      first line\n"
+      << "      second line\n"
+      << "  </a>\n"
+      << "  <b z=\"3\"/>\n"
+      << "</ctml>\n";
+    XML_Node root;
+    root.build(s);
+    XML_Node& ctml = root.child("ctml");
+    ASSERT_EQ((size_t) 3, ctml.nChildren());
+    EXPECT_TRUE(ctml.child(0).isComment());
+    EXPECT_EQ(" a comment ", ctml.child(0).value());
+    EXPECT_EQ("first line\n second line", ctml.child("a").value());
+    EXPECT_EQ("1", ctml.child("a")["x"]);
+    EXPECT_EQ("two", ctml.child("a")["y"]);
+    EXPECT_EQ("3", ctml.child("b")["z"]);
+    EXPECT_EQ(7, ctml.child("b").lineNumber());
+}
+
+}
@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "cantera/kinetics/BatchEvaluator.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+//! Check the results of BatchEvaluator against the rates and enthalpies
+//! computed by setting each state of *gas*.
+void checkBatch(IdealGasMix& gas, size_t nStates, const double* T,
+                const double* P, const vector_fp& Y, size_t blockSize)
+{
+    size_t nsp = gas.nSpecies();
+    BatchEvaluator batch(gas);
+    EXPECT_TRUE(batch.vectorized());
+    batch.setBlockSize(blockSize);
+    vector_fp wdot(nsp * nStates), hbar(nsp * nStates), h(nStates);
+    batch.eval(nStates, T, P, &Y[0], &wdot[0], &hbar[0], &h[0]);
+
+    vector_fp y(nsp), wdot1(nsp), hbar1(nsp);
+    for (size_t n = 0; n < nStates; n++) {
+        for (size_t k = 0; k < nsp; k++) {
+            y[k] = Y[k*nStates + n];
+        }
+        gas.setState_TPY(T[n], P[n], &y[0]);
+        gas.getNetProductionRates(&wdot1[0]);
+        gas.getPartialMolarEnthalpies(&hbar1[0]);
+        EXPECT_DOUBLE_EQ(gas.enthalpy_mass(), h[n]);
+        double scale = 0.0;
+        for (size_t k = 0; k < nsp; k++) {
+            scale = std::max(scale, std::abs(wdot1[k]));
+        }
+        for (size_t k = 0; k < nsp; k++) {
+            EXPECT_NEAR(wdot1[k], wdot[k*nStates + n], 1e-14 * scale)
+                << gas.speciesName(k) << " " << n;
+            EXPECT_DOUBLE_EQ(hbar1[k], hbar[k*nStates + n]);
+        }
+    }
+}
+
+class BatchEvaluatorTest : public testing::Test
+{
+public:
+    BatchEvaluatorTest() : gas("gri30.xml", "gri30"), nStates(7) {
+        double T0[] = {1500.0, 900.0, 1500.0, 2100.0, 900.0, 1200.0, 1500.0};
+        double P0[] = {OneAtm, 2*OneAtm, 5*OneAtm, OneAtm, 2*OneAtm,
+                       0.5*OneAtm, OneAtm};
+        T.assign(T0, T0 + nStates);
+        P.assign(P0, P0 + nStates);
+        size_t nsp = gas.nSpecies();
+        Y.resize(nsp * nStates);
+        for (size_t n = 0; n < nStates; n++) {
+            gas.setState_TPX(T[n], P[n], "CH4:" + fp2str(1.0 + 0.1*n) +
+                             ", O2:2.0, N2:7.52, OH:0.01, H:0.02, O:0.005, "
+                             "CO:0.1, H2O:0.2, HO2:0.001, CH3:0.003");
+            for (size_t k = 0; k < nsp; k++) {
+                Y[k*nStates + n] = gas.massFraction(k);
+            }
+        }
+        gas.setState_TPX(300, OneAtm, "AR:1.0");
+    }
+
+protected:
+    IdealGasMix gas;
+    size_t nStates;
+    vector_fp T, P, Y;
+};
+
+TEST_F(BatchEvaluatorTest, matches_single_states)
+{
+    checkBatch(gas, nStates, &T[0], &P[0], Y, 64);
+    // the state of the phase is not used
+    gas.setState_TPX(300, OneAtm, "AR:1.0");
+    checkBatch(gas, nStates, &T[0], &P[0], Y, 64);
+}
+
+TEST_F(BatchEvaluatorTest, block_size)
+{
+    // blocks of 3, 3 and 1 states
+    checkBatch(gas, nStates, &T[0], &P[0], Y, 3);
+    checkBatch(gas, nStates, &T[0], &P[0], Y, 1);
+}
+
+TEST_F(BatchEvaluatorTest, rate_multipliers)
+{
+    for (size_t i = 0; i < gas.nReactions(); i++) {
+        gas.setMultiplier(i, 1.0 + 0.01 * (i % 7));
+    }
+    checkBatch(gas, nStates, &T[0], &P[0], Y, 4);
+}
+
+TEST(BatchEvaluator, pdep)
+{
+    // P-log and Chebyshev reactions
+    IdealGasMix gas("../data/pdep-test.xml", "gas");
+    size_t nsp = gas.nSpecies();
+    const size_t nStates = 5;
+    double T[] = {500.0, 900.0, 1100.0, 900.0, 1500.0};
+    double P[] = {0.01*OneAtm, OneAtm, 8*OneAtm, 20*OneAtm, 90*OneAtm};
+    vector_fp Y(nsp * nStates);
+    for (size_t n = 0; n < nStates; n++) {
+        for (size_t k = 0; k < nsp; k++) {
+            Y[k*nStates + n] = 1.0 + 0.1 * ((k + n) % 3);
+        }
+    }
+    checkBatch(gas, nStates, T, P, Y, 2);
+}
+
+TEST(BatchEvaluator, sri_falloff)
+{
+    IdealGasMix gas("../data/sri-falloff.xml", "gas");
+    size_t nsp = gas.nSpecies();
+    const size_t nStates = 3;
+    double T[] = {600.0, 1200.0, 1800.0};
+    double P[] = {0.1*OneAtm, OneAtm, 10*OneAtm};
+    vector_fp Y(nsp * nStates);
+    for (size_t n = 0; n < nStates; n++) {
+        for (size_t k = 0; k < nsp; k++) {
+            Y[k*nStates + n] = 1.0 + 0.2 * ((k + 2*n) % 5);
+        }
+    }
+    checkBatch(gas, nStates, T, P, Y, 64);
+}
+
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include "cantera/kinetics.h"
+#include "cantera/thermo/IdealGasPhase.h"
+
+namespace Cantera
+{
+
+class ProductionRateDerivatives : public testing::Test
+{
+public:
+    void setup(const std::string& file, const std::string& id,
+               const std::string& X) {
+        thermo_.reset(newPhase(file, id));
+        std::vector<ThermoPhase*> phases;
+        phases.push_back(thermo_.get());
+        kin_.reset(newKineticsMgr(thermo_->xml(), phases));
+        nsp_ = thermo_->nSpecies();
+        if (X.empty()) {
+            vector_fp Xuniform(nsp_, 1.0 / nsp_);
+            thermo_->setState_TPX(1200, 2*OneAtm, &Xuniform[0]);
+        } else {
+            thermo_->setState_TPX(1200, 2*OneAtm, X);
+        }
+    }
+
+    //! Compare getNetProductionRates_ddC against finite differences
+    void check_ddC() {
+        vector_fp jac(nsp_ * nsp_);
+        kin_->getNetProductionRates_ddC(&jac[0]);
+
+        vector_fp conc(nsp_), conc2(nsp_), wdot1(nsp_), wdot2(nsp_);
+        thermo_->getConcentrations(&conc[0]);
+        double scale = 0.0;
+        for (size_t k = 0; k < nsp_ * nsp_; k++) {
+            scale = std::max(scale, std::abs(jac[k]));
+        }
+
+        for (size_t j = 0; j < nsp_; j++) {
+            // setConcentrations clips negative values, so species that are
+            // absent are perturbed in the positive direction only
+            double dC = 1e-6 * (conc[j] + 1e-6);
+            double Clow = std::max(conc[j] - dC, 0.0);
+            conc2 = conc;
+            conc2[j] = Clow;
+            thermo_->setConcentrations(&conc2[0]);
+            kin_->getNetProductionRates(&wdot1[0]);
+            conc2[j] = conc[j] + dC;
+            thermo_->setConcentrations(&conc2[0]);
+            kin_->getNetProductionRates(&wdot2[0]);
+            for (size_t k = 0; k < nsp_; k++) {
+                EXPECT_NEAR((wdot2[k] - wdot1[k]) / (conc2[j] - Clow),
+                            jac[k + nsp_*j], 1e-5 * scale)
+                    << "k = " << k << ", j = " << j;
+            }
+        }
+        thermo_->setConcentrations(&conc[0]);
+    }
+
+    //! Check that all nonzero elements of getNetProductionRates_ddC are
+    //! included in the pattern from getProductionRateSparsity
+    void check_sparsity() {
+        vector_fp jac(nsp_ * nsp_);
+        kin_->getNetProductionRates_ddC(&jac[0]);
+        std::vector<size_t> colStart, rowIndex;
+        kin_->getProductionRateSparsity(colStart, rowIndex);
+        ASSERT_EQ(nsp_ + 1, colStart.size());
+        for (size_t j = 0; j < nsp_; j++) {
+            std::vector<bool> nonzero(nsp_, false);
+            for (size_t p = colStart[j]; p < colStart[j+1]; p++) {
+                nonzero[rowIndex[p]] = true;
+            }
+            EXPECT_TRUE(nonzero[j]);
+            for (size_t k = 0; k < nsp_; k++) {
+                if (!nonzero[k]) {
+                    EXPECT_EQ(0.0, jac[k + nsp_*j])
+                        << "k = " << k << ", j = " << j;
+                }
+            }
+        }
+    }
+
+    //! Compare getNetProductionRates_ddT against finite differences
+    void check_ddT() {
+        vector_fp dwdot(nsp_), wdot1(nsp_), wdot2(nsp_);
+        kin_->getNetProductionRates_ddT(&dwdot[0]);
+        double scale = 0.0;
+        for (size_t k = 0; k < nsp_; k++) {
+            scale = std::max(scale, std::abs(dwdot[k]));
+        }
+
+        // constant density and composition implies constant concentrations
+        double T = thermo_->temperature();
+        double dT = 1e-5 * T;
+        thermo_->setTemperature(T - dT);
+        kin_->getNetProductionRates(&wdot1[0]);
+        thermo_->setTemperature(T + dT);
+        kin_->getNetProductionRates(&wdot2[0]);
+        for (size_t k = 0; k < nsp_; k++) {
+            EXPECT_NEAR((wdot2[k] - wdot1[k]) / (2 * dT), dwdot[k], 1e-5 * scale)
+                << "k = " << k;
+        }
+        thermo_->setTemperature(T);
+    }
+
+protected:
+    std::auto_ptr<ThermoPhase> thermo_;
+    std::auto_ptr<Kinetics> kin_;
+    size_t nsp_;
+};
+
+TEST_F(ProductionRateDerivatives, gri30)
+{
+    setup("gri30.xml", "gri30", "CH4:0.05, O2:0.18, N2:0.7, AR:0.01, H2O:0.03, "
+          "CO2:0.02, H:0.002, O:0.001, OH:0.003, CH3:0.001, HO2:0.0005, "
+          "CO:0.004, H2:0.002");
+    check_ddC();
+    check_ddT();
+    check_sparsity();
+}
+
+TEST_F(ProductionRateDerivatives, chemically_activated)
+{
+    setup("../data/chemically-activated-reaction.xml", "gas",
+          "ch3:0.1, oh:0.15, ch2o:0.05, h2:0.02, n2:0.68");
+    check_ddC();
+    check_ddT();
+}
+
+TEST_F(ProductionRateDerivatives, sri_falloff)
+{
+    setup("../data/sri-falloff.xml", "gas", "");
+    check_ddC();
+    check_ddT();
+}
+
+TEST_F(ProductionRateDerivatives, fractional_orders)
+{
+    setup("../data/frac.xml", "gas", "");
+    check_ddC();
+    check_ddT();
+    check_sparsity();
+}
+
+} // namespace Cantera
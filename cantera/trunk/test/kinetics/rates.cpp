@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "cantera/kinetics.h"
 #include "cantera/thermo/IdealGasPhase.h"
+#include "cantera/kinetics/StoichManager.h"
 
 namespace Cantera
 {
@@ -144,4 +145,61 @@ TEST_F(FracCoeffTest, EquilibriumConstants)
     EXPECT_NEAR(exp(-deltaG0_1/RT) * pow(pRef/RT, -0.5), Kc[1], 1e-13 * Kc[1]);
 }
 
+TEST(ArrheniusRateMgr, matches_Arrhenius)
+{
+    // Enough reactions for the vectorized loops to have remainders, and
+    // reaction numbers that are not in order
+    Rate1<Arrhenius> rates;
+    std::vector<Arrhenius> arrhenius;
+    size_t n = 23;
+    for (size_t i = 0; i < n; i++) {
+        arrhenius.push_back(Arrhenius((i % 4 == 3) ? -1e10 : 1e3 * (i + 1),
+                                      -1.5 + 0.25 * i, 500.0 * i));
+        rates.install((7 * i) % n, arrhenius.back());
+    }
+    EXPECT_EQ(n, rates.nReactions());
+
+    vector_fp k(n);
+    for (double T = 300.0; T < 3500.0; T += 450.0) {
+        rates.update(T, log(T), &k[0]);
+        for (size_t i = 0; i < n; i++) {
+            double kexact = arrhenius[i].updateRC(log(T), 1.0 / T);
+            EXPECT_NEAR(kexact, k[(7 * i) % n], 1e-14 * std::abs(kexact));
+        }
+    }
+}
+
+TEST(StoichManagerN, increment_species)
+{
+    // Reactions with one, two and three molecules, including repeated
+    // species, with reaction and species numbers that are not in order, and
+    // one reaction with a fractional coefficient
+    StoichManagerN stoich;
+    std::vector<size_t> k(1, 3);
+    stoich.add(4, k); // S3
+    k.push_back(1);
+    stoich.add(0, k); // S3 + S1
+    vector_fp coeffs(1, 2.0);
+    stoich.add(2, std::vector<size_t>(1, 0), coeffs, coeffs); // 2 S0
+    k.push_back(3);
+    stoich.add(1, k); // 2 S3 + S1
+    coeffs.assign(1, 0.5);
+    stoich.add(3, std::vector<size_t>(1, 1), coeffs, coeffs); // 0.5 S1
+
+    // Rates and species values that can be summed exactly
+    double R[] = {1.0, 2.0, 4.0, 8.0, 16.0};
+    vector_fp S(5, 32.0);
+    stoich.incrementSpecies(R, &S[0]);
+    EXPECT_DOUBLE_EQ(32.0 + 2*4.0, S[0]);
+    EXPECT_DOUBLE_EQ(32.0 + 1.0 + 2.0 + 0.5*8.0, S[1]);
+    EXPECT_DOUBLE_EQ(32.0, S[2]);
+    EXPECT_DOUBLE_EQ(32.0 + 16.0 + 1.0 + 2*2.0, S[3]);
+    EXPECT_DOUBLE_EQ(32.0, S[4]);
+
+    stoich.decrementSpecies(R, &S[0]);
+    for (size_t n = 0; n < S.size(); n++) {
+        EXPECT_DOUBLE_EQ(32.0, S[n]);
+    }
+}
+
 }
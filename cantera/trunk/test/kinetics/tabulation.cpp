@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+class RateTabulation : public testing::Test
+{
+public:
+    void setup(const std::string& file, const std::string& id,
+               const std::string& X) {
+        gas_.reset(new IdealGasMix(file, id));
+        if (X.empty()) {
+            size_t nsp = gas_->nSpecies();
+            vector_fp Xuniform(nsp, 1.0 / nsp);
+            gas_->setState_TPX(1000.0, OneAtm, &Xuniform[0]);
+        } else {
+            gas_->setState_TPX(1000.0, OneAtm, X);
+        }
+    }
+
+    //! Evaluate the forward rate constants, equilibrium constants and net
+    //! rates of progress at temperature *T* and pressure *P*.
+    void eval(double T, double P, vector_fp& kf, vector_fp& kc,
+              vector_fp& ropnet) {
+        size_t nr = gas_->nReactions();
+        kf.resize(nr);
+        kc.resize(nr);
+        ropnet.resize(nr);
+        gas_->setState_TP(T, P);
+        gas_->getFwdRateConstants(&kf[0]);
+        gas_->getEquilibriumConstants(&kc[0]);
+        gas_->getNetRatesOfProgress(&ropnet[0]);
+    }
+
+    //! Compare rates interpolated with tolerance *rtol* with the directly
+    //! evaluated rates at temperatures between *Tmin* and *Tmax*.
+    void check(double Tmin, double Tmax, double P, double rtol) {
+        size_t nT = 37;
+        std::vector<vector_fp> kf0(nT), kc0(nT), rop0(nT);
+        for (size_t n = 0; n < nT; n++) {
+            eval(Tmin + (Tmax - Tmin) * (n + 0.37) / nT, P, kf0[n], kc0[n],
+                 rop0[n]);
+        }
+
+        gas_->setRateTabulation(Tmin, Tmax, rtol);
+        EXPECT_GT(gas_->rateTableSize(), (size_t) 0);
+        EXPECT_LE(gas_->rateTableError(), rtol);
+
+        vector_fp kf, kc, rop;
+        for (size_t n = 0; n < nT; n++) {
+            double T = Tmin + (Tmax - Tmin) * (n + 0.37) / nT;
+            eval(T, P, kf, kc, rop);
+            double scale = 0.0;
+            for (size_t i = 0; i < kf.size(); i++) {
+                scale = std::max(scale, std::abs(rop0[n][i]));
+            }
+            for (size_t i = 0; i < kf.size(); i++) {
+                EXPECT_NEAR(kf0[n][i], kf[i], 10 * rtol * kf0[n][i])
+                    << "T = " << T << ", i = " << i;
+                EXPECT_NEAR(kc0[n][i], kc[i], 10 * rtol * kc0[n][i])
+                    << "T = " << T << ", i = " << i;
+                EXPECT_NEAR(rop0[n][i], rop[i], 100 * rtol * scale)
+                    << "T = " << T << ", i = " << i;
+            }
+        }
+
+        // Outside of the tabulated range, rates are evaluated directly
+        gas_->disableRateTabulation();
+        eval(Tmax + 100.0, P, kf0[0], kc0[0], rop0[0]);
+        gas_->setRateTabulation(Tmin, Tmax, rtol);
+        eval(Tmax + 100.0, P, kf, kc, rop);
+        for (size_t i = 0; i < kf.size(); i++) {
+            EXPECT_DOUBLE_EQ(kf0[0][i], kf[i]);
+            EXPECT_DOUBLE_EQ(kc0[0][i], kc[i]);
+        }
+        gas_->disableRateTabulation();
+        EXPECT_EQ((size_t) 0, gas_->rateTableSize());
+    }
+
+    std::auto_ptr<IdealGasMix> gas_;
+};
+
+TEST_F(RateTabulation, gri30)
+{
+    setup("gri30.xml", "gri30", "CH4:0.05, O2:0.18, N2:0.7, AR:0.01, "
+          "H2O:0.03, CO:0.01, H:0.002, OH:0.003, O:0.001, CH3:0.001");
+    check(300.0, 3000.0, OneAtm, 1e-6);
+    check(800.0, 2500.0, 10*OneAtm, 1e-4);
+}
+
+TEST_F(RateTabulation, sri_falloff)
+{
+    setup("../data/sri-falloff.xml", "gas", "");
+    check(500.0, 2500.0, 3*OneAtm, 1e-8);
+}
+
+TEST_F(RateTabulation, pdep)
+{
+    // P-log and Chebyshev rates are not tabulated, but share m_rfn with the
+    // tabulated rates
+    setup("../data/pdep-test.xml", "gas", "");
+    check(400.0, 2000.0, 5*OneAtm, 1e-8);
+}
+
+TEST_F(RateTabulation, tolerance_not_met)
+{
+    setup("gri30.xml", "gri30", "CH4:1.0, O2:2.0, N2:7.52");
+    vector_fp kf0(gas_->nReactions()), kf(gas_->nReactions());
+    gas_->getFwdRateConstants(&kf0[0]);
+    EXPECT_THROW(gas_->setRateTabulation(300.0, 3000.0, 1e-10, 17),
+                 CanteraError);
+    EXPECT_EQ((size_t) 0, gas_->rateTableSize());
+    EXPECT_DOUBLE_EQ(1000.0, gas_->temperature());
+    gas_->getFwdRateConstants(&kf[0]);
+    for (size_t i = 0; i < kf.size(); i++) {
+        EXPECT_DOUBLE_EQ(kf0[i], kf[i]);
+    }
+}
+
+} // namespace Cantera
@@ -0,0 +1,460 @@
+#include "gtest/gtest.h"
+#include "cantera/oneD/Sim1D.h"
+#include "cantera/oneD/Inlet1D.h"
+#include "cantera/oneD/StFlow.h"
+#include "cantera/oneD/MultiJac.h"
+#include "cantera/oneD/MultiNewton.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/transport.h"
+
+namespace Cantera
+{
+
+#ifdef THREAD_SAFE_CANTERA
+#define THREADED_TEST_F(fixture, name) TEST_F(fixture, name)
+#else
+// Residuals are always evaluated by a single thread, so report these tests as
+// disabled rather than running them serially.
+#define THREADED_TEST_F(fixture, name) TEST_F(fixture, DISABLED_##name)
+#endif
+
+//! Mole fraction of H2 in the fuel stream, with the balance argon
+class FuelFraction : public ContinuationParameter
+{
+public:
+    FuelFraction(Inlet1D& inlet, ThermoPhase& th) :
+        fuel(inlet), gas(th), xfuel(0.5) {}
+    doublereal value() const {
+        return xfuel;
+    }
+    void setValue(doublereal p) {
+        xfuel = p;
+        vector_fp x(gas.nSpecies(), 0.0);
+        x[gas.speciesIndex("H2")] = p;
+        x[gas.speciesIndex("AR")] = 1.0 - p;
+        fuel.setMoleFractions(&x[0]);
+    }
+    Inlet1D& fuel;
+    ThermoPhase& gas;
+    doublereal xfuel;
+};
+
+//! Counterflow H2/air diffusion flame, with an initial guess that has a
+//! temperature peak in the middle of the domain.
+class CounterflowTest : public testing::Test
+{
+public:
+    CounterflowTest() :
+        gas("h2o2.xml", "ohmech"),
+        flow(&gas, gas.nSpecies(), 12)
+    {
+        tr = newTransportMgr("Mix", &gas);
+        gas.setState_TPX(300.0, OneAtm, "H2:1.0, AR:1.0");
+        vector_fp z(12);
+        for (size_t i = 0; i < 12; i++) {
+            z[i] = 0.02 * i / 11.0;
+        }
+        flow.setupGrid(12, &z[0]);
+        flow.setTransport(*tr);
+        flow.setKinetics(gas);
+        flow.setPressure(OneAtm);
+
+        fuel.setMoleFractions("H2:1.0, AR:1.0");
+        fuel.setMdot(0.2);
+        fuel.setTemperature(300.0);
+        ox.setMoleFractions("O2:0.21, AR:0.79");
+        ox.setMdot(0.4);
+        ox.setTemperature(300.0);
+
+        std::vector<Domain1D*> domains;
+        domains.push_back(&fuel);
+        domains.push_back(&flow);
+        domains.push_back(&ox);
+        sim = new Sim1D(domains);
+
+        vector_fp locs(3), values(3);
+        locs[0] = 0.0;
+        locs[1] = 0.5;
+        locs[2] = 1.0;
+        values[0] = 300.0;
+        values[1] = 1500.0;
+        values[2] = 300.0;
+        sim->setInitialGuess("T", locs, values);
+        values[0] = 0.2;
+        values[1] = 0.0;
+        values[2] = -0.2;
+        sim->setInitialGuess("u", locs, values);
+        values[0] = 0.01;
+        values[1] = 0.01;
+        values[2] = 0.01;
+        sim->setInitialGuess("H", locs, values);
+        sim->setInitialGuess("OH", locs, values);
+        values[0] = 0.5;
+        values[1] = 0.1;
+        values[2] = 0.0;
+        sim->setInitialGuess("H2", locs, values);
+        values[0] = 0.0;
+        values[1] = 0.2;
+        values[2] = 0.0;
+        sim->setInitialGuess("H2O", locs, values);
+        values[0] = 0.0;
+        values[1] = 0.05;
+        values[2] = 0.23;
+        sim->setInitialGuess("O2", locs, values);
+    }
+
+    ~CounterflowTest() {
+        delete sim;
+        delete tr;
+    }
+
+    IdealGasMix gas;
+    Transport* tr;
+    AxiStagnFlow flow;
+    Inlet1D fuel;
+    Inlet1D ox;
+    Sim1D* sim;
+};
+
+TEST_F(CounterflowTest, colored_jacobian)
+{
+    size_t n = sim->size();
+    vector_fp x(sim->solution(), sim->solution() + n);
+    MultiJac& jac = sim->OneDim::jacobian();
+    EXPECT_TRUE(jac.coloring());
+    int nevals = jac.nEvals();
+    sim->evalSSJacobian();
+    EXPECT_EQ(nevals + 1, jac.nEvals());
+    EXPECT_GE(jac.elapsedTime(), 0.0);
+    BandMatrix colored(jac);
+
+    jac.setColoring(false);
+    sim->evalSSJacobian();
+    EXPECT_EQ(nevals + 2, jac.nEvals());
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(x[i], sim->solution()[i]);
+    }
+
+    size_t bw = sim->bandwidth();
+    for (size_t j = 0; j < n; j++) {
+        double scale = 0.0;
+        for (size_t i = (j > bw) ? j - bw : 0; i < std::min(j + bw + 1, n); i++) {
+            scale = std::max(scale, std::abs(jac.value(i,j)));
+        }
+        for (size_t i = (j > bw) ? j - bw : 0; i < std::min(j + bw + 1, n); i++) {
+            EXPECT_NEAR(jac.value(i,j), colored.value(i,j), 1e-8 * scale)
+                << "i = " << i << ", j = " << j;
+        }
+    }
+}
+
+THREADED_TEST_F(CounterflowTest, threaded_eval)
+{
+    size_t n = sim->size();
+    vector_fp x(sim->solution(), sim->solution() + n);
+    MultiJac& jac = sim->OneDim::jacobian();
+    gas.setMultiplier(3, 2.5);
+    Transport* multi = newTransportMgr("Multi", &gas);
+
+    for (int model = 0; model < 2; model++) {
+        if (model == 1) {
+            flow.setTransport(*multi, true);
+        }
+        vector_fp r1(n), r3(n);
+        sim->setNThreads(1);
+        sim->OneDim::eval(npos, &x[0], &r1[0], 0.0, 0);
+        EXPECT_EQ((size_t) 1, flow.nThreadsUsed());
+        sim->evalSSJacobian();
+        BandMatrix jac1(jac);
+
+        // results are identical for any number of threads
+        sim->setNThreads(3);
+        EXPECT_EQ((size_t) 3, flow.nThreads());
+        sim->OneDim::eval(npos, &x[0], &r3[0], 0.0, 0);
+        EXPECT_EQ((size_t) 3, flow.nThreadsUsed());
+        sim->evalSSJacobian();
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_EQ(r1[i], r3[i]) << "model = " << model << ", i = " << i;
+            for (size_t j = 0; j < n; j++) {
+                if (jac1.value(i,j) != jac.value(i,j)) {
+                    ADD_FAILURE() << "Jacobian differs for model = " << model
+                                  << ", i = " << i << ", j = " << j;
+                }
+            }
+        }
+    }
+    flow.setTransport(*tr);
+    delete multi;
+}
+
+TEST_F(CounterflowTest, block_tridiagonal)
+{
+    size_t n = sim->size();
+    MultiJac& jac = sim->OneDim::jacobian();
+    EXPECT_FALSE(jac.blockTridiagonal());
+    sim->evalSSJacobian();
+    BandMatrix band(jac);
+
+    jac.setBlockTridiagonal(true);
+    sim->evalSSJacobian();
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            if (band.value(i,j) != jac.value(i,j)) {
+                ADD_FAILURE() << "Jacobian differs for i = " << i
+                              << ", j = " << j;
+            }
+        }
+    }
+
+    vector_fp b(n), x1(n), x2(n), r(n);
+    for (size_t i = 0; i < n; i++) {
+        b[i] = 1.0 + std::sin(1.0*i);
+    }
+    ASSERT_EQ(0, band.solve(&b[0], &x1[0]));
+    ASSERT_EQ(0, jac.solve(&b[0], &x2[0]));
+    band.mult(&x2[0], &r[0]);
+    double scale = 0.0, rmax = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(x1[i], x2[i], 1e-8 * std::max(std::abs(x1[i]), 1.0));
+        double rowsum = 0.0;
+        for (size_t j = 0; j < n; j++) {
+            rowsum += std::abs(band.value(i,j) * x2[j]);
+        }
+        scale = std::max(scale, rowsum);
+        rmax = std::max(rmax, std::abs(b[i] - r[i]));
+    }
+    EXPECT_LT(rmax, 1e-12 * scale);
+
+    // the option is kept when the grid is refined
+    sim->solve(0, true);
+    EXPECT_GT(sim->points(), (size_t) 16);
+    EXPECT_TRUE(sim->OneDim::jacobian().blockTridiagonal());
+}
+
+TEST_F(CounterflowTest, remapped_jacobian)
+{
+    sim->solve(0, true);
+    sim->setRefineCriteria(1, 10.0, 0.5, 0.6);
+    sim->evalSSJacobian();
+    size_t np = sim->points();
+    ASSERT_GT(sim->refine(0), 0);
+    ASSERT_GT(sim->points(), np);
+
+    // Only the columns near the new points need to be evaluated
+    MultiJac& jac = sim->OneDim::jacobian();
+    size_t npending = jac.nPendingPoints();
+    EXPECT_GT(npending, (size_t) 0);
+    EXPECT_LT(npending, sim->points() / 2);
+
+    size_t n = sim->size();
+    vector_fp x(sim->solution(), sim->solution() + n), r(n);
+    sim->OneDim::eval(npos, &x[0], &r[0], 0.0, 0);
+    jac.evalPending(&x[0], &r[0]);
+    EXPECT_EQ((size_t) 0, jac.nPendingPoints());
+    EXPECT_EQ(1, jac.nEvals());
+    BandMatrix remapped(jac);
+
+    sim->evalSSJacobian();
+    size_t bw = sim->bandwidth();
+    for (size_t j = 0; j < n; j++) {
+        double scale = 0.0;
+        for (size_t i = (j > bw) ? j - bw : 0; i < std::min(j + bw + 1, n); i++) {
+            scale = std::max(scale, std::abs(jac.value(i,j)));
+        }
+        for (size_t i = (j > bw) ? j - bw : 0; i < std::min(j + bw + 1, n); i++) {
+            EXPECT_NEAR(jac.value(i,j), remapped.value(i,j), 1e-8 * scale)
+                << "i = " << i << ", j = " << j;
+        }
+    }
+
+    // An invalidated Jacobian is not reused
+    fuel.setMoleFractions("H2:0.8, AR:1.2");
+    sim->setRefineCriteria(1, 10.0, 0.2, 0.3);
+    ASSERT_GT(sim->refine(0), 0);
+    EXPECT_EQ((size_t) 0, sim->OneDim::jacobian().nPendingPoints());
+}
+
+TEST_F(CounterflowTest, transposed_solve)
+{
+    size_t n = sim->size();
+    MultiJac& jac = sim->OneDim::jacobian();
+    vector_fp b(n), x(n);
+    for (size_t i = 0; i < n; i++) {
+        b[i] = 1.0 + std::sin(1.0*i);
+    }
+    for (int block = 0; block < 2; block++) {
+        jac.setBlockTridiagonal(block == 1);
+        sim->evalSSJacobian();
+        ASSERT_EQ(0, jac.solveTranspose(&b[0], &x[0]));
+        double xmax = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            xmax = std::max(xmax, std::abs(x[i]));
+        }
+        for (size_t j = 0; j < n; j++) {
+            double sum = 0.0, scale = 0.0;
+            for (size_t i = 0; i < n; i++) {
+                sum += jac.value(i,j) * x[i];
+                scale += std::abs(jac.value(i,j)) * xmax;
+            }
+            EXPECT_NEAR(b[j], sum, 1e-12 * scale)
+                << "block = " << block << ", j = " << j;
+        }
+    }
+}
+
+TEST_F(CounterflowTest, adjoint_sensitivities)
+{
+    sim->solve(0, false);
+    flow.solveEnergyEqn();
+    flow.setSteadyTolerances(1e-10, 1e-14);
+    flow.setTransientTolerances(1e-10, 1e-14);
+    sim->solve(0, false);
+
+    // sensitivities of the temperature at the middle grid point
+    size_t n = sim->size();
+    size_t iT = flow.loc() + 6 * flow.nComponents() + 2;
+    ASSERT_EQ("T", flow.componentName(2));
+    vector_fp dgdx(n, 0.0), sens(gas.nReactions());
+    dgdx[iT] = 1.0;
+    sim->getReactionSensitivities(gas, &dgdx[0], &sens[0]);
+    for (size_t i = 0; i < gas.nReactions(); i++) {
+        EXPECT_DOUBLE_EQ(1.0, gas.multiplier(i));
+    }
+
+    // compare with central differences of the solution for some of the most
+    // sensitive reactions
+    vector_fp x0(sim->solution(), sim->solution() + n);
+    size_t reactions[] = {7, 13, 19, 20};
+    double dp = 1e-4;
+    for (size_t m = 0; m < 4; m++) {
+        size_t i = reactions[m];
+        gas.setMultiplier(i, 1.0 + dp);
+        sim->solve(0, false);
+        double T1 = sim->solution()[iT];
+        sim->setSolution(&x0[0]);
+        gas.setMultiplier(i, 1.0 - dp);
+        sim->solve(0, false);
+        double T2 = sim->solution()[iT];
+        sim->setSolution(&x0[0]);
+        gas.setMultiplier(i, 1.0);
+        EXPECT_NEAR((T1 - T2) / (2 * dp), sens[i], 2e-3 * std::abs(sens[i]))
+            << "reaction " << i;
+    }
+}
+
+TEST_F(CounterflowTest, newton_krylov)
+{
+    MultiNewton& newton = sim->newton();
+    EXPECT_FALSE(newton.krylov());
+    newton.setKrylov(true);
+    newton.setJacReuseRate(0.3);
+    sim->solve(0, false);
+    EXPECT_GT(newton.nKrylovIters(), 0);
+    EXPECT_GT(sim->OneDim::jacobian().nFactors(), 0);
+
+    // the solution satisfies the convergence criterion of the direct solver
+    newton.setKrylov(false);
+    size_t n = sim->size();
+    vector_fp x(sim->solution(), sim->solution() + n), step(n);
+    sim->evalSSJacobian();
+    newton.step(&x[0], &step[0], *sim, sim->OneDim::jacobian(), 0);
+    EXPECT_LT(newton.norm2(&x[0], &step[0], *sim), 1.0);
+}
+
+TEST_F(CounterflowTest, natural_continuation)
+{
+    sim->solve(0, false);
+    flow.solveEnergyEqn();
+    sim->solve(0, false);
+    size_t n = sim->size();
+    vector_fp x0(sim->solution(), sim->solution() + n);
+
+    FuelFraction xfuel(fuel, gas);
+    sim->initContinuation(xfuel, -0.02, false);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(0, sim->continuationStep());
+    }
+    EXPECT_LT(xfuel.value(), 0.48);
+    vector_fp x1(sim->solution(), sim->solution() + n);
+
+    // same solution as the one found by the ordinary solver
+    sim->setSolution(&x0[0]);
+    sim->solve(0, false);
+    for (size_t j = 0; j < flow.nPoints(); j++) {
+        EXPECT_NEAR(sim->value(1, 2, j), x1[flow.loc() + flow.index(2, j)],
+                    0.05);
+    }
+}
+
+TEST_F(CounterflowTest, arclength_continuation)
+{
+    sim->solve(0, false);
+    flow.solveEnergyEqn();
+    sim->setRefineCriteria(1, 5.0, 0.5, 0.5);
+    sim->setMaxGridPoints(1, 40);
+    sim->solve(0, true);
+    FuelFraction xfuel(fuel, gas);
+    xfuel.setValue(0.09);
+    sim->solve(0, false);
+
+    // Reduce the fuel fraction until the flame is extinguished
+    sim->initContinuation(xfuel, -0.01);
+    EXPECT_LT(sim->continuationDirection(), 0.0);
+    int nsteps = 0;
+    while (!sim->continuationStep() && nsteps < 100) {
+        nsteps++;
+    }
+    ASSERT_LT(nsteps, 100);
+    EXPECT_GT(sim->continuationDirection(), 0.0);
+    EXPECT_NEAR(0.071, xfuel.value(), 0.005);
+
+    // Past the turning point, the maximum temperature decreases as the fuel
+    // fraction increases
+    size_t n = sim->size();
+    double Tmax0 = 0.0, Tmax1 = 0.0;
+    for (size_t j = 0; j < flow.nPoints(); j++) {
+        Tmax0 = std::max(Tmax0, sim->value(1, 2, j));
+    }
+    double p0 = xfuel.value();
+    for (int i = 0; i < 3; i++) {
+        sim->continuationStep();
+    }
+    for (size_t j = 0; j < flow.nPoints(); j++) {
+        Tmax1 = std::max(Tmax1, sim->value(1, 2, j));
+    }
+    vector_fp x(sim->solution(), sim->solution() + n);
+    EXPECT_GT(xfuel.value(), p0);
+    EXPECT_LT(Tmax1, Tmax0);
+
+    // The point on the middle branch is a steady-state solution, which the
+    // ordinary solver accepts without moving to the extinguished branch
+    sim->solve(0, false);
+    for (size_t j = 0; j < flow.nPoints(); j++) {
+        EXPECT_NEAR(x[flow.loc() + flow.index(2, j)], sim->value(1, 2, j),
+                    0.1);
+    }
+}
+
+TEST_F(CounterflowTest, continuation_errors)
+{
+    FuelFraction xfuel(fuel, gas);
+    EXPECT_THROW(sim->continuationStep(), CanteraError);
+    sim->solve(0, false);
+    EXPECT_THROW(sim->initContinuation(xfuel, 0.0), CanteraError);
+    sim->initContinuation(xfuel, -0.01);
+
+    // the grid can't be changed during the continuation
+    sim->setRefineCriteria(1, 2.0, 0.1, 0.1);
+    sim->refine(0);
+    EXPECT_THROW(sim->continuationStep(), CanteraError);
+}
+}
+
+int main(int argc, char** argv)
+{
+    printf("Running main() from jacobian.cpp\n");
+    testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+    Cantera::appdelete();
+    return result;
+}
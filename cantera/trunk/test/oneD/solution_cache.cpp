@@ -0,0 +1,195 @@
+#include "gtest/gtest.h"
+#include "cantera/oneD/Sim1D.h"
+#include "cantera/oneD/Inlet1D.h"
+#include "cantera/oneD/StFlow.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/transport.h"
+#include "cantera/numerics/funcs.h"
+
+#include <algorithm>
+
+namespace Cantera
+{
+
+//! Freely-propagating H2/O2/Ar flame, with the location of the flame fixed
+//! by the point where T = 900 K
+class FreeFlameTest : public testing::Test
+{
+public:
+    FreeFlameTest() :
+        gas("h2o2.xml", "ohmech"),
+        flow(&gas)
+    {
+        vector_fp z(6);
+        for (size_t i = 0; i < 5; i++) {
+            z[i] = 0.0075 * i;
+        }
+        z[5] = 0.0315;
+        flow.setupGrid(6, &z[0]);
+        tr = newTransportMgr("Mix", &gas);
+        flow.setTransport(*tr);
+        flow.setKinetics(gas);
+        flow.setPressure(OneAtm);
+
+        std::vector<Domain1D*> domains;
+        domains.push_back(&inlet);
+        domains.push_back(&flow);
+        domains.push_back(&outlet);
+        sim = new Sim1D(domains);
+        sim->setRefineCriteria(1, 10.0, 0.5, 0.5);
+        setInlet(0.6);
+
+        double rho_in = gas.density();
+        vector_fp yin(gas.nSpecies()), yout(gas.nSpecies());
+        gas.getMassFractions(&yin[0]);
+        gas.equilibrate("HP");
+        gas.getMassFractions(&yout[0]);
+        double rho_out = gas.density();
+        double Tad = gas.temperature();
+        double mdot = 0.3 * rho_in;
+        inlet.setMdot(mdot);
+
+        vector_fp locs(3), values(3);
+        locs[0] = 0.0;
+        locs[1] = 0.7;
+        locs[2] = 1.0;
+        values[0] = mdot / rho_in;
+        values[1] = values[2] = mdot / rho_out;
+        sim->setInitialGuess("u", locs, values);
+        values[0] = 300.0;
+        values[1] = values[2] = Tad;
+        sim->setInitialGuess("T", locs, values);
+        for (size_t k = 0; k < gas.nSpecies(); k++) {
+            values[0] = yin[k];
+            values[1] = values[2] = yout[k];
+            sim->setInitialGuess(gas.speciesName(k), locs, values);
+        }
+    }
+
+    ~FreeFlameTest() {
+        delete sim;
+        delete tr;
+    }
+
+    //! Set the equivalence ratio of the unburned gas
+    void setInlet(double phi) {
+        vector_fp x(gas.nSpecies(), 0.0);
+        x[gas.speciesIndex("H2")] = 2.0 * phi;
+        x[gas.speciesIndex("O2")] = 1.0;
+        x[gas.speciesIndex("AR")] = 5.0;
+        gas.setState_TPX(300.0, OneAtm, &x[0]);
+        inlet.setMoleFractions(&x[0]);
+        inlet.setTemperature(300.0);
+    }
+
+    void solve() {
+        flow.fixTemperature();
+        sim->setFixedTemperature(900.0);
+        sim->solve(0, true);
+        flow.solveEnergyEqn();
+        sim->solve(0, true);
+    }
+
+    IdealGasMix gas;
+    Transport* tr;
+    FreeFlame flow;
+    Inlet1D inlet;
+    Outlet1D outlet;
+    Sim1D* sim;
+};
+
+TEST_F(FreeFlameTest, nearest_solution)
+{
+    solve();
+    vector_fp params(1, 0.6);
+    sim->cacheSolution(params);
+    vector_fp z0 = flow.grid();
+    vector_fp T0(z0.size());
+    for (size_t j = 0; j < z0.size(); j++) {
+        T0[j] = sim->value(1, 2, j);
+    }
+
+    setInlet(1.0);
+    params[0] = 1.0;
+    sim->solve(0, true);
+    sim->cacheSolution(params);
+    EXPECT_EQ((size_t) 2, sim->nCachedSolutions());
+    double Su1 = sim->value(1, 0, 0);
+
+    // Nearest solution is the first one, which is restored exactly at the
+    // points of its grid
+    setInlet(0.7);
+    params[0] = 0.7;
+    ASSERT_GT(flow.nPoints(), z0.size());
+    EXPECT_EQ((size_t) 0, sim->restoreCachedSolution(params));
+    size_t nmatch = 0;
+    for (size_t j = 0; j < flow.nPoints(); j++) {
+        size_t k = std::find(z0.begin(), z0.end(), flow.grid(j)) - z0.begin();
+        if (k != z0.size()) {
+            EXPECT_NEAR(T0[k], sim->value(1, 2, j), 1e-10 * T0[k]);
+            nmatch++;
+        }
+    }
+    EXPECT_EQ(z0.size(), nmatch);
+
+    // Starting from the nearest solution gives the same solution as before
+    setInlet(1.0);
+    params[0] = 0.9;
+    EXPECT_EQ((size_t) 1, sim->restoreCachedSolution(params));
+    sim->solve(0, true);
+    EXPECT_NEAR(Su1, sim->value(1, 0, 0), 1e-4 * Su1);
+}
+
+TEST_F(FreeFlameTest, fixed_temperature_point)
+{
+    solve();
+    vector_fp params(2);
+    params[0] = 0.6;
+    params[1] = 300.0;
+    sim->cacheSolution(params);
+    vector_fp z0 = flow.grid();
+    vector_fp T0(z0.size());
+    size_t jfixed = npos;
+    for (size_t j = 0; j < z0.size(); j++) {
+        T0[j] = sim->value(1, 2, j);
+        if (z0[j] == flow.m_zfixed) {
+            jfixed = j;
+        }
+    }
+    ASSERT_NE(npos, jfixed);
+    EXPECT_DOUBLE_EQ(900.0, T0[jfixed]);
+
+    // Move the fixed point downstream. The cached profiles are shifted so
+    // that the temperature at the new fixed point is the fixed temperature.
+    double shift = z0[jfixed + 3] - z0[jfixed];
+    flow.m_zfixed = z0[jfixed + 3];
+    sim->restoreCachedSolution(params);
+    EXPECT_EQ(900.0, flow.m_tfixed);
+    EXPECT_NEAR(900.0, sim->value(1, 2, jfixed + 3), 1e-8);
+    for (size_t j = 0; j < z0.size(); j++) {
+        double T = linearInterp(z0[j] - shift, z0, T0);
+        EXPECT_NEAR(T, sim->value(1, 2, j), 1e-8) << j;
+    }
+
+    // The fixed temperature of the cached solution is used if the current
+    // flame has none
+    flow.m_tfixed = Undef;
+    flow.m_zfixed = Undef;
+    sim->restoreCachedSolution(params);
+    EXPECT_EQ(900.0, flow.m_tfixed);
+    EXPECT_EQ(z0[jfixed], flow.m_zfixed);
+    EXPECT_NEAR(900.0, sim->value(1, 2, jfixed), 1e-8);
+}
+
+TEST_F(FreeFlameTest, cache_errors)
+{
+    vector_fp params(2, 1.0);
+    EXPECT_THROW(sim->restoreCachedSolution(params), CanteraError);
+    sim->cacheSolution(params);
+    params.push_back(1.0);
+    EXPECT_THROW(sim->restoreCachedSolution(params), CanteraError);
+    sim->clearSolutionCache();
+    EXPECT_EQ((size_t) 0, sim->nCachedSolutions());
+}
+
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "cantera/thermo/HMWSoln.h"
+
+namespace Cantera
+{
+
+class HMWSoln_Test : public testing::Test
+{
+public:
+    HMWSoln_Test() : brine("../data/HMW_NaCl_sp1977_alt.xml",
+                           "NaCl_electrolyte") {
+        nsp = brine.nSpecies();
+        moll.resize(nsp, 0.0);
+        moll[brine.speciesIndex("Na+")] = 3.0;
+        moll[brine.speciesIndex("Cl-")] = 3.0;
+    }
+
+    void setState(HMWSoln& p, double T, double P) {
+        p.setState_TP(T, P);
+        p.setMolalities(&moll[0]);
+    }
+
+    HMWSoln brine;
+    size_t nsp;
+    vector_fp moll;
+};
+
+// The partial molar enthalpies, heat capacities and volumes depend on the
+// temperature and pressure derivatives of the activity coefficients, which
+// should be consistent with finite differences of the chemical potentials.
+void checkDerivatives(HMWSoln& p, const vector_fp& moll, bool checkCp)
+{
+    size_t nsp = p.nSpecies();
+    double T = 323.15;
+    double P = 2 * OneAtm;
+    double dT = 1e-3 * T;
+    double dP = 1e-2 * P;
+    vector_fp mu(nsp), muTp(nsp), muTm(nsp), muP(nsp);
+    vector_fp h(nsp), hTp(nsp), hTm(nsp), cp(nsp), V(nsp);
+
+    p.setState_TP(T + dT, P);
+    p.setMolalities(&moll[0]);
+    p.getChemPotentials(&muTp[0]);
+    p.getPartialMolarEnthalpies(&hTp[0]);
+    p.setState_TP(T - dT, P);
+    p.setMolalities(&moll[0]);
+    p.getChemPotentials(&muTm[0]);
+    p.getPartialMolarEnthalpies(&hTm[0]);
+    p.setState_TP(T, P + dP);
+    p.setMolalities(&moll[0]);
+    p.getChemPotentials(&muP[0]);
+    p.setState_TP(T, P);
+    p.setMolalities(&moll[0]);
+    p.getChemPotentials(&mu[0]);
+    p.getPartialMolarEnthalpies(&h[0]);
+    p.getPartialMolarCp(&cp[0]);
+    p.getPartialMolarVolumes(&V[0]);
+
+    for (size_t k = 0; k < nsp; k++) {
+        if (k != 0 && moll[k] == 0.0) {
+            continue;
+        }
+        // h = mu - T * dmu/dT
+        double hfd = mu[k] - T * (muTp[k] - muTm[k]) / (2 * dT);
+        EXPECT_NEAR(hfd, h[k], 1e-5 * std::abs(h[k]) + 10.0) << k;
+        if (checkCp) {
+            double cpfd = (hTp[k] - hTm[k]) / (2 * dT);
+            EXPECT_NEAR(cpfd, cp[k], 1e-3 * std::abs(cp[k]) + 0.1) << k;
+        }
+        double Vfd = (muP[k] - mu[k]) / dP;
+        EXPECT_NEAR(Vfd, V[k], 1e-3 * std::abs(V[k]) + 1e-7) << k;
+    }
+}
+
+TEST_F(HMWSoln_Test, derivatives_vs_finite_difference)
+{
+    // The second temperature derivative of A_Debye computed by WaterProps
+    // is only approximate, so the heat capacity is checked using the
+    // constant A_Debye input below.
+    checkDerivatives(brine, moll, false);
+}
+
+TEST_F(HMWSoln_Test, derivatives_vs_finite_difference_const_ADebye)
+{
+    HMWSoln tc("../data/HMW_NaCl_tc.xml", "NaCl_electrolyte");
+    checkDerivatives(tc, moll, true);
+}
+
+// Derivatives which are requested once are evaluated along with the activity
+// coefficients for later states. The results should not depend on the order
+// in which the properties are requested.
+TEST_F(HMWSoln_Test, evaluation_order)
+{
+    HMWSoln other("../data/HMW_NaCl_sp1977_alt.xml", "NaCl_electrolyte");
+    vector_fp ac1(nsp), ac2(nsp), cp1(nsp), cp2(nsp), V1(nsp), V2(nsp);
+    setState(brine, 298.15, OneAtm);
+    brine.getPartialMolarCp(&cp1[0]);
+    brine.getPartialMolarVolumes(&V1[0]);
+
+    for (int n = 0; n < 3; n++) {
+        double T = 300.0 + 20.0 * n;
+        moll[brine.speciesIndex("Na+")] = moll[brine.speciesIndex("Cl-")] =
+            1.0 + n;
+        setState(brine, T, OneAtm);
+        setState(other, T, OneAtm);
+        brine.getMolalityActivityCoefficients(&ac1[0]);
+        brine.getPartialMolarCp(&cp1[0]);
+        brine.getPartialMolarVolumes(&V1[0]);
+        other.getPartialMolarVolumes(&V2[0]);
+        other.getPartialMolarCp(&cp2[0]);
+        other.getMolalityActivityCoefficients(&ac2[0]);
+        for (size_t k = 0; k < nsp; k++) {
+            EXPECT_DOUBLE_EQ(ac1[k], ac2[k]);
+            EXPECT_DOUBLE_EQ(cp1[k], cp2[k]);
+            EXPECT_DOUBLE_EQ(V1[k], V2[k]);
+        }
+    }
+}
+
+}
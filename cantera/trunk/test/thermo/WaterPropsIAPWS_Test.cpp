@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include "cantera/thermo/WaterPropsIAPWS.h"
+#include "cantera/base/ctexceptions.h"
+
+namespace Cantera
+{
+
+class WaterDensityTableTest : public testing::Test
+{
+public:
+    WaterDensityTableTest() {
+        tabulated.setDensityTabulation(280.0, 450.0, 2.0E7, 1.0E-6);
+    }
+
+    WaterPropsIAPWS exact;
+    WaterPropsIAPWS tabulated;
+};
+
+TEST_F(WaterDensityTableTest, table_size)
+{
+    EXPECT_GT(tabulated.densityTableSize(), (size_t) 81);
+    EXPECT_LE(tabulated.densityTableError(), 1.0E-6);
+    EXPECT_EQ((size_t) 0, exact.densityTableSize());
+    tabulated.disableDensityTabulation();
+    EXPECT_EQ((size_t) 0, tabulated.densityTableSize());
+}
+
+TEST_F(WaterDensityTableTest, liquid_states)
+{
+    for (int i = 0; i < 20; i++) {
+        double T = 280.0 + 8.5 * i + 0.3;
+        double P = std::max(exact.psat_est(T), 1.0E5) + 9.7E5 * i;
+        double rho1 = exact.density(T, P, WATER_LIQUID);
+        double h1 = exact.enthalpy();
+        double rho2 = tabulated.density(T, P, WATER_LIQUID, 1000.0);
+        double h2 = tabulated.enthalpy();
+        // Both densities are within the convergence tolerance of the full
+        // iteration of the exact value
+        EXPECT_NEAR(rho1, rho2, 1.0E-9 * rho1);
+        EXPECT_NEAR(h1, h2, 1.0E-8 * std::abs(h1));
+        EXPECT_DOUBLE_EQ(T, tabulated.temperature());
+        EXPECT_DOUBLE_EQ(rho2, tabulated.density());
+    }
+}
+
+TEST_F(WaterDensityTableTest, fallback)
+{
+    // above the tabulated temperatures
+    EXPECT_DOUBLE_EQ(exact.density(500.0, 1.0E7, WATER_LIQUID),
+                     tabulated.density(500.0, 1.0E7, WATER_LIQUID));
+    // above the tabulated pressures
+    EXPECT_DOUBLE_EQ(exact.density(300.0, 5.0E7, WATER_LIQUID),
+                     tabulated.density(300.0, 5.0E7, WATER_LIQUID));
+    // below the saturation pressure
+    EXPECT_DOUBLE_EQ(exact.density(400.0, 1.0E5, WATER_LIQUID),
+                     tabulated.density(400.0, 1.0E5, WATER_LIQUID));
+    // steam
+    EXPECT_DOUBLE_EQ(exact.density(400.0, 1.0E5, WATER_GAS),
+                     tabulated.density(400.0, 1.0E5, WATER_GAS));
+    EXPECT_DOUBLE_EQ(exact.density(400.0, 1.0E5, -1),
+                     tabulated.density(400.0, 1.0E5, -1));
+    EXPECT_DOUBLE_EQ(exact.density(400.0, 1.0E5, WATER_LIQUID, 1.0),
+                     tabulated.density(400.0, 1.0E5, WATER_LIQUID, 1.0));
+}
+
+TEST_F(WaterDensityTableTest, invalid_range)
+{
+    WaterPropsIAPWS water;
+    EXPECT_THROW(water.setDensityTabulation(280.0, 700.0), CanteraError);
+    EXPECT_THROW(water.setDensityTabulation(200.0, 400.0), CanteraError);
+    EXPECT_THROW(water.setDensityTabulation(280.0, 400.0, 500.0),
+                 CanteraError);
+    EXPECT_EQ((size_t) 0, water.densityTableSize());
+}
+
+// The density iteration used to fail for the liquid at some low pressures,
+// where round-off errors prevented it from meeting its convergence criteria
+TEST(WaterPropsIAPWS, psat_roundoff)
+{
+    WaterPropsIAPWS water;
+    EXPECT_NEAR(2135.0, water.psat(291.68754863012936), 1.0);
+}
+
+}
@@ -94,3 +94,70 @@ TEST_F(SpeciesThermoInterpTypeTest, install_shomate)
     EXPECT_FLOAT_EQ(p2.entropy_mass(), p.entropy_mass());
     EXPECT_FLOAT_EQ(p2.cp_mass(), p.cp_mass());
 }
+
+//! Check that the properties of all species computed together by
+//! SpeciesThermo::update match the ones computed for each species by
+//! SpeciesThermo::update_one, and the ones computed for all temperatures
+//! together by GeneralSpeciesThermo::updateBatch.
+void checkUpdate(ThermoPhase& p)
+{
+    size_t nsp = p.nSpecies();
+    vector_fp cp(nsp), h(nsp), s(nsp), cp1(nsp), h1(nsp), s1(nsp);
+    double T[] = {250.0, 298.15, 700.0, 999.99, 1000.0, 1000.01, 1382.0,
+                  2000.0, 3000.0, 5000.0};
+    size_t nT = 10;
+    vector_fp cpb(nsp*nT), hb(nsp*nT), sb(nsp*nT);
+    SpeciesThermo& spthermo = p.speciesThermo();
+    GeneralSpeciesThermo* gsp = dynamic_cast<GeneralSpeciesThermo*>(&spthermo);
+    ASSERT_TRUE(gsp != 0);
+    gsp->updateBatch(nT, T, &cpb[0], &hb[0], &sb[0]);
+    for (size_t i = 0; i < nT; i++) {
+        spthermo.update(T[i], &cp[0], &h[0], &s[0]);
+        for (size_t k = 0; k < nsp; k++) {
+            spthermo.update_one(k, T[i], &cp1[0], &h1[0], &s1[0]);
+            EXPECT_DOUBLE_EQ(cp1[k], cp[k]) << p.speciesName(k) << " " << T[i];
+            EXPECT_DOUBLE_EQ(h1[k], h[k]) << p.speciesName(k) << " " << T[i];
+            EXPECT_DOUBLE_EQ(s1[k], s[k]) << p.speciesName(k) << " " << T[i];
+            EXPECT_EQ(cp[k], cpb[k*nT + i]) << p.speciesName(k) << " " << T[i];
+            EXPECT_EQ(h[k], hb[k*nT + i]) << p.speciesName(k) << " " << T[i];
+            EXPECT_EQ(s[k], sb[k*nT + i]) << p.speciesName(k) << " " << T[i];
+        }
+    }
+}
+
+TEST(GeneralSpeciesThermo, update_nasa)
+{
+    IdealGasPhase p("gri30.xml", "gri30");
+    checkUpdate(p);
+}
+
+TEST(GeneralSpeciesThermo, update_shomate)
+{
+    IdealGasPhase p("../data/simplephases.cti", "shomate1");
+    checkUpdate(p);
+}
+
+TEST(GeneralSpeciesThermo, update_mixed)
+{
+    // NASA (7 coefficient) and NASA9 species with two and four temperature
+    // regions
+    IdealGasPhase p("../data/gasNASA9.xml", "nasa9");
+    checkUpdate(p);
+
+    IdealGasPhase p2("../data/simplephases.cti", "simple1");
+    checkUpdate(p2);
+}
+
+TEST(GeneralSpeciesThermo, modify_Hf298)
+{
+    IdealGasPhase p("gri30.xml", "gri30");
+    size_t k = p.speciesIndex("OH");
+    double h0 = p.speciesThermo().reportOneHf298(k);
+    p.modifyOneHf298SS(k, h0 + 1.0e6);
+    checkUpdate(p);
+
+    size_t nsp = p.nSpecies();
+    vector_fp cp(nsp), h(nsp), s(nsp);
+    p.speciesThermo().update(298.15, &cp[0], &h[0], &s[0]);
+    EXPECT_NEAR(h0 + 1.0e6, h[k] * GasConstant * 298.15, 1e-6 * std::abs(h0));
+}
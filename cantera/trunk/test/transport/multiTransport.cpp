@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+
+#include "cantera/IdealGasMix.h"
+#include "cantera/transport/TransportFactory.h"
+
+namespace Cantera
+{
+
+// Reference values were computed by solving the full 3K x 3K L matrix
+// equation, before the internal energy block was eliminated from it.
+class MultiTransportTest : public testing::Test
+{
+public:
+    void check(const std::string& file, const std::string& phase, double T,
+               const std::string& X, double lambda,
+               const std::map<std::string, double>& Dtherm) {
+        IdealGasMix gas(file, phase);
+        Transport* tr = newTransportMgr("Multi", &gas);
+        gas.setState_TPX(T, OneAtm, X);
+        size_t K = gas.nSpecies();
+        vector_fp dt(K), d(K*K);
+
+        // The multicomponent diffusion coefficients overwrite part of the L
+        // matrix, and should not affect the other properties
+        tr->getMultiDiffCoeffs(K, &d[0]);
+        EXPECT_NEAR(lambda, tr->thermalConductivity(), 1e-12 * lambda);
+        tr->getThermalDiffCoeffs(&dt[0]);
+        std::map<std::string, double>::const_iterator iter;
+        for (iter = Dtherm.begin(); iter != Dtherm.end(); ++iter) {
+            size_t k = gas.speciesIndex(iter->first);
+            EXPECT_NEAR(iter->second, dt[k], 1e-10 * std::abs(iter->second))
+                << iter->first;
+        }
+        for (size_t k = 0; k < K; k++) {
+            if (!Dtherm.count(gas.speciesName(k))) {
+                // species not present in the mixture
+                EXPECT_NEAR(0.0, dt[k], 1e-18) << gas.speciesName(k);
+            }
+        }
+        delete tr;
+    }
+};
+
+TEST_F(MultiTransportTest, h2o2)
+{
+    // H, O and AR have no internal energy modes
+    std::map<std::string, double> Dtherm;
+    Dtherm["H2"] = -1.20873847323086e-06;
+    Dtherm["H"] = -2.46077354742061e-07;
+    Dtherm["O"] = -3.71297077551045e-07;
+    Dtherm["O2"] = 5.44487609336643e-07;
+    Dtherm["OH"] = -3.24463973348784e-07;
+    Dtherm["H2O"] = -1.30414077807019e-06;
+    Dtherm["AR"] = 2.9102300476063e-06;
+    check("h2o2.xml", "ohmech", 1200.0,
+          "H2:0.2, O2:0.1, H2O:0.3, H:0.05, O:0.05, OH:0.05, AR:0.25",
+          0.167091243427409, Dtherm);
+}
+
+TEST_F(MultiTransportTest, gri30)
+{
+    std::map<std::string, double> Dtherm;
+    Dtherm["H"] = -2.65173610409436e-08;
+    Dtherm["O2"] = 2.72142245603896e-07;
+    Dtherm["OH"] = -4.82298545042808e-08;
+    Dtherm["H2O"] = -7.68829335510877e-07;
+    Dtherm["CH4"] = -1.42095186700375e-07;
+    Dtherm["CO"] = 1.3751246239944e-09;
+    Dtherm["CO2"] = 7.200690901577e-07;
+    Dtherm["N2"] = -1.02149161499399e-07;
+    Dtherm["AR"] = 9.42344388702856e-08;
+    check("gri30.xml", "gri30", 1800.0,
+          "CH4:0.02, O2:0.1, N2:0.7, H2O:0.1, CO2:0.05, CO:0.01, OH:0.005, "
+          "H:0.005, AR:0.01", 0.127917855244282, Dtherm);
+}
+
+TEST(MultiTransport, state_changes)
+{
+    // The inverse of L00,00 is shared by getMultiDiffCoeffs() and
+    // thermalConductivity(), and must be updated when the state changes
+    IdealGasMix gas("h2o2.xml", "ohmech");
+    Transport* tr = newTransportMgr("Multi", &gas);
+    size_t K = gas.nSpecies();
+    vector_fp d1(K*K), d2(K*K);
+    std::string X1 = "H2:0.2, O2:0.1, H2O:0.3, H:0.05, OH:0.05, AR:0.3";
+    std::string X2 = "H2:0.5, O2:0.2, H2O:0.1, O:0.1, AR:0.1";
+
+    gas.setState_TPX(1200.0, OneAtm, X1);
+    double lambda1 = tr->thermalConductivity();
+    tr->getMultiDiffCoeffs(K, &d1[0]);
+
+    gas.setState_TPX(1200.0, OneAtm, X2);
+    tr->getMultiDiffCoeffs(K, &d2[0]);
+    double lambda2 = tr->thermalConductivity();
+    EXPECT_GT(std::abs(lambda2 - lambda1), 1e-3 * lambda1);
+
+    gas.setState_TPX(1500.0, OneAtm, X1);
+    EXPECT_GT(std::abs(tr->thermalConductivity() - lambda1), 1e-3 * lambda1);
+
+    gas.setState_TPX(1200.0, OneAtm, X1);
+    EXPECT_DOUBLE_EQ(lambda1, tr->thermalConductivity());
+    tr->getMultiDiffCoeffs(K, &d2[0]);
+    for (size_t i = 0; i < K*K; i++) {
+        EXPECT_DOUBLE_EQ(d1[i], d2[i]);
+    }
+    delete tr;
+}
+
+}